@@ -255,6 +255,24 @@ typedef enum aqlprofile_att_parameter_rt_timestamp_t
   AQLPROFILE_ATT_PARAMETER_RT_TIMESTAMP_DISABLE
 } aqlprofile_att_parameter_rt_timestamp_t;
 
+/**
+ * @brief Flags selecting how aqlprofile_att_iterate_data() reads the trace buffers
+ */
+typedef enum aqlprofile_att_parameter_export_flags_t
+{
+  AQLPROFILE_ATT_PARAMETER_EXPORT_DEFAULT = 0,  // Copy the shader engine buffers one at a time
+  /**
+   * Copy the buffers of all shader engines concurrently, each into its own host buffer.
+   * The memory copy callback is then called from several threads at once.
+   */
+  AQLPROFILE_ATT_PARAMETER_EXPORT_CONCURRENT_COPY = 1 << 0,
+  /**
+   * Request a host accessible trace buffer and pass its per shader engine regions to the
+   * data callback without a copy. Gfx9 data, which needs a header prepended, is still copied.
+   */
+  AQLPROFILE_ATT_PARAMETER_EXPORT_HOST_ACCESS = 1 << 1,
+} aqlprofile_att_parameter_export_flags_t;
+
 typedef enum aqlprofile_att_parameter_name_ext_t
 {
   /**
@@ -262,6 +280,7 @@ typedef enum aqlprofile_att_parameter_name_ext_t
    */
   AQLPROFILE_ATT_PARAMETER_NAME_BUFFER_SIZE_HIGH = 11,
   AQLPROFILE_ATT_PARAMETER_NAME_RT_TIMESTAMP,  // one of aqlprofile_att_parameter_rt_timestamp_t
+  AQLPROFILE_ATT_PARAMETER_NAME_EXPORT_FLAGS,  // mask of aqlprofile_att_parameter_export_flags_t
 } aqlprofile_att_parameter_name_ext_t;
 
 // Profile parameter object
@@ -301,7 +320,7 @@ typedef hsa_status_t (*aqlprofile_pmc_data_callback_t)(aqlprofile_pmc_event_t ev
 /**
  * @brief Data callback for thread trace. This will be called at least once per shader engine
  * @param[in] shader Shader Engine ID
- * @param[in] buffer Pointer containing the data
+ * @param[in] buffer Pointer containing the data, only valid for the duration of the callback
  * @param[in] size Amount of bytes used by thread trace
  * @param[in] callback_data Data returned to user
  * @retval HSA_STATUS_SUCCESS to continue iteration
@@ -378,6 +397,8 @@ void aqlprofile_pmc_delete_packets(aqlprofile_handle_t handle);
 
 /**
  * @brief Iterates over thread trace data and the data to user
+ * The callback is called from the calling thread, in shader engine order. How the data is read
+ * is selected by AQLPROFILE_ATT_PARAMETER_NAME_EXPORT_FLAGS.
  * @param[in] handle The handle returned from aqlprofile_att_create_packets()
  * @param[in] callback CB where the resulting data is going to be returned
  * @param[in] userdata Data sent back to user
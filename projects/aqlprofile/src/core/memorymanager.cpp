@@ -22,6 +22,8 @@
 
 #include "memorymanager.hpp"
 #include <algorithm>
+#include <cstring>
+#include <future>
 
 std::atomic<size_t> MemoryManager::HANDLE_COUNTER{1};
 std::unordered_map<size_t, std::shared_ptr<MemoryManager>> MemoryManager::managers;
@@ -59,3 +61,58 @@ void CounterMemoryManager::CopyEvents(const aqlprofile_pmc_event_t* _events, siz
   events.insert(events.end(), acc_requests.begin(), acc_requests.end());
   std::sort(events.begin(), events.end());
 }
+
+void TraceMemoryManager::ExportSamples(const std::vector<TraceSample>& samples,
+                                       aqlprofile_att_data_callback_t callback, void* userdata) {
+  // Copies the sample, with its header, to the start of dst. Returns the size written.
+  auto copy_sample = [this](const TraceSample& sample, char* dst) {
+    size_t offset = 0;
+    if (sample.header) {
+      std::memcpy(dst, &*sample.header, sizeof(uint64_t));
+      offset = sizeof(uint64_t);
+    }
+    CopyMemory(dst + offset, sample.ptr, sample.size);
+    return offset + sample.size;
+  };
+
+  const bool zero_copy = IsOutputHostAccessible();
+  const bool concurrent = export_flags & AQLPROFILE_ATT_PARAMETER_EXPORT_CONCURRENT_COPY;
+
+  if (concurrent) {
+    // Start every copy up front, then hand the samples out in order as their copy completes,
+    // so the callback of one shader engine overlaps with the copies of the next ones.
+    std::vector<std::vector<char>> buffers(samples.size());
+    std::vector<std::future<size_t>> copies(samples.size());
+    for (size_t i = 0; i < samples.size(); i++) {
+      if (zero_copy && !samples[i].header) continue;
+      buffers[i].resize(samples[i].size + sizeof(uint64_t));
+      copies[i] = std::async(std::launch::async, copy_sample, std::cref(samples[i]),
+                             buffers[i].data());
+    }
+
+    for (size_t i = 0; i < samples.size(); i++) {
+      const TraceSample& sample = samples[i];
+      if (!copies[i].valid()) {
+        callback(sample.shader_engine, const_cast<void*>(sample.ptr), sample.size, userdata);
+        continue;
+      }
+      size_t size = copies[i].get();
+      callback(sample.shader_engine, buffers[i].data(), size, userdata);
+    }
+    return;
+  }
+
+  size_t max_sample_size = 0;
+  for (const auto& sample : samples) max_sample_size = std::max(sample.size, max_sample_size);
+  std::vector<char> buffer;
+
+  for (const auto& sample : samples) {
+    if (zero_copy && !sample.header) {
+      callback(sample.shader_engine, const_cast<void*>(sample.ptr), sample.size, userdata);
+      continue;
+    }
+    if (buffer.empty()) buffer.resize(max_sample_size + sizeof(uint64_t));
+    size_t size = copy_sample(sample, buffer.data());
+    callback(sample.shader_engine, buffer.data(), size, userdata);
+  }
+}
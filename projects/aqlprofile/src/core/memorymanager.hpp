@@ -26,6 +26,7 @@
 #include <mutex>
 #include <unordered_map>
 #include <memory>
+#include <optional>
 #include "aqlprofile-sdk/aql_profile_v2.h"
 #include <stdexcept>
 #include "pm4/trace_config.h"
@@ -185,6 +186,14 @@ class CounterMemoryManager : public MemoryManager {
   std::vector<EventRequest> events;
 };
 
+// Trace data written by one shader engine
+struct TraceSample {
+  uint32_t shader_engine;
+  const void* ptr;
+  size_t size;
+  std::optional<uint64_t> header;  // Prepended to the data when set
+};
+
 class TraceMemoryManager : public MemoryManager {
  public:
   TraceMemoryManager(hsa_agent_t agent, aqlprofile_memory_alloc_callback_t alloc,
@@ -199,11 +208,24 @@ class TraceMemoryManager : public MemoryManager {
   void CreateOutputBuf(size_t size) override {
     aqlprofile_buffer_desc_flags_t flags{};
     flags.device_access = true;
+    flags.host_access = IsOutputHostAccessible();
     flags.memory_hint = AQLPROFILE_MEMORY_HINT_DEVICE_NONCOHERENT;
     outputbuf = AllocMemory(size, flags);
     outputbuf_size = size;
   }
 
+  // Mask of aqlprofile_att_parameter_export_flags_t, set before CreateOutputBuf()
+  void SetExportFlags(uint32_t flags) { export_flags = flags; }
+  uint32_t GetExportFlags() const { return export_flags; }
+  bool IsOutputHostAccessible() const {
+    return export_flags & AQLPROFILE_ATT_PARAMETER_EXPORT_HOST_ACCESS;
+  }
+
+  // Passes the samples to the callback in order, copying them to host memory unless the
+  // output buffer is host accessible.
+  void ExportSamples(const std::vector<TraceSample>& samples,
+                     aqlprofile_att_data_callback_t callback, void* userdata);
+
   void CreateTraceControlBuf(size_t size) {
     aqlprofile_buffer_desc_flags_t flags{};
     flags.host_access = flags.device_access = true;
@@ -238,6 +260,7 @@ class TraceMemoryManager : public MemoryManager {
  protected:
   int target_cu = -1;
   int simd_mask = 0xF;
+  uint32_t export_flags = AQLPROFILE_ATT_PARAMETER_EXPORT_DEFAULT;
   aqlprofile_memory_copy_t copy_fn;
   std::vector<hsa_ven_amd_aqlprofile_parameter_t> att_params;
   std::unique_ptr<void, MemoryDeleter> trace_control_buf = nullptr;
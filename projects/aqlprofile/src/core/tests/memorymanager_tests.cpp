@@ -22,7 +22,10 @@
 
 #include "core/memorymanager.hpp"
 #include "gtest/gtest.h"
+#include <atomic>
 #include <cstring>
+#include <map>
+#include <string>
 
 // Dummy alloc/dealloc functions for testing
 hsa_status_t dummy_alloc(void** ptr, size_t size, aqlprofile_buffer_desc_flags_t, void*) {
@@ -121,4 +124,82 @@ TEST(CodeobjMemoryManagerTest, CmdBufferAlloc) {
     hsa_agent_t agent = {.handle = 1};
     CodeobjMemoryManager mgr(agent, dummy_alloc, dummy_dealloc, 128, nullptr);
     ASSERT_NE(mgr.cmd_buffer.get(), nullptr);
-}
\ No newline at end of file
+}
+
+std::atomic<int> copy_count{0};
+hsa_status_t counting_copy(void* dst, const void* src, size_t size, void*) {
+    copy_count++;
+    memcpy(dst, src, size);
+    return HSA_STATUS_SUCCESS;
+}
+
+struct ExportedSample {
+    const void* ptr;
+    std::string data;
+};
+
+hsa_status_t collect_sample(uint32_t shader, void* buffer, uint64_t size, void* userdata) {
+    auto* exported = static_cast<std::map<uint32_t, ExportedSample>*>(userdata);
+    (*exported)[shader] = {buffer, std::string(static_cast<char*>(buffer), size)};
+    return HSA_STATUS_SUCCESS;
+}
+
+class TraceExportTest : public ::testing::TestWithParam<uint32_t> {
+protected:
+    void SetUp() override {
+        copy_count = 0;
+        se_data = {std::string(96, 'a'), std::string(32, 'b'), std::string(160, 'c')};
+        for (uint32_t se = 0; se < se_data.size(); se++)
+            samples.push_back({se, se_data[se].data(), se_data[se].size(), std::nullopt});
+    }
+    std::vector<std::string> se_data;
+    std::vector<TraceSample> samples;
+};
+
+TEST_P(TraceExportTest, ExportsEverySample) {
+    hsa_agent_t agent = {.handle = 1};
+    TraceMemoryManager mgr(agent, dummy_alloc, dummy_dealloc, counting_copy, nullptr);
+    mgr.SetExportFlags(GetParam());
+
+    std::map<uint32_t, ExportedSample> exported;
+    mgr.ExportSamples(samples, collect_sample, &exported);
+
+    ASSERT_EQ(exported.size(), se_data.size());
+    for (uint32_t se = 0; se < se_data.size(); se++) ASSERT_EQ(exported[se].data, se_data[se]);
+
+    if (mgr.IsOutputHostAccessible()) {
+        EXPECT_EQ(copy_count, 0);
+        for (uint32_t se = 0; se < se_data.size(); se++)
+            EXPECT_EQ(exported[se].ptr, se_data[se].data());
+    } else {
+        EXPECT_EQ(copy_count, static_cast<int>(se_data.size()));
+    }
+}
+
+TEST_P(TraceExportTest, PrependsHeader) {
+    hsa_agent_t agent = {.handle = 1};
+    TraceMemoryManager mgr(agent, dummy_alloc, dummy_dealloc, counting_copy, nullptr);
+    mgr.SetExportFlags(GetParam());
+
+    const uint64_t header = 0x1122334455667788ull;
+    for (auto& sample : samples) sample.header = header;
+
+    std::map<uint32_t, ExportedSample> exported;
+    mgr.ExportSamples(samples, collect_sample, &exported);
+
+    // The header can not be prepended in place, so the samples are always copied
+    EXPECT_EQ(copy_count, static_cast<int>(se_data.size()));
+    ASSERT_EQ(exported.size(), se_data.size());
+    for (uint32_t se = 0; se < se_data.size(); se++) {
+        std::string expected(reinterpret_cast<const char*>(&header), sizeof(header));
+        ASSERT_EQ(exported[se].data, expected + se_data[se]);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ExportFlags, TraceExportTest,
+    ::testing::Values(AQLPROFILE_ATT_PARAMETER_EXPORT_DEFAULT,
+                      AQLPROFILE_ATT_PARAMETER_EXPORT_CONCURRENT_COPY,
+                      AQLPROFILE_ATT_PARAMETER_EXPORT_HOST_ACCESS,
+                      AQLPROFILE_ATT_PARAMETER_EXPORT_CONCURRENT_COPY |
+                          AQLPROFILE_ATT_PARAMETER_EXPORT_HOST_ACCESS));
@@ -113,7 +113,6 @@ hsa_status_t _internal_aqlprofile_att_iterate_data(aqlprofile_handle_t handle,
   }
 
   std::vector<size_t> sample_sizes(se_number_total, 0);
-  size_t max_sample_size = 0;
 
   // The samples sizes are returned in the control buffer
   for (uint64_t se_index = 0; se_index < se_number_total; se_index++) {
@@ -139,32 +138,26 @@ hsa_status_t _internal_aqlprofile_att_iterate_data(aqlprofile_handle_t handle,
     }
 
     sample_sizes.at(se_index) = sample_size;
-    max_sample_size = std::max(sample_size, max_sample_size);
   }
 
-  std::vector<size_t> cpu_sample(max_sample_size / sizeof(size_t) + sizeof(att_header_packet_t), 0);
+  std::vector<TraceSample> samples;
+  samples.reserve(se_number_total);
 
-  // The samples sizes are returned in the control buffer
   for (uint64_t se_index = 0; se_index < se_number_total; se_index++) {
     int target_cu = memorymgr->config.GetTargetCU(se_index);
     if (target_cu < 0) continue;
 
-    void* sample_ptr = reinterpret_cast<void*>(memorymgr->config.GetSEBaseAddr(se_index));
-    size_t sample_size = sample_sizes.at(se_index);
-    size_t sample_size_plus_header = sample_size;
-
-    char* sample_data_ptr = (char*)cpu_sample.data();
-    if (pm4_factory->GetGpuId() < aql_profile::GFX10_GPU_ID) {
-      auto* header = reinterpret_cast<att_header_packet_t*>(cpu_sample.data());
-      *header = getHeaderPacket(se_index, target_cu, memorymgr->GetSimdMask());
-      sample_data_ptr += sizeof(att_header_packet_t);
-      sample_size_plus_header = sample_size + sizeof(att_header_packet_t);
-    }
-
-    memorymgr->CopyMemory((void*)sample_data_ptr, sample_ptr, sample_size);
-    callback(se_index, (void*)cpu_sample.data(), sample_size_plus_header, userdata);
+    TraceSample sample{};
+    sample.shader_engine = se_index;
+    sample.ptr = reinterpret_cast<const void*>(memorymgr->config.GetSEBaseAddr(se_index));
+    sample.size = sample_sizes.at(se_index);
+    if (pm4_factory->GetGpuId() < aql_profile::GFX10_GPU_ID)
+      sample.header = getHeaderPacket(se_index, target_cu, memorymgr->GetSimdMask()).raw;
+    samples.push_back(sample);
   }
 
+  memorymgr->ExportSamples(samples, callback, userdata);
+
   return status;
 }
 
@@ -219,6 +212,9 @@ hsa_status_t _internal_aqlprofile_att_create_packets(
         case AQLPROFILE_ATT_PARAMETER_NAME_RT_TIMESTAMP:
           trace_config.enable_rt_timestamp = p->value != static_cast<uint32_t>(AQLPROFILE_ATT_PARAMETER_RT_TIMESTAMP_DISABLE);
           break;
+        case AQLPROFILE_ATT_PARAMETER_NAME_EXPORT_FLAGS:
+          memorymgr->SetExportFlags(p->value);
+          break;
         case HSA_VEN_AMD_AQLPROFILE_PARAMETER_NAME_PERFCOUNTER_MASK:
           trace_config.perfMASK = p->value;
           break;
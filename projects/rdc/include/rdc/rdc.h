@@ -1349,6 +1349,68 @@ rdc_status_t rdc_field_get_value_since(rdc_handle_t p_rdc_handle, uint32_t gpu_i
 rdc_status_t rdc_field_unwatch(rdc_handle_t p_rdc_handle, rdc_gpu_group_t group_id,
                                rdc_field_grp_t field_group_id);
 
+/**
+ * @brief A field value pushed to a field listener
+ */
+typedef struct {
+  uint32_t gpu_index;     //!< The GPU index of the value
+  rdc_field_value field;  //!< The field value
+} rdc_field_update_t;
+
+/**
+ * The updates are only valid for the duration of the callback. The
+ * user_data is the pointer passed to rdc_field_listen.
+ */
+typedef void (*rdc_field_listen_callback)(const rdc_field_update_t* updates, uint32_t count,
+                                          void* user_data);
+
+/**
+ *  @brief Register a function to be called with the new values of a
+ *  field collection as they are cached.
+ *
+ *  @details The values are pushed as the fields are updated instead of
+ *  being polled with rdc_field_get_value_since. The fields must be watched
+ *  with rdc_field_watch to be updated. The values cached during a
+ *  coalesce interval are delivered together in one call; an interval of 0
+ *  delivers each batch of updates as soon as it is cached. If a field is
+ *  updated again before its value was delivered, only the latest value is
+ *  delivered.
+ *
+ *  @param[in] p_rdc_handle The RDC handler.
+ *
+ *  @param[in] group_id The GPU group id.
+ *
+ *  @param[in] field_group_id  The field group id.
+ *
+ *  @param[in] coalesce_interval  The minimum time between two calls of the
+ *  callback in usec.
+ *
+ *  @param[in] callback  The function called with the new values.
+ *
+ *  @param[in] user_data  The pointer passed to the callback.
+ *
+ *  @param[out] listener_id  The id to pass to rdc_field_unlisten.
+ *
+ *  @retval ::RDC_ST_OK is returned upon successful call.
+ */
+rdc_status_t rdc_field_listen(rdc_handle_t p_rdc_handle, rdc_gpu_group_t group_id,
+                              rdc_field_grp_t field_group_id, uint64_t coalesce_interval,
+                              rdc_field_listen_callback callback, void* user_data,
+                              uint32_t* listener_id);
+
+/**
+ *  @brief Stop pushing the values to a field listener.
+ *
+ *  @details The callback will not be called after this call returns.
+ *
+ *  @param[in] p_rdc_handle The RDC handler.
+ *
+ *  @param[in] listener_id The id returned by rdc_field_listen.
+ *
+ *  @retval ::RDC_ST_OK is returned upon successful call.
+ */
+rdc_status_t rdc_field_unlisten(rdc_handle_t p_rdc_handle, uint32_t listener_id);
+
 /**
  *  @brief Run the diagnostic test cases
  *
@@ -22,6 +22,7 @@ THE SOFTWARE.
 #ifndef INCLUDE_RDC_LIB_RDCCACHEMANAGER_H_
 #define INCLUDE_RDC_LIB_RDCCACHEMANAGER_H_
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -34,6 +35,9 @@ THE SOFTWARE.
 namespace amd {
 namespace rdc {
 
+// Called with each value cached for the fields a listener subscribed to
+typedef std::function<void(uint32_t gpu_index, const rdc_field_value& value)> RdcCacheListener;
+
 class RdcCacheManager {
  public:
   virtual rdc_status_t rdc_field_get_latest_value(uint32_t gpu_index, rdc_field_t field,
@@ -47,6 +51,12 @@ class RdcCacheManager {
                                    uint64_t max_keep_samples, double max_keep_age) = 0;
   virtual std::string get_cache_stats() = 0;
 
+  // The listener is called from the thread updating the cache, so it should
+  // only hand the value off. It is not called after remove_listener returns.
+  virtual uint32_t add_listener(const std::vector<RdcFieldKey>& fields,
+                                RdcCacheListener listener) = 0;
+  virtual rdc_status_t remove_listener(uint32_t listener_id) = 0;
+
   virtual rdc_status_t rdc_job_get_stats(const char job_id[64], const rdc_gpu_gauges_t& gpu_gauges,
                                          rdc_job_info_t* p_job_info) = 0;
   virtual rdc_status_t rdc_job_start_stats(const char job_id[64], const rdc_group_info_t& group,
@@ -77,6 +77,11 @@ class RdcHandler {
                                                  rdc_field_value* value) = 0;
   virtual rdc_status_t rdc_field_unwatch(rdc_gpu_group_t group_id,
                                          rdc_field_grp_t field_group_id) = 0;
+  virtual rdc_status_t rdc_field_listen(rdc_gpu_group_t group_id, rdc_field_grp_t field_group_id,
+                                        uint64_t coalesce_interval,
+                                        rdc_field_listen_callback callback, void* user_data,
+                                        uint32_t* listener_id) = 0;
+  virtual rdc_status_t rdc_field_unlisten(uint32_t listener_id) = 0;
 
   // Diagnostic API
   virtual rdc_status_t rdc_diagnostic_run(rdc_gpu_group_t group_id, rdc_diag_level_t level,
@@ -35,6 +35,9 @@ class RdcWatchTable {
  public:
   virtual rdc_status_t rdc_field_update_all() = 0;
   virtual rdc_status_t rdc_field_listen_notif(uint32_t timeout_ms) = 0;
+  //!< Block until the next watched field is due, but no longer than
+  //!< max_wait_us. Unless the watches change, wait at least min_wait_us.
+  virtual void rdc_field_wait_update(uint64_t min_wait_us, uint64_t max_wait_us) = 0;
 
   virtual rdc_status_t rdc_job_start_stats(rdc_gpu_group_t group_id, const char job_id[64],
                                            uint64_t update_freq,
@@ -23,9 +23,12 @@ THE SOFTWARE.
 #define INCLUDE_RDC_LIB_IMPL_RDCCACHEMANAGERIMPL_H_
 
 #include <array>
+#include <limits>
 #include <map>
 #include <memory>
 #include <mutex>  // NOLINT(build/c++11)
+#include <set>
+#include <shared_mutex>
 #include <string>
 #include <vector>
 
@@ -47,7 +50,59 @@ struct RdcCacheEntry {
   rdc_field_value_data value;
 };
 
-typedef std::map<RdcFieldKey, std::vector<RdcCacheEntry>> RdcCacheSamples;
+// Time ordered samples of a single field kept in a circular buffer.
+// Retention drops entries from the head without shifting the rest, and
+// lookups by timestamp use a binary search over the logical index, where
+// index 0 is the oldest sample. The buffer grows on demand until it
+// reaches the capacity; after that each push overwrites the oldest sample.
+class RdcCacheRing {
+ public:
+  static constexpr size_t kUnbounded = std::numeric_limits<size_t>::max();
+
+  explicit RdcCacheRing(size_t capacity = kUnbounded) : capacity_(capacity) {}
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  size_t capacity() const { return capacity_; }
+
+  const RdcCacheEntry& operator[](size_t i) const {
+    return buffer_[(head_ + i) % buffer_.size()];
+  }
+  const RdcCacheEntry& back() const { return (*this)[size_ - 1]; }
+
+  // Append a sample. An out-of-order sample is moved into place so that the
+  // buffer stays sorted by last_time.
+  void push_back(const RdcCacheEntry& entry);
+  // Drop the count oldest samples.
+  void pop_front(size_t count);
+  // Change the capacity, dropping the oldest samples that no longer fit.
+  void set_capacity(size_t capacity);
+  void clear();
+
+  // Index of the first sample with last_time >= ts, or size() if none.
+  size_t lower_bound(uint64_t ts) const;
+  // Index of the first sample with last_time > ts, or size() if none.
+  size_t upper_bound(uint64_t ts) const;
+
+ private:
+  RdcCacheEntry& at(size_t i) { return buffer_[(head_ + i) % buffer_.size()]; }
+  // Re-linearize the samples into a buffer of new_size slots.
+  void resize_buffer(size_t new_size);
+
+  std::vector<RdcCacheEntry> buffer_;
+  size_t head_ = 0;
+  size_t size_ = 0;
+  size_t capacity_;
+};
+
+// The samples of one field with the lock that guards them, so that
+// updates and queries of different fields do not contend.
+struct RdcCacheSeries {
+  std::mutex mutex;
+  RdcCacheRing samples;
+};
+
+typedef std::map<RdcFieldKey, RdcCacheRing> RdcCacheSamples;
 
 struct FieldSummaryStats {
   int64_t max_value;
@@ -102,6 +157,9 @@ class RdcCacheManagerImpl : public RdcCacheManager {
   rdc_status_t evict_cache(uint32_t gpu_index, rdc_field_t field_id, uint64_t max_keep_samples,
                            double max_keep_age) override;
   std::string get_cache_stats() override;
+  uint32_t add_listener(const std::vector<RdcFieldKey>& fields,
+                        RdcCacheListener listener) override;
+  rdc_status_t remove_listener(uint32_t listener_id) override;
 
   rdc_status_t rdc_job_get_stats(const char job_id[64], const rdc_gpu_gauges_t& gpu_gauges,
                                  rdc_job_info_t* p_job_info) override;
@@ -131,7 +189,26 @@ class RdcCacheManagerImpl : public RdcCacheManager {
                    unsigned int adjuster);
   void set_average_summary(rdc_stats_summary_t& summary,
                            uint32_t num_gpus);  // NOLINT
-  RdcCacheSamples cache_samples_;
+  // Find the series of a field, creating it when create is set. The series
+  // are never removed, so the returned pointer stays valid.
+  RdcCacheSeries* find_series(const RdcFieldKey& field, bool create);
+
+  // The map lock only guards the map structure; each series has its own lock.
+  std::map<RdcFieldKey, std::unique_ptr<RdcCacheSeries>> cache_samples_;
+  std::shared_mutex cache_samples_mutex_;
+
+  struct RdcCacheListenerEntry {
+    std::set<RdcFieldKey> fields;
+    RdcCacheListener listener;
+  };
+
+  // Updates take the listener lock shared, so listeners are only excluded
+  // while one is added or removed.
+  std::map<uint32_t, RdcCacheListenerEntry> listeners_;
+  uint32_t next_listener_id_ = 1;
+  std::shared_mutex listeners_mutex_;
+
+  // Guards the job and health caches
   RdcJobStatsCache cache_jobs_;
   RdcHealthStatsCache cache_health_;
   std::mutex cache_mutex_;
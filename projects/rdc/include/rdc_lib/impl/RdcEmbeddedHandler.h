@@ -22,7 +22,13 @@ THE SOFTWARE.
 #ifndef INCLUDE_RDC_LIB_IMPL_RDCEMBEDDEDHANDLER_H_
 #define INCLUDE_RDC_LIB_IMPL_RDCEMBEDDEDHANDLER_H_
 
-#include <future>  // NOLINT(build/c++11)
+#include <condition_variable>  // NOLINT(build/c++11)
+#include <future>              // NOLINT(build/c++11)
+#include <map>
+#include <memory>
+#include <mutex>   // NOLINT(build/c++11)
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
 
 #include "rdc_lib/RdcCacheManager.h"
 #include "rdc_lib/RdcConfigSettings.h"
@@ -85,6 +91,10 @@ class RdcEmbeddedHandler final : public RdcHandler {
                                          uint64_t since_time_stamp, uint64_t* next_since_time_stamp,
                                          rdc_field_value* value) override;
   rdc_status_t rdc_field_unwatch(rdc_gpu_group_t group_id, rdc_field_grp_t field_group_id) override;
+  rdc_status_t rdc_field_listen(rdc_gpu_group_t group_id, rdc_field_grp_t field_group_id,
+                                uint64_t coalesce_interval, rdc_field_listen_callback callback,
+                                void* user_data, uint32_t* listener_id) override;
+  rdc_status_t rdc_field_unlisten(uint32_t listener_id) override;
   // Diagnostic API
   rdc_status_t rdc_diagnostic_run(rdc_gpu_group_t group_id, rdc_diag_level_t level,
                                   const char* config, size_t config_size,
@@ -145,6 +155,24 @@ class RdcEmbeddedHandler final : public RdcHandler {
   ~RdcEmbeddedHandler() final;
 
  private:
+  // The cache manager hands the values over to the listener thread, which
+  // calls the callback so that a slow callback does not hold up the updates.
+  // Only the latest value of a field is kept until it is delivered, so a
+  // slow callback cannot make the pending updates grow without bound.
+  struct FieldListener {
+    rdc_field_listen_callback callback;
+    void* user_data;
+    uint64_t coalesce_interval;  // usec
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<rdc_field_update_t> pending;
+    std::map<RdcFieldKey, size_t> pending_index;  // index into pending
+    bool stop = false;
+    std::thread thread;
+  };
+  static void deliver_field_updates(FieldListener* listener);
+  void stop_field_listener(std::unique_ptr<FieldListener> listener);
+
   rdc_status_t get_gpu_gauges(rdc_gpu_gauges_t* gpu_gauges);
   RdcPartitionPtr partition_;
   RdcGroupSettingsPtr group_settings_;
@@ -158,6 +186,8 @@ class RdcEmbeddedHandler final : public RdcHandler {
   RdcTopologyLinkPtr topologylink_;
   RdcConfigSettingsPtr config_handler_;
   std::future<void> updater_;
+  std::map<uint32_t, std::unique_ptr<FieldListener>> field_listeners_;
+  std::mutex field_listeners_mutex_;
 };
 
 }  // namespace rdc
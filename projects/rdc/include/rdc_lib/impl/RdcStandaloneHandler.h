@@ -24,7 +24,9 @@ THE SOFTWARE.
 #include <grpcpp/grpcpp.h>
 
 #include <future>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <thread>
 
 #include "rdc.grpc.pb.h"  // NOLINT
@@ -79,6 +81,10 @@ class RdcStandaloneHandler : public RdcHandler {
                                          uint64_t since_time_stamp, uint64_t* next_since_time_stamp,
                                          rdc_field_value* value) override;
   rdc_status_t rdc_field_unwatch(rdc_gpu_group_t group_id, rdc_field_grp_t field_group_id) override;
+  rdc_status_t rdc_field_listen(rdc_gpu_group_t group_id, rdc_field_grp_t field_group_id,
+                                uint64_t coalesce_interval, rdc_field_listen_callback callback,
+                                void* user_data, uint32_t* listener_id) override;
+  rdc_status_t rdc_field_unlisten(uint32_t listener_id) override;
   // Diagnostic API
   rdc_status_t rdc_diagnostic_run(rdc_gpu_group_t group_id, rdc_diag_level_t level,
                                   const char* config, size_t config_size,
@@ -137,6 +143,7 @@ class RdcStandaloneHandler : public RdcHandler {
 
   explicit RdcStandaloneHandler(const char* ip_and_port, const char* root_ca,
                                 const char* client_cert, const char* client_key);
+  ~RdcStandaloneHandler() override;
 
  private:
   // Helper function to handle the error
@@ -153,6 +160,18 @@ class RdcStandaloneHandler : public RdcHandler {
   };
 
   std::map<uint32_t, struct policy_thread_context> policy_threads_;
+
+  // A ListenFields stream read by its own thread until it is cancelled
+  struct field_listen_context {
+    ::grpc::ClientContext context;
+    std::unique_ptr<::grpc::ClientReader<::rdc::ListenFieldsResponse>> reader;
+    std::thread t;
+  };
+  void stop_field_listener(std::unique_ptr<field_listen_context> ctx);
+
+  std::map<uint32_t, std::unique_ptr<field_listen_context>> field_listeners_;
+  uint32_t next_listener_id_ = 1;
+  std::mutex field_listeners_mutex_;
 };
 
 }  // namespace rdc
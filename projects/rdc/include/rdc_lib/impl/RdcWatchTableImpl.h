@@ -23,10 +23,15 @@ THE SOFTWARE.
 #define INCLUDE_RDC_LIB_IMPL_RDCWATCHTABLEIMPL_H_
 
 #include <atomic>
+#include <condition_variable>  // NOLINT
+#include <functional>
+#include <future>  // NOLINT
 #include <map>
 #include <memory>
 #include <mutex>  // NOLINT
+#include <queue>
 #include <string>
+#include <thread>  // NOLINT
 #include <utility>
 #include <vector>
 
@@ -48,6 +53,34 @@ struct FieldSettings {
   double max_keep_age;
   bool is_watching;
   uint64_t last_update_time;
+  uint64_t next_update_time;  //!< When the field is due, in milliseconds
+};
+
+//!< An entry of the update schedule. It is stale, and skipped, when it no
+//!< longer matches the next_update_time of the field in fields_to_watch_.
+struct FieldDeadline {
+  uint64_t due_time;
+  RdcFieldKey field;
+  bool operator>(const FieldDeadline& other) const { return due_time > other.due_time; }
+};
+
+//!< A small set of threads fetching the fields of different GPUs
+//!< concurrently, so that a GPU with slow fields does not hold up the others.
+class RdcFetchWorkers {
+ public:
+  explicit RdcFetchWorkers(uint32_t num_workers);
+  ~RdcFetchWorkers();
+
+  std::future<void> submit(std::function<void()> task);
+
+ private:
+  void worker_loop();
+
+  std::vector<std::thread> workers_;
+  std::queue<std::packaged_task<void()>> tasks_;
+  std::mutex tasks_mutex_;
+  std::condition_variable tasks_cv_;
+  bool stopped_;
 };
 
 struct JobWatchTableEntry {
@@ -94,6 +127,7 @@ class RdcWatchTableImpl : public RdcWatchTable {
   //!< once per second.
   rdc_status_t rdc_field_update_all() override;
   rdc_status_t rdc_field_listen_notif(uint32_t timeout_ms) override;
+  void rdc_field_wait_update(uint64_t min_wait_us, uint64_t max_wait_us) override;
 
   RdcWatchTableImpl(const RdcGroupSettingsPtr& group_settings, const RdcCacheManagerPtr& cache_mgr,
                     const RdcMetricFetcherPtr& metric_fetcher, const RdcModuleMgrPtr& module_mgr,
@@ -106,6 +140,13 @@ class RdcWatchTableImpl : public RdcWatchTable {
   //!< Helper function to clean up the watch table and cache
   void clean_up();
 
+  //!< Helper function to rebuild the update schedule after the fields or
+  //!< their update frequencies change
+  void reschedule_fields();
+
+  //!< Helper function to fetch the due fields, one batch per GPU
+  void fetch_fields(std::map<uint32_t, std::vector<rdc_gpu_field_t>>& gpu_fields);  // NOLINT
+
   //!< Helper function for debug information in watch table and cache
   void debug_status();
 
@@ -174,6 +215,17 @@ class RdcWatchTableImpl : public RdcWatchTable {
   //!< The health watch table to store the health settings.
   std::map<uint32_t, HealthWatchTableEntry> health_watch_table_;
 
+  //!< The min-heap of field deadlines, so that rdc_field_update_all() only
+  //!< visits the fields that are due.
+  std::priority_queue<FieldDeadline, std::vector<FieldDeadline>, std::greater<FieldDeadline>>
+      update_queue_;
+  //!< Wakes rdc_field_wait_update() when the schedule changes
+  std::condition_variable schedule_cv_;
+  bool schedule_changed_;
+
+  //!< Created on the first update that involves more than one GPU
+  std::unique_ptr<RdcFetchWorkers> fetch_workers_;
+
   //!< The last clean up time
   std::atomic<uint64_t> last_cleanup_time_;
   std::mutex watch_mutex_;
@@ -26,6 +26,8 @@ THE SOFTWARE.
 
 #include <cstdint>
 #include <map>
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -41,7 +43,7 @@ namespace rdc {
 class RdcRocpBase {
  public:
   RdcRocpBase();
-  RdcRocpBase(const RdcRocpBase&) = default;
+  RdcRocpBase(const RdcRocpBase&) = delete;
   RdcRocpBase(RdcRocpBase&&) = delete;
   RdcRocpBase& operator=(const RdcRocpBase&) = delete;
   RdcRocpBase& operator=(RdcRocpBase&&) = delete;
@@ -50,6 +52,9 @@ class RdcRocpBase {
   /**
    * @brief Lookup ROCProfiler counter
    *
+   * Safe to call concurrently: lookups of different GPUs sample in parallel,
+   * lookups of the same GPU are serialized on its counter sampler.
+   *
    * @param[in] gpu_field GPU_ID and FIELD_ID of requested metric
    * @param[out] value A pointer that will be populated with returned value
    *
@@ -87,7 +92,12 @@ class RdcRocpBase {
   std::vector<std::shared_ptr<CounterSampler>> samplers = {};
   std::map<rdc_field_t, const char*> field_to_metric = {};
   std::map<uint32_t, uint32_t> entity_to_prof_map = {};
+  //!< One per entry of samplers; a CounterSampler has a single context
+  std::vector<std::unique_ptr<std::mutex>> sampler_mutexes = {};
 
+  //!< Guards the initialization. The members above are only modified while
+  //!< initializing, and read after taking this mutex once.
+  std::mutex m_init_mutex;
   bool m_is_initialized = false;
 
   // these fields must be divided by time passed
@@ -287,6 +287,27 @@ rdc_status_t rdc_field_unwatch(rdc_handle_t p_rdc_handle, rdc_gpu_group_t group_
       ->rdc_field_unwatch(group_id, field_group_id);
 }
 
+rdc_status_t rdc_field_listen(rdc_handle_t p_rdc_handle, rdc_gpu_group_t group_id,
+                              rdc_field_grp_t field_group_id, uint64_t coalesce_interval,
+                              rdc_field_listen_callback callback, void* user_data,
+                              uint32_t* listener_id) {
+  if (!p_rdc_handle || !callback || !listener_id) {
+    return RDC_ST_INVALID_HANDLER;
+  }
+
+  return static_cast<amd::rdc::RdcHandler*>(p_rdc_handle)
+      ->rdc_field_listen(group_id, field_group_id, coalesce_interval, callback, user_data,
+                         listener_id);
+}
+
+rdc_status_t rdc_field_unlisten(rdc_handle_t p_rdc_handle, uint32_t listener_id) {
+  if (!p_rdc_handle) {
+    return RDC_ST_INVALID_HANDLER;
+  }
+
+  return static_cast<amd::rdc::RdcHandler*>(p_rdc_handle)->rdc_field_unlisten(listener_id);
+}
+
 rdc_status_t rdc_group_gpu_destroy(rdc_handle_t p_rdc_handle, rdc_gpu_group_t p_rdc_group_id) {
   if (!p_rdc_handle) {
     return RDC_ST_INVALID_HANDLER;
@@ -23,6 +23,7 @@ THE SOFTWARE.
 
 #include <sys/time.h>
 
+#include <algorithm>
 #include <cmath>
 #include <ctime>
 #include <sstream>
@@ -33,6 +34,126 @@ THE SOFTWARE.
 namespace amd {
 namespace rdc {
 
+void RdcCacheRing::push_back(const RdcCacheEntry& entry) {
+  if (capacity_ == 0) {
+    return;
+  }
+  if (size_ == capacity_) {
+    // Full, overwrite the oldest sample
+    head_ = (head_ + 1) % buffer_.size();
+    size_--;
+  } else if (size_ == buffer_.size()) {
+    size_t grow = std::max<size_t>(buffer_.size() * 2, 16);
+    resize_buffer(std::min(grow, capacity_));
+  }
+
+  size_t pos = size_++;
+  at(pos) = entry;
+  // Samples normally arrive in order; keep the buffer sorted otherwise.
+  while (pos > 0 && at(pos - 1).last_time > entry.last_time) {
+    std::swap(at(pos - 1), at(pos));
+    pos--;
+  }
+}
+
+void RdcCacheRing::pop_front(size_t count) {
+  if (count >= size_) {
+    clear();
+    return;
+  }
+  head_ = (head_ + count) % buffer_.size();
+  size_ -= count;
+}
+
+void RdcCacheRing::set_capacity(size_t capacity) {
+  if (capacity == capacity_) {
+    return;
+  }
+  if (size_ > capacity) {
+    pop_front(size_ - capacity);
+  }
+  capacity_ = capacity;
+  if (buffer_.size() > capacity_) {
+    resize_buffer(capacity_);
+  }
+}
+
+void RdcCacheRing::clear() {
+  head_ = 0;
+  size_ = 0;
+}
+
+size_t RdcCacheRing::lower_bound(uint64_t ts) const {
+  size_t first = 0;
+  size_t count = size_;
+  while (count > 0) {
+    size_t step = count / 2;
+    if ((*this)[first + step].last_time < ts) {
+      first += step + 1;
+      count -= step + 1;
+    } else {
+      count = step;
+    }
+  }
+  return first;
+}
+
+size_t RdcCacheRing::upper_bound(uint64_t ts) const {
+  size_t first = 0;
+  size_t count = size_;
+  while (count > 0) {
+    size_t step = count / 2;
+    if ((*this)[first + step].last_time <= ts) {
+      first += step + 1;
+      count -= step + 1;
+    } else {
+      count = step;
+    }
+  }
+  return first;
+}
+
+void RdcCacheRing::resize_buffer(size_t new_size) {
+  std::vector<RdcCacheEntry> buffer(new_size);
+  for (size_t i = 0; i < size_; i++) {
+    buffer[i] = (*this)[i];
+  }
+  buffer_.swap(buffer);
+  head_ = 0;
+}
+
+static void copy_cache_entry(const RdcCacheEntry& entry, rdc_field_t field_id,
+                             rdc_field_value* value) {
+  value->field_id = field_id;
+  value->ts = entry.last_time;
+  value->type = entry.type;
+  if (entry.type == STRING) {
+    strncpy_with_null(value->value.str, entry.value.str, RDC_MAX_STR_LENGTH);
+  } else {
+    value->value.l_int = entry.value.l_int;
+  }
+}
+
+RdcCacheSeries* RdcCacheManagerImpl::find_series(const RdcFieldKey& field, bool create) {
+  {
+    std::shared_lock<std::shared_mutex> guard(cache_samples_mutex_);
+    auto cache_samples_ite = cache_samples_.find(field);
+    if (cache_samples_ite != cache_samples_.end()) {
+      return cache_samples_ite->second.get();
+    }
+  }
+  if (!create) {
+    return nullptr;
+  }
+
+  std::unique_lock<std::shared_mutex> guard(cache_samples_mutex_);
+  auto& series = cache_samples_[field];
+  if (!series) {
+    series.reset(new RdcCacheSeries);
+  }
+  return series.get();
+}
+
 rdc_status_t RdcCacheManagerImpl::rdc_field_get_value_since(uint32_t gpu_index,
                                                             rdc_field_t field_id,
                                                             uint64_t since_time_stamp,
@@ -42,70 +163,60 @@ rdc_status_t RdcCacheManagerImpl::rdc_field_get_value_since(uint32_t gpu_index,
     return RDC_ST_BAD_PARAMETER;
   }
 
-  std::lock_guard<std::mutex> guard(cache_mutex_);
-  RdcFieldKey field{gpu_index, field_id};
-  auto cache_samples_ite = cache_samples_.find(field);
-  if (cache_samples_ite == cache_samples_.end() || cache_samples_ite->second.size() == 0) {
+  RdcCacheSeries* series = find_series({gpu_index, field_id}, false);
+  if (series == nullptr) {
     return RDC_ST_NOT_FOUND;
   }
 
-  // TODO(bill_liu): Optimize it using the binary search
-  auto cache_values = cache_samples_ite->second;
-  for (auto cache_value = cache_values.begin(); cache_value != cache_values.end(); cache_value++) {
-    if (cache_value->last_time >= since_time_stamp) {
-      // move to next potential timestamp
-      auto next_iter = std::next(cache_value);
-      if (next_iter != cache_values.end()) {
-        *next_since_time_stamp = next_iter->last_time;
-      } else {  // Last item, set it to the future by adding 1us
-        *next_since_time_stamp = cache_value->last_time + 1;
-      }
-      value->ts = cache_value->last_time;
-      value->type = cache_value->type;
-
-      if (value->type == STRING) {
-        strncpy_with_null(value->value.str, cache_value->value.str, RDC_MAX_STR_LENGTH);
-      } else {
-        value->value.l_int = cache_value->value.l_int;
-      }
-      value->field_id = field_id;
-      return RDC_ST_OK;
-    }
+  std::lock_guard<std::mutex> guard(series->mutex);
+  const auto& cache_values = series->samples;
+  size_t index = cache_values.lower_bound(since_time_stamp);
+  if (index == cache_values.size()) {
+    *next_since_time_stamp = since_time_stamp;
+    return RDC_ST_NOT_FOUND;
   }
 
-  *next_since_time_stamp = since_time_stamp;
-  return RDC_ST_NOT_FOUND;
+  const auto& cache_value = cache_values[index];
+  // move to next potential timestamp
+  if (index + 1 < cache_values.size()) {
+    *next_since_time_stamp = cache_values[index + 1].last_time;
+  } else {  // Last item, set it to the future by adding 1us
+    *next_since_time_stamp = cache_value.last_time + 1;
+  }
+  copy_cache_entry(cache_value, field_id, value);
+  return RDC_ST_OK;
 }
 
 rdc_status_t RdcCacheManagerImpl::evict_cache(uint32_t gpu_index, rdc_field_t field_id,
                                               uint64_t max_keep_samples, double max_keep_age) {
-  std::lock_guard<std::mutex> guard(cache_mutex_);
+  RdcCacheSeries* series = find_series({gpu_index, field_id}, false);
+  if (series == nullptr) {
+    return RDC_ST_NOT_FOUND;
+  }
 
-  RdcFieldKey field{gpu_index, field_id};
-  auto cache_samples_ite = cache_samples_.find(field);
-  if (cache_samples_ite == cache_samples_.end() || cache_samples_ite->second.size() == 0) {
+  std::lock_guard<std::mutex> guard(series->mutex);
+  auto& cache_values = series->samples;
+  if (cache_values.empty()) {
     return RDC_ST_NOT_FOUND;
   }
 
-  // Check max_keep_samples
-  auto& cache_values = cache_samples_ite->second;
-  int item_remove = cache_values.size() - max_keep_samples;
-  if (item_remove > 0) {
-    cache_values.erase(cache_values.begin(), cache_values.begin() + item_remove);
+  // Check max_keep_samples. The ring keeps at most that many samples from
+  // now on, so later updates overwrite the oldest entry in place.
+  if (max_keep_samples == 0) {
+    cache_values.clear();
+    return RDC_ST_OK;
   }
+  cache_values.set_capacity(
+      static_cast<size_t>(std::min<uint64_t>(max_keep_samples, RdcCacheRing::kUnbounded)));
 
   // Check max_keep_age
   struct timeval tv;
   gettimeofday(&tv, NULL);
   uint64_t now = static_cast<uint64_t>(tv.tv_sec) * 1000 + tv.tv_usec / 1000;
 
-  auto ite = cache_values.begin();
-  while (ite != cache_values.end()) {
-    if (ite->last_time + max_keep_age * 1000 >= now) {
-      break;
-    } else {
-      ite = cache_values.erase(ite);
-    }
+  double oldest = std::ceil(now - max_keep_age * 1000);
+  if (oldest > 0) {
+    cache_values.pop_front(cache_values.lower_bound(static_cast<uint64_t>(oldest)));
   }
 
   return RDC_ST_OK;
@@ -118,14 +229,17 @@ rdc_status_t RdcCacheManagerImpl::rdc_field_get_latest_value(uint32_t gpu_index,
     return RDC_ST_BAD_PARAMETER;
   }
 
-  std::lock_guard<std::mutex> guard(cache_mutex_);
-  RdcFieldKey field{gpu_index, field_id};
-  auto cache_samples_ite = cache_samples_.find(field);
-  if (cache_samples_ite == cache_samples_.end() || cache_samples_ite->second.size() == 0) {
+  RdcCacheSeries* series = find_series({gpu_index, field_id}, false);
+  if (series == nullptr) {
+    return RDC_ST_NOT_FOUND;
+  }
+
+  std::lock_guard<std::mutex> guard(series->mutex);
+  if (series->samples.empty()) {
     return RDC_ST_NOT_FOUND;
   }
 
-  auto& cache_value = cache_samples_ite->second.back();
+  auto& cache_value = series->samples.back();
   value->ts = cache_value.last_time;
   value->type = cache_value.type;
   value->value = cache_value.value;
@@ -136,15 +250,19 @@ rdc_status_t RdcCacheManagerImpl::rdc_field_get_latest_value(uint32_t gpu_index,
 
 std::string RdcCacheManagerImpl::get_cache_stats() {
   std::stringstream strstream;
-  std::lock_guard<std::mutex> guard(cache_mutex_);
 
   strstream << "Cache samples:";
-  auto cache_samples_ite = cache_samples_.begin();
-  for (; cache_samples_ite != cache_samples_.end(); cache_samples_ite++) {
-    strstream << "<" << cache_samples_ite->first.first << "," << cache_samples_ite->first.second
-              << ":" << cache_samples_ite->second.size() << "> ";
+  {
+    std::shared_lock<std::shared_mutex> samples_guard(cache_samples_mutex_);
+    auto cache_samples_ite = cache_samples_.begin();
+    for (; cache_samples_ite != cache_samples_.end(); cache_samples_ite++) {
+      std::lock_guard<std::mutex> series_guard(cache_samples_ite->second->mutex);
+      strstream << "<" << cache_samples_ite->first.first << "," << cache_samples_ite->first.second
+                << ":" << cache_samples_ite->second->samples.size() << "> ";
+    }
   }
 
+  std::lock_guard<std::mutex> guard(cache_mutex_);
   strstream << " Job caches:";
   auto job_ite = cache_jobs_.begin();
   for (; job_ite != cache_jobs_.end(); job_ite++) {
@@ -161,17 +279,39 @@ rdc_status_t RdcCacheManagerImpl::rdc_update_cache(uint32_t gpu_index,
   entry.value = value.value;
   entry.type = value.type;
 
-  std::lock_guard<std::mutex> guard(cache_mutex_);
-  RdcFieldKey field{gpu_index, value.field_id};
-  auto cache_samples_ite = cache_samples_.find(field);
-  if (cache_samples_ite == cache_samples_.end()) {
-    std::vector<RdcCacheEntry> ve;
-    ve.push_back(entry);
-    cache_samples_.insert({field, ve});
-  } else {
-    cache_samples_ite->second.push_back(entry);
+  RdcFieldKey key{gpu_index, value.field_id};
+  RdcCacheSeries* series = find_series(key, true);
+  {
+    std::lock_guard<std::mutex> guard(series->mutex);
+    series->samples.push_back(entry);
   }
 
+  // Push the value outside of the series lock so that readers of the
+  // field are not held up by the listeners.
+  std::shared_lock<std::shared_mutex> listeners_guard(listeners_mutex_);
+  for (auto& ite : listeners_) {
+    if (ite.second.fields.find(key) != ite.second.fields.end()) {
+      ite.second.listener(gpu_index, value);
+    }
+  }
+
+  return RDC_ST_OK;
+}
+
+uint32_t RdcCacheManagerImpl::add_listener(const std::vector<RdcFieldKey>& fields,
+                                           RdcCacheListener listener) {
+  std::unique_lock<std::shared_mutex> guard(listeners_mutex_);
+  uint32_t listener_id = next_listener_id_++;
+  listeners_[listener_id] = {std::set<RdcFieldKey>(fields.begin(), fields.end()),
+                             std::move(listener)};
+  return listener_id;
+}
+
+rdc_status_t RdcCacheManagerImpl::remove_listener(uint32_t listener_id) {
+  std::unique_lock<std::shared_mutex> guard(listeners_mutex_);
+  if (listeners_.erase(listener_id) == 0) {
+    return RDC_ST_NOT_FOUND;
+  }
   return RDC_ST_OK;
 }
 
@@ -509,26 +649,12 @@ rdc_status_t RdcCacheManagerImpl::rdc_health_set(rdc_gpu_group_t group_id, uint3
   entry.value = value.value;
   entry.type = value.type;
 
-  auto health_ite = cache_health_.find(group_id);
-  if (health_ite == cache_health_.end()) {
-    std::vector<RdcCacheEntry> ve;
-    ve.push_back(entry);
-
-    RdcCacheSamples cache_sample;
-    cache_sample.insert({field, ve});
-
-    cache_health_.insert({group_id, cache_sample});
-  } else {
-    auto samples_ite = health_ite->second.find(field);
-    if (samples_ite == health_ite->second.end()) {
-      std::vector<RdcCacheEntry> ve;
-      ve.push_back(entry);
-
-      health_ite->second.insert({field, ve});
-    } else {
-      samples_ite->second.push_back(entry);
-    }
+  auto& cache_sample = cache_health_[group_id];
+  auto samples_ite = cache_sample.find(field);
+  if (samples_ite == cache_sample.end()) {
+    samples_ite = cache_sample.emplace(field, RdcCacheRing(HEALTH_MAX_KEEP_SAMPLES)).first;
   }
+  samples_ite->second.push_back(entry);
 
   return RDC_ST_OK;
 }
@@ -544,48 +670,25 @@ rdc_status_t RdcCacheManagerImpl::rdc_health_get_values(
 
   RdcFieldKey field{gpu_index, field_id};
   auto samples_ite = health_ite->second.find(field);
-  if (samples_ite == health_ite->second.end() || samples_ite->second.size() == 0)
+  if (samples_ite == health_ite->second.end() || samples_ite->second.empty())
     return RDC_ST_NOT_FOUND;
 
-  auto cache_values = samples_ite->second;
-  rdc_status_t result = RDC_ST_OK;
+  const auto& cache_values = samples_ite->second;
   if (start_value != nullptr) {
-    // get start value
-    result = RDC_ST_NOT_FOUND;
-    for (auto entry = cache_values.begin(); entry != cache_values.end(); entry++) {
-      if (entry->last_time >= start_timestamp) {
-        start_value->field_id = field_id;
-        start_value->ts = entry->last_time;
-        start_value->type = entry->type;
-        if (entry->type == STRING)
-          strncpy_with_null(start_value->value.str, entry->value.str, RDC_MAX_STR_LENGTH);
-        else
-          start_value->value.l_int = entry->value.l_int;
-        result = RDC_ST_OK;
-        break;
-      }
-    }  // end for
-  }    // end if
-
-  if ((RDC_ST_OK == result) && (end_value != nullptr)) {
-    // get end value
-    result = RDC_ST_NOT_FOUND;
-    for (auto entry = cache_values.rbegin(); entry != cache_values.rend(); entry++) {
-      if (entry->last_time <= end_timestamp) {
-        end_value->field_id = field_id;
-        end_value->ts = entry->last_time;
-        end_value->type = entry->type;
-        if (entry->type == STRING)
-          strncpy_with_null(end_value->value.str, entry->value.str, RDC_MAX_STR_LENGTH);
-        else
-          end_value->value.l_int = entry->value.l_int;
-        result = RDC_ST_OK;
-        break;
-      }
-    }  // end for
-  }    // end if
+    // get start value: the first sample at or after start_timestamp
+    size_t index = cache_values.lower_bound(start_timestamp);
+    if (index == cache_values.size()) return RDC_ST_NOT_FOUND;
+    copy_cache_entry(cache_values[index], field_id, start_value);
+  }
+
+  if (end_value != nullptr) {
+    // get end value: the last sample at or before end_timestamp
+    size_t index = cache_values.upper_bound(end_timestamp);
+    if (index == 0) return RDC_ST_NOT_FOUND;
+    copy_cache_entry(cache_values[index - 1], field_id, end_value);
+  }
 
-  return result;
+  return RDC_ST_OK;
 }
 
 rdc_status_t RdcCacheManagerImpl::rdc_health_clear(rdc_gpu_group_t group_id) {
@@ -609,19 +712,13 @@ rdc_status_t RdcCacheManagerImpl::rdc_update_health_stats(rdc_gpu_group_t group_
     return RDC_ST_NOT_FOUND;
   }
 
-  // Check HEALTH_MAX_KEEP_SAMPLES
-  auto& cache_values = samples_ite->second;
-  int item_remove = cache_values.size() - HEALTH_MAX_KEEP_SAMPLES + 1;
-  if (item_remove > 0) {
-    cache_values.erase(cache_values.begin(), cache_values.begin() + item_remove);
-  }
-
   RdcCacheEntry entry;
   entry.last_time = value.ts;
   entry.value = value.value;
   entry.type = value.type;
 
-  cache_values.push_back(entry);
+  // The ring holds HEALTH_MAX_KEEP_SAMPLES, so this drops the oldest sample
+  samples_ite->second.push_back(entry);
 
   return RDC_ST_OK;
 }
@@ -23,6 +23,8 @@ THE SOFTWARE.
 
 #include <string.h>
 
+#include <chrono>  // NOLINT(build/c++11)
+
 #include "amd_smi/amdsmi.h"
 #include "common/rdc_fields_supported.h"
 #include "rdc/rdc.h"
@@ -95,7 +97,19 @@ RdcEmbeddedHandler::RdcEmbeddedHandler(rdc_operation_mode_t mode)
   }
 }
 
-RdcEmbeddedHandler::~RdcEmbeddedHandler() { metrics_updater_->stop(); }
+RdcEmbeddedHandler::~RdcEmbeddedHandler() {
+  metrics_updater_->stop();
+
+  std::map<uint32_t, std::unique_ptr<FieldListener>> listeners;
+  {
+    std::lock_guard<std::mutex> guard(field_listeners_mutex_);
+    listeners.swap(field_listeners_);
+  }
+  for (auto& ite : listeners) {
+    cache_mgr_->remove_listener(ite.first);
+    stop_field_listener(std::move(ite.second));
+  }
+}
 
 // JOB API
 rdc_status_t RdcEmbeddedHandler::rdc_job_start_stats(rdc_gpu_group_t groupId, const char job_id[64],
@@ -392,6 +406,111 @@ rdc_status_t RdcEmbeddedHandler::rdc_field_unwatch(rdc_gpu_group_t group_id,
   return watch_table_->rdc_field_unwatch(group_id, field_group_id);
 }
 
+rdc_status_t RdcEmbeddedHandler::rdc_field_listen(rdc_gpu_group_t group_id,
+                                                  rdc_field_grp_t field_group_id,
+                                                  uint64_t coalesce_interval,
+                                                  rdc_field_listen_callback callback,
+                                                  void* user_data, uint32_t* listener_id) {
+  if (!callback || !listener_id) {
+    return RDC_ST_BAD_PARAMETER;
+  }
+
+  rdc_group_info_t group_info;
+  rdc_status_t status = rdc_group_gpu_get_info(group_id, &group_info);
+  if (status != RDC_ST_OK) return status;
+
+  rdc_field_group_info_t field_info;
+  status = rdc_group_field_get_info(field_group_id, &field_info);
+  if (status != RDC_ST_OK) return status;
+
+  std::vector<RdcFieldKey> fields;
+  for (unsigned int i = 0; i < group_info.count; i++) {
+    for (uint32_t j = 0; j < field_info.count; j++) {
+      fields.push_back({group_info.entity_ids[i], field_info.field_ids[j]});
+    }
+  }
+
+  auto listener = std::make_unique<FieldListener>();
+  listener->callback = callback;
+  listener->user_data = user_data;
+  listener->coalesce_interval = coalesce_interval;
+  FieldListener* raw_listener = listener.get();
+
+  std::lock_guard<std::mutex> guard(field_listeners_mutex_);
+  *listener_id = cache_mgr_->add_listener(
+      fields, [raw_listener](uint32_t gpu_index, const rdc_field_value& value) {
+        {
+          std::lock_guard<std::mutex> listener_guard(raw_listener->mutex);
+          auto& pending = raw_listener->pending;
+          auto inserted = raw_listener->pending_index.emplace(
+              RdcFieldKey{gpu_index, value.field_id}, pending.size());
+          if (inserted.second) {
+            pending.push_back({gpu_index, value});
+          } else {
+            pending[inserted.first->second].field = value;
+          }
+        }
+        raw_listener->cv.notify_one();
+      });
+  listener->thread = std::thread(deliver_field_updates, raw_listener);
+  field_listeners_[*listener_id] = std::move(listener);
+
+  return RDC_ST_OK;
+}
+
+rdc_status_t RdcEmbeddedHandler::rdc_field_unlisten(uint32_t listener_id) {
+  std::unique_ptr<FieldListener> listener;
+  {
+    std::lock_guard<std::mutex> guard(field_listeners_mutex_);
+    auto ite = field_listeners_.find(listener_id);
+    if (ite == field_listeners_.end()) {
+      return RDC_ST_NOT_FOUND;
+    }
+    listener = std::move(ite->second);
+    field_listeners_.erase(ite);
+  }
+
+  // No value is handed to the listener after it is removed from the cache
+  cache_mgr_->remove_listener(listener_id);
+  stop_field_listener(std::move(listener));
+  return RDC_ST_OK;
+}
+
+void RdcEmbeddedHandler::deliver_field_updates(FieldListener* listener) {
+  std::vector<rdc_field_update_t> updates;
+  std::unique_lock<std::mutex> lock(listener->mutex);
+  while (true) {
+    listener->cv.wait(lock, [listener] { return listener->stop || !listener->pending.empty(); });
+    if (listener->stop) break;
+
+    // Collect the values cached during the interval into one call
+    if (listener->coalesce_interval > 0) {
+      listener->cv.wait_for(lock, std::chrono::microseconds(listener->coalesce_interval),
+                            [listener] { return listener->stop; });
+      if (listener->stop) break;
+    }
+
+    updates.clear();
+    updates.swap(listener->pending);
+    listener->pending_index.clear();
+    lock.unlock();
+    listener->callback(updates.data(), static_cast<uint32_t>(updates.size()),
+                       listener->user_data);
+    lock.lock();
+  }
+}
+
+void RdcEmbeddedHandler::stop_field_listener(std::unique_ptr<FieldListener> listener) {
+  {
+    std::lock_guard<std::mutex> guard(listener->mutex);
+    listener->stop = true;
+  }
+  listener->cv.notify_one();
+  if (listener->thread.joinable()) {
+    listener->thread.join();
+  }
+}
+
 // Diagnostic API
 rdc_status_t RdcEmbeddedHandler::rdc_diagnostic_run(rdc_gpu_group_t group_id,
                                                     rdc_diag_level_t level, const char* config,
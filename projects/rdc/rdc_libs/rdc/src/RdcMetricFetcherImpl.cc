@@ -25,6 +25,7 @@ THE SOFTWARE.
 #include <string.h>
 #include <sys/time.h>
 
+#include <atomic>
 #include <chrono>  //NOLINT
 #include <cstddef>
 #include <cstdint>
@@ -350,9 +351,10 @@ rdc_status_t RdcMetricFetcherImpl::bulk_fetch_smi_fields(
   };
 
   // To prevent always call the bulk API even if it is not supported,
-  // the static is used to cache last try.
-  static amdsmi_status_t rs = AMDSMI_STATUS_SUCCESS;
-  if (rs != AMDSMI_STATUS_SUCCESS) {
+  // the static is used to cache last try. It is atomic as the watch table
+  // may fetch the fields of different GPUs concurrently.
+  static std::atomic<amdsmi_status_t> bulk_status{AMDSMI_STATUS_SUCCESS};
+  if (bulk_status != AMDSMI_STATUS_SUCCESS) {
     results.clear();
     return RDC_ST_NOT_SUPPORTED;
   }
@@ -371,10 +373,11 @@ rdc_status_t RdcMetricFetcherImpl::bulk_fetch_smi_fields(
   for (; ite != bulk_fields.end(); ite++) {
     amdsmi_gpu_metrics_t gpu_metrics;
     amdsmi_processor_handle processor_handle;
-    rs = get_processor_handle_from_id(ite->first, &processor_handle);
+    amdsmi_status_t rs = get_processor_handle_from_id(ite->first, &processor_handle);
 
     rs = amdsmi_get_gpu_metrics_info(processor_handle, &gpu_metrics);
     if (rs != AMDSMI_STATUS_SUCCESS) {
+      bulk_status = rs;
       results.clear();
       return RDC_ST_NOT_SUPPORTED;
     }
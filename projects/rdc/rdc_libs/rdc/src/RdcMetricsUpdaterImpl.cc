@@ -40,6 +40,9 @@ RdcMetricsUpdaterImpl::RdcMetricsUpdaterImpl(const RdcWatchTablePtr& watch_table
 // There's no point in starting/stopping it constantly.
 static const uint32_t kRdcFieldListenNotifTime_mS = 10000;
 static const uint32_t kRdcEventCheck_ms = 1000;
+// The watch table cleans up once per second, so wake up at least that often
+// even if no field is due.
+static const uint64_t kRdcMaxUpdateWait_us = 1000000;
 
 void RdcMetricsUpdaterImpl::start() {
   if (started_) {
@@ -55,7 +58,9 @@ void RdcMetricsUpdaterImpl::start() {
   updater_ = std::async(std::launch::async, [this]() {
     while (started_) {
       watch_table_->rdc_field_update_all();
-      std::this_thread::sleep_for(std::chrono::microseconds(_check_frequency));
+      // Sleep until the next field is due instead of polling every
+      // _check_frequency, which only bounds how often the table is checked.
+      watch_table_->rdc_field_wait_update(_check_frequency, kRdcMaxUpdateWait_us);
     }
   });
 }
@@ -25,6 +25,7 @@ THE SOFTWARE.
 #include <sys/time.h>
 
 #include <algorithm>
+#include <chrono>  // NOLINT
 #include <ctime>
 #include <map>
 #include <sstream>
@@ -40,6 +41,54 @@ THE SOFTWARE.
 namespace amd {
 namespace rdc {
 
+//!< The number of threads to fetch fields of different GPUs concurrently.
+//!< The updater thread fetches one GPU itself.
+static const uint32_t kRdcFetchWorkers = 3;
+
+RdcFetchWorkers::RdcFetchWorkers(uint32_t num_workers) : stopped_(false) {
+  for (uint32_t i = 0; i < num_workers; i++) {
+    workers_.emplace_back(&RdcFetchWorkers::worker_loop, this);
+  }
+}
+
+RdcFetchWorkers::~RdcFetchWorkers() {
+  {
+    std::lock_guard<std::mutex> guard(tasks_mutex_);
+    stopped_ = true;
+  }
+  tasks_cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+std::future<void> RdcFetchWorkers::submit(std::function<void()> task) {
+  std::packaged_task<void()> packaged(std::move(task));
+  auto result = packaged.get_future();
+  {
+    std::lock_guard<std::mutex> guard(tasks_mutex_);
+    tasks_.push(std::move(packaged));
+  }
+  tasks_cv_.notify_one();
+  return result;
+}
+
+void RdcFetchWorkers::worker_loop() {
+  while (true) {
+    std::packaged_task<void()> task;
+    {
+      std::unique_lock<std::mutex> lk(tasks_mutex_);
+      tasks_cv_.wait(lk, [this] { return stopped_ || !tasks_.empty(); });
+      if (tasks_.empty()) {  // stopped
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop();
+    }
+    task();
+  }
+}
+
 RdcWatchTableImpl::RdcWatchTableImpl(const RdcGroupSettingsPtr& group_settings,
                                      const RdcCacheManagerPtr& cache_mgr,
                                      const RdcMetricFetcherPtr& metric_fetcher,
@@ -50,6 +99,7 @@ RdcWatchTableImpl::RdcWatchTableImpl(const RdcGroupSettingsPtr& group_settings,
       metric_fetcher_(metric_fetcher),
       rdc_module_mgr_(module_mgr),
       notifications_(notif),
+      schedule_changed_(false),
       last_cleanup_time_(0) {}
 
 rdc_status_t RdcWatchTableImpl::rdc_job_start_stats(rdc_gpu_group_t group_id, const char job_id[64],
@@ -219,6 +269,7 @@ rdc_status_t RdcWatchTableImpl::rdc_field_watch(rdc_gpu_group_t group_id,
   f.max_keep_age = max_keep_age;
   f.max_keep_samples = max_keep_samples;
   f.last_update_time = 0;
+  f.next_update_time = 0;
   f.is_watching = true;
 
   // Get individual fields for the watch
@@ -301,6 +352,7 @@ rdc_status_t RdcWatchTableImpl::rdc_field_watch(rdc_gpu_group_t group_id,
     rdc_telemetry->rdc_telemetry_fields_watch(&fields[0], fields.size());
   }
 
+  reschedule_fields();
   return RDC_ST_OK;
 }
 
@@ -373,6 +425,7 @@ rdc_status_t RdcWatchTableImpl::update_field_in_table_when_unwatch(const RdcFiel
     rdc_telemetry->rdc_telemetry_fields_unwatch(&unwatch_fields[0], unwatch_fields.size());
   }
 
+  reschedule_fields();
   return RDC_ST_OK;
 }
 
@@ -948,32 +1001,87 @@ rdc_status_t RdcWatchTableImpl::handle_fields(rdc_gpu_field_value_t* values, uin
   return RDC_ST_OK;
 }
 
+void RdcWatchTableImpl::reschedule_fields() {
+  update_queue_ = decltype(update_queue_)();
+  for (auto& fite : fields_to_watch_) {
+    if (!fite.second.is_watching) {
+      continue;
+    }
+    fite.second.next_update_time = fite.second.last_update_time + fite.second.update_freq / 1000;
+    update_queue_.push({fite.second.next_update_time, fite.first});
+  }
+  schedule_changed_ = true;
+  schedule_cv_.notify_all();
+}
+
+void RdcWatchTableImpl::fetch_fields(
+    std::map<uint32_t, std::vector<rdc_gpu_field_t>>& gpu_fields) {
+  auto rdc_telemetry = rdc_module_mgr_->get_telemetry_module();
+  if (!rdc_telemetry) {
+    RDC_LOG(RDC_ERROR, "RdcWatchTableImpl: Fail to get the telemetry module");
+    return;
+  }
+
+  auto fetch = [this, &rdc_telemetry](std::vector<rdc_gpu_field_t>& fields) {
+    rdc_telemetry->rdc_telemetry_fields_value_get(&fields[0], fields.size(),
+                                                  RdcWatchTableImpl::handle_fields, this);
+  };
+
+  // Hand all GPUs but the first to the workers and fetch the first one here.
+  // The caller holds watch_mutex_ until all of them complete, and the
+  // callbacks of different GPUs only touch different fields.
+  std::vector<std::future<void>> pending;
+  auto ite = gpu_fields.begin();
+  if (gpu_fields.size() > 1) {
+    if (!fetch_workers_) {
+      fetch_workers_.reset(new RdcFetchWorkers(kRdcFetchWorkers));
+    }
+    for (auto wite = std::next(ite); wite != gpu_fields.end(); wite++) {
+      auto& fields = wite->second;
+      pending.push_back(fetch_workers_->submit([&fetch, &fields]() { fetch(fields); }));
+    }
+  }
+  fetch(ite->second);
+
+  for (auto& p : pending) {
+    p.wait();
+  }
+}
+
 rdc_status_t RdcWatchTableImpl::rdc_field_update_all() {
   struct timeval tv;
   gettimeofday(&tv, NULL);
   uint64_t now = static_cast<uint64_t>(tv.tv_sec) * 1000 + tv.tv_usec / 1000;
 
-  // Collect all fields need to be updated for bulk fetch
-  std::vector<rdc_gpu_field_t> fields;
   std::lock_guard<std::mutex> guard(watch_mutex_);
-  auto fite = fields_to_watch_.begin();
-  for (; fite != fields_to_watch_.end(); fite++) {
-    // Is this field need to be updated?
-    uint64_t track_freq = fite->second.update_freq / 1000;
-    if (!fite->second.is_watching || fite->second.last_update_time + track_freq > now) {
-      continue;
+
+  // Collect the fields that are due, grouped per GPU for bulk fetch
+  std::map<uint32_t, std::vector<rdc_gpu_field_t>> gpu_fields;
+  std::vector<RdcFieldKey> due_fields;
+  while (!update_queue_.empty() && update_queue_.top().due_time <= now) {
+    FieldDeadline deadline = update_queue_.top();
+    update_queue_.pop();
+
+    auto fite = fields_to_watch_.find(deadline.field);
+    if (fite == fields_to_watch_.end() || !fite->second.is_watching ||
+        fite->second.next_update_time != deadline.due_time) {
+      continue;  // Unwatched or rescheduled
     }
-    fields.push_back({fite->first.first, fite->first.second});
+    gpu_fields[deadline.field.first].push_back({deadline.field.first, deadline.field.second});
+    due_fields.push_back(deadline.field);
   }
 
-  if (fields.size() != 0) {
-    auto rdc_telemetry = rdc_module_mgr_->get_telemetry_module();
-    if (rdc_telemetry) {
-      rdc_telemetry->rdc_telemetry_fields_value_get(&fields[0], fields.size(),
-                                                    RdcWatchTableImpl::handle_fields, this);
-    } else {
-      RDC_LOG(RDC_ERROR, "RdcWatchTableImpl: Fail to get the telemetry module");
-    }
+  if (!gpu_fields.empty()) {
+    fetch_fields(gpu_fields);
+  }
+
+  // Schedule the next update of the fetched fields. The fields are still
+  // in fields_to_watch_ as the watch_mutex_ is held.
+  for (auto& field : due_fields) {
+    auto& settings = fields_to_watch_.at(field);
+    settings.next_update_time =
+        std::max(settings.last_update_time, now) + settings.update_freq / 1000;
+    update_queue_.push({settings.next_update_time, field});
   }
 
   // Clean up is expensive, only do it once per second
@@ -985,6 +1093,23 @@ rdc_status_t RdcWatchTableImpl::rdc_field_update_all() {
   return RDC_ST_OK;
 }
 
+void RdcWatchTableImpl::rdc_field_wait_update(uint64_t min_wait_us, uint64_t max_wait_us) {
+  auto now = std::chrono::system_clock::now();
+  auto wake_time = now + std::chrono::microseconds(max_wait_us);
+
+  std::unique_lock<std::mutex> lk(watch_mutex_);
+  if (!update_queue_.empty()) {
+    // The deadlines are in milliseconds since the epoch
+    std::chrono::system_clock::time_point due_time(
+        std::chrono::milliseconds(update_queue_.top().due_time));
+    auto earliest = now + std::chrono::microseconds(min_wait_us);
+    wake_time = std::min(wake_time, std::max(due_time, earliest));
+  }
+
+  schedule_changed_ = false;
+  schedule_cv_.wait_until(lk, wake_time, [this]() { return schedule_changed_; });
+}
+
 rdc_status_t RdcWatchTableImpl::rdc_notif_update_cache(rdc_evnt_notification_t* events,
                                                        uint32_t num_events) {
   if (events == nullptr || num_events == 0) {
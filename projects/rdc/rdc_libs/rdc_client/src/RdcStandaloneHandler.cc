@@ -24,6 +24,8 @@ THE SOFTWARE.
 #include <grpcpp/grpcpp.h>
 
 #include <future>
+#include <memory>
+#include <vector>
 
 #include "rdc.grpc.pb.h"  // NOLINT
 #include "rdc.pb.h"
@@ -53,6 +55,17 @@ RdcStandaloneHandler::RdcStandaloneHandler(const char* ip_and_port, const char*
   stub_ = ::rdc::RdcAPI::NewStub(grpc::CreateChannel(ip_and_port, cred));
 }
 
+RdcStandaloneHandler::~RdcStandaloneHandler() {
+  std::map<uint32_t, std::unique_ptr<field_listen_context>> listeners;
+  {
+    std::lock_guard<std::mutex> guard(field_listeners_mutex_);
+    listeners.swap(field_listeners_);
+  }
+  for (auto& ite : listeners) {
+    stop_field_listener(std::move(ite.second));
+  }
+}
+
 rdc_status_t RdcStandaloneHandler::error_handle(::grpc::Status status, uint32_t rdc_status) {
   if (!status.ok()) {
     std::cout << status.error_message() << ". Error code:" << status.error_code() << std::endl;
@@ -570,6 +583,93 @@ rdc_status_t RdcStandaloneHandler::rdc_field_unwatch(rdc_gpu_group_t group_id,
   return error_handle(status, reply.status());
 }
 
+rdc_status_t RdcStandaloneHandler::rdc_field_listen(rdc_gpu_group_t group_id,
+                                                    rdc_field_grp_t field_group_id,
+                                                    uint64_t coalesce_interval,
+                                                    rdc_field_listen_callback callback,
+                                                    void* user_data, uint32_t* listener_id) {
+  if (!callback || !listener_id) {
+    return RDC_ST_BAD_PARAMETER;
+  }
+
+  ::rdc::ListenFieldsRequest request;
+  ::rdc::ListenFieldsResponse reply;
+  auto ctx = std::make_unique<field_listen_context>();
+
+  request.set_group_id(group_id);
+  request.set_field_group_id(field_group_id);
+  request.set_coalesce_interval(coalesce_interval);
+  ctx->reader = stub_->ListenFields(&ctx->context, request);
+
+  // The first response tells whether the server registered the listener
+  if (!ctx->reader->Read(&reply)) {
+    return error_handle(ctx->reader->Finish(), RDC_ST_CLIENT_ERROR);
+  }
+  if (reply.status() != RDC_ST_OK) {
+    ctx->context.TryCancel();
+    ctx->reader->Finish();
+    return static_cast<rdc_status_t>(reply.status());
+  }
+
+  field_listen_context* raw_ctx = ctx.get();
+  // The first response may already carry values
+  ctx->t = std::thread([raw_ctx, callback, user_data, reply]() mutable {
+    std::vector<rdc_field_update_t> updates;
+    do {
+      updates.resize(reply.updates_size());
+      for (int i = 0; i < reply.updates_size(); i++) {
+        const ::rdc::FieldUpdate& update = reply.updates(i);
+        rdc_field_value& value = updates[i].field;
+        updates[i].gpu_index = update.gpu_index();
+        value.field_id = static_cast<rdc_field_t>(update.field_id());
+        value.status = update.rdc_status();
+        value.ts = update.ts();
+        value.type = static_cast<rdc_field_type_t>(update.type());
+        if (value.type == INTEGER) {
+          value.value.l_int = update.l_int();
+        } else if (value.type == DOUBLE) {
+          value.value.dbl = update.dbl();
+        } else if (value.type == STRING || value.type == BLOB) {
+          strncpy_with_null(value.value.str, update.str().c_str(), RDC_MAX_STR_LENGTH);
+        }
+      }
+      if (!updates.empty()) {
+        callback(updates.data(), static_cast<uint32_t>(updates.size()), user_data);
+      }
+    } while (raw_ctx->reader->Read(&reply));
+  });
+
+  std::lock_guard<std::mutex> guard(field_listeners_mutex_);
+  *listener_id = next_listener_id_++;
+  field_listeners_[*listener_id] = std::move(ctx);
+  return RDC_ST_OK;
+}
+
+rdc_status_t RdcStandaloneHandler::rdc_field_unlisten(uint32_t listener_id) {
+  std::unique_ptr<field_listen_context> ctx;
+  {
+    std::lock_guard<std::mutex> guard(field_listeners_mutex_);
+    auto ite = field_listeners_.find(listener_id);
+    if (ite == field_listeners_.end()) {
+      return RDC_ST_NOT_FOUND;
+    }
+    ctx = std::move(ite->second);
+    field_listeners_.erase(ite);
+  }
+
+  stop_field_listener(std::move(ctx));
+  return RDC_ST_OK;
+}
+
+void RdcStandaloneHandler::stop_field_listener(std::unique_ptr<field_listen_context> ctx) {
+  // Cancelling the call makes the pending Read of the thread return false
+  ctx->context.TryCancel();
+  if (ctx->t.joinable()) {
+    ctx->t.join();
+  }
+  ctx->reader->Finish();
+}
+
 // Diagnostic API
 rdc_status_t RdcStandaloneHandler::rdc_diagnostic_run(rdc_gpu_group_t group_id,
                                                       rdc_diag_level_t level, const char* config,
@@ -116,11 +116,11 @@ static const std::map<rdc_field_t, const char*> temp_field_map_k = {
 double RdcRocpBase::run_profiler(uint32_t agent_index, rdc_field_t field) {
   thread_local std::vector<rocprofiler_record_counter_t> records;
 
-  auto counter_sampler = CounterSampler::get_samplers()[agent_index];
-  if (!counter_sampler) {
+  if (agent_index >= samplers.size() || !samplers[agent_index]) {
     RDC_LOG(RDC_ERROR, "Error: Counter sampler not found for GPU index " << agent_index);
     return RDC_ST_BAD_PARAMETER;
   }
+  auto& counter_sampler = samplers[agent_index];
 
   auto field_it = field_to_metric.find(field);
   if (field_it == field_to_metric.end()) {
@@ -130,6 +130,7 @@ double RdcRocpBase::run_profiler(uint32_t agent_index, rdc_field_t field) {
   const std::string& metric_id = field_it->second;
 
   try {
+    std::lock_guard<std::mutex> guard(*sampler_mutexes[agent_index]);
     counter_sampler->sample_counter_values({metric_id}, records, collection_duration_us_k);
   } catch (const std::exception& e) {
     RDC_LOG(RDC_ERROR, "Error while sampling counter values: " << e.what());
@@ -146,6 +147,7 @@ double RdcRocpBase::run_profiler(uint32_t agent_index, rdc_field_t field) {
 }
 
 const char* RdcRocpBase::get_field_id_from_name(rdc_field_t field) {
+  std::lock_guard<std::mutex> guard(m_init_mutex);
   auto it = field_to_metric.find(field);
   if (it == field_to_metric.end()) {
     RDC_LOG(RDC_ERROR, "Error: Field ID " << field << " not found in field_to_metric map.");
@@ -156,6 +158,7 @@ const char* RdcRocpBase::get_field_id_from_name(rdc_field_t field) {
 }
 
 const std::vector<rdc_field_t> RdcRocpBase::get_field_ids() {
+  std::lock_guard<std::mutex> guard(m_init_mutex);
   std::vector<rdc_field_t> field_ids;
   for (auto& [k, v] : field_to_metric) {
     field_ids.push_back(k);
@@ -248,6 +251,8 @@ rdc_status_t RdcRocpBase::map_entity_to_profiler() {
 }
 
 void RdcRocpBase::init_rocp_if_not() {
+  // Concurrent lookups wait here until the first one has initialized
+  std::lock_guard<std::mutex> guard(m_init_mutex);
   if (m_is_initialized) {
     return;
   }
@@ -276,6 +281,9 @@ void RdcRocpBase::init_rocp_if_not() {
   agents = CounterSampler::get_available_agents();
   RDC_LOG(RDC_DEBUG, "Agent count: " << agents.size());
   samplers = CounterSampler::get_samplers();
+  for (size_t i = 0; i < samplers.size(); i++) {
+    sampler_mutexes.emplace_back(new std::mutex);
+  }
 
   map_entity_to_profiler();
 
@@ -330,8 +338,6 @@ rdc_status_t RdcRocpBase::rocp_lookup(rdc_gpu_field_t gpu_field, rdc_field_value
   // default type
   *type = DOUBLE;
 
-  // convert from entity to flat index
-  uint32_t agent_index = entity_to_prof_map[gpu_field.gpu_index];
   const auto& field = gpu_field.field_id;
 
   if (data == nullptr) {
@@ -340,6 +346,11 @@ rdc_status_t RdcRocpBase::rocp_lookup(rdc_gpu_field_t gpu_field, rdc_field_value
 
   init_rocp_if_not();
 
+  // convert from entity to flat index. The map is complete once initialized,
+  // unmapped entities fall back to the first agent.
+  const auto prof_ite = entity_to_prof_map.find(gpu_field.gpu_index);
+  const uint32_t agent_index = (prof_ite != entity_to_prof_map.end()) ? prof_ite->second : 0;
+
   const bool is_eval_field = (eval_fields.find(field) != eval_fields.end());
 
   const auto start_time = std::chrono::high_resolution_clock::now();
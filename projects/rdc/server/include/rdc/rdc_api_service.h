@@ -24,6 +24,8 @@ THE SOFTWARE.
 
 #include <grpcpp/server_context.h>
 
+#include <atomic>
+#include <mutex>
 #include <thread>
 
 #include "rdc.grpc.pb.h"  // NOLINT
@@ -101,6 +103,10 @@ class RdcAPIServiceImpl final : public ::rdc::RdcAPI::Service {
                                const ::rdc::UnWatchFieldsRequest* request,
                                ::rdc::UnWatchFieldsResponse* reply) override;
 
+  ::grpc::Status ListenFields(
+      ::grpc::ServerContext* context, const ::rdc::ListenFieldsRequest* request,
+      ::grpc::ServerWriter< ::rdc::ListenFieldsResponse>* writer) override;
+
   ::grpc::Status UpdateAllFields(::grpc::ServerContext* context,
                                  const ::rdc::UpdateAllFieldsRequest* request,
                                  ::rdc::UpdateAllFieldsResponse* reply) override;
@@ -205,6 +211,15 @@ class RdcAPIServiceImpl final : public ::rdc::RdcAPI::Service {
   // map for group_id and thread context
   static std::map<uint32_t, struct policy_thread_context*> policy_threads_;
   static int PolicyCallback(rdc_policy_callback_response_t* userData);
+
+  // The values of a listener are written from the listener thread of the
+  // handler while the ListenFields call waits for the client to cancel it.
+  struct listen_stream_context {
+    ::grpc::ServerWriter< ::rdc::ListenFieldsResponse>* writer;
+    std::mutex write_mutex;  // Guards the writer
+    std::atomic<bool> failed;
+  };
+  static void ListenCallback(const rdc_field_update_t* updates, uint32_t count, void* user_data);
 };
 
 }  // namespace rdc
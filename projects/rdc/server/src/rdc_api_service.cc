@@ -25,6 +25,7 @@ THE SOFTWARE.
 #include <grpcpp/grpcpp.h>
 #include <grpcpp/impl/call_op_set.h>
 
+#include <chrono>
 #include <csignal>
 #include <future>
 #include <iostream>
@@ -415,6 +416,78 @@ RdcAPIServiceImpl::~RdcAPIServiceImpl() {
   return ::grpc::Status::OK;
 }
 
+::grpc::Status RdcAPIServiceImpl::ListenFields(
+    ::grpc::ServerContext* context, const ::rdc::ListenFieldsRequest* request,
+    ::grpc::ServerWriter<::rdc::ListenFieldsResponse>* writer) {
+  if (!writer || !request) {
+    return ::grpc::Status(::grpc::StatusCode::INTERNAL, "Empty contents");
+  }
+
+  listen_stream_context ctx;
+  ctx.writer = writer;
+  ctx.failed = false;
+
+  uint32_t listener_id = 0;
+  rdc_status_t result =
+      rdc_field_listen(rdc_handle_, request->group_id(), request->field_group_id(),
+                       request->coalesce_interval(), ListenCallback, &ctx, &listener_id);
+
+  // The listener may already be delivering values, so the first response
+  // is written under the same lock as them. Every response carries the
+  // status, so the client accepts values arriving before this one.
+  ::rdc::ListenFieldsResponse reply;
+  reply.set_status(result);
+  {
+    std::lock_guard<std::mutex> guard(ctx.write_mutex);
+    if (!writer->Write(reply)) {
+      ctx.failed = true;
+    }
+  }
+  if (result != RDC_ST_OK) {
+    return ::grpc::Status::OK;
+  }
+
+  while (!context->IsCancelled() && !ctx.failed) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+
+  // No callback is running once the listener is removed
+  rdc_field_unlisten(rdc_handle_, listener_id);
+  return ::grpc::Status::OK;
+}
+
+void RdcAPIServiceImpl::ListenCallback(const rdc_field_update_t* updates, uint32_t count,
+                                       void* user_data) {
+  listen_stream_context* ctx = static_cast<listen_stream_context*>(user_data);
+  if (ctx->failed) {
+    return;
+  }
+
+  ::rdc::ListenFieldsResponse reply;
+  reply.set_status(RDC_ST_OK);
+  for (uint32_t i = 0; i < count; i++) {
+    const rdc_field_value& value = updates[i].field;
+    ::rdc::FieldUpdate* update = reply.add_updates();
+    update->set_gpu_index(updates[i].gpu_index);
+    update->set_field_id(value.field_id);
+    update->set_rdc_status(value.status);
+    update->set_ts(value.ts);
+    update->set_type(static_cast<::rdc::FieldUpdate_FieldType>(value.type));
+    if (value.type == INTEGER) {
+      update->set_l_int(value.value.l_int);
+    } else if (value.type == DOUBLE) {
+      update->set_dbl(value.value.dbl);
+    } else if (value.type == STRING || value.type == BLOB) {
+      update->set_str(value.value.str);
+    }
+  }
+
+  std::lock_guard<std::mutex> guard(ctx->write_mutex);
+  if (!ctx->writer->Write(reply)) {
+    ctx->failed = true;
+  }
+}
+
 ::grpc::Status RdcAPIServiceImpl::UpdateAllFields(::grpc::ServerContext* context,
                                                   const ::rdc::UpdateAllFieldsRequest* request,
                                                   ::rdc::UpdateAllFieldsResponse* reply) {
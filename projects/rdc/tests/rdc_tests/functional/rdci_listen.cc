@@ -0,0 +1,159 @@
+/*
+Copyright (c) 2026 - present Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "rdc_tests/functional/rdci_listen.h"
+
+#include <gtest/gtest.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include "rdc/rdc.h"
+#include "rdc_tests/test_common.h"
+
+namespace {
+std::atomic<uint32_t> listen_update_count{0};
+
+void ListenCallback(const rdc_field_update_t* updates, uint32_t count, void* user_data) {
+  (void)(user_data);
+  for (uint32_t i = 0; i < count; i++) {
+    if (updates[i].field.status == RDC_ST_OK) {
+      listen_update_count++;
+    }
+  }
+}
+}  // namespace
+
+TestRdciListen::TestRdciListen() : TestBase() {
+  set_title("\tRDC Listen Test");
+  set_description("\tThe Listen test verifies that the watched field values are pushed. ");
+}
+
+TestRdciListen::~TestRdciListen(void) {}
+
+void TestRdciListen::SetUp(void) {
+  TestBase::SetUp();
+  rdc_status_t result = AllocateRDCChannel();
+  ASSERT_EQ(result, RDC_ST_OK);
+  return;
+}
+
+void TestRdciListen::DisplayTestInfo(void) { TestBase::DisplayTestInfo(); }
+
+void TestRdciListen::DisplayResults(void) const {
+  TestBase::DisplayResults();
+  return;
+}
+
+void TestRdciListen::Close() {
+  TestBase::Close();
+  rdc_status_t result;
+  if (standalone_) {
+    IF_VERB(STANDARD) { std::cout << "\t**Disconnecting from host....\n" << std::endl; }
+    result = rdc_disconnect(rdc_handle);
+    ASSERT_EQ(result, RDC_ST_OK);
+  } else {
+    IF_VERB(STANDARD) { std::cout << "\t**Stopping Embedded RDC Engine....\n" << std::endl; }
+    result = rdc_stop_embedded(rdc_handle);
+    ASSERT_EQ(result, RDC_ST_OK);
+  }
+
+  result = rdc_shutdown();
+  ASSERT_EQ(result, RDC_ST_OK);
+}
+
+void TestRdciListen::Run(void) {
+  TestBase::Run();
+  rdc_status_t result;
+  if (standalone_) {
+    IF_VERB(STANDARD) { std::cout << "\t**Connecting to host....\n" << std::endl; }
+    char hostIpAddress[] = {"localhost:50051"};
+    result = rdc_connect(hostIpAddress, &rdc_handle, nullptr, nullptr, nullptr);
+    ASSERT_EQ(result, RDC_ST_OK);
+  } else {
+    IF_VERB(STANDARD) { std::cout << "\t**Starting embedded RDC engine....\n" << std::endl; }
+    result = rdc_start_embedded(RDC_OPERATION_MODE_AUTO, &rdc_handle);
+    ASSERT_EQ(result, RDC_ST_OK);
+  }
+
+  rdc_gpu_group_t group_id;
+  rdc_field_grp_t field_group_id;
+  result = rdc_group_gpu_create(rdc_handle, RDC_GROUP_EMPTY, "GRP_LISTEN", &group_id);
+  ASSERT_EQ(result, RDC_ST_OK);
+
+  result = rdc_group_gpu_add(rdc_handle, group_id, 0);
+  ASSERT_EQ(result, RDC_ST_OK);
+
+  rdc_field_t field_ids[] = {RDC_FI_GPU_TEMP, RDC_FI_POWER_USAGE};
+  uint32_t fsize = sizeof(field_ids) / sizeof(field_ids[0]);
+  result = rdc_group_field_create(rdc_handle, fsize, &field_ids[0], "FIELD_GRP_LISTEN",
+                                  &field_group_id);
+  ASSERT_EQ(result, RDC_ST_OK);
+
+  uint32_t listener_id = 0;
+  result = rdc_field_listen(rdc_handle, -1, field_group_id, 0, ListenCallback, nullptr,
+                            &listener_id);
+  ASSERT_EQ(result, RDC_ST_NOT_FOUND);
+
+  result = rdc_field_listen(rdc_handle, group_id, -1, 0, ListenCallback, nullptr, &listener_id);
+  ASSERT_EQ(result, RDC_ST_NOT_FOUND);
+
+  result = rdc_field_listen(rdc_handle, group_id, field_group_id, 0, nullptr, nullptr,
+                            &listener_id);
+  ASSERT_EQ(result, RDC_ST_INVALID_HANDLER);
+
+  // Update every 100ms and deliver the values every 200ms
+  result = rdc_field_watch(rdc_handle, group_id, field_group_id, 100000, 60, 10);
+  ASSERT_EQ(result, RDC_ST_OK);
+
+  listen_update_count = 0;
+  result = rdc_field_listen(rdc_handle, group_id, field_group_id, 200000, ListenCallback,
+                            nullptr, &listener_id);
+  ASSERT_EQ(result, RDC_ST_OK);
+
+  std::this_thread::sleep_for(std::chrono::seconds(2));
+
+  result = rdc_field_unlisten(rdc_handle, listener_id);
+  ASSERT_EQ(result, RDC_ST_OK);
+  ASSERT_GT(listen_update_count.load(), 0u);
+
+  // No value is delivered once the listener is removed
+  uint32_t count = listen_update_count;
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  ASSERT_EQ(listen_update_count.load(), count);
+
+  result = rdc_field_unlisten(rdc_handle, listener_id);
+  ASSERT_EQ(result, RDC_ST_NOT_FOUND);
+
+  result = rdc_field_unwatch(rdc_handle, group_id, field_group_id);
+  ASSERT_EQ(result, RDC_ST_OK);
+
+  result = rdc_group_gpu_destroy(rdc_handle, group_id);
+  ASSERT_EQ(result, RDC_ST_OK);
+
+  result = rdc_group_field_destroy(rdc_handle, field_group_id);
+  ASSERT_EQ(result, RDC_ST_OK);
+}
@@ -35,6 +35,7 @@ THE SOFTWARE.
 #include "functional/rdci_dmon.h"
 #include "functional/rdci_fieldgroup.h"
 #include "functional/rdci_group.h"
+#include "functional/rdci_listen.h"
 #include "functional/rdci_stats.h"
 #include "rdc/rdc.h"
 #include "rdc_tests/test_base.h"
@@ -104,6 +105,11 @@ TEST(rdctstReadOnly, TestRdciStats) {
   RunGenericTest(&tst);
 }
 
+TEST(rdctstReadOnly, TestRdciListen) {
+  TestRdciListen tst;
+  RunGenericTest(&tst);
+}
+
 static int getPIDFromName(std::string name) {
   int pid = -1;
 
@@ -0,0 +1,225 @@
+/*
+Copyright (c) 2026 - present Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "rdc_lib/impl/RdcCacheManagerImpl.h"
+
+using amd::rdc::RdcCacheEntry;
+using amd::rdc::RdcCacheManagerImpl;
+using amd::rdc::RdcCacheRing;
+
+namespace {
+
+RdcCacheEntry make_entry(uint64_t ts) {
+  RdcCacheEntry entry{};
+  entry.last_time = ts;
+  entry.type = INTEGER;
+  entry.value.l_int = static_cast<int64_t>(ts * 2);
+  return entry;
+}
+
+rdc_field_value make_value(rdc_field_t field, uint64_t ts) {
+  rdc_field_value value{};
+  value.field_id = field;
+  value.ts = ts;
+  value.type = INTEGER;
+  value.value.l_int = static_cast<int64_t>(ts * 2);
+  return value;
+}
+
+}  // namespace
+
+TEST(rdctstUnit, CacheRingGrowAndSearch) {
+  RdcCacheRing ring;
+  EXPECT_TRUE(ring.empty());
+  EXPECT_EQ(ring.lower_bound(0), 0u);
+
+  for (uint64_t i = 0; i < 100; i++) {
+    ring.push_back(make_entry(i * 10));
+  }
+  ASSERT_EQ(ring.size(), 100u);
+  EXPECT_EQ(ring[0].last_time, 0u);
+  EXPECT_EQ(ring.back().last_time, 990u);
+  EXPECT_EQ(ring.lower_bound(50), 5u);
+  EXPECT_EQ(ring.lower_bound(55), 6u);
+  EXPECT_EQ(ring.upper_bound(50), 6u);
+  EXPECT_EQ(ring.lower_bound(1000), ring.size());
+  EXPECT_EQ(ring.upper_bound(990), ring.size());
+}
+
+TEST(rdctstUnit, CacheRingWrapAround) {
+  RdcCacheRing ring(10);
+  for (uint64_t i = 0; i < 25; i++) {
+    ring.push_back(make_entry(i * 10));
+  }
+
+  // Full: the oldest samples were overwritten and the head wrapped around
+  ASSERT_EQ(ring.size(), 10u);
+  for (size_t i = 0; i < ring.size(); i++) {
+    EXPECT_EQ(ring[i].last_time, (15 + i) * 10) << "index " << i;
+    EXPECT_EQ(ring[i].value.l_int, static_cast<int64_t>((15 + i) * 20)) << "index " << i;
+  }
+  EXPECT_EQ(ring.lower_bound(200), 5u);
+  EXPECT_EQ(ring.upper_bound(200), 6u);
+
+  // An out-of-order sample is moved into place across the wrap point
+  ring.push_back(make_entry(155));
+  ASSERT_EQ(ring.size(), 10u);
+  EXPECT_EQ(ring[0].last_time, 155u);
+  EXPECT_EQ(ring[1].last_time, 160u);
+  EXPECT_EQ(ring.back().last_time, 240u);
+  for (size_t i = 1; i < ring.size(); i++) {
+    EXPECT_LT(ring[i - 1].last_time, ring[i].last_time) << "index " << i;
+  }
+}
+
+TEST(rdctstUnit, CacheRingEviction) {
+  RdcCacheRing ring;
+  for (uint64_t i = 0; i < 100; i++) {
+    ring.push_back(make_entry(i * 10));
+  }
+
+  // Shrinking drops the oldest samples
+  ring.set_capacity(10);
+  ASSERT_EQ(ring.size(), 10u);
+  EXPECT_EQ(ring[0].last_time, 900u);
+  EXPECT_EQ(ring.back().last_time, 990u);
+
+  ring.pop_front(3);
+  ASSERT_EQ(ring.size(), 7u);
+  EXPECT_EQ(ring[0].last_time, 930u);
+
+  // Growing keeps the retained samples in order
+  ring.set_capacity(50);
+  for (uint64_t i = 100; i < 160; i++) {
+    ring.push_back(make_entry(i * 10));
+  }
+  ASSERT_EQ(ring.size(), 50u);
+  EXPECT_EQ(ring[0].last_time, 1100u);
+  EXPECT_EQ(ring.back().last_time, 1590u);
+
+  ring.pop_front(ring.size() + 1);
+  EXPECT_TRUE(ring.empty());
+
+  ring.set_capacity(0);
+  ring.push_back(make_entry(1));
+  EXPECT_TRUE(ring.empty());
+}
+
+TEST(rdctstUnit, CacheManagerEviction) {
+  RdcCacheManagerImpl cache;
+  for (uint64_t ts = 1; ts <= 5; ts++) {
+    ASSERT_EQ(cache.rdc_update_cache(0, make_value(RDC_FI_GPU_TEMP, ts)), RDC_ST_OK);
+  }
+
+  rdc_field_value value{};
+  uint64_t next_ts = 0;
+  ASSERT_EQ(cache.rdc_field_get_value_since(0, RDC_FI_GPU_TEMP, 3, &next_ts, &value), RDC_ST_OK);
+  EXPECT_EQ(value.ts, 3u);
+  EXPECT_EQ(value.value.l_int, 6);
+  EXPECT_EQ(next_ts, 4u);
+
+  // Keep the 2 latest samples; the age limit keeps everything
+  ASSERT_EQ(cache.evict_cache(0, RDC_FI_GPU_TEMP, 2, 1e12), RDC_ST_OK);
+  ASSERT_EQ(cache.rdc_field_get_value_since(0, RDC_FI_GPU_TEMP, 0, &next_ts, &value), RDC_ST_OK);
+  EXPECT_EQ(value.ts, 4u);
+
+  // Later updates overwrite the oldest sample in place
+  ASSERT_EQ(cache.rdc_update_cache(0, make_value(RDC_FI_GPU_TEMP, 6)), RDC_ST_OK);
+  ASSERT_EQ(cache.rdc_field_get_value_since(0, RDC_FI_GPU_TEMP, 0, &next_ts, &value), RDC_ST_OK);
+  EXPECT_EQ(value.ts, 5u);
+  ASSERT_EQ(cache.rdc_field_get_latest_value(0, RDC_FI_GPU_TEMP, &value), RDC_ST_OK);
+  EXPECT_EQ(value.ts, 6u);
+
+  ASSERT_EQ(cache.evict_cache(0, RDC_FI_GPU_TEMP, 0, 1e12), RDC_ST_OK);
+  EXPECT_EQ(cache.rdc_field_get_latest_value(0, RDC_FI_GPU_TEMP, &value), RDC_ST_NOT_FOUND);
+}
+
+TEST(rdctstUnit, CacheManagerConcurrentReadWrite) {
+  constexpr uint32_t kNumGpus = 4;
+  constexpr uint64_t kNumSamples = 20000;
+  constexpr uint64_t kKeepSamples = 64;
+
+  RdcCacheManagerImpl cache;
+  std::atomic<bool> done{false};
+  std::atomic<uint64_t> errors{0};
+
+  // One writer per gpu, as the watch table updates them
+  std::vector<std::thread> threads;
+  for (uint32_t gpu = 0; gpu < kNumGpus; gpu++) {
+    threads.emplace_back([&cache, &errors, gpu]() {
+      for (uint64_t ts = 1; ts <= kNumSamples; ts++) {
+        if (cache.rdc_update_cache(gpu, make_value(RDC_FI_GPU_TEMP, ts)) != RDC_ST_OK) {
+          errors++;
+        }
+        if (ts % 256 == 0) {
+          cache.evict_cache(gpu, RDC_FI_GPU_TEMP, kKeepSamples, 1e12);
+        }
+      }
+    });
+  }
+
+  // Readers must only ever see consistent, ordered samples
+  for (uint32_t r = 0; r < 2; r++) {
+    threads.emplace_back([&cache, &done, &errors]() {
+      while (!done.load()) {
+        for (uint32_t gpu = 0; gpu < kNumGpus; gpu++) {
+          rdc_field_value value{};
+          if (cache.rdc_field_get_latest_value(gpu, RDC_FI_GPU_TEMP, &value) == RDC_ST_OK &&
+              value.value.l_int != static_cast<int64_t>(value.ts * 2)) {
+            errors++;
+          }
+          uint64_t next_ts = 0;
+          if (cache.rdc_field_get_value_since(gpu, RDC_FI_GPU_TEMP, 0, &next_ts, &value) ==
+                  RDC_ST_OK &&
+              (next_ts <= value.ts || value.value.l_int != static_cast<int64_t>(value.ts * 2))) {
+            errors++;
+          }
+        }
+      }
+    });
+  }
+
+  for (uint32_t gpu = 0; gpu < kNumGpus; gpu++) {
+    threads[gpu].join();
+  }
+  done.store(true);
+  for (size_t i = kNumGpus; i < threads.size(); i++) {
+    threads[i].join();
+  }
+
+  EXPECT_EQ(errors.load(), 0u);
+  for (uint32_t gpu = 0; gpu < kNumGpus; gpu++) {
+    rdc_field_value value{};
+    ASSERT_EQ(cache.rdc_field_get_latest_value(gpu, RDC_FI_GPU_TEMP, &value), RDC_ST_OK);
+    EXPECT_EQ(value.ts, kNumSamples);
+    uint64_t next_ts = 0;
+    ASSERT_EQ(cache.rdc_field_get_value_since(gpu, RDC_FI_GPU_TEMP, 0, &next_ts, &value),
+              RDC_ST_OK);
+    EXPECT_EQ(value.ts, kNumSamples - kKeepSamples + 1);
+  }
+}
@@ -0,0 +1,202 @@
+/*
+Copyright (c) 2026 - present Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include <gtest/gtest.h>
+#include <sys/time.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cstdint>
+#include <memory>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "rdc_lib/RdcModuleMgr.h"
+#include "rdc_lib/RdcNotification.h"
+#include "rdc_lib/impl/RdcCacheManagerImpl.h"
+#include "rdc_lib/impl/RdcWatchTableImpl.h"
+#include "rdc_lib/rdc_common.h"
+
+namespace {
+
+constexpr uint32_t kNumGpus = 4;
+constexpr rdc_gpu_group_t kGroupId = 1;
+constexpr rdc_field_grp_t kFieldGroupId = 1;
+const rdc_field_t kFields[] = {RDC_FI_GPU_TEMP, RDC_FI_POWER_USAGE};
+constexpr auto kFetchTime = std::chrono::milliseconds(100);
+
+int64_t expected_value(uint32_t gpu_index, rdc_field_t field) {
+  return static_cast<int64_t>(gpu_index) * 1000 + field;
+}
+
+class FakeGroupSettings : public amd::rdc::RdcGroupSettings {
+ public:
+  rdc_status_t rdc_group_gpu_create(const char*, rdc_gpu_group_t*) override {
+    return RDC_ST_NOT_SUPPORTED;
+  }
+  rdc_status_t rdc_group_gpu_destroy(rdc_gpu_group_t) override { return RDC_ST_NOT_SUPPORTED; }
+  rdc_status_t rdc_group_gpu_add(rdc_gpu_group_t, uint32_t) override {
+    return RDC_ST_NOT_SUPPORTED;
+  }
+  rdc_status_t rdc_group_gpu_get_info(rdc_gpu_group_t, rdc_group_info_t* info) override {
+    *info = {};
+    info->count = kNumGpus;
+    for (uint32_t i = 0; i < kNumGpus; i++) {
+      info->entity_ids[i] = i;
+    }
+    return RDC_ST_OK;
+  }
+  rdc_status_t rdc_group_get_all_ids(rdc_gpu_group_t[], uint32_t*) override {
+    return RDC_ST_NOT_SUPPORTED;
+  }
+  rdc_status_t rdc_group_field_create(uint32_t, rdc_field_t*, const char*,
+                                      rdc_field_grp_t*) override {
+    return RDC_ST_NOT_SUPPORTED;
+  }
+  rdc_status_t rdc_group_field_destroy(rdc_field_grp_t) override { return RDC_ST_NOT_SUPPORTED; }
+  rdc_status_t rdc_group_field_get_info(rdc_field_grp_t, rdc_field_group_info_t* info) override {
+    *info = {};
+    info->count = sizeof(kFields) / sizeof(kFields[0]);
+    std::copy(std::begin(kFields), std::end(kFields), info->field_ids);
+    return RDC_ST_OK;
+  }
+  rdc_status_t rdc_group_field_get_all_ids(rdc_field_grp_t[], uint32_t*) override {
+    return RDC_ST_NOT_SUPPORTED;
+  }
+};
+
+class FakeNotification : public amd::rdc::RdcNotification {
+ public:
+  bool is_notification_event(rdc_field_t) const override { return false; }
+  rdc_status_t set_listen_events(const std::vector<RdcFieldKey>) override { return RDC_ST_OK; }
+  rdc_status_t listen(amd::rdc::rdc_evnt_notification_t*, uint32_t* num_events,
+                      uint32_t) override {
+    *num_events = 0;
+    return RDC_ST_OK;
+  }
+  rdc_status_t stop_listening(uint32_t) override { return RDC_ST_OK; }
+};
+
+// A module whose fetches are slow, recording how many GPUs are fetched at once
+class SlowTelemetry : public amd::rdc::RdcTelemetry {
+ public:
+  rdc_status_t rdc_telemetry_fields_query(uint32_t field_ids[MAX_NUM_FIELDS],
+                                          uint32_t* field_count) override {
+    *field_count = sizeof(kFields) / sizeof(kFields[0]);
+    std::copy(std::begin(kFields), std::end(kFields), field_ids);
+    return RDC_ST_OK;
+  }
+
+  rdc_status_t rdc_telemetry_fields_value_get(rdc_gpu_field_t* fields, uint32_t fields_count,
+                                              rdc_field_value_f callback,
+                                              void* user_data) override {
+    auto in_flight = ++in_flight_;
+    auto max_in_flight = max_in_flight_.load();
+    while (in_flight > max_in_flight &&
+           !max_in_flight_.compare_exchange_weak(max_in_flight, in_flight)) {
+    }
+    calls_++;
+
+    std::this_thread::sleep_for(kFetchTime);
+
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    uint64_t now = static_cast<uint64_t>(tv.tv_sec) * 1000 + tv.tv_usec / 1000;
+
+    std::vector<rdc_gpu_field_value_t> values(fields_count);
+    for (uint32_t i = 0; i < fields_count; i++) {
+      // One call per GPU
+      if (fields[i].gpu_index != fields[0].gpu_index) {
+        mixed_gpus_++;
+      }
+      values[i] = {};
+      values[i].gpu_index = fields[i].gpu_index;
+      values[i].field_value.field_id = fields[i].field_id;
+      values[i].field_value.status = RDC_ST_OK;
+      values[i].field_value.ts = now;
+      values[i].field_value.type = INTEGER;
+      values[i].field_value.value.l_int = expected_value(fields[i].gpu_index, fields[i].field_id);
+    }
+    in_flight_--;
+    return callback(values.data(), fields_count, user_data);
+  }
+
+  rdc_status_t rdc_telemetry_fields_watch(rdc_gpu_field_t*, uint32_t) override {
+    return RDC_ST_OK;
+  }
+  rdc_status_t rdc_telemetry_fields_unwatch(rdc_gpu_field_t*, uint32_t) override {
+    return RDC_ST_OK;
+  }
+
+  std::atomic<uint32_t> in_flight_{0};
+  std::atomic<uint32_t> max_in_flight_{0};
+  std::atomic<uint32_t> calls_{0};
+  std::atomic<uint32_t> mixed_gpus_{0};
+};
+
+class FakeModuleMgr : public amd::rdc::RdcModuleMgr {
+ public:
+  explicit FakeModuleMgr(const amd::rdc::RdcTelemetryPtr& telemetry) : telemetry_(telemetry) {}
+  amd::rdc::RdcTelemetryPtr get_telemetry_module() override { return telemetry_; }
+  amd::rdc::RdcDiagnosticPtr get_diagnostic_module() override { return nullptr; }
+
+ private:
+  amd::rdc::RdcTelemetryPtr telemetry_;
+};
+
+}  // namespace
+
+TEST(rdctstUnit, WatchTableParallelFetch) {
+  auto telemetry = std::make_shared<SlowTelemetry>();
+  auto cache_mgr = std::make_shared<amd::rdc::RdcCacheManagerImpl>();
+  amd::rdc::RdcWatchTableImpl watch_table(
+      std::make_shared<FakeGroupSettings>(), cache_mgr, nullptr,
+      std::make_shared<FakeModuleMgr>(telemetry), std::make_shared<FakeNotification>());
+
+  ASSERT_EQ(watch_table.rdc_field_watch(kGroupId, kFieldGroupId, 1000000, 60, 10), RDC_ST_OK);
+
+  const auto start = std::chrono::steady_clock::now();
+  ASSERT_EQ(watch_table.rdc_field_update_all(), RDC_ST_OK);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  // Every GPU is fetched with one bulk call, several of them at the same time
+  EXPECT_EQ(telemetry->calls_.load(), kNumGpus);
+  EXPECT_EQ(telemetry->mixed_gpus_.load(), 0u);
+  EXPECT_GT(telemetry->max_in_flight_.load(), 1u);
+  EXPECT_LT(elapsed, kFetchTime * kNumGpus);
+
+  // The values of every GPU reached the cache
+  for (uint32_t gpu = 0; gpu < kNumGpus; gpu++) {
+    for (auto field : kFields) {
+      rdc_field_value value{};
+      ASSERT_EQ(cache_mgr->rdc_field_get_latest_value(gpu, field, &value), RDC_ST_OK)
+          << "gpu " << gpu << " field " << field;
+      EXPECT_EQ(value.value.l_int, expected_value(gpu, field));
+    }
+  }
+
+  // Nothing is due again before the update frequency
+  ASSERT_EQ(watch_table.rdc_field_update_all(), RDC_ST_OK);
+  EXPECT_EQ(telemetry->calls_.load(), kNumGpus);
+
+  ASSERT_EQ(watch_table.rdc_field_unwatch(kGroupId, kFieldGroupId), RDC_ST_OK);
+}
@@ -1243,6 +1243,75 @@ typedef struct {
   /// \endcond
 } rsmi_gpu_metrics_t;
 
+/**
+ * @brief Scalar ::rsmi_gpu_metrics_t fields that can be retrieved in bulk
+ * with ::rsmi_dev_gpu_metrics_fields_get. Each field maps 1:1 to the
+ * ::rsmi_gpu_metrics_t data member of the same name.
+ */
+typedef enum {
+  RSMI_GPU_METRICS_FIELD_FIRST = 0,
+
+  RSMI_GPU_METRICS_FIELD_TEMPERATURE_EDGE = RSMI_GPU_METRICS_FIELD_FIRST,
+  RSMI_GPU_METRICS_FIELD_TEMPERATURE_HOTSPOT,
+  RSMI_GPU_METRICS_FIELD_TEMPERATURE_MEM,
+  RSMI_GPU_METRICS_FIELD_TEMPERATURE_VRGFX,
+  RSMI_GPU_METRICS_FIELD_TEMPERATURE_VRSOC,
+  RSMI_GPU_METRICS_FIELD_TEMPERATURE_VRMEM,
+  RSMI_GPU_METRICS_FIELD_AVERAGE_GFX_ACTIVITY,
+  RSMI_GPU_METRICS_FIELD_AVERAGE_UMC_ACTIVITY,
+  RSMI_GPU_METRICS_FIELD_AVERAGE_MM_ACTIVITY,
+  RSMI_GPU_METRICS_FIELD_AVERAGE_SOCKET_POWER,
+  RSMI_GPU_METRICS_FIELD_ENERGY_ACCUMULATOR,
+  RSMI_GPU_METRICS_FIELD_SYSTEM_CLOCK_COUNTER,
+  RSMI_GPU_METRICS_FIELD_AVERAGE_GFXCLK_FREQUENCY,
+  RSMI_GPU_METRICS_FIELD_AVERAGE_SOCCLK_FREQUENCY,
+  RSMI_GPU_METRICS_FIELD_AVERAGE_UCLK_FREQUENCY,
+  RSMI_GPU_METRICS_FIELD_AVERAGE_VCLK0_FREQUENCY,
+  RSMI_GPU_METRICS_FIELD_AVERAGE_DCLK0_FREQUENCY,
+  RSMI_GPU_METRICS_FIELD_AVERAGE_VCLK1_FREQUENCY,
+  RSMI_GPU_METRICS_FIELD_AVERAGE_DCLK1_FREQUENCY,
+  RSMI_GPU_METRICS_FIELD_CURRENT_GFXCLK,
+  RSMI_GPU_METRICS_FIELD_CURRENT_SOCCLK,
+  RSMI_GPU_METRICS_FIELD_CURRENT_UCLK,
+  RSMI_GPU_METRICS_FIELD_CURRENT_VCLK0,
+  RSMI_GPU_METRICS_FIELD_CURRENT_DCLK0,
+  RSMI_GPU_METRICS_FIELD_CURRENT_VCLK1,
+  RSMI_GPU_METRICS_FIELD_CURRENT_DCLK1,
+  RSMI_GPU_METRICS_FIELD_THROTTLE_STATUS,
+  RSMI_GPU_METRICS_FIELD_CURRENT_FAN_SPEED,
+  RSMI_GPU_METRICS_FIELD_PCIE_LINK_WIDTH,
+  RSMI_GPU_METRICS_FIELD_PCIE_LINK_SPEED,
+  RSMI_GPU_METRICS_FIELD_GFX_ACTIVITY_ACC,
+  RSMI_GPU_METRICS_FIELD_MEM_ACTIVITY_ACC,
+  RSMI_GPU_METRICS_FIELD_FIRMWARE_TIMESTAMP,
+  RSMI_GPU_METRICS_FIELD_VOLTAGE_SOC,
+  RSMI_GPU_METRICS_FIELD_VOLTAGE_GFX,
+  RSMI_GPU_METRICS_FIELD_VOLTAGE_MEM,
+  RSMI_GPU_METRICS_FIELD_INDEP_THROTTLE_STATUS,
+  RSMI_GPU_METRICS_FIELD_CURRENT_SOCKET_POWER,
+  RSMI_GPU_METRICS_FIELD_GFXCLK_LOCK_STATUS,
+  RSMI_GPU_METRICS_FIELD_XGMI_LINK_WIDTH,
+  RSMI_GPU_METRICS_FIELD_XGMI_LINK_SPEED,
+  RSMI_GPU_METRICS_FIELD_PCIE_BANDWIDTH_ACC,
+  RSMI_GPU_METRICS_FIELD_PCIE_BANDWIDTH_INST,
+  RSMI_GPU_METRICS_FIELD_PCIE_L0_TO_RECOV_COUNT_ACC,
+  RSMI_GPU_METRICS_FIELD_PCIE_REPLAY_COUNT_ACC,
+  RSMI_GPU_METRICS_FIELD_PCIE_REPLAY_ROVER_COUNT_ACC,
+  RSMI_GPU_METRICS_FIELD_PCIE_NAK_SENT_COUNT_ACC,
+  RSMI_GPU_METRICS_FIELD_PCIE_NAK_RCVD_COUNT_ACC,
+  RSMI_GPU_METRICS_FIELD_ACCUMULATION_COUNTER,
+  RSMI_GPU_METRICS_FIELD_PROCHOT_RESIDENCY_ACC,
+  RSMI_GPU_METRICS_FIELD_PPT_RESIDENCY_ACC,
+  RSMI_GPU_METRICS_FIELD_SOCKET_THM_RESIDENCY_ACC,
+  RSMI_GPU_METRICS_FIELD_VR_THM_RESIDENCY_ACC,
+  RSMI_GPU_METRICS_FIELD_HBM_THM_RESIDENCY_ACC,
+  RSMI_GPU_METRICS_FIELD_NUM_PARTITION,
+  RSMI_GPU_METRICS_FIELD_PCIE_LC_PERF_OTHER_END_RECOVERY,
+  RSMI_GPU_METRICS_FIELD_VRAM_MAX_BANDWIDTH,
+
+  RSMI_GPU_METRICS_FIELD_LAST = RSMI_GPU_METRICS_FIELD_VRAM_MAX_BANDWIDTH
+} rsmi_gpu_metrics_field_t;
+
 /**
  * @brief This structure holds error counts.
  */
@@ -3011,6 +3080,179 @@ rsmi_status_t rsmi_dev_od_volt_info_get(uint32_t dv_ind,
 rsmi_status_t rsmi_dev_gpu_metrics_info_get(uint32_t dv_ind,
                                             rsmi_gpu_metrics_t *pgpu_metrics);
 
+/**
+ *  @brief Set the maximum age of a cached gpu metrics snapshot
+ *
+ *  @details Every call to ::rsmi_dev_gpu_metrics_info_get, and every metric
+ *  getter built on top of it (temperature, activity, clock, power, ...), reads
+ *  and decodes the complete gpu_metrics table of the device. When @p max_age_us
+ *  is non-zero, the decoded table is kept as a per-device snapshot and is
+ *  reused by those calls until it is older than @p max_age_us microseconds.
+ *  Only an expired snapshot causes the gpu_metrics file to be read again.
+ *  A value of 0 (the default) disables the snapshot; every call reads the
+ *  gpu_metrics file. Changing the value drops all currently cached snapshots.
+ *
+ *  @param[in] max_age_us maximum snapshot age, in microseconds
+ *
+ *  @retval ::RSMI_STATUS_SUCCESS call was successful
+ */
+rsmi_status_t rsmi_gpu_metrics_cache_max_age_set(uint64_t max_age_us);
+
+/**
+ *  @brief Get the maximum age of a cached gpu metrics snapshot
+ *
+ *  @details See ::rsmi_gpu_metrics_cache_max_age_set.
+ *
+ *  @param[inout] max_age_us a pointer to a uint64_t to which the maximum
+ *  snapshot age, in microseconds, will be written
+ *
+ *  @retval ::RSMI_STATUS_SUCCESS call was successful
+ *  @retval ::RSMI_STATUS_INVALID_ARGS the provided arguments are not valid
+ */
+rsmi_status_t rsmi_gpu_metrics_cache_max_age_get(uint64_t *max_age_us);
+
+/**
+ *  @brief Get several gpu metrics fields for several devices in one call
+ *
+ *  @details Given an array of @p num_devices device indices @p dv_inds and an
+ *  array of @p num_fields ::rsmi_gpu_metrics_field_t @p fields, this function
+ *  will write the value of every field for every device to @p values. The
+ *  gpu_metrics table of each device is read at most once per call (or not at
+ *  all, when a snapshot younger than the age set with
+ *  ::rsmi_gpu_metrics_cache_max_age_set is available), and all the fields of
+ *  that device are served from the same table.
+ *
+ *  @p values and @p field_status must both hold @p num_devices * @p num_fields
+ *  entries. The entry for device @p dv_inds[d] and field @p fields[f] is
+ *  located at index (d * @p num_fields + f).
+ *
+ *  An entry of @p field_status is set to ::RSMI_STATUS_NOT_SUPPORTED when the
+ *  field is not populated by the gpu metrics version of the device, or to the
+ *  error returned while reading the gpu_metrics table of the device. The
+ *  corresponding entry of @p values is then set to UINT64_MAX.
+ *
+ *  @param[in] dv_inds an array of device indices
+ *
+ *  @param[in] num_devices the number of entries in @p dv_inds
+ *
+ *  @param[in] fields an array of ::rsmi_gpu_metrics_field_t
+ *
+ *  @param[in] num_fields the number of entries in @p fields
+ *
+ *  @param[inout] values a caller provided array of
+ *  @p num_devices * @p num_fields uint64_t to which the values will be written
+ *
+ *  @param[inout] field_status a caller provided array of
+ *  @p num_devices * @p num_fields ::rsmi_status_t to which the status of
+ *  each value will be written
+ *
+ *  @retval ::RSMI_STATUS_SUCCESS call was successful; check @p field_status
+ *  for the status of each value
+ *  @retval ::RSMI_STATUS_INVALID_ARGS the provided arguments are not valid
+ */
+rsmi_status_t rsmi_dev_gpu_metrics_fields_get(const uint32_t *dv_inds,
+                                           uint32_t num_devices,
+                                           const rsmi_gpu_metrics_field_t *fields,
+                                           uint32_t num_fields,
+                                           uint64_t *values,
+                                           rsmi_status_t *field_status);
+
+/**
+ *  @brief Start sampling gpu metrics fields of a device in the background
+ *
+ *  @details Given a device index @p dv_ind, an array of @p num_fields
+ *  ::rsmi_gpu_metrics_field_t @p fields and a sampling interval
+ *  @p interval_us, this function will make a library thread read the
+ *  gpu_metrics table of the device every @p interval_us microseconds and
+ *  publish the requested fields. The published values are read with
+ *  ::rsmi_dev_sampler_fields_get, which neither touches sysfs nor takes the
+ *  device mutex.
+ *
+ *  Samples are published in a shared memory segment (unless thread-only
+ *  mutexes are in use), so other processes using this library can read them
+ *  with ::rsmi_dev_sampler_fields_get without sampling the device
+ *  themselves. The segment is only accessible to processes of the same user,
+ *  and is removed when the sampling process shuts the library down. Only one
+ *  process at a time may sample a given device.
+ *
+ *  Calling this function again for a device sampled by the calling process
+ *  replaces its set of fields and interval.
+ *
+ *  @param[in] dv_ind a device index
+ *
+ *  @param[in] fields an array of ::rsmi_gpu_metrics_field_t to sample
+ *
+ *  @param[in] num_fields the number of entries in @p fields
+ *
+ *  @param[in] interval_us the sampling interval, in microseconds
+ *
+ *  @retval ::RSMI_STATUS_SUCCESS call was successful
+ *  @retval ::RSMI_STATUS_BUSY the device is already sampled by another process
+ *  @retval ::RSMI_STATUS_OUT_OF_RESOURCES the sample storage could not be
+ *  allocated
+ *  @retval ::RSMI_STATUS_INVALID_ARGS the provided arguments are not valid
+ */
+rsmi_status_t rsmi_dev_sampler_start(uint32_t dv_ind,
+                                     const rsmi_gpu_metrics_field_t *fields,
+                                     uint32_t num_fields, uint64_t interval_us);
+
+/**
+ *  @brief Stop the background sampling of a device
+ *
+ *  @details Given a device index @p dv_ind, stop the sampling started by the
+ *  calling process with ::rsmi_dev_sampler_start. Sampling of all devices
+ *  also stops when the library is shut down.
+ *
+ *  @param[in] dv_ind a device index
+ *
+ *  @retval ::RSMI_STATUS_SUCCESS call was successful
+ *  @retval ::RSMI_STATUS_NOT_FOUND the device is not sampled by the calling
+ *  process
+ *  @retval ::RSMI_STATUS_INVALID_ARGS the provided arguments are not valid
+ */
+rsmi_status_t rsmi_dev_sampler_stop(uint32_t dv_ind);
+
+/**
+ *  @brief Get the latest background sample of gpu metrics fields
+ *
+ *  @details Given a device index @p dv_ind and an array of @p num_fields
+ *  ::rsmi_gpu_metrics_field_t @p fields, this function will write the latest
+ *  values published by the sampler of the device (see
+ *  ::rsmi_dev_sampler_start) to @p values, and their status to
+ *  @p field_status. The sampler may run in the calling process or in any
+ *  other process. All the values returned by one call belong to the same
+ *  sample.
+ *
+ *  An entry of @p field_status is set to ::RSMI_STATUS_NO_DATA when the field
+ *  is not sampled, or to the status of reading the field when the sample was
+ *  taken (for example ::RSMI_STATUS_NOT_SUPPORTED).
+ *
+ *  @param[in] dv_ind a device index
+ *
+ *  @param[in] fields an array of ::rsmi_gpu_metrics_field_t
+ *
+ *  @param[in] num_fields the number of entries in @p fields
+ *
+ *  @param[inout] values a caller provided array of @p num_fields uint64_t
+ *
+ *  @param[inout] field_status a caller provided array of @p num_fields
+ *  ::rsmi_status_t
+ *
+ *  @param[inout] timestamp_ns if not nullptr, the CLOCK_MONOTONIC time, in
+ *  nanoseconds, at which the sample was taken
+ *
+ *  @retval ::RSMI_STATUS_SUCCESS call was successful
+ *  @retval ::RSMI_STATUS_NO_DATA the device is not being sampled, no
+ *  sample was published yet, or the sampling process exited without stopping
+ *  @retval ::RSMI_STATUS_BUSY a consistent sample could not be read
+ *  @retval ::RSMI_STATUS_INVALID_ARGS the provided arguments are not valid
+ */
+rsmi_status_t rsmi_dev_sampler_fields_get(uint32_t dv_ind,
+                                          const rsmi_gpu_metrics_field_t *fields,
+                                          uint32_t num_fields, uint64_t *values,
+                                          rsmi_status_t *field_status,
+                                          uint64_t *timestamp_ns);
+
 /**
  *  @brief This function sets the clock range information
  *
@@ -54,6 +54,7 @@
 #include <map>
 #include <type_traits>
 #include <optional>
+#include <mutex>  // NOLINT
 
 #include "rocm_smi/rocm_smi_monitor.h"
 #include "rocm_smi/rocm_smi_power_mon.h"
@@ -67,6 +68,8 @@
 namespace amd {
 namespace smi {
 
+struct SamplerSnapshot_t;
+
 enum DevKFDNodePropTypes {
   kDevKFDNodePropCachesCnt,
   kDevKFDNodePropIoLinksCnt,
@@ -243,11 +246,18 @@ class Device {
     rsmi_status_t run_internal_gpu_metrics_query(AMDGpuMetricsUnitType_t metric_counter, AMDGpuDynamicMetricTblValues_t& values);
     rsmi_status_t dev_log_gpu_metrics(std::ostringstream& outstream_metrics);
     AMGpuMetricsPublicLatestTupl_t dev_copy_internal_to_external_metrics();
+    bool dev_get_gpu_metrics_snapshot(uint64_t max_age_us,
+                                      AMGpuMetricsPublicLatest_t& snapshot);
+    void dev_set_gpu_metrics_snapshot(const AMGpuMetricsPublicLatest_t& snapshot);
+    void dev_reset_gpu_metrics_snapshot();
+    SamplerSnapshot_t* dev_sampler_snapshot();
+    std::string dev_sampler_snapshot_name();
 
     static const std::map<DevInfoTypes, const char*> devInfoTypesStrings;
     void set_smi_device_id(uint32_t i) { m_device_id = i; }
     void set_smi_partition_id(uint32_t i) { m_partition_id = i; }
     static const char* get_type_string(DevInfoTypes type);
+    std::string sysfs_file_path(DevInfoTypes type) const;
     rsmi_status_t get_smi_device_identifiers(uint32_t device_id,
                   rsmi_device_identifiers_t *device_identifiers);
 
@@ -288,6 +298,17 @@ class Device {
     uint64_t m_gpu_metrics_updated_timestamp;
     uint32_t m_device_id;
     uint32_t m_partition_id;
+
+    // Decoded gpu_metrics table served while younger than the max. age set
+    // by rsmi_gpu_metrics_cache_max_age_set(). Guarded by its own (process
+    // local) mutex so cache hits don't take the shared-memory device mutex.
+    std::mutex m_gpu_metrics_snapshot_mutex;
+    AMGpuMetricsPublicLatest_t m_gpu_metrics_snapshot;
+    uint64_t m_gpu_metrics_snapshot_timestamp;  // steady clock, ns; 0 = empty
+
+    // Published by the (possibly remote) sampler; mapped on first use.
+    std::once_flag m_sampler_snapshot_once;
+    SamplerSnapshot_t* m_sampler_snapshot;
 };
 
 
@@ -804,6 +804,7 @@ using AMGpuMetricsLatest_t = AMDGpuMetrics_v18_t;
  */
 using AMGpuMetricsPublicLatest_t = rsmi_gpu_metrics_t;
 using AMGpuMetricsPublicLatestTupl_t = std::tuple<rsmi_status_t, AMGpuMetricsPublicLatest_t>;
+using AMGpuMetricsFieldValueTupl_t = std::tuple<rsmi_status_t, uint64_t>;
 
 using GpuMetricU16Tbl_t = std::vector<uint16_t>;
 using GpuMetricU32Tbl_t = std::vector<uint32_t>;
@@ -1313,6 +1314,10 @@ template<typename T>
 rsmi_status_t rsmi_dev_gpu_metrics_info_query(uint32_t dv_ind,
                         AMDGpuMetricsUnitType_t metric_counter, T& metric_value);
 
+AMGpuMetricsFieldValueTupl_t
+get_gpu_metrics_field_value(const AMGpuMetricsPublicLatest_t& metrics,
+                            rsmi_gpu_metrics_field_t field);
+
 }  // namespace amd::smi
 
 
@@ -54,6 +54,7 @@
 #include <unordered_map>
 #include <map>
 #include <mutex>  // NOLINT
+#include <atomic>
 #include <utility>
 
 #include "rocm_smi/rocm_smi_io_link.h"
@@ -62,6 +63,7 @@
 #include "rocm_smi/rocm_smi_monitor.h"
 #include "rocm_smi/rocm_smi_power_mon.h"
 #include "rocm_smi/rocm_smi_common.h"
+#include "rocm_smi/rocm_smi_sampler.h"
 
 namespace amd {
 namespace smi {
@@ -121,6 +123,12 @@ class RocmSMI {
     bool isLoggingOn(void);
     uint32_t getLogSetting(void);
 
+    uint64_t gpu_metrics_max_age_us(void) const {
+      return gpu_metrics_max_age_us_.load(std::memory_order_relaxed);}
+    void set_gpu_metrics_max_age_us(uint64_t max_age_us);
+
+    Sampler* sampler(void);
+
  private:
     std::vector<std::shared_ptr<Device>> devices_;
     std::map<uint64_t, std::shared_ptr<KFDNode>> kfd_node_map_;
@@ -154,6 +162,10 @@ class RocmSMI {
     std::mutex bootstrap_mutex_;
     uint32_t ref_count_;  // Access to this should be protected
                           // by bootstrap_mutex_
+    std::atomic<uint64_t> gpu_metrics_max_age_us_;
+    std::mutex sampler_mutex_;
+    std::unique_ptr<Sampler> sampler_;  // Access to this should be protected
+                                        // by sampler_mutex_
 };
 
 }  // namespace smi
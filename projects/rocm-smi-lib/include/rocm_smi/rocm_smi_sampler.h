@@ -0,0 +1,140 @@
+/*
+ * =============================================================================
+ *   ROC Runtime Conformance Release License
+ * =============================================================================
+ * The University of Illinois/NCSA
+ * Open Source License (NCSA)
+ *
+ * Copyright (c) 2025, Advanced Micro Devices, Inc.
+ * All rights reserved.
+ *
+ * Developed by:
+ *
+ *                 AMD Research and AMD ROC Software Development
+ *
+ *                 Advanced Micro Devices, Inc.
+ *
+ *                 www.amd.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal with the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimers.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimers in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the names of <Name of Development Group, Name of Institution>,
+ *    nor the names of its contributors may be used to endorse or promote
+ *    products derived from this Software without specific prior written
+ *    permission.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS WITH THE SOFTWARE.
+ *
+ */
+#ifndef INCLUDE_ROCM_SMI_ROCM_SMI_SAMPLER_H_
+#define INCLUDE_ROCM_SMI_ROCM_SMI_SAMPLER_H_
+
+#include <sys/types.h>
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <condition_variable>  // NOLINT
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+
+#include "rocm_smi/rocm_smi.h"
+
+namespace amd {
+namespace smi {
+
+class Device;
+
+constexpr uint32_t kSamplerNumFields = RSMI_GPU_METRICS_FIELD_LAST + 1;
+static_assert(kSamplerNumFields <= 64,
+              "Sampled fields must fit the SamplerSnapshot_t field mask");
+
+constexpr uint64_t kSamplerSnapshotMagic = 0x524d5349534d504cULL;  // "RSMISMPL"
+
+//  Latest sample of a device, published by a single writer (the sampler
+//  thread of the owning process) under a sequence lock. It is mapped from a
+//  POSIX shared memory segment (or from private memory when thread-only
+//  mutexes are used), so it only holds lock-free atomics.
+//
+//  m_sequence is odd while the writer is updating the values; readers retry
+//  until they observe the same even sequence before and after copying.
+struct SamplerSnapshot_t {
+  std::atomic<uint64_t> m_magic;
+  std::atomic<int64_t>  m_owner_pid;     // 0: nobody is sampling
+  std::atomic<uint64_t> m_sequence;
+  std::atomic<uint64_t> m_interval_us;
+  std::atomic<uint64_t> m_field_mask;    // bit N set: field N is sampled
+  std::atomic<uint64_t> m_timestamp_ns;  // steady (monotonic) clock
+  std::atomic<uint64_t> m_values[kSamplerNumFields];
+  std::atomic<int32_t>  m_status[kSamplerNumFields];
+};
+
+SamplerSnapshot_t* sampler_snapshot_map(const std::string& name,
+                                        bool process_shared);
+void sampler_snapshot_unmap(SamplerSnapshot_t* snapshot);
+void sampler_snapshot_unlink(const std::string& name);
+
+//  Periodically reads the gpu_metrics table of every device this process
+//  samples, from one background thread, and publishes the configured fields
+//  into the device's SamplerSnapshot_t.
+class Sampler {
+ public:
+    Sampler();
+    ~Sampler();
+
+    rsmi_status_t start(uint32_t dv_ind, uint64_t field_mask,
+                        uint64_t interval_us);
+    rsmi_status_t stop(uint32_t dv_ind);
+    void stop_all();
+
+    static rsmi_status_t read(const SamplerSnapshot_t& snapshot,
+                              const rsmi_gpu_metrics_field_t* fields,
+                              uint32_t num_fields, uint64_t* values,
+                              rsmi_status_t* field_status,
+                              uint64_t* timestamp_ns);
+
+ private:
+    struct SampledDevice_t {
+      uint32_t m_dv_ind;
+      uint64_t m_field_mask;
+      uint64_t m_interval_us;
+      std::chrono::steady_clock::time_point m_next_due;
+      SamplerSnapshot_t* m_snapshot;
+      std::string m_snapshot_name;  // empty: not process shared
+    };
+
+    void sampler_loop();
+    void sample_device(const SampledDevice_t& sampled_dev);
+    bool release(SamplerSnapshot_t* snapshot);
+
+    std::mutex m_mutex;         // guards m_sampled_devs, m_stop_requested
+    std::mutex m_sample_mutex;  // held while publishing into snapshots
+    std::condition_variable m_cv;
+    bool m_stop_requested;
+    std::map<uint32_t, SampledDevice_t> m_sampled_devs;
+    std::thread m_thread;
+};
+
+}  // namespace smi
+}  // namespace amd
+
+#endif  // INCLUDE_ROCM_SMI_ROCM_SMI_SAMPLER_H_
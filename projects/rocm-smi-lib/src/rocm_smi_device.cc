@@ -66,6 +66,7 @@
 #include "rocm_smi/rocm_smi_exception.h"
 #include "rocm_smi/rocm_smi_utils.h"
 #include "rocm_smi/rocm_smi_logger.h"
+#include "rocm_smi/rocm_smi_sampler.h"
 #include "shared_mutex.h"  // NOLINT
 
 namespace amd {
@@ -613,7 +614,10 @@ static const std::map<const char *, dev_depends_t> kDevFuncDependsMap = {
 
 Device::Device(std::string p, RocmSMI_env_vars const *e) :
             monitor_(nullptr), path_(p), env_(e), evt_notif_anon_fd_(-1),
-                                                   m_gpu_metrics_header{0, 0, 0} {
+                                                   m_gpu_metrics_header{0, 0, 0},
+                                                   m_gpu_metrics_snapshot{},
+                                                   m_gpu_metrics_snapshot_timestamp(0),
+                                                   m_sampler_snapshot(nullptr) {
 #ifndef DEBUG
     env_ = nullptr;
 #endif
@@ -634,9 +638,27 @@ Device::Device(std::string p, RocmSMI_env_vars const *e) :
 }
 
 Device:: ~Device() {
+  sampler_snapshot_unmap(m_sampler_snapshot);
   shared_mutex_close(mutex_);
 }
 
+SamplerSnapshot_t* Device::dev_sampler_snapshot() {
+  std::call_once(m_sampler_snapshot_once, [&]() {
+    m_sampler_snapshot = sampler_snapshot_map(dev_sampler_snapshot_name(),
+                                              (mutex_.shm_fd != -1));
+  });
+  return m_sampler_snapshot;
+}
+
+std::string Device::dev_sampler_snapshot_name() {
+  // Same naming as the device mutex; a thread-only mutex (no shared
+  // memory) means the snapshot stays private to this process too.
+  if (mutex_.shm_fd == -1) {
+    return {};
+  }
+  return "/rocm_smi_sampler_" + path_.substr(path_.rfind('/') + 1);
+}
+
 template <typename T>
 int Device::openDebugFileStream(DevInfoTypes type, T *fs, const char *str) {
   std::string debugfs_path;
@@ -675,10 +697,8 @@ static const std::map<DevInfoTypes, std::string> kDevFallbackFile = {
   {kDevErrCntXGMIWAFL, "ras/aca_xgmi_wafl"},
 };
 
-template <typename T>
-int Device::openSysfsFileStream(DevInfoTypes type, T *fs, const char *str) {
+std::string Device::sysfs_file_path(DevInfoTypes type) const {
   auto sysfs_path = path_;
-  std::ostringstream ss;
 
 #ifdef DEBUG
   if (env_->path_DRM_root_override
@@ -689,6 +709,13 @@ int Device::openSysfsFileStream(DevInfoTypes type, T *fs, const char *str) {
 
   sysfs_path += "/device/";
   sysfs_path += kDevAttribNameMap.at(type);
+  return sysfs_path;
+}
+
+template <typename T>
+int Device::openSysfsFileStream(DevInfoTypes type, T *fs, const char *str) {
+  auto sysfs_path = sysfs_file_path(type);
+  std::ostringstream ss;
 
   DBG_FILE_ERROR(sysfs_path, str);
   bool reg_file;
@@ -42,6 +42,7 @@
 #include <ctime>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <memory>
 #include <optional>
@@ -4278,6 +4279,45 @@ AMGpuMetricsPublicLatestTupl_t Device::dev_copy_internal_to_external_metrics()
   return m_gpu_metrics_ptr->copy_internal_to_external_metrics();
 }
 
+bool Device::dev_get_gpu_metrics_snapshot(uint64_t max_age_us,
+                                          AMGpuMetricsPublicLatest_t& snapshot)
+{
+  const auto now_ns = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch()).count());
+
+  // Saturate, so a very large max. age means "never expires" instead of wrapping around
+  constexpr auto kMaxAgeUsLimit = std::numeric_limits<uint64_t>::max() / 1000;
+  const auto max_age_ns = (max_age_us > kMaxAgeUsLimit) ?
+                              std::numeric_limits<uint64_t>::max() : (max_age_us * 1000);
+
+  std::lock_guard<std::mutex> guard(m_gpu_metrics_snapshot_mutex);
+  if ((m_gpu_metrics_snapshot_timestamp == 0) ||
+      ((now_ns - m_gpu_metrics_snapshot_timestamp) > max_age_ns)) {
+    return false;
+  }
+
+  snapshot = m_gpu_metrics_snapshot;
+  return true;
+}
+
+void Device::dev_set_gpu_metrics_snapshot(const AMGpuMetricsPublicLatest_t& snapshot)
+{
+  const auto now_ns = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch()).count());
+
+  std::lock_guard<std::mutex> guard(m_gpu_metrics_snapshot_mutex);
+  m_gpu_metrics_snapshot = snapshot;
+  m_gpu_metrics_snapshot_timestamp = now_ns;
+}
+
+void Device::dev_reset_gpu_metrics_snapshot()
+{
+  std::lock_guard<std::mutex> guard(m_gpu_metrics_snapshot_mutex);
+  m_gpu_metrics_snapshot_timestamp = 0;
+}
+
 
 rsmi_status_t Device::run_internal_gpu_metrics_query(AMDGpuMetricsUnitType_t metric_counter, AMDGpuDynamicMetricTblValues_t& values)
 {
@@ -4464,6 +4504,147 @@ template
 rsmi_status_t rsmi_dev_gpu_metrics_info_query<GpuMetricU64Tbl_t>
 (uint32_t dv_ind, AMDGpuMetricsUnitType_t metric_counter, GpuMetricU64Tbl_t& metric_value);
 
+
+//  Note: Public metric data members holding their type max were never
+//        assigned (see init_max_public_gpu_matrics()).
+template<typename T>
+AMGpuMetricsFieldValueTupl_t make_gpu_metrics_field_value(T value)
+{
+  if (value == init_max_uint_types<T>()) {
+    return std::make_tuple(rsmi_status_t::RSMI_STATUS_NOT_SUPPORTED,
+                           std::numeric_limits<uint64_t>::max());
+  }
+  return std::make_tuple(rsmi_status_t::RSMI_STATUS_SUCCESS,
+                         static_cast<uint64_t>(value));
+}
+
+AMGpuMetricsFieldValueTupl_t
+get_gpu_metrics_field_value(const AMGpuMetricsPublicLatest_t& metrics,
+                            rsmi_gpu_metrics_field_t field)
+{
+  switch (field) {
+    case RSMI_GPU_METRICS_FIELD_TEMPERATURE_EDGE:
+      return make_gpu_metrics_field_value(metrics.temperature_edge);
+    case RSMI_GPU_METRICS_FIELD_TEMPERATURE_HOTSPOT:
+      return make_gpu_metrics_field_value(metrics.temperature_hotspot);
+    case RSMI_GPU_METRICS_FIELD_TEMPERATURE_MEM:
+      return make_gpu_metrics_field_value(metrics.temperature_mem);
+    case RSMI_GPU_METRICS_FIELD_TEMPERATURE_VRGFX:
+      return make_gpu_metrics_field_value(metrics.temperature_vrgfx);
+    case RSMI_GPU_METRICS_FIELD_TEMPERATURE_VRSOC:
+      return make_gpu_metrics_field_value(metrics.temperature_vrsoc);
+    case RSMI_GPU_METRICS_FIELD_TEMPERATURE_VRMEM:
+      return make_gpu_metrics_field_value(metrics.temperature_vrmem);
+    case RSMI_GPU_METRICS_FIELD_AVERAGE_GFX_ACTIVITY:
+      return make_gpu_metrics_field_value(metrics.average_gfx_activity);
+    case RSMI_GPU_METRICS_FIELD_AVERAGE_UMC_ACTIVITY:
+      return make_gpu_metrics_field_value(metrics.average_umc_activity);
+    case RSMI_GPU_METRICS_FIELD_AVERAGE_MM_ACTIVITY:
+      return make_gpu_metrics_field_value(metrics.average_mm_activity);
+    case RSMI_GPU_METRICS_FIELD_AVERAGE_SOCKET_POWER:
+      return make_gpu_metrics_field_value(metrics.average_socket_power);
+    case RSMI_GPU_METRICS_FIELD_ENERGY_ACCUMULATOR:
+      return make_gpu_metrics_field_value(metrics.energy_accumulator);
+    case RSMI_GPU_METRICS_FIELD_SYSTEM_CLOCK_COUNTER:
+      return make_gpu_metrics_field_value(metrics.system_clock_counter);
+    case RSMI_GPU_METRICS_FIELD_AVERAGE_GFXCLK_FREQUENCY:
+      return make_gpu_metrics_field_value(metrics.average_gfxclk_frequency);
+    case RSMI_GPU_METRICS_FIELD_AVERAGE_SOCCLK_FREQUENCY:
+      return make_gpu_metrics_field_value(metrics.average_socclk_frequency);
+    case RSMI_GPU_METRICS_FIELD_AVERAGE_UCLK_FREQUENCY:
+      return make_gpu_metrics_field_value(metrics.average_uclk_frequency);
+    case RSMI_GPU_METRICS_FIELD_AVERAGE_VCLK0_FREQUENCY:
+      return make_gpu_metrics_field_value(metrics.average_vclk0_frequency);
+    case RSMI_GPU_METRICS_FIELD_AVERAGE_DCLK0_FREQUENCY:
+      return make_gpu_metrics_field_value(metrics.average_dclk0_frequency);
+    case RSMI_GPU_METRICS_FIELD_AVERAGE_VCLK1_FREQUENCY:
+      return make_gpu_metrics_field_value(metrics.average_vclk1_frequency);
+    case RSMI_GPU_METRICS_FIELD_AVERAGE_DCLK1_FREQUENCY:
+      return make_gpu_metrics_field_value(metrics.average_dclk1_frequency);
+    case RSMI_GPU_METRICS_FIELD_CURRENT_GFXCLK:
+      return make_gpu_metrics_field_value(metrics.current_gfxclk);
+    case RSMI_GPU_METRICS_FIELD_CURRENT_SOCCLK:
+      return make_gpu_metrics_field_value(metrics.current_socclk);
+    case RSMI_GPU_METRICS_FIELD_CURRENT_UCLK:
+      return make_gpu_metrics_field_value(metrics.current_uclk);
+    case RSMI_GPU_METRICS_FIELD_CURRENT_VCLK0:
+      return make_gpu_metrics_field_value(metrics.current_vclk0);
+    case RSMI_GPU_METRICS_FIELD_CURRENT_DCLK0:
+      return make_gpu_metrics_field_value(metrics.current_dclk0);
+    case RSMI_GPU_METRICS_FIELD_CURRENT_VCLK1:
+      return make_gpu_metrics_field_value(metrics.current_vclk1);
+    case RSMI_GPU_METRICS_FIELD_CURRENT_DCLK1:
+      return make_gpu_metrics_field_value(metrics.current_dclk1);
+    case RSMI_GPU_METRICS_FIELD_THROTTLE_STATUS:
+      return make_gpu_metrics_field_value(metrics.throttle_status);
+    case RSMI_GPU_METRICS_FIELD_CURRENT_FAN_SPEED:
+      return make_gpu_metrics_field_value(metrics.current_fan_speed);
+    case RSMI_GPU_METRICS_FIELD_PCIE_LINK_WIDTH:
+      return make_gpu_metrics_field_value(metrics.pcie_link_width);
+    case RSMI_GPU_METRICS_FIELD_PCIE_LINK_SPEED:
+      return make_gpu_metrics_field_value(metrics.pcie_link_speed);
+    case RSMI_GPU_METRICS_FIELD_GFX_ACTIVITY_ACC:
+      return make_gpu_metrics_field_value(metrics.gfx_activity_acc);
+    case RSMI_GPU_METRICS_FIELD_MEM_ACTIVITY_ACC:
+      return make_gpu_metrics_field_value(metrics.mem_activity_acc);
+    case RSMI_GPU_METRICS_FIELD_FIRMWARE_TIMESTAMP:
+      return make_gpu_metrics_field_value(metrics.firmware_timestamp);
+    case RSMI_GPU_METRICS_FIELD_VOLTAGE_SOC:
+      return make_gpu_metrics_field_value(metrics.voltage_soc);
+    case RSMI_GPU_METRICS_FIELD_VOLTAGE_GFX:
+      return make_gpu_metrics_field_value(metrics.voltage_gfx);
+    case RSMI_GPU_METRICS_FIELD_VOLTAGE_MEM:
+      return make_gpu_metrics_field_value(metrics.voltage_mem);
+    case RSMI_GPU_METRICS_FIELD_INDEP_THROTTLE_STATUS:
+      return make_gpu_metrics_field_value(metrics.indep_throttle_status);
+    case RSMI_GPU_METRICS_FIELD_CURRENT_SOCKET_POWER:
+      return make_gpu_metrics_field_value(metrics.current_socket_power);
+    case RSMI_GPU_METRICS_FIELD_GFXCLK_LOCK_STATUS:
+      return make_gpu_metrics_field_value(metrics.gfxclk_lock_status);
+    case RSMI_GPU_METRICS_FIELD_XGMI_LINK_WIDTH:
+      return make_gpu_metrics_field_value(metrics.xgmi_link_width);
+    case RSMI_GPU_METRICS_FIELD_XGMI_LINK_SPEED:
+      return make_gpu_metrics_field_value(metrics.xgmi_link_speed);
+    case RSMI_GPU_METRICS_FIELD_PCIE_BANDWIDTH_ACC:
+      return make_gpu_metrics_field_value(metrics.pcie_bandwidth_acc);
+    case RSMI_GPU_METRICS_FIELD_PCIE_BANDWIDTH_INST:
+      return make_gpu_metrics_field_value(metrics.pcie_bandwidth_inst);
+    case RSMI_GPU_METRICS_FIELD_PCIE_L0_TO_RECOV_COUNT_ACC:
+      return make_gpu_metrics_field_value(metrics.pcie_l0_to_recov_count_acc);
+    case RSMI_GPU_METRICS_FIELD_PCIE_REPLAY_COUNT_ACC:
+      return make_gpu_metrics_field_value(metrics.pcie_replay_count_acc);
+    case RSMI_GPU_METRICS_FIELD_PCIE_REPLAY_ROVER_COUNT_ACC:
+      return make_gpu_metrics_field_value(metrics.pcie_replay_rover_count_acc);
+    case RSMI_GPU_METRICS_FIELD_PCIE_NAK_SENT_COUNT_ACC:
+      return make_gpu_metrics_field_value(metrics.pcie_nak_sent_count_acc);
+    case RSMI_GPU_METRICS_FIELD_PCIE_NAK_RCVD_COUNT_ACC:
+      return make_gpu_metrics_field_value(metrics.pcie_nak_rcvd_count_acc);
+    case RSMI_GPU_METRICS_FIELD_ACCUMULATION_COUNTER:
+      return make_gpu_metrics_field_value(metrics.accumulation_counter);
+    case RSMI_GPU_METRICS_FIELD_PROCHOT_RESIDENCY_ACC:
+      return make_gpu_metrics_field_value(metrics.prochot_residency_acc);
+    case RSMI_GPU_METRICS_FIELD_PPT_RESIDENCY_ACC:
+      return make_gpu_metrics_field_value(metrics.ppt_residency_acc);
+    case RSMI_GPU_METRICS_FIELD_SOCKET_THM_RESIDENCY_ACC:
+      return make_gpu_metrics_field_value(metrics.socket_thm_residency_acc);
+    case RSMI_GPU_METRICS_FIELD_VR_THM_RESIDENCY_ACC:
+      return make_gpu_metrics_field_value(metrics.vr_thm_residency_acc);
+    case RSMI_GPU_METRICS_FIELD_HBM_THM_RESIDENCY_ACC:
+      return make_gpu_metrics_field_value(metrics.hbm_thm_residency_acc);
+    case RSMI_GPU_METRICS_FIELD_NUM_PARTITION:
+      return make_gpu_metrics_field_value(metrics.num_partition);
+    case RSMI_GPU_METRICS_FIELD_PCIE_LC_PERF_OTHER_END_RECOVERY:
+      return make_gpu_metrics_field_value(metrics.pcie_lc_perf_other_end_recovery);
+    case RSMI_GPU_METRICS_FIELD_VRAM_MAX_BANDWIDTH:
+      return make_gpu_metrics_field_value(metrics.vram_max_bandwidth);
+    default:
+      break;
+  }
+
+  return std::make_tuple(rsmi_status_t::RSMI_STATUS_INVALID_ARGS,
+                         std::numeric_limits<uint64_t>::max());
+}
+
 } //namespace amd::smi
 
 rsmi_status_t
@@ -4505,7 +4686,6 @@ rsmi_dev_gpu_metrics_header_info_get(uint32_t dv_ind, metrics_table_header_t& he
 rsmi_status_t
 rsmi_dev_gpu_metrics_info_get(uint32_t dv_ind, rsmi_gpu_metrics_t* smu) {
   TRY
-  DEVICE_MUTEX
   CHK_SUPPORT_NAME_ONLY(smu)
 
   auto status_code(rsmi_status_t::RSMI_STATUS_SUCCESS);
@@ -4529,6 +4709,23 @@ rsmi_dev_gpu_metrics_info_get(uint32_t dv_ind, rsmi_gpu_metrics_t* smu) {
     return status_code;
   }
 
+  //  A recent enough snapshot doesn't need the gpu_metrics file, nor the
+  //  device mutex.
+  const auto max_age_us = smi.gpu_metrics_max_age_us();
+  if ((max_age_us > 0) && dev->dev_get_gpu_metrics_snapshot(max_age_us, *smu)) {
+    ss << __PRETTY_FUNCTION__
+       << " | ======= end ======= "
+       << " | Success (snapshot) "
+       << " | Device #: " << dv_ind
+       << " | Max. Age (us): " << max_age_us
+       << " | Returning = "
+       << getRSMIStatusString(status_code)
+       << " |";
+    LOG_TRACE(ss);
+    return status_code;
+  }
+
+  DEVICE_MUTEX
   dev->set_smi_device_id(dv_ind);
   uint32_t partition_id = 0;
   auto ret = rsmi_dev_partition_id_get(dv_ind, &partition_id);
@@ -4539,9 +4736,7 @@ rsmi_dev_gpu_metrics_info_get(uint32_t dv_ind, rsmi_gpu_metrics_t* smu) {
   }
 
   // check if file exists, report not supported if it does not exist
-  std::string file_name = "/sys/class/drm/card"
-                          + std::to_string(dev->index())
-                          + "/device/gpu_metrics";
+  const auto file_name = dev->sysfs_file_path(amd::smi::kDevGpuMetrics);
   if (access(file_name.c_str(), F_OK | R_OK) != 0) {
     status_code = RSMI_STATUS_NOT_SUPPORTED;
     ss << __PRETTY_FUNCTION__
@@ -4570,6 +4765,9 @@ rsmi_dev_gpu_metrics_info_get(uint32_t dv_ind, rsmi_gpu_metrics_t* smu) {
   }
 
   *smu = external_metrics;
+  if (max_age_us > 0) {
+    dev->dev_set_gpu_metrics_snapshot(external_metrics);
+  }
   ss << __PRETTY_FUNCTION__
       << " | ======= end ======= "
       << " | Success "
@@ -4583,3 +4781,121 @@ rsmi_dev_gpu_metrics_info_get(uint32_t dv_ind, rsmi_gpu_metrics_t* smu) {
   CATCH
 }
 
+rsmi_status_t
+rsmi_gpu_metrics_cache_max_age_set(uint64_t max_age_us) {
+  TRY
+  std::ostringstream ss;
+  ss << __PRETTY_FUNCTION__
+     << " | ======= start ======= "
+     << " | Max. Age (us): " << max_age_us
+     << " |";
+  LOG_TRACE(ss);
+
+  amd::smi::RocmSMI::getInstance().set_gpu_metrics_max_age_us(max_age_us);
+  return rsmi_status_t::RSMI_STATUS_SUCCESS;
+  CATCH
+}
+
+rsmi_status_t
+rsmi_gpu_metrics_cache_max_age_get(uint64_t* max_age_us) {
+  TRY
+  if (max_age_us == nullptr) {
+    return rsmi_status_t::RSMI_STATUS_INVALID_ARGS;
+  }
+
+  *max_age_us = amd::smi::RocmSMI::getInstance().gpu_metrics_max_age_us();
+  return rsmi_status_t::RSMI_STATUS_SUCCESS;
+  CATCH
+}
+
+rsmi_status_t
+rsmi_dev_gpu_metrics_fields_get(const uint32_t* dv_inds, uint32_t num_devices,
+                                const rsmi_gpu_metrics_field_t* fields,
+                                uint32_t num_fields, uint64_t* values,
+                                rsmi_status_t* field_status) {
+  TRY
+  std::ostringstream ss;
+  auto status_code(rsmi_status_t::RSMI_STATUS_SUCCESS);
+  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
+  LOG_TRACE(ss);
+
+  if ((dv_inds == nullptr) || (fields == nullptr) || (values == nullptr) ||
+      (field_status == nullptr) || (num_devices == 0) || (num_fields == 0)) {
+    status_code = rsmi_status_t::RSMI_STATUS_INVALID_ARGS;
+    ss << __PRETTY_FUNCTION__
+       << " | ======= end ======= "
+       << " | Fail "
+       << " | Cause: null array or empty request"
+       << " | Returning = "
+       << getRSMIStatusString(status_code)
+       << " |";
+    LOG_ERROR(ss);
+    return status_code;
+  }
+
+  amd::smi::RocmSMI& smi = amd::smi::RocmSMI::getInstance();
+  for (uint32_t dev_idx = 0; dev_idx < num_devices; ++dev_idx) {
+    if (dv_inds[dev_idx] >= smi.devices().size()) {
+      status_code = rsmi_status_t::RSMI_STATUS_INVALID_ARGS;
+      ss << __PRETTY_FUNCTION__
+         << " | ======= end ======= "
+         << " | Fail "
+         << " | Device #: " << dv_inds[dev_idx]
+         << " | Cause: device index out of range"
+         << " | Returning = "
+         << getRSMIStatusString(status_code)
+         << " |";
+      LOG_ERROR(ss);
+      return status_code;
+    }
+  }
+  for (uint32_t field_idx = 0; field_idx < num_fields; ++field_idx) {
+    if ((fields[field_idx] < RSMI_GPU_METRICS_FIELD_FIRST) ||
+        (fields[field_idx] > RSMI_GPU_METRICS_FIELD_LAST)) {
+      status_code = rsmi_status_t::RSMI_STATUS_INVALID_ARGS;
+      ss << __PRETTY_FUNCTION__
+         << " | ======= end ======= "
+         << " | Fail "
+         << " | Field: " << static_cast<uint32_t>(fields[field_idx])
+         << " | Cause: unknown gpu metrics field"
+         << " | Returning = "
+         << getRSMIStatusString(status_code)
+         << " |";
+      LOG_ERROR(ss);
+      return status_code;
+    }
+  }
+
+  //  One gpu_metrics read (or snapshot hit) per device serves all the fields.
+  rsmi_gpu_metrics_t gpu_metrics{};
+  for (uint32_t dev_idx = 0; dev_idx < num_devices; ++dev_idx) {
+    const auto read_status = rsmi_dev_gpu_metrics_info_get(dv_inds[dev_idx],
+                                                           &gpu_metrics);
+    for (uint32_t field_idx = 0; field_idx < num_fields; ++field_idx) {
+      const auto entry = (static_cast<std::size_t>(dev_idx) * num_fields) + field_idx;
+      if (read_status != rsmi_status_t::RSMI_STATUS_SUCCESS) {
+        values[entry] = std::numeric_limits<uint64_t>::max();
+        field_status[entry] = read_status;
+        continue;
+      }
+
+      const auto [field_code, field_value] =
+          amd::smi::get_gpu_metrics_field_value(gpu_metrics, fields[field_idx]);
+      values[entry] = field_value;
+      field_status[entry] = field_code;
+    }
+  }
+
+  ss << __PRETTY_FUNCTION__
+     << " | ======= end ======= "
+     << " | Success "
+     << " | Devices: " << num_devices
+     << " | Fields: " << num_fields
+     << " | Returning = "
+     << getRSMIStatusString(status_code)
+     << " |";
+  LOG_TRACE(ss);
+  return status_code;
+  CATCH
+}
+
@@ -426,6 +426,11 @@ RocmSMI::Initialize(uint64_t flags) {
 
 void
 RocmSMI::Cleanup() {
+  {
+    // The sampler thread reads through devices_; stop it first.
+    std::lock_guard<std::mutex> guard(sampler_mutex_);
+    sampler_.reset();
+  }
   devices_.clear();
   monitors_.clear();
 
@@ -439,7 +444,8 @@ RocmSMI::Cleanup() {
 }
 
 RocmSMI::RocmSMI(uint64_t flags) : init_options_(flags),
-                          kfd_notif_evt_fh_(-1), kfd_notif_evt_fh_refcnt_(0) {
+                          kfd_notif_evt_fh_(-1), kfd_notif_evt_fh_refcnt_(0),
+                          gpu_metrics_max_age_us_(0) {
 }
 
 RocmSMI::~RocmSMI() = default;
@@ -546,6 +552,21 @@ uint32_t RocmSMI::getLogSetting() {
   return this->env_vars_.logging_on;
 }
 
+Sampler* RocmSMI::sampler(void) {
+  std::lock_guard<std::mutex> guard(sampler_mutex_);
+  if (!sampler_) {
+    sampler_ = std::make_unique<Sampler>();
+  }
+  return sampler_.get();
+}
+
+void RocmSMI::set_gpu_metrics_max_age_us(uint64_t max_age_us) {
+  gpu_metrics_max_age_us_.store(max_age_us, std::memory_order_relaxed);
+  for (auto& dev : devices_) {
+    dev->dev_reset_gpu_metrics_snapshot();
+  }
+}
+
 void RocmSMI::debugRSMIEnvVarInfo(void) {
   std::cout << __PRETTY_FUNCTION__
             << RocmSMI::getInstance().getRSMIEnvVarInfo();
@@ -0,0 +1,470 @@
+/*
+ * =============================================================================
+ * The University of Illinois/NCSA
+ * Open Source License (NCSA)
+ *
+ * Copyright (c) 2025, Advanced Micro Devices, Inc.
+ * All rights reserved.
+ *
+ * Developed by:
+ *
+ *                 AMD Research and AMD ROC Software Development
+ *
+ *                 Advanced Micro Devices, Inc.
+ *
+ *                 www.amd.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal with the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimers.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimers in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the names of <Name of Development Group, Name of Institution>,
+ *    nor the names of its contributors may be used to endorse or promote
+ *    products derived from this Software without specific prior written
+ *    permission.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS WITH THE SOFTWARE.
+ *
+ */
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#include "rocm_smi/rocm_smi_common.h"  // Should go before rocm_smi.h
+#include "rocm_smi/rocm_smi.h"
+#include "rocm_smi/rocm_smi_main.h"
+#include "rocm_smi/rocm_smi_device.h"
+#include "rocm_smi/rocm_smi_gpu_metrics.h"
+#include "rocm_smi/rocm_smi_sampler.h"
+#include "rocm_smi/rocm_smi_utils.h"
+#include "rocm_smi/rocm_smi_exception.h"
+#include "rocm_smi/rocm_smi_logger.h"
+
+#define TRY try {
+#define CATCH } catch (...) {return amd::smi::handleException();}
+
+namespace amd {
+namespace smi {
+
+//  A writer only holds the sequence odd for the time it takes to store
+//  kSamplerNumFields values; readers give up after this many attempts.
+static const uint32_t kSamplerMaxReadRetries = 1024;
+
+static uint64_t sampler_now_ns() {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+static bool is_process_alive(int64_t pid) {
+  if (kill(static_cast<pid_t>(pid), 0) == 0) {
+    return true;
+  }
+  return (errno != ESRCH);
+}
+
+SamplerSnapshot_t* sampler_snapshot_map(const std::string& name,
+                                        bool process_shared) {
+  std::ostringstream ss;
+  void* addr = MAP_FAILED;
+
+  if (process_shared) {
+    // Only processes of the same user may publish or read samples.
+    const mode_t mode = 0600;
+    int shm_fd = shm_open(name.c_str(), O_RDWR | O_CREAT, mode);
+    if (shm_fd == -1) {
+      ss << __PRETTY_FUNCTION__ << " | shm_open(" << name << ") failed: "
+         << std::strerror(errno);
+      LOG_ERROR(ss);
+      return nullptr;
+    }
+
+    // Only ever grow the segment; a new segment is zero filled, which reads
+    // as "no sample published yet".
+    struct stat shm_stat{};
+    if ((fstat(shm_fd, &shm_stat) != 0) ||
+        ((static_cast<std::size_t>(shm_stat.st_size) < sizeof(SamplerSnapshot_t)) &&
+         (ftruncate(shm_fd, sizeof(SamplerSnapshot_t)) != 0))) {
+      ss << __PRETTY_FUNCTION__ << " | sizing " << name << " failed: "
+         << std::strerror(errno);
+      LOG_ERROR(ss);
+      close(shm_fd);
+      return nullptr;
+    }
+
+    addr = mmap(nullptr, sizeof(SamplerSnapshot_t), PROT_READ | PROT_WRITE,
+                MAP_SHARED, shm_fd, 0);
+    close(shm_fd);
+  } else {
+    addr = mmap(nullptr, sizeof(SamplerSnapshot_t), PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  }
+
+  if (addr == MAP_FAILED) {
+    ss << __PRETTY_FUNCTION__ << " | mmap(" << name << ") failed: "
+       << std::strerror(errno);
+    LOG_ERROR(ss);
+    return nullptr;
+  }
+  return reinterpret_cast<SamplerSnapshot_t*>(addr);
+}
+
+void sampler_snapshot_unmap(SamplerSnapshot_t* snapshot) {
+  if (snapshot != nullptr) {
+    (void)munmap(snapshot, sizeof(SamplerSnapshot_t));
+  }
+}
+
+void sampler_snapshot_unlink(const std::string& name) {
+  if (!name.empty()) {
+    (void)shm_unlink(name.c_str());
+  }
+}
+
+Sampler::Sampler() : m_stop_requested(false) {
+}
+
+Sampler::~Sampler() {
+  stop_all();
+}
+
+rsmi_status_t Sampler::start(uint32_t dv_ind, uint64_t field_mask,
+                             uint64_t interval_us) {
+  std::ostringstream ss;
+  RocmSMI& smi = RocmSMI::getInstance();
+  auto& dev = smi.devices()[dv_ind];
+  auto snapshot = dev->dev_sampler_snapshot();
+  if (snapshot == nullptr) {
+    return RSMI_STATUS_OUT_OF_RESOURCES;
+  }
+
+  std::lock_guard<std::mutex> sample_guard(m_sample_mutex);
+
+  // Only one process may publish into a device snapshot. Take over the
+  // snapshot of a process that went away without releasing it.
+  const int64_t my_pid = getpid();
+  auto owner_pid = snapshot->m_owner_pid.load(std::memory_order_acquire);
+  if (owner_pid != my_pid) {
+    if ((owner_pid != 0) && is_process_alive(owner_pid)) {
+      ss << __PRETTY_FUNCTION__ << " | Device #: " << dv_ind
+         << " | already sampled by pid " << owner_pid;
+      LOG_INFO(ss);
+      return RSMI_STATUS_BUSY;
+    }
+    if (!snapshot->m_owner_pid.compare_exchange_strong(owner_pid, my_pid,
+                                                   std::memory_order_acq_rel)) {
+      return RSMI_STATUS_BUSY;
+    }
+  }
+
+  // A previous owner may have died in the middle of a publication.
+  auto sequence = snapshot->m_sequence.load(std::memory_order_relaxed);
+  sequence |= 1;
+  snapshot->m_sequence.store(sequence, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  snapshot->m_interval_us.store(interval_us, std::memory_order_relaxed);
+  snapshot->m_field_mask.store(field_mask, std::memory_order_relaxed);
+  snapshot->m_timestamp_ns.store(0, std::memory_order_relaxed);
+  snapshot->m_magic.store(kSamplerSnapshotMagic, std::memory_order_relaxed);
+  snapshot->m_sequence.store(sequence + 1, std::memory_order_release);
+
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_sampled_devs[dv_ind] = SampledDevice_t{dv_ind, field_mask, interval_us,
+                                             std::chrono::steady_clock::now(),
+                                             snapshot,
+                                             dev->dev_sampler_snapshot_name()};
+    if (!m_thread.joinable()) {
+      m_stop_requested = false;
+      m_thread = std::thread(&Sampler::sampler_loop, this);
+    }
+  }
+  m_cv.notify_one();
+
+  ss << __PRETTY_FUNCTION__ << " | Device #: " << dv_ind
+     << " | Field Mask: " << print_unsigned_hex_and_int(field_mask)
+     << " | Interval (us): " << interval_us;
+  LOG_INFO(ss);
+  return RSMI_STATUS_SUCCESS;
+}
+
+rsmi_status_t Sampler::stop(uint32_t dv_ind) {
+  SamplerSnapshot_t* snapshot = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    auto sampled_dev = m_sampled_devs.find(dv_ind);
+    if (sampled_dev == m_sampled_devs.end()) {
+      return RSMI_STATUS_NOT_FOUND;
+    }
+    snapshot = sampled_dev->second.m_snapshot;
+    m_sampled_devs.erase(sampled_dev);
+  }
+
+  // Wait for an in-flight sampling pass before giving the snapshot away.
+  std::lock_guard<std::mutex> sample_guard(m_sample_mutex);
+  release(snapshot);
+  return RSMI_STATUS_SUCCESS;
+}
+
+void Sampler::stop_all() {
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_stop_requested = true;
+  }
+  m_cv.notify_one();
+  if (m_thread.joinable()) {
+    m_thread.join();
+  }
+
+  // On shutdown the segments this process published into are removed too.
+  // Processes which still map them read RSMI_STATUS_NO_DATA from then on.
+  std::lock_guard<std::mutex> guard(m_mutex);
+  for (auto& [dv_ind, sampled_dev] : m_sampled_devs) {
+    if (release(sampled_dev.m_snapshot)) {
+      sampler_snapshot_unlink(sampled_dev.m_snapshot_name);
+    }
+  }
+  m_sampled_devs.clear();
+}
+
+bool Sampler::release(SamplerSnapshot_t* snapshot) {
+  int64_t my_pid = getpid();
+  return snapshot->m_owner_pid.compare_exchange_strong(my_pid, 0,
+                                                   std::memory_order_acq_rel);
+}
+
+void Sampler::sampler_loop() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (!m_stop_requested) {
+    if (m_sampled_devs.empty()) {
+      m_cv.wait(lock);
+      continue;
+    }
+
+    auto next_due = std::chrono::steady_clock::time_point::max();
+    for (const auto& [dv_ind, sampled_dev] : m_sampled_devs) {
+      next_due = std::min(next_due, sampled_dev.m_next_due);
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (now < next_due) {
+      m_cv.wait_until(lock, next_due);
+      continue;
+    }
+
+    std::vector<SampledDevice_t> due_devs;
+    for (auto& [dv_ind, sampled_dev] : m_sampled_devs) {
+      if (sampled_dev.m_next_due <= now) {
+        due_devs.push_back(sampled_dev);
+        sampled_dev.m_next_due =
+            now + std::chrono::microseconds(sampled_dev.m_interval_us);
+      }
+    }
+
+    // Sysfs reads happen without m_mutex, so the schedule can be changed
+    // while a slow gpu_metrics read is in progress.
+    lock.unlock();
+    {
+      std::lock_guard<std::mutex> sample_guard(m_sample_mutex);
+      for (const auto& sampled_dev : due_devs) {
+        sample_device(sampled_dev);
+      }
+    }
+    lock.lock();
+  }
+}
+
+void Sampler::sample_device(const SampledDevice_t& sampled_dev) {
+  auto snapshot = sampled_dev.m_snapshot;
+  if (snapshot->m_owner_pid.load(std::memory_order_acquire) != getpid()) {
+    return;
+  }
+
+  // Decode everything first; the sequence is odd only while storing.
+  rsmi_gpu_metrics_t gpu_metrics{};
+  const auto read_status = rsmi_dev_gpu_metrics_info_get(sampled_dev.m_dv_ind,
+                                                         &gpu_metrics);
+  uint64_t values[kSamplerNumFields];
+  rsmi_status_t status[kSamplerNumFields];
+  for (uint32_t field = 0; field < kSamplerNumFields; ++field) {
+    if (!(sampled_dev.m_field_mask & (1ULL << field))) {
+      continue;
+    }
+    if (read_status != RSMI_STATUS_SUCCESS) {
+      values[field] = std::numeric_limits<uint64_t>::max();
+      status[field] = read_status;
+      continue;
+    }
+    std::tie(status[field], values[field]) = get_gpu_metrics_field_value(
+        gpu_metrics, static_cast<rsmi_gpu_metrics_field_t>(field));
+  }
+
+  const auto sequence = snapshot->m_sequence.load(std::memory_order_relaxed);
+  snapshot->m_sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (uint32_t field = 0; field < kSamplerNumFields; ++field) {
+    if (sampled_dev.m_field_mask & (1ULL << field)) {
+      snapshot->m_values[field].store(values[field], std::memory_order_relaxed);
+      snapshot->m_status[field].store(static_cast<int32_t>(status[field]),
+                                      std::memory_order_relaxed);
+    }
+  }
+  snapshot->m_timestamp_ns.store(sampler_now_ns(), std::memory_order_relaxed);
+  snapshot->m_sequence.store(sequence + 2, std::memory_order_release);
+}
+
+rsmi_status_t Sampler::read(const SamplerSnapshot_t& snapshot,
+                            const rsmi_gpu_metrics_field_t* fields,
+                            uint32_t num_fields, uint64_t* values,
+                            rsmi_status_t* field_status,
+                            uint64_t* timestamp_ns) {
+  if (snapshot.m_magic.load(std::memory_order_acquire) != kSamplerSnapshotMagic) {
+    return RSMI_STATUS_NO_DATA;
+  }
+
+  for (uint32_t attempt = 0; attempt < kSamplerMaxReadRetries; ++attempt) {
+    const auto sequence_begin = snapshot.m_sequence.load(std::memory_order_acquire);
+    if (sequence_begin & 1) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    const auto owner_pid = snapshot.m_owner_pid.load(std::memory_order_relaxed);
+    const auto field_mask = snapshot.m_field_mask.load(std::memory_order_relaxed);
+    const auto timestamp = snapshot.m_timestamp_ns.load(std::memory_order_relaxed);
+    for (uint32_t idx = 0; idx < num_fields; ++idx) {
+      const auto field = static_cast<uint32_t>(fields[idx]);
+      if (!(field_mask & (1ULL << field))) {
+        values[idx] = std::numeric_limits<uint64_t>::max();
+        field_status[idx] = RSMI_STATUS_NO_DATA;
+        continue;
+      }
+      values[idx] = snapshot.m_values[field].load(std::memory_order_relaxed);
+      field_status[idx] = static_cast<rsmi_status_t>(
+          snapshot.m_status[field].load(std::memory_order_relaxed));
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (snapshot.m_sequence.load(std::memory_order_relaxed) != sequence_begin) {
+      continue;
+    }
+
+    // A sampler which died without releasing the snapshot left its last
+    // sample behind; it is not refreshed anymore.
+    if ((owner_pid == 0) || (timestamp == 0) ||
+        ((owner_pid != getpid()) && !is_process_alive(owner_pid))) {
+      return RSMI_STATUS_NO_DATA;
+    }
+    if (timestamp_ns != nullptr) {
+      *timestamp_ns = timestamp;
+    }
+    return RSMI_STATUS_SUCCESS;
+  }
+
+  return RSMI_STATUS_BUSY;
+}
+
+}  // namespace smi
+}  // namespace amd
+
+
+static rsmi_status_t
+sampler_field_mask_get(const rsmi_gpu_metrics_field_t* fields,
+                       uint32_t num_fields, uint64_t* field_mask) {
+  if ((fields == nullptr) || (num_fields == 0)) {
+    return RSMI_STATUS_INVALID_ARGS;
+  }
+
+  *field_mask = 0;
+  for (uint32_t idx = 0; idx < num_fields; ++idx) {
+    if ((fields[idx] < RSMI_GPU_METRICS_FIELD_FIRST) ||
+        (fields[idx] > RSMI_GPU_METRICS_FIELD_LAST)) {
+      return RSMI_STATUS_INVALID_ARGS;
+    }
+    *field_mask |= (1ULL << static_cast<uint32_t>(fields[idx]));
+  }
+  return RSMI_STATUS_SUCCESS;
+}
+
+rsmi_status_t
+rsmi_dev_sampler_start(uint32_t dv_ind, const rsmi_gpu_metrics_field_t* fields,
+                       uint32_t num_fields, uint64_t interval_us) {
+  TRY
+  GET_DEV_FROM_INDX
+  std::ostringstream ss;
+  ss << __PRETTY_FUNCTION__ << " | ======= start ======= "
+     << " | Device #: " << dv_ind;
+  LOG_TRACE(ss);
+
+  uint64_t field_mask = 0;
+  auto status_code = sampler_field_mask_get(fields, num_fields, &field_mask);
+  if (status_code != RSMI_STATUS_SUCCESS) {
+    return status_code;
+  }
+  if (interval_us == 0) {
+    return RSMI_STATUS_INVALID_ARGS;
+  }
+
+  return smi.sampler()->start(dv_ind, field_mask, interval_us);
+  CATCH
+}
+
+rsmi_status_t
+rsmi_dev_sampler_stop(uint32_t dv_ind) {
+  TRY
+  CHECK_DV_IND_RANGE
+  std::ostringstream ss;
+  ss << __PRETTY_FUNCTION__ << " | ======= start ======= "
+     << " | Device #: " << dv_ind;
+  LOG_TRACE(ss);
+
+  return smi.sampler()->stop(dv_ind);
+  CATCH
+}
+
+rsmi_status_t
+rsmi_dev_sampler_fields_get(uint32_t dv_ind,
+                            const rsmi_gpu_metrics_field_t* fields,
+                            uint32_t num_fields, uint64_t* values,
+                            rsmi_status_t* field_status,
+                            uint64_t* timestamp_ns) {
+  TRY
+  GET_DEV_FROM_INDX
+
+  uint64_t field_mask = 0;
+  auto status_code = sampler_field_mask_get(fields, num_fields, &field_mask);
+  if ((status_code != RSMI_STATUS_SUCCESS) || (values == nullptr) ||
+      (field_status == nullptr)) {
+    return RSMI_STATUS_INVALID_ARGS;
+  }
+
+  auto snapshot = dev->dev_sampler_snapshot();
+  if (snapshot == nullptr) {
+    return RSMI_STATUS_NO_DATA;
+  }
+  return amd::smi::Sampler::read(*snapshot, fields, num_fields, values,
+                                 field_status, timestamp_ns);
+  CATCH
+}
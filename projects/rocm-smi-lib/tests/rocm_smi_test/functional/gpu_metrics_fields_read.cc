@@ -0,0 +1,235 @@
+/*
+ * =============================================================================
+ *   ROC Runtime Conformance Release License
+ * =============================================================================
+ * The University of Illinois/NCSA
+ * Open Source License (NCSA)
+ *
+ * Copyright (c) 2025, Advanced Micro Devices, Inc.
+ * All rights reserved.
+ *
+ * Developed by:
+ *
+ *                 AMD Research and AMD ROC Software Development
+ *
+ *                 Advanced Micro Devices, Inc.
+ *
+ *                 www.amd.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal with the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimers.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimers in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the names of <Name of Development Group, Name of Institution>,
+ *    nor the names of its contributors may be used to endorse or promote
+ *    products derived from this Software without specific prior written
+ *    permission.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS WITH THE SOFTWARE.
+ *
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "rocm_smi/rocm_smi.h"
+#include "rocm_smi_test/functional/gpu_metrics_fields_read.h"
+#include "rocm_smi_test/test_common.h"
+
+
+TestGpuMetricsFieldsRead::TestGpuMetricsFieldsRead() : TestBase() {
+  set_title("RSMI GPU Metrics Fields Read Test");
+  set_description("The GPU Metrics Fields tests verify that multiple gpu "
+                  "metrics fields can be read for multiple devices at once, "
+                  "and that they match the gpu metrics snapshot.");
+}
+
+TestGpuMetricsFieldsRead::~TestGpuMetricsFieldsRead(void) {
+}
+
+void TestGpuMetricsFieldsRead::SetUp(void) {
+  TestBase::SetUp();
+
+  return;
+}
+
+void TestGpuMetricsFieldsRead::DisplayTestInfo(void) {
+  TestBase::DisplayTestInfo();
+}
+
+void TestGpuMetricsFieldsRead::DisplayResults(void) const {
+  TestBase::DisplayResults();
+  return;
+}
+
+void TestGpuMetricsFieldsRead::Close() {
+  // This will close handles opened within rsmitst utility calls and call
+  // rsmi_shut_down(), so it should be done after other hsa cleanup
+  TestBase::Close();
+}
+
+
+void TestGpuMetricsFieldsRead::Run(void) {
+  rsmi_status_t err;
+
+  TestBase::Run();
+  if (setup_failed_) {
+    std::cout << "** SetUp Failed for this test. Skipping.**" << std::endl;
+    return;
+  }
+
+  // A long max. age guarantees all reads below are served by one snapshot.
+  const uint64_t kMaxAgeUs = 60 * 1000 * 1000;
+  uint64_t orig_max_age_us = 0;
+  err = rsmi_gpu_metrics_cache_max_age_get(&orig_max_age_us);
+  CHK_ERR_ASRT(err);
+  err = rsmi_gpu_metrics_cache_max_age_set(kMaxAgeUs);
+  CHK_ERR_ASRT(err);
+  uint64_t max_age_us = 0;
+  err = rsmi_gpu_metrics_cache_max_age_get(&max_age_us);
+  CHK_ERR_ASRT(err);
+  ASSERT_EQ(max_age_us, kMaxAgeUs);
+
+  std::vector<uint32_t> dv_inds;
+  for (uint32_t i = 0; i < num_monitor_devs(); ++i) {
+    dv_inds.push_back(i);
+  }
+
+  std::vector<rsmi_gpu_metrics_field_t> fields;
+  for (uint32_t f = RSMI_GPU_METRICS_FIELD_FIRST;
+       f <= RSMI_GPU_METRICS_FIELD_LAST; ++f) {
+    fields.push_back(static_cast<rsmi_gpu_metrics_field_t>(f));
+  }
+
+  const auto num_devices = static_cast<uint32_t>(dv_inds.size());
+  const auto num_fields = static_cast<uint32_t>(fields.size());
+  std::vector<uint64_t> values(dv_inds.size() * fields.size());
+  std::vector<rsmi_status_t> field_status(values.size());
+
+  if (num_devices > 0) {
+    err = rsmi_dev_gpu_metrics_fields_get(dv_inds.data(), num_devices,
+                                          fields.data(), num_fields,
+                                          values.data(), field_status.data());
+    CHK_ERR_ASRT(err);
+  }
+
+  for (uint32_t d = 0; d < num_devices; ++d) {
+    PrintDeviceHeader(dv_inds[d]);
+
+    rsmi_gpu_metrics_t smu = {};
+    err = rsmi_dev_gpu_metrics_info_get(dv_inds[d], &smu);
+    if (err == RSMI_STATUS_NOT_SUPPORTED) {
+      IF_VERB(STANDARD) {
+        std::cout << "\t**" << "Not supported on this machine" << std::endl;
+      }
+      for (uint32_t f = 0; f < num_fields; ++f) {
+        ASSERT_EQ(field_status[d * num_fields + f], RSMI_STATUS_NOT_SUPPORTED);
+      }
+      continue;
+    }
+    CHK_ERR_ASRT(err);
+
+    // Served from the same snapshot, so the values must be identical.
+    const auto entry = [&](rsmi_gpu_metrics_field_t field) {
+      return (d * num_fields) + static_cast<uint32_t>(field);
+    };
+    if (field_status[entry(RSMI_GPU_METRICS_FIELD_TEMPERATURE_HOTSPOT)] ==
+        RSMI_STATUS_SUCCESS) {
+      ASSERT_EQ(values[entry(RSMI_GPU_METRICS_FIELD_TEMPERATURE_HOTSPOT)],
+                smu.temperature_hotspot);
+    }
+    if (field_status[entry(RSMI_GPU_METRICS_FIELD_SYSTEM_CLOCK_COUNTER)] ==
+        RSMI_STATUS_SUCCESS) {
+      ASSERT_EQ(values[entry(RSMI_GPU_METRICS_FIELD_SYSTEM_CLOCK_COUNTER)],
+                smu.system_clock_counter);
+    }
+    if (field_status[entry(RSMI_GPU_METRICS_FIELD_ENERGY_ACCUMULATOR)] ==
+        RSMI_STATUS_SUCCESS) {
+      ASSERT_EQ(values[entry(RSMI_GPU_METRICS_FIELD_ENERGY_ACCUMULATOR)],
+                smu.energy_accumulator);
+    }
+
+    for (uint32_t f = 0; f < num_fields; ++f) {
+      const auto status = field_status[d * num_fields + f];
+      ASSERT_TRUE((status == RSMI_STATUS_SUCCESS) ||
+                  (status == RSMI_STATUS_NOT_SUPPORTED));
+      if (status == RSMI_STATUS_NOT_SUPPORTED) {
+        ASSERT_EQ(values[d * num_fields + f],
+                  std::numeric_limits<uint64_t>::max());
+      }
+      IF_VERB(STANDARD) {
+        std::cout << "\t  -> field [" << f << "]: ";
+        if (status == RSMI_STATUS_SUCCESS) {
+          std::cout << values[d * num_fields + f] << "\n";
+        } else {
+          std::cout << "N/A" << "\n";
+        }
+      }
+    }
+  }
+
+  // A max. age that overflows when converted to nanoseconds must saturate,
+  // i.e. the snapshot never expires, instead of wrapping to a few nanoseconds.
+  const uint64_t kOverflowMaxAgeUs =
+      (std::numeric_limits<uint64_t>::max() / 1000) + 1;
+  err = rsmi_gpu_metrics_cache_max_age_set(kOverflowMaxAgeUs);
+  CHK_ERR_ASRT(err);
+  if (num_devices > 0) {
+    std::vector<uint64_t> first(values.size());
+    std::vector<uint64_t> second(values.size());
+    err = rsmi_dev_gpu_metrics_fields_get(dv_inds.data(), num_devices,
+                                          fields.data(), num_fields,
+                                          first.data(), field_status.data());
+    CHK_ERR_ASRT(err);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    err = rsmi_dev_gpu_metrics_fields_get(dv_inds.data(), num_devices,
+                                          fields.data(), num_fields,
+                                          second.data(), field_status.data());
+    CHK_ERR_ASRT(err);
+    ASSERT_EQ(first, second);
+  }
+
+  // Verify argument checking
+  uint64_t value = 0;
+  rsmi_status_t status = RSMI_STATUS_SUCCESS;
+  const uint32_t bad_dv_ind = num_monitor_devs();
+  const auto bad_field = static_cast<rsmi_gpu_metrics_field_t>(
+      RSMI_GPU_METRICS_FIELD_LAST + 1);
+  err = rsmi_dev_gpu_metrics_fields_get(&bad_dv_ind, 1, fields.data(), 1,
+                                        &value, &status);
+  ASSERT_EQ(err, RSMI_STATUS_INVALID_ARGS);
+  if (num_devices > 0) {
+    err = rsmi_dev_gpu_metrics_fields_get(dv_inds.data(), 1, &bad_field, 1,
+                                          &value, &status);
+    ASSERT_EQ(err, RSMI_STATUS_INVALID_ARGS);
+  }
+  err = rsmi_dev_gpu_metrics_fields_get(nullptr, 1, fields.data(), 1,
+                                        &value, &status);
+  ASSERT_EQ(err, RSMI_STATUS_INVALID_ARGS);
+  err = rsmi_gpu_metrics_cache_max_age_get(nullptr);
+  ASSERT_EQ(err, RSMI_STATUS_INVALID_ARGS);
+
+  err = rsmi_gpu_metrics_cache_max_age_set(orig_max_age_us);
+  CHK_ERR_ASRT(err);
+}
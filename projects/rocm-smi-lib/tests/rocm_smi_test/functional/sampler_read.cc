@@ -0,0 +1,230 @@
+/*
+ * =============================================================================
+ *   ROC Runtime Conformance Release License
+ * =============================================================================
+ * The University of Illinois/NCSA
+ * Open Source License (NCSA)
+ *
+ * Copyright (c) 2025, Advanced Micro Devices, Inc.
+ * All rights reserved.
+ *
+ * Developed by:
+ *
+ *                 AMD Research and AMD ROC Software Development
+ *
+ *                 Advanced Micro Devices, Inc.
+ *
+ *                 www.amd.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal with the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimers.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimers in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the names of <Name of Development Group, Name of Institution>,
+ *    nor the names of its contributors may be used to endorse or promote
+ *    products derived from this Software without specific prior written
+ *    permission.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS WITH THE SOFTWARE.
+ *
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>  // NOLINT
+#include <iostream>
+#include <limits>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "rocm_smi/rocm_smi.h"
+#include "rocm_smi_test/functional/sampler_read.h"
+#include "rocm_smi_test/test_common.h"
+
+
+TestSamplerRead::TestSamplerRead() : TestBase() {
+  set_title("RSMI Sampler Read Test");
+  set_description("The Sampler tests verify that gpu metrics fields sampled "
+                  "in the background can be read, and that only the "
+                  "configured fields are published.");
+}
+
+TestSamplerRead::~TestSamplerRead(void) {
+}
+
+void TestSamplerRead::SetUp(void) {
+  TestBase::SetUp();
+
+  return;
+}
+
+void TestSamplerRead::DisplayTestInfo(void) {
+  TestBase::DisplayTestInfo();
+}
+
+void TestSamplerRead::DisplayResults(void) const {
+  TestBase::DisplayResults();
+  return;
+}
+
+void TestSamplerRead::Close() {
+  // This will close handles opened within rsmitst utility calls and call
+  // rsmi_shut_down(), so it should be done after other hsa cleanup
+  TestBase::Close();
+}
+
+
+void TestSamplerRead::Run(void) {
+  rsmi_status_t err;
+
+  TestBase::Run();
+  if (setup_failed_) {
+    std::cout << "** SetUp Failed for this test. Skipping.**" << std::endl;
+    return;
+  }
+
+  const uint64_t kIntervalUs = 10 * 1000;
+  const std::vector<rsmi_gpu_metrics_field_t> sampled_fields = {
+    RSMI_GPU_METRICS_FIELD_TEMPERATURE_HOTSPOT,
+    RSMI_GPU_METRICS_FIELD_AVERAGE_GFX_ACTIVITY,
+    RSMI_GPU_METRICS_FIELD_SYSTEM_CLOCK_COUNTER,
+  };
+  const auto num_sampled = static_cast<uint32_t>(sampled_fields.size());
+
+  // A sample left behind by a sampler process which died must not be
+  // reported as current.
+  if (num_monitor_devs() > 0) {
+    const pid_t child = fork();
+    ASSERT_NE(child, -1);
+    if (child == 0) {
+      std::vector<uint64_t> values(sampled_fields.size());
+      std::vector<rsmi_status_t> field_status(sampled_fields.size());
+      if (rsmi_dev_sampler_start(0, sampled_fields.data(), num_sampled,
+                                 kIntervalUs) != RSMI_STATUS_SUCCESS) {
+        _exit(1);
+      }
+      for (uint32_t retry = 0; retry < 100; ++retry) {
+        if (rsmi_dev_sampler_fields_get(0, sampled_fields.data(), num_sampled,
+                                        values.data(), field_status.data(),
+                                        nullptr) == RSMI_STATUS_SUCCESS) {
+          _exit(0);  // Without releasing the snapshot
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(kIntervalUs));
+      }
+      _exit(1);
+    }
+
+    int child_status = 0;
+    ASSERT_EQ(waitpid(child, &child_status, 0), child);
+    if (WIFEXITED(child_status) && (WEXITSTATUS(child_status) == 0)) {
+      std::vector<uint64_t> values(sampled_fields.size());
+      std::vector<rsmi_status_t> field_status(sampled_fields.size());
+      err = rsmi_dev_sampler_fields_get(0, sampled_fields.data(), num_sampled,
+                                        values.data(), field_status.data(),
+                                        nullptr);
+      ASSERT_EQ(err, RSMI_STATUS_NO_DATA);
+    }
+  }
+
+  for (uint32_t i = 0; i < num_monitor_devs(); ++i) {
+    PrintDeviceHeader(i);
+
+    err = rsmi_dev_sampler_start(i, sampled_fields.data(), num_sampled,
+                                 kIntervalUs);
+    if (err == RSMI_STATUS_BUSY) {
+      IF_VERB(STANDARD) {
+        std::cout << "\t**" << "Device is sampled by another process"
+                  << std::endl;
+      }
+      continue;
+    }
+    CHK_ERR_ASRT(err);
+
+    // Wait for the first sample to be published.
+    std::vector<uint64_t> values(sampled_fields.size());
+    std::vector<rsmi_status_t> field_status(sampled_fields.size());
+    uint64_t timestamp_ns = 0;
+    for (uint32_t retry = 0; retry < 100; ++retry) {
+      err = rsmi_dev_sampler_fields_get(i, sampled_fields.data(), num_sampled,
+                                        values.data(), field_status.data(),
+                                        &timestamp_ns);
+      if (err != RSMI_STATUS_NO_DATA) {
+        break;
+      }
+      std::this_thread::sleep_for(std::chrono::microseconds(kIntervalUs));
+    }
+    CHK_ERR_ASRT(err);
+    ASSERT_NE(timestamp_ns, 0u);
+
+    for (uint32_t f = 0; f < num_sampled; ++f) {
+      ASSERT_NE(field_status[f], RSMI_STATUS_NO_DATA);
+      IF_VERB(STANDARD) {
+        std::cout << "\t  -> field [" << sampled_fields[f] << "]: ";
+        if (field_status[f] == RSMI_STATUS_SUCCESS) {
+          std::cout << values[f] << "\n";
+        } else {
+          std::cout << "N/A" << "\n";
+        }
+      }
+    }
+
+    // Samples keep being published.
+    uint64_t next_timestamp_ns = timestamp_ns;
+    for (uint32_t retry = 0; retry < 100 && next_timestamp_ns == timestamp_ns;
+         ++retry) {
+      std::this_thread::sleep_for(std::chrono::microseconds(kIntervalUs));
+      err = rsmi_dev_sampler_fields_get(i, sampled_fields.data(), num_sampled,
+                                        values.data(), field_status.data(),
+                                        &next_timestamp_ns);
+      CHK_ERR_ASRT(err);
+    }
+    ASSERT_GT(next_timestamp_ns, timestamp_ns);
+
+    // Fields that are not sampled are not published.
+    const rsmi_gpu_metrics_field_t not_sampled =
+        RSMI_GPU_METRICS_FIELD_VRAM_MAX_BANDWIDTH;
+    uint64_t value = 0;
+    rsmi_status_t status = RSMI_STATUS_SUCCESS;
+    err = rsmi_dev_sampler_fields_get(i, &not_sampled, 1, &value, &status,
+                                      nullptr);
+    CHK_ERR_ASRT(err);
+    ASSERT_EQ(status, RSMI_STATUS_NO_DATA);
+    ASSERT_EQ(value, std::numeric_limits<uint64_t>::max());
+
+    err = rsmi_dev_sampler_stop(i);
+    CHK_ERR_ASRT(err);
+    err = rsmi_dev_sampler_fields_get(i, sampled_fields.data(), num_sampled,
+                                      values.data(), field_status.data(),
+                                      nullptr);
+    ASSERT_EQ(err, RSMI_STATUS_NO_DATA);
+    err = rsmi_dev_sampler_stop(i);
+    ASSERT_EQ(err, RSMI_STATUS_NOT_FOUND);
+
+    // Verify argument checking
+    err = rsmi_dev_sampler_start(i, sampled_fields.data(), num_sampled, 0);
+    ASSERT_EQ(err, RSMI_STATUS_INVALID_ARGS);
+    err = rsmi_dev_sampler_start(i, nullptr, num_sampled, kIntervalUs);
+    ASSERT_EQ(err, RSMI_STATUS_INVALID_ARGS);
+    err = rsmi_dev_sampler_fields_get(i, sampled_fields.data(), num_sampled,
+                                      nullptr, field_status.data(), nullptr);
+    ASSERT_EQ(err, RSMI_STATUS_INVALID_ARGS);
+  }
+}
@@ -85,6 +85,8 @@
 #include "functional/computepartition_read_write.h"
 #include "rocm_smi_test/functional/hw_topology_read.h"
 #include "rocm_smi_test/functional/gpu_metrics_read.h"
+#include "rocm_smi_test/functional/gpu_metrics_fields_read.h"
+#include "rocm_smi_test/functional/sampler_read.h"
 #include "rocm_smi_test/functional/metrics_counter_read.h"
 #include "rocm_smi_test/functional/perf_determinism.h"
 #include "functional/memorypartition_read_write.h"
@@ -243,6 +245,14 @@ TEST(rsmitstReadOnly, TestGpuMetricsRead) {
   TestGpuMetricsRead tst;
   RunGenericTest(&tst);
 }
+TEST(rsmitstReadOnly, TestGpuMetricsFieldsRead) {
+  TestGpuMetricsFieldsRead tst;
+  RunGenericTest(&tst);
+}
+TEST(rsmitstReadOnly, TestSamplerRead) {
+  TestSamplerRead tst;
+  RunGenericTest(&tst);
+}
 TEST(rsmitstReadOnly, TestMetricsCounterRead) {
   TestMetricsCounterRead tst;
   RunGenericTest(&tst);
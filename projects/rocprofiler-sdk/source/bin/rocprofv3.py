@@ -572,11 +572,11 @@ For MPI applications (or other job launchers such as SLURM), place rocprofv3 ins
 
     perfetto_options.add_argument(
         "--perfetto-backend",
-        help="Perfetto data collection backend. 'system' mode requires starting traced and perfetto daemons",
+        help="Perfetto data collection backend. 'system' mode requires starting traced and perfetto daemons. 'direct' mode writes the trace packets without a perfetto tracing session, so the buffer options do not apply",
         default=None,
         type=str,
         nargs=1,
-        choices=("inprocess", "system"),
+        choices=("inprocess", "system", "direct"),
     )
     perfetto_options.add_argument(
         "--perfetto-buffer-size",
@@ -0,0 +1,122 @@
+// MIT License
+//
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "lib/common/container/rcu_flat_map.hpp"
+
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rocprofiler
+{
+namespace common
+{
+namespace container
+{
+namespace rcu
+{
+namespace
+{
+struct reader_registry
+{
+    std::mutex                                mutex = {};
+    std::vector<std::unique_ptr<reader_slot>> slots = {};
+    std::vector<reader_slot*>                 idle  = {};
+};
+
+// intentionally leaked: threads may exit after the static objects are destroyed
+reader_registry*
+get_registry()
+{
+    static auto* _v = new reader_registry{};
+    return _v;
+}
+
+struct thread_reader_slot
+{
+    thread_reader_slot()
+    {
+        auto* _registry = get_registry();
+        auto  _lk       = std::unique_lock<std::mutex>{_registry->mutex};
+        if(_registry->idle.empty())
+        {
+            slot = _registry->slots.emplace_back(std::make_unique<reader_slot>()).get();
+        }
+        else
+        {
+            slot = _registry->idle.back();
+            _registry->idle.pop_back();
+        }
+    }
+
+    ~thread_reader_slot()
+    {
+        auto* _registry = get_registry();
+        auto  _lk       = std::unique_lock<std::mutex>{_registry->mutex};
+        _registry->idle.emplace_back(slot);
+    }
+
+    thread_reader_slot(const thread_reader_slot&)     = delete;
+    thread_reader_slot(thread_reader_slot&&) noexcept = delete;
+    thread_reader_slot& operator=(const thread_reader_slot&) = delete;
+    thread_reader_slot& operator=(thread_reader_slot&&) noexcept = delete;
+
+    reader_slot* slot = nullptr;
+};
+}  // namespace
+
+reader_slot*
+get_reader_slot()
+{
+    static thread_local auto _v = thread_reader_slot{};
+    return _v.slot;
+}
+
+void
+synchronize()
+{
+    // slots are never deallocated so the pointers remain valid after the lock is released.
+    // A thread registering a slot after this point can only load the newly published snapshot
+    auto _slots = std::vector<reader_slot*>{};
+    {
+        auto* _registry = get_registry();
+        auto  _lk       = std::unique_lock<std::mutex>{_registry->mutex};
+        _slots.reserve(_registry->slots.size());
+        for(const auto& itr : _registry->slots)
+            _slots.emplace_back(itr.get());
+    }
+
+    for(auto* itr : _slots)
+    {
+        auto _sequence = itr->sequence.load(std::memory_order_seq_cst);
+        if(_sequence % 2 == 0) continue;
+
+        // only wait for the read section observed above: a later one reads the new snapshot
+        while(itr->sequence.load(std::memory_order_acquire) == _sequence)
+            std::this_thread::yield();
+    }
+}
+}  // namespace rcu
+}  // namespace container
+}  // namespace common
+}  // namespace rocprofiler
@@ -0,0 +1,213 @@
+// MIT License
+//
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace rocprofiler
+{
+namespace common
+{
+namespace container
+{
+namespace rcu
+{
+/// sequence counter of a thread: odd while the thread is reading a published snapshot
+struct reader_slot
+{
+    std::atomic<uint64_t> sequence = {0};
+};
+
+/// returns the slot of the calling thread. Slots of exited threads are reused
+reader_slot*
+get_reader_slot();
+
+/// waits until every read section which was active when called has ended. Snapshots which
+/// were unpublished before the call can be deleted afterwards
+void
+synchronize();
+
+/// marks the calling thread as reading published snapshots for the lifetime of the object.
+/// Read sections cannot be nested
+struct read_section
+{
+    read_section()
+    : m_slot{get_reader_slot()}
+    , m_sequence{m_slot->sequence.load(std::memory_order_relaxed)}
+    {
+        m_slot->sequence.store(m_sequence + 1, std::memory_order_seq_cst);
+    }
+
+    ~read_section() { m_slot->sequence.store(m_sequence + 2, std::memory_order_release); }
+
+    read_section(const read_section&)     = delete;
+    read_section(read_section&&) noexcept = delete;
+    read_section& operator=(const read_section&) = delete;
+    read_section& operator=(read_section&&) noexcept = delete;
+
+private:
+    reader_slot* m_slot     = nullptr;
+    uint64_t     m_sequence = 0;
+};
+}  // namespace rcu
+
+/// Map for data which is read far more often than it changes. Updates are applied to an
+/// authoritative std::unordered_map under a mutex and then published as an immutable,
+/// open-addressed snapshot with an atomic pointer swap. Lookups only read the current
+/// snapshot: they never take a lock and never wait on an update.
+template <typename KeyT, typename MappedT, typename HashT = std::hash<KeyT>>
+class rcu_flat_map
+{
+public:
+    using key_type    = KeyT;
+    using mapped_type = MappedT;
+    using map_type    = std::unordered_map<KeyT, MappedT, HashT>;
+
+    rcu_flat_map() = default;
+    ~rcu_flat_map() { delete m_table.load(); }
+
+    rcu_flat_map(const rcu_flat_map&)     = delete;
+    rcu_flat_map(rcu_flat_map&&) noexcept = delete;
+    rcu_flat_map& operator=(const rcu_flat_map&) = delete;
+    rcu_flat_map& operator=(rcu_flat_map&&) noexcept = delete;
+
+    /// value of the key in the published snapshot or the fallback when the key is missing
+    mapped_type find(const key_type& _key, mapped_type _fallback = {}) const;
+
+    /// number of entries in the published snapshot
+    size_t size() const;
+
+    /// invokes `_func(map_type&, Args...)` on the authoritative map and publishes the result.
+    /// Batch modifications into one update: every update copies the whole map
+    template <typename FuncT, typename... Args>
+    void update(FuncT&& _func, Args&&... _args);
+
+private:
+    struct entry
+    {
+        key_type    key      = {};
+        mapped_type value    = {};
+        bool        occupied = false;
+    };
+
+    struct table
+    {
+        explicit table(const map_type& _data);
+
+        size_t index(const key_type& _key) const;
+
+        size_t             count = 0;
+        size_t             shift = 0;
+        std::vector<entry> slots = {};
+    };
+
+    std::mutex          m_mutex = {};
+    map_type            m_data  = {};
+    std::atomic<table*> m_table = {nullptr};
+};
+
+template <typename KeyT, typename MappedT, typename HashT>
+rcu_flat_map<KeyT, MappedT, HashT>::table::table(const map_type& _data)
+: count{_data.size()}
+{
+    // keep the load factor at or below 1/2 so that probe sequences stay short
+    size_t _bits = 4;
+    while((size_t{1} << _bits) < 2 * count)
+        ++_bits;
+
+    shift = (8 * sizeof(uint64_t)) - _bits;
+    slots.resize(size_t{1} << _bits);
+
+    for(const auto& itr : _data)
+    {
+        auto _idx = index(itr.first);
+        while(slots[_idx].occupied)
+            _idx = (_idx + 1) & (slots.size() - 1);
+        slots[_idx] = entry{itr.first, itr.second, true};
+    }
+}
+
+template <typename KeyT, typename MappedT, typename HashT>
+size_t
+rcu_flat_map<KeyT, MappedT, HashT>::table::index(const key_type& _key) const
+{
+    // fibonacci hashing: the high bits are well mixed even when the hash is the identity of an
+    // aligned address
+    constexpr uint64_t multiplier = 0x9e3779b97f4a7c15ULL;
+    return static_cast<size_t>((static_cast<uint64_t>(HashT{}(_key)) * multiplier) >> shift);
+}
+
+template <typename KeyT, typename MappedT, typename HashT>
+MappedT
+rcu_flat_map<KeyT, MappedT, HashT>::find(const key_type& _key, mapped_type _fallback) const
+{
+    auto        _section = rcu::read_section{};
+    const auto* _table   = m_table.load(std::memory_order_seq_cst);
+    if(!_table) return _fallback;
+
+    const auto _mask = _table->slots.size() - 1;
+    for(auto _idx = _table->index(_key);; _idx = (_idx + 1) & _mask)
+    {
+        const auto& _entry = _table->slots[_idx];
+        if(!_entry.occupied) return _fallback;
+        if(_entry.key == _key) return _entry.value;
+    }
+}
+
+template <typename KeyT, typename MappedT, typename HashT>
+size_t
+rcu_flat_map<KeyT, MappedT, HashT>::size() const
+{
+    auto        _section = rcu::read_section{};
+    const auto* _table   = m_table.load(std::memory_order_seq_cst);
+    return (_table) ? _table->count : 0;
+}
+
+template <typename KeyT, typename MappedT, typename HashT>
+template <typename FuncT, typename... Args>
+void
+rcu_flat_map<KeyT, MappedT, HashT>::update(FuncT&& _func, Args&&... _args)
+{
+    auto _lk = std::unique_lock<std::mutex>{m_mutex};
+
+    std::forward<FuncT>(_func)(m_data, std::forward<Args>(_args)...);
+
+    auto* _prev = m_table.exchange(new table{m_data}, std::memory_order_seq_cst);
+
+    // readers which loaded the previous snapshot finish before it is deleted
+    if(_prev)
+    {
+        rcu::synchronize();
+        delete _prev;
+    }
+}
+}  // namespace container
+}  // namespace common
+}  // namespace rocprofiler
@@ -24,11 +24,17 @@
 
 #include "lib/common/mpl.hpp"
 
+#include <algorithm>
 #include <array>
+#include <charconv>
 #include <cstddef>
+#include <cstdint>
+#include <cstdio>
 #include <iomanip>
 #include <ios>
 #include <ostream>
+#include <sstream>
+#include <string>
 #include <string_view>
 #include <type_traits>
 
@@ -74,6 +80,144 @@ write_csv_entry(std::ostream& ofs, TupleT&& _data, std::index_sequence<Idx...>)
     return (ofs << '\n');
 }
 
+/// Formats CSV rows directly into a reusable buffer which is handed to the stream in large
+/// blocks. Numbers are formatted with std::to_chars instead of iostreams. The output is identical
+/// to write_csv_entry with the numerical_formatter
+class buffered_writer
+{
+public:
+    static constexpr size_t default_flush_threshold = 4 * 1024 * 1024;
+
+    explicit buffered_writer(std::ostream& ofs, size_t flush_threshold = default_flush_threshold)
+    : m_ofs{ofs}
+    , m_flush_threshold{flush_threshold}
+    {
+        m_buffer.reserve(m_flush_threshold + (m_flush_threshold / 16));
+    }
+
+    ~buffered_writer() { flush(); }
+
+    buffered_writer(const buffered_writer&)     = delete;
+    buffered_writer(buffered_writer&&) noexcept = delete;
+    buffered_writer& operator=(const buffered_writer&) = delete;
+    buffered_writer& operator=(buffered_writer&&) noexcept = delete;
+
+    template <typename... Args>
+    void write_row(Args&&... args)
+    {
+        size_t _idx = 0;
+        ((append_column(_idx++, std::forward<Args>(args))), ...);
+        m_buffer.push_back('\n');
+        if(m_buffer.size() >= m_flush_threshold) flush();
+    }
+
+    void flush()
+    {
+        if(m_buffer.empty()) return;
+        m_ofs.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+        m_buffer.clear();
+    }
+
+private:
+    template <typename Tp>
+    void append_column(size_t idx, const Tp& _val)
+    {
+        if(idx > 0) m_buffer.push_back(',');
+        append(_val);
+    }
+
+    template <typename Tp>
+    void append_chars(Tp _val)
+    {
+        auto _buf = std::array<char, 32>{};
+        auto _ret = std::to_chars(_buf.data(), _buf.data() + _buf.size(), _val);
+        m_buffer.append(_buf.data(), _ret.ptr);
+    }
+
+    void append_floating(double _val)
+    {
+        // matches numerical_formatter: fixed notation with 6 digits for values >= 1 and
+        // scientific notation with 8 digits otherwise
+        constexpr double one    = 1.0;
+        const bool       _fixed = (_val >= one);
+        auto             _buf   = std::array<char, 512>{};
+        char*            _end   = nullptr;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        _end = std::to_chars(_buf.data(),
+                             _buf.data() + _buf.size(),
+                             _val,
+                             (_fixed) ? std::chars_format::fixed : std::chars_format::scientific,
+                             (_fixed) ? 6 : 8)
+                   .ptr;
+#else
+        auto _n = std::snprintf(_buf.data(), _buf.size(), (_fixed) ? "%.6f" : "%.8e", _val);
+        _end    = _buf.data() + ((_n > 0) ? std::min<size_t>(_n, _buf.size() - 1) : 0);
+#endif
+        m_buffer.append(_buf.data(), _end);
+    }
+
+    template <typename Tp>
+    void append(const Tp& _val)
+    {
+        using value_type = common::mpl::unqualified_type_t<Tp>;
+
+        if constexpr(common::mpl::is_string_type<value_type>::value)
+        {
+            m_buffer.push_back('"');
+            if constexpr(std::is_array<Tp>::value)
+            {
+                m_buffer.append(_val);
+            }
+            else if constexpr(std::is_pointer<value_type>::value)
+            {
+                if(_val) m_buffer.append(_val);
+            }
+            else
+            {
+                m_buffer.append(_val.data(), _val.size());
+            }
+            m_buffer.push_back('"');
+        }
+        else if constexpr(std::is_same<value_type, bool>::value)
+        {
+            m_buffer.push_back((_val) ? '1' : '0');
+        }
+        else if constexpr(std::is_same<value_type, char>::value ||
+                          std::is_same<value_type, signed char>::value ||
+                          std::is_same<value_type, unsigned char>::value)
+        {
+            // iostreams write single byte integers as characters
+            m_buffer.push_back(static_cast<char>(_val));
+        }
+        else if constexpr(std::is_integral<value_type>::value)
+        {
+            append_chars(_val);
+        }
+        else if constexpr(std::is_enum<value_type>::value &&
+                          std::is_convertible<value_type, int64_t>::value)
+        {
+            // unscoped enumerations are written as their underlying type, which makes single byte
+            // underlying types characters like iostreams do
+            append(static_cast<std::underlying_type_t<value_type>>(_val));
+        }
+        else if constexpr(std::is_same<value_type, float>::value ||
+                          std::is_same<value_type, double>::value)
+        {
+            append_floating(_val);
+        }
+        else
+        {
+            auto _ss = std::ostringstream{};
+            numerical_formatter{}(_ss, _val) << _val;
+            m_buffer.append(_ss.str());
+        }
+    }
+
+    std::ostream& m_ofs;
+    size_t        m_flush_threshold = default_flush_threshold;
+    std::string   m_buffer          = {};
+};
+
 template <size_t NumCols>
 struct csv_encoder
 {
@@ -90,6 +234,13 @@ struct csv_encoder
         return csv_encoder<columns>{};
     }
 
+    template <typename... Args, std::enable_if_t<sizeof...(Args) == columns, int> = 0>
+    static auto write_row(buffered_writer& writer, Args&&... args)
+    {
+        writer.write_row(std::forward<Args>(args)...);
+        return csv_encoder<columns>{};
+    }
+
     template <typename FmtT = numerical_formatter, typename Tp, size_t N>
     static auto write_row(std::ostream& ofs, const std::array<Tp, N>& arr)
     {
@@ -39,6 +39,7 @@ csv_output_file::~csv_output_file()
 {
     if(m_os.stream) ROCP_INFO << "Closing result file: " << m_name;
 
+    m_writer.flush();
     m_os.close();
 }
 }  // namespace tool
@@ -66,15 +66,20 @@ struct csv_output_file
     std::ostream& operator<<(T&& value)
     {
         auto _lk = std::unique_lock<std::mutex>{m_mutex};
+        m_writer.flush();
         return ((m_os.stream) ? *m_os.stream : std::cerr) << std::forward<T>(value) << std::flush;
     }
 
+    /// buffer for rows formatted by the csv encoders. It must only be used by one thread
+    csv::buffered_writer& writer() { return m_writer; }
+
     operator bool() const { return m_os.stream != nullptr; }
 
 private:
-    const std::string m_name  = {};
-    std::mutex        m_mutex = {};
-    output_stream     m_os    = {};
+    const std::string    m_name   = {};
+    std::mutex           m_mutex  = {};
+    output_stream        m_os     = {};
+    csv::buffered_writer m_writer{(m_os.stream) ? *m_os.stream : std::cerr};
 };
 
 template <size_t N>
@@ -38,7 +38,9 @@
 #include <unistd.h>
 #include <cstdint>
 #include <iomanip>
+#include <string>
 #include <string_view>
+#include <unordered_map>
 #include <utility>
 
 namespace rocprofiler
@@ -47,6 +49,29 @@ namespace tool
 {
 namespace
 {
+// agent columns are formatted once per agent instead of once per record
+struct agent_index_names
+{
+    agent_index_names(const metadata& _metadata, agent_indexing _index)
+    : m_metadata{_metadata}
+    , m_index{_index}
+    {}
+
+    std::string_view operator()(rocprofiler_agent_id_t _id)
+    {
+        auto itr = m_names.find(_id.handle);
+        if(itr == m_names.end())
+            itr = m_names.emplace(_id.handle, m_metadata.get_agent_index(_id, m_index).as_string())
+                      .first;
+        return itr->second;
+    }
+
+private:
+    const metadata&                           m_metadata;
+    agent_indexing                            m_index;
+    std::unordered_map<uint64_t, std::string> m_names = {};
+};
+
 tool::csv_output_file
 get_stats_output_file(const output_config& cfg, std::string_view name)
 {
@@ -178,6 +203,7 @@ generate_csv(const output_config& cfg,
                                       "Vendor_Name",
                                       "Product_Name",
                                       "Model_Name"}};
+    auto& _writer = ofs.writer();
 
     for(auto& itr : data)
     {
@@ -189,8 +215,7 @@ generate_csv(const output_config& cfg,
         else
             _type = "UNK";
 
-        auto row_ss = std::stringstream{};
-        rocprofiler::tool::csv::agent_info_csv_encoder::write_row(row_ss,
+        rocprofiler::tool::csv::agent_info_csv_encoder::write_row(_writer,
                                                                   itr.node_id,
                                                                   itr.logical_node_id,
                                                                   _type,
@@ -244,7 +269,6 @@ generate_csv(const output_config& cfg,
                                                                   itr.vendor_name,
                                                                   itr.product_name,
                                                                   itr.model_name);
-        ofs << row_ss.str();
     }
 }
 
@@ -283,12 +307,13 @@ generate_csv(const output_config&
                                       "Grid_Size_X",
                                       "Grid_Size_Y",
                                       "Grid_Size_Z"}};
+    auto& _writer     = ofs.writer();
+    auto  agent_names = agent_index_names{tool_metadata, cfg.agent_index_value};
 
     for(auto ditr : data)
     {
         for(auto record : data.get(ditr))
         {
-            auto        row_ss      = std::stringstream{};
             auto        kernel_name = tool_metadata.get_kernel_name(record.dispatch_info.kernel_id,
                                                              record.correlation_id.external.value);
             const auto* kernel_info =
@@ -297,10 +322,9 @@ generate_csv(const output_config&
                 (kernel_info->group_segment_size + (lds_block_size - 1)) & ~(lds_block_size - 1);
 
             rocprofiler::tool::csv::kernel_trace_with_stream_csv_encoder::write_row(
-                row_ss,
+                _writer,
                 tool_metadata.get_kind_name(record.kind),
-                tool_metadata.get_agent_index(record.dispatch_info.agent_id, cfg.agent_index_value)
-                    .as_string(),
+                agent_names(record.dispatch_info.agent_id),
                 record.dispatch_info.queue_id.handle,
                 record.stream_id.handle,
                 record.thread_id,
@@ -321,7 +345,6 @@ generate_csv(const output_config&
                 record.dispatch_info.grid_size.x,
                 record.dispatch_info.grid_size.y,
                 record.dispatch_info.grid_size.z);
-            ofs << row_ss.str();
         }
     }
 }
@@ -346,14 +369,14 @@ generate_csv(const output_config&                                       cfg,
                                       "Correlation_Id",
                                       "Start_Timestamp",
                                       "End_Timestamp"}};
+    auto& _writer = ofs.writer();
     for(auto ditr : data)
     {
         for(auto record : data.get(ditr))
         {
-            auto row_ss   = std::stringstream{};
             auto api_name = tool_metadata.get_operation_name(record.kind, record.operation);
             rocprofiler::tool::csv::api_csv_encoder::write_row(
-                row_ss,
+                _writer,
                 tool_metadata.get_kind_name(record.kind),
                 api_name,
                 tool_metadata.process_id,
@@ -361,8 +384,6 @@ generate_csv(const output_config&                                       cfg,
                 record.correlation_id.internal,
                 record.start_timestamp,
                 record.end_timestamp);
-
-            ofs << row_ss.str();
         }
     }
 }
@@ -387,15 +408,15 @@ generate_csv(const output_config&                                          cfg,
                                       "Correlation_Id",
                                       "Start_Timestamp",
                                       "End_Timestamp"}};
+    auto& _writer = ofs.writer();
 
     for(auto ditr : data)
     {
         for(auto record : data.get(ditr))
         {
-            auto row_ss   = std::stringstream{};
             auto api_name = tool_metadata.get_operation_name(record.kind, record.operation);
             rocprofiler::tool::csv::api_csv_encoder::write_row(
-                row_ss,
+                _writer,
                 tool_metadata.get_kind_name(record.kind),
                 api_name,
                 tool_metadata.process_id,
@@ -403,8 +424,6 @@ generate_csv(const output_config&                                          cfg,
                 record.correlation_id.internal,
                 record.start_timestamp,
                 record.end_timestamp);
-
-            ofs << row_ss.str();
         }
     }
 }
@@ -431,26 +450,24 @@ generate_csv(const output_config&                                           cfg,
                                       "Correlation_Id",
                                       "Start_Timestamp",
                                       "End_Timestamp"}};
+    auto& _writer     = ofs.writer();
+    auto  agent_names = agent_index_names{tool_metadata, cfg.agent_index_value};
 
     for(auto ditr : data)
     {
         for(auto record : data.get(ditr))
         {
-            auto row_ss   = std::stringstream{};
             auto api_name = tool_metadata.get_operation_name(record.kind, record.operation);
             rocprofiler::tool::csv::memory_copy_with_stream_csv_encoder::write_row(
-                row_ss,
+                _writer,
                 tool_metadata.get_kind_name(record.kind),
                 api_name,
                 record.stream_id.handle,
-                tool_metadata.get_agent_index(record.src_agent_id, cfg.agent_index_value)
-                    .as_string(),
-                tool_metadata.get_agent_index(record.dst_agent_id, cfg.agent_index_value)
-                    .as_string(),
+                agent_names(record.src_agent_id),
+                agent_names(record.dst_agent_id),
                 record.correlation_id.internal,
                 record.start_timestamp,
                 record.end_timestamp);
-            ofs << row_ss.str();
         }
     }
 }
@@ -477,24 +494,24 @@ generate_csv(const output_config&
                                       "Correlation_Id",
                                       "Start_Timestamp",
                                       "End_Timestamp"}};
+    auto& _writer     = ofs.writer();
+    auto  agent_names = agent_index_names{tool_metadata, cfg.agent_index_value};
     for(auto ditr : data)
     {
         for(auto record : data.get(ditr))
         {
-            auto agent_info = std::string{};
+            auto agent_info = std::string_view{};
             // Free functions currently do not track agent information. Only set it on allocation
             // operations, otherwise set it to 0 currently
             if(record.operation == ROCPROFILER_MEMORY_ALLOCATION_ALLOCATE ||
                record.operation == ROCPROFILER_MEMORY_ALLOCATION_VMEM_ALLOCATE)
             {
-                agent_info = tool_metadata.get_agent_index(record.agent_id, cfg.agent_index_value)
-                                 .as_string();
+                agent_info = agent_names(record.agent_id);
             }
             auto api_name = tool_metadata.get_operation_name(record.kind, record.operation);
-            auto row_ss   = std::stringstream{};
 
             rocprofiler::tool::csv::memory_allocation_csv_encoder::write_row(
-                row_ss,
+                _writer,
                 tool_metadata.get_kind_name(record.kind),
                 api_name,
                 agent_info,
@@ -503,8 +520,6 @@ generate_csv(const output_config&
                 record.correlation_id.internal,
                 record.start_timestamp,
                 record.end_timestamp);
-
-            ofs << row_ss.str();
         }
     }
 }
@@ -530,12 +545,12 @@ generate_csv(const output_config&                                             cf
                                       "Correlation_Id",
                                       "Start_Timestamp",
                                       "End_Timestamp"}};
+    auto& _writer = ofs.writer();
     for(auto ditr : data)
     {
         for(auto record : data.get(ditr))
         {
-            auto row_ss = std::stringstream{};
-            auto _name  = std::string_view{};
+            auto _name = std::string_view{};
 
             if(record.kind == ROCPROFILER_BUFFER_TRACING_MARKER_CORE_RANGE_API &&
                (record.operation == ROCPROFILER_MARKER_CORE_RANGE_API_ID_roctxMarkA ||
@@ -549,7 +564,7 @@ generate_csv(const output_config&                                             cf
                 _name = tool_metadata.get_operation_name(record.kind, record.operation);
             }
 
-            tool::csv::marker_csv_encoder::write_row(row_ss,
+            tool::csv::marker_csv_encoder::write_row(_writer,
                                                      tool_metadata.get_kind_name(record.kind),
                                                      _name,
                                                      tool_metadata.process_id,
@@ -557,8 +572,6 @@ generate_csv(const output_config&                                             cf
                                                      record.correlation_id.internal,
                                                      record.start_timestamp,
                                                      record.end_timestamp);
-
-            ofs << row_ss.str();
         }
     }
 }
@@ -596,6 +609,8 @@ generate_csv(const output_config&                    cfg,
                                       "Counter_Value",
                                       "Start_Timestamp",
                                       "End_Timestamp"}};
+    auto& _writer     = ofs.writer();
+    auto  agent_names = agent_index_names{tool_metadata, cfg.agent_index_value};
 
     auto counter_id_to_name = std::unordered_map<rocprofiler_counter_id_t, std::string_view>{};
     for(const auto& itr : tool_metadata.get_counter_info())
@@ -621,17 +636,13 @@ generate_csv(const output_config&                    cfg,
                 (kernel_info->group_segment_size + (lds_block_size - 1)) & ~(lds_block_size - 1);
 
             auto magnitude = [](rocprofiler_dim3_t dims) { return (dims.x * dims.y * dims.z); };
-            auto row_ss    = std::stringstream{};
             for(auto& [counter_id, counter_value] : counter_id_value)
             {
                 tool::csv::counter_collection_csv_encoder::write_row(
-                    row_ss,
+                    _writer,
                     correlation_id.internal,
                     record.dispatch_data.dispatch_info.dispatch_id,
-                    tool_metadata
-                        .get_agent_index(record.dispatch_data.dispatch_info.agent_id,
-                                         cfg.agent_index_value)
-                        .as_string(),
+                    agent_names(record.dispatch_data.dispatch_info.agent_id),
                     record.dispatch_data.dispatch_info.queue_id.handle,
                     tool_metadata.process_id,
                     record.thread_id,
@@ -649,7 +660,6 @@ generate_csv(const output_config&                    cfg,
                     record.dispatch_data.start_timestamp,
                     record.dispatch_data.end_timestamp);
             }
-            ofs << row_ss.str();
         }
     }
 }
@@ -679,28 +689,27 @@ generate_csv(const output_config&
                                          "End_Timestamp",
                                          "Allocation_Size",
                                      }};
+    auto& _writer     = ofs.writer();
+    auto  agent_names = agent_index_names{tool_metadata, cfg.agent_index_value};
 
     for(auto ditr : data)
     {
         for(auto record : data.get(ditr))
         {
-            auto row_ss    = std::stringstream{};
             auto kind_name = tool_metadata.get_kind_name(record.kind);
             auto op_name   = tool_metadata.get_operation_name(record.kind, record.operation);
 
             tool::csv::scratch_memory_encoder::write_row(
-                row_ss,
+                _writer,
                 kind_name,
                 op_name,
-                tool_metadata.get_agent_index(record.agent_id, cfg.agent_index_value).as_string(),
+                agent_names(record.agent_id),
                 record.queue_id.handle,
                 record.thread_id,
                 record.flags,
                 record.start_timestamp,
                 record.end_timestamp,
                 record.allocation_size);
-
-            ofs << row_ss.str();
         }
     }
 }
@@ -726,14 +735,14 @@ generate_csv(const output_config&                                           cfg,
                                       "Correlation_Id",
                                       "Start_Timestamp",
                                       "End_Timestamp"}};
+    auto& _writer = ofs.writer();
     for(auto ditr : data)
     {
         for(auto record : data.get(ditr))
         {
-            auto row_ss   = std::stringstream{};
             auto api_name = tool_metadata.get_operation_name(record.kind, record.operation);
             rocprofiler::tool::csv::api_csv_encoder::write_row(
-                row_ss,
+                _writer,
                 tool_metadata.get_kind_name(record.kind),
                 api_name,
                 tool_metadata.process_id,
@@ -741,8 +750,6 @@ generate_csv(const output_config&                                           cfg,
                 record.correlation_id.internal,
                 record.start_timestamp,
                 record.end_timestamp);
-
-            ofs << row_ss.str();
         }
     }
 }
@@ -768,14 +775,14 @@ generate_csv(const output_config&
                                       "Correlation_Id",
                                       "Start_Timestamp",
                                       "End_Timestamp"}};
+    auto& _writer = ofs.writer();
     for(auto ditr : data)
     {
         for(auto record : data.get(ditr))
         {
-            auto row_ss   = std::stringstream{};
             auto api_name = tool_metadata.get_operation_name(record.kind, record.operation);
             rocprofiler::tool::csv::api_csv_encoder::write_row(
-                row_ss,
+                _writer,
                 tool_metadata.get_kind_name(record.kind),
                 api_name,
                 tool_metadata.process_id,
@@ -783,8 +790,6 @@ generate_csv(const output_config&
                 record.correlation_id.internal,
                 record.start_timestamp,
                 record.end_timestamp);
-
-            ofs << row_ss.str();
         }
     }
 }
@@ -810,14 +815,14 @@ generate_csv(const output_config&                                              c
                                       "Correlation_Id",
                                       "Start_Timestamp",
                                       "End_Timestamp"}};
+    auto& _writer = ofs.writer();
     for(auto ditr : data)
     {
         for(auto record : data.get(ditr))
         {
-            auto row_ss   = std::stringstream{};
             auto api_name = tool_metadata.get_operation_name(record.kind, record.operation);
             rocprofiler::tool::csv::api_csv_encoder::write_row(
-                row_ss,
+                _writer,
                 tool_metadata.get_kind_name(record.kind),
                 api_name,
                 tool_metadata.process_id,
@@ -825,8 +830,6 @@ generate_csv(const output_config&                                              c
                 record.correlation_id.internal,
                 record.start_timestamp,
                 record.end_timestamp);
-
-            ofs << row_ss.str();
         }
     }
 }
@@ -851,40 +854,35 @@ generate_csv(const output_config&                                              c
                                       "Instruction",
                                       "Instruction_Comment",
                                       "Correlation_Id"}};
+    auto& _writer = ofs.writer();
     for(auto ditr : data)
     {
         for(const auto& record : data.get(ditr))
         {
             if(record.inst_index == -1)
             {
-                auto        row_ss = std::stringstream{};
                 std::string inst_comment =
                     "Unrecognized code object id, physical virtual address of PC:" +
                     std::to_string(record.pc_sample_record.pc.code_object_offset);
                 rocprofiler::tool::csv::pc_sampling_host_trap_csv_encoder::write_row(
-                    row_ss,
+                    _writer,
                     record.pc_sample_record.timestamp,
                     record.pc_sample_record.exec_mask,
                     record.pc_sample_record.dispatch_id,
                     "",
                     inst_comment,
                     record.pc_sample_record.correlation_id.internal);
-
-                ofs << row_ss.str();
             }
             else
             {
-                auto row_ss = std::stringstream{};
                 rocprofiler::tool::csv::pc_sampling_host_trap_csv_encoder::write_row(
-                    row_ss,
+                    _writer,
                     record.pc_sample_record.timestamp,
                     record.pc_sample_record.exec_mask,
                     record.pc_sample_record.dispatch_id,
                     tool_metadata.get_instruction(record.inst_index),
                     tool_metadata.get_comment(record.inst_index),
                     record.pc_sample_record.correlation_id.internal);
-
-                ofs << row_ss.str();
             }
         }
     }
@@ -916,6 +914,7 @@ generate_csv(const output_config&
                                          "Stall_Reason",
                                          "Wave_Count",
                                      }};
+    auto& _writer = ofs.writer();
     for(auto ditr : data)
     {
         for(const auto& record : data.get(ditr))
@@ -936,9 +935,8 @@ generate_csv(const output_config&
                 inst_comment = tool_metadata.get_comment(record.inst_index);
             }
 
-            auto row_ss = std::stringstream{};
             rocprofiler::tool::csv::pc_sampling_stochastic_csv_encoder::write_row(
-                row_ss,
+                _writer,
                 record.pc_sample_record.timestamp,
                 record.pc_sample_record.exec_mask,
                 record.pc_sample_record.dispatch_id,
@@ -957,8 +955,6 @@ generate_csv(const output_config&
                         record.pc_sample_record.snapshot.reason_not_issued))),
                 // Similar reasoning as for wave_issued.
                 static_cast<unsigned int>(record.pc_sample_record.wave_count));
-
-            ofs << row_ss.str();
         }
     }
 }
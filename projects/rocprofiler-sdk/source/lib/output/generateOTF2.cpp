@@ -45,15 +45,18 @@
 #include <otf2/OTF2_Pthread_Locks.h>
 #include <otf2/otf2.h>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <ctime>
 #include <future>
 #include <map>
+#include <memory>
 #include <thread>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #define OTF2_CHECK(result)                                                                         \
     {                                                                                              \
@@ -168,28 +171,32 @@ operator<(const location_base& lhs, const location_base& rhs)
            std::tie(rhs.pid, rhs.tid, rhs.agent.handle, rhs.queue.handle, rhs.type);
 }
 
+bool
+operator==(const location_base& lhs, const location_base& rhs)
+{
+    return std::tie(lhs.pid, lhs.tid, lhs.agent.handle, lhs.queue.handle, lhs.type) ==
+           std::tie(rhs.pid, rhs.tid, rhs.agent.handle, rhs.queue.handle, rhs.type);
+}
+
+struct location_hash
+{
+    size_t operator()(const location_base& _location) const { return _location.hash(); }
+};
+
 struct location_data : location_base
 {
-    location_data(uint64_t                    _pid,
-                  rocprofiler_thread_id_t     _tid,
-                  rocprofiler_agent_id_t      _agent = {.handle = 0},
-                  rocprofiler_location_type_t _type  = ROCPROFILER_AGENT_NO_TYPE,
-                  rocprofiler_queue_id_t      _queue = {.handle = 0})
-    : location_base{_pid, _tid, _agent, _type, _queue}
+    explicit location_data(const location_base& _location)
+    : location_base{_location}
     , index{++index_counter}
     , event_writer{OTF2_Archive_GetEvtWriter(CHECK_NOTNULL(archive), index)}
     {
         CHECK_NOTNULL(event_writer);
     }
 
-    using location_base::hash;
-
     static uint64_t index_counter;
 
     uint64_t        index        = 0;
     event_writer_t* event_writer = nullptr;
-
-    bool operator==(const location_base& rhs) const { return (hash() == rhs.hash()); }
 };
 
 uint64_t location_data::index_counter = 0;
@@ -209,28 +216,6 @@ get_locations()
     return _v;
 }
 
-const location_data*
-get_location(const location_base& _location, bool _init = false)
-{
-    for(auto& itr : get_locations())
-        if(*itr == _location) return itr.get();
-
-    if(_init)
-        return get_locations()
-            .emplace_back(std::make_unique<location_data>(
-                _location.pid, _location.tid, _location.agent, _location.type, _location.queue))
-            .get();
-
-    return nullptr;
-}
-
-event_writer_t*
-get_event_writer(const location_base& _location, bool _init = false)
-{
-    const auto* _loc = get_location(_location, _init);
-    return (_loc) ? _loc->event_writer : nullptr;
-}
-
 OTF2_FlushType
 pre_flush(void*            userData,
           OTF2_FileType    fileType,
@@ -264,25 +249,6 @@ get_hash_id(Tp&& _val)
         return get_hash_id(*_val);
 }
 
-template <typename... Args>
-auto
-add_event(std::string_view             name,
-          const location_base&         _location,
-          rocprofiler_callback_phase_t _phase,
-          OTF2_TimeStamp               _ts,
-          attribute_list_t*            _attributes = nullptr)
-{
-    auto* evt_writer = get_event_writer(_location, true);
-    auto  _hash      = get_hash_id(name);
-
-    if(_phase == ROCPROFILER_CALLBACK_PHASE_ENTER)
-        OTF2_CHECK(OTF2_EvtWriter_Enter(evt_writer, _attributes, _ts, _hash))
-    else if(_phase == ROCPROFILER_CALLBACK_PHASE_EXIT)
-        OTF2_CHECK(OTF2_EvtWriter_Leave(evt_writer, _attributes, _ts, _hash))
-    else
-        ROCP_FATAL << "otf2::add_event phase is not enter or exit";
-}
-
 void
 setup(const output_config& cfg)
 {
@@ -320,81 +286,114 @@ shutdown()
     OTF2_CHECK(OTF2_Archive_Close(archive));
 }
 
-struct event_info
+struct evt_data
 {
-    explicit event_info(location_base&& _loc)
-    : m_location{tool::get_location(std::forward<location_base>(_loc), true)}
-    {}
+    rocprofiler_callback_phase_t phase     = ROCPROFILER_CALLBACK_PHASE_NONE;
+    std::string_view             name      = {};
+    size_t                       region    = 0;
+    size_t                       category  = 0;
+    uint64_t                     timestamp = 0;
+};
 
-    auto                 id() const { return m_location->index; }
-    auto                 hash() const { return m_location->hash(); }
-    const location_base* get_location() const { return m_location; }
+// events are collected per location in the pass over the records. Every location has its own
+// event writer so the locations are written independently of each other
+struct location_events
+{
+    std::string           name     = {};
+    const location_data*  location = nullptr;
+    std::vector<evt_data> events   = {};
+};
 
-    std::string name        = {};
-    uint64_t    event_count = 0;
+using location_map_t   = std::unordered_map<location_base, location_events, location_hash>;
+using location_entry_t = location_map_t::value_type;
 
-private:
-    const location_data* m_location = nullptr;
-};
+// order in which the locations are numbered and defined: threads, then memory copies, memory
+// allocations and kernel dispatches
+bool
+location_order(const location_entry_t* lhs, const location_entry_t* rhs)
+{
+    auto _rank = [](rocprofiler_location_type_t _type) {
+        switch(_type)
+        {
+            case ROCPROFILER_AGENT_NO_TYPE: return 0;
+            case ROCPROFILER_AGENT_MEMORY_COPY_TYPE: return 1;
+            case ROCPROFILER_AGENT_MEMORY_ALLOC_TYPE: return 2;
+            case ROCPROFILER_AGENT_DISPATCH_TYPE: return 3;
+        }
+        return 4;
+    };
 
-template <typename Tp>
-attribute_list_t*
-create_attribute_list()
+    auto _lhs_rank = _rank(lhs->first.type);
+    auto _rhs_rank = _rank(rhs->first.type);
+    if(_lhs_rank != _rhs_rank) return (_lhs_rank < _rhs_rank);
+    return (lhs->first < rhs->first);
+}
+
+void
+write_events(location_events& _data, const timestamps_t& _app_ts)
 {
-    auto* _val = OTF2_AttributeList_New();
+    std::sort(_data.events.begin(), _data.events.end(), [](const auto& lhs, const auto& rhs) {
+        if(lhs.timestamp != rhs.timestamp) return (lhs.timestamp < rhs.timestamp);
+        return (lhs.phase > rhs.phase);
+    });
+
+    auto* _evt_writer = _data.location->event_writer;
+    auto* _attributes = OTF2_AttributeList_New();
 
-    const auto* _name = sdk::perfetto_category<Tp>::name;
-    auto        _hash = get_hash_id(_name);
+    for(const auto& itr : _data.events)
+    {
+        if(itr.phase == ROCPROFILER_CALLBACK_PHASE_ENTER)
+        {
+            auto _attr_value      = OTF2_AttributeValue{};
+            _attr_value.stringRef = itr.category;
+            OTF2_AttributeList_RemoveAllAttributes(_attributes);
+            OTF2_AttributeList_AddAttribute(_attributes, 0, OTF2_TYPE_STRING, _attr_value);
+            OTF2_CHECK(OTF2_EvtWriter_Enter(_evt_writer, _attributes, itr.timestamp, itr.region))
+        }
+        else if(itr.phase == ROCPROFILER_CALLBACK_PHASE_EXIT)
+        {
+            OTF2_CHECK(OTF2_EvtWriter_Leave(_evt_writer, nullptr, itr.timestamp, itr.region))
+        }
+        else
+        {
+            ROCP_FATAL << "otf2::write_events phase is not enter or exit";
+        }
 
-    auto _attr_value      = OTF2_AttributeValue{};
-    _attr_value.stringRef = _hash;
-    OTF2_AttributeList_AddAttribute(_val, 0, OTF2_TYPE_STRING, _attr_value);
+        ROCP_ERROR_IF(itr.timestamp < _app_ts.app_start_time)
+            << "event found with timestamp < app start time by "
+            << (_app_ts.app_start_time - itr.timestamp) << " nsec :: " << itr.name;
+        ROCP_ERROR_IF(itr.timestamp > _app_ts.app_end_time)
+            << "event found with timestamp > app end time by "
+            << (itr.timestamp - _app_ts.app_end_time) << " nsec :: " << itr.name;
+    }
 
-    return _val;
+    OTF2_AttributeList_Delete(_attributes);
 }
 }  // namespace
 
 void
-write_otf2(const output_config&                                          cfg,
-           const metadata&                                               tool_metadata,
-           uint64_t                                                      pid,
-           const std::vector<agent_info>&                                agent_data,
-           std::deque<tool_buffer_tracing_hip_api_ext_record_t>*         hip_api_data,
-           std::deque<rocprofiler_buffer_tracing_hsa_api_record_t>*      hsa_api_data,
-           std::deque<tool_buffer_tracing_kernel_dispatch_ext_record_t>* kernel_dispatch_data,
-           std::deque<tool_buffer_tracing_memory_copy_ext_record_t>*     memory_copy_data,
-           std::deque<rocprofiler_buffer_tracing_marker_api_record_t>*   marker_api_data,
-           std::deque<rocprofiler_buffer_tracing_scratch_memory_record_t>* /*scratch_memory_data*/,
-           std::deque<rocprofiler_buffer_tracing_rccl_api_record_t>*       rccl_api_data,
-           std::deque<tool_buffer_tracing_memory_allocation_ext_record_t>* memory_allocation_data,
-           std::deque<rocprofiler_buffer_tracing_rocdecode_api_ext_record_t>* rocdecode_api_data,
-           std::deque<rocprofiler_buffer_tracing_rocjpeg_api_record_t>*       rocjpeg_api_data)
+write_otf2(
+    const output_config&                                                    cfg,
+    const metadata&                                                         tool_metadata,
+    uint64_t                                                                pid,
+    const std::vector<agent_info>&                                          agent_data,
+    const generator<tool_buffer_tracing_hip_api_ext_record_t>&              hip_api_gen,
+    const generator<rocprofiler_buffer_tracing_hsa_api_record_t>&           hsa_api_gen,
+    const generator<tool_buffer_tracing_kernel_dispatch_ext_record_t>&      kernel_dispatch_gen,
+    const generator<tool_buffer_tracing_memory_copy_ext_record_t>&          memory_copy_gen,
+    const generator<rocprofiler_buffer_tracing_marker_api_record_t>&        marker_api_gen,
+    const generator<rocprofiler_buffer_tracing_scratch_memory_record_t>&    /*scratch_memory_gen*/,
+    const generator<rocprofiler_buffer_tracing_rccl_api_record_t>&          rccl_api_gen,
+    const generator<tool_buffer_tracing_memory_allocation_ext_record_t>&    memory_allocation_gen,
+    const generator<rocprofiler_buffer_tracing_rocdecode_api_ext_record_t>& rocdecode_api_gen,
+    const generator<rocprofiler_buffer_tracing_rocjpeg_api_record_t>&       rocjpeg_api_gen)
 {
     namespace sdk = ::rocprofiler::sdk;
 
     setup(cfg);
 
-    auto _app_ts    = timestamps_t{tool_metadata.process_start_ns, tool_metadata.process_end_ns};
-    auto agents_map = tool_metadata.agents_map;
-
-    const auto  kernel_sym_data = tool_metadata.get_kernel_symbols();
-    const auto& buffer_names    = tool_metadata.buffer_names;
-    auto        tids            = std::set<rocprofiler_thread_id_t>{};
-    auto agent_thread_ids = std::map<rocprofiler_thread_id_t, std::set<rocprofiler_agent_id_t>>{};
-    auto agent_thread_ids_alloc =
-        std::map<rocprofiler_thread_id_t, std::set<rocprofiler_agent_id_t>>{};
-    auto agent_queue_ids =
-        std::map<rocprofiler_thread_id_t,
-                 std::map<rocprofiler_agent_id_t, std::unordered_set<rocprofiler_queue_id_t>>>{};
-
-    auto thread_event_info = std::map<rocprofiler_thread_id_t, event_info>{};
-    auto agent_memcpy_info =
-        std::map<rocprofiler_thread_id_t, std::map<rocprofiler_agent_id_t, event_info>>{};
-    auto agent_memalloc_info =
-        std::map<rocprofiler_thread_id_t, std::map<rocprofiler_agent_id_t, event_info>>{};
-    auto agent_dispatch_info =
-        std::map<rocprofiler_thread_id_t,
-                 std::map<rocprofiler_agent_id_t, std::map<rocprofiler_queue_id_t, event_info>>>{};
+    auto _app_ts = timestamps_t{tool_metadata.process_start_ns, tool_metadata.process_end_ns};
+    const auto& buffer_names = tool_metadata.buffer_names;
 
     auto _get_agent = [&agent_data](rocprofiler_agent_id_t _id) -> const rocprofiler_agent_t* {
         for(const auto& itr : agent_data)
@@ -402,342 +401,243 @@ write_otf2(const output_config&                                          cfg,
         return CHECK_NOTNULL(nullptr);
     };
 
-    auto _get_kernel_sym_data =
-        [&kernel_sym_data](
-            const rocprofiler_kernel_dispatch_info_t& _info) -> const kernel_symbol_info* {
-        for(const auto& kitr : kernel_sym_data)
-            if(kitr.kernel_id == _info.kernel_id) return &kitr;
-        return CHECK_NOTNULL(nullptr);
+    auto _hash_data = hash_map_t{};
+    auto _attr_str  = std::unordered_map<size_t, std::string_view>{};
+    auto _locations = location_map_t{};
+
+    auto add_region = [&_hash_data](std::string_view     _name,
+                                    OTF2_RegionRole_enum _role,
+                                    OTF2_Paradigm_enum   _paradigm) {
+        auto _hash = get_hash_id(_name);
+        if(_hash_data.count(_hash) == 0)
+            _hash_data.emplace(_hash, region_info{std::string{_name}, _role, _paradigm});
+        return _hash;
     };
 
-    {
-        for(auto itr : *hsa_api_data)
-            tids.emplace(itr.thread_id);
-        for(auto itr : *hip_api_data)
-            tids.emplace(itr.thread_id);
-        for(auto itr : *marker_api_data)
-            tids.emplace(itr.thread_id);
-        for(auto itr : *rccl_api_data)
-            tids.emplace(itr.thread_id);
-        for(auto itr : *rocdecode_api_data)
-            tids.emplace(itr.thread_id);
-        for(auto itr : *rocjpeg_api_data)
-            tids.emplace(itr.thread_id);
-
-        for(auto itr : *memory_copy_data)
+    auto get_category = [&_attr_str](auto _category) {
+        using category_t = common::mpl::unqualified_type_t<decltype(_category)>;
+        auto _name       = sdk::perfetto_category<category_t>::name;
+        auto _hash       = get_hash_id(_name);
+        _attr_str.emplace(_hash, _name);
+        return _hash;
+    };
+
+    // the locations are discovered in the same pass which collects their events. Every thread
+    // with device activity also gets a (possibly empty) thread location
+    auto add_event = [&_locations](const location_base& _location,
+                                   std::string_view     _name,
+                                   size_t               _region,
+                                   size_t               _category,
+                                   const auto&          _record) {
+        auto [itr, _inserted] = _locations.try_emplace(_location);
+        auto& _events         = itr->second.events;  // references remain valid on rehash
+        if(_inserted && _location.type != ROCPROFILER_AGENT_NO_TYPE)
+            _locations.try_emplace(location_base{_location.pid, _location.tid});
+
+        _events.emplace_back(evt_data{
+            ROCPROFILER_CALLBACK_PHASE_ENTER, _name, _region, _category, _record.start_timestamp});
+        _events.emplace_back(
+            evt_data{ROCPROFILER_CALLBACK_PHASE_EXIT, _name, _region, 0, _record.end_timestamp});
+    };
+
+    // trace events
+    auto add_api_events = [&](const auto& _gen, auto _category, OTF2_Paradigm_enum _paradigm) {
+        size_t _category_hash = 0;
+        for(auto ditr : _gen)
         {
-            tids.emplace(itr.thread_id);
-            agent_thread_ids[itr.thread_id].emplace(itr.dst_agent_id);
+            for(auto itr : _gen.get(ditr))
+            {
+                if(itr.kind == ROCPROFILER_BUFFER_TRACING_MARKER_CORE_RANGE_API &&
+                   itr.operation == ROCPROFILER_MARKER_CORE_RANGE_API_ID_roctxMarkA)
+                    continue;
+
+                using value_type = common::mpl::unqualified_type_t<decltype(itr)>;
+                auto name        = buffer_names.at(itr.kind, itr.operation);
+                if constexpr(std::is_same<value_type,
+                                          rocprofiler_buffer_tracing_marker_api_record_t>::value)
+                {
+                    if(itr.kind == ROCPROFILER_BUFFER_TRACING_MARKER_CORE_RANGE_API &&
+                       itr.operation != ROCPROFILER_MARKER_CORE_RANGE_API_ID_roctxGetThreadId)
+                        name = tool_metadata.get_marker_message(itr.correlation_id.internal);
+                }
+
+                if(_category_hash == 0) _category_hash = get_category(_category);
+                add_event(location_base{pid, itr.thread_id},
+                          name,
+                          add_region(name, OTF2_REGION_ROLE_FUNCTION, _paradigm),
+                          _category_hash,
+                          itr);
+            }
         }
+    };
+
+    add_api_events(hsa_api_gen, sdk::category::hsa_api{}, OTF2_PARADIGM_HIP);
+    add_api_events(hip_api_gen, sdk::category::hip_api{}, OTF2_PARADIGM_HIP);
+    add_api_events(marker_api_gen, sdk::category::marker_api{}, OTF2_PARADIGM_USER);
+    add_api_events(rccl_api_gen, sdk::category::rccl_api{}, OTF2_PARADIGM_HIP);
+    add_api_events(rocjpeg_api_gen, sdk::category::rocjpeg_api{}, OTF2_PARADIGM_HIP);
+    add_api_events(rocdecode_api_gen, sdk::category::rocdecode_api{}, OTF2_PARADIGM_USER);
 
-        for(auto itr : *memory_allocation_data)
+    for(auto ditr : memory_copy_gen)
+    {
+        for(auto itr : memory_copy_gen.get(ditr))
         {
-            tids.emplace(itr.thread_id);
-            agent_thread_ids_alloc[itr.thread_id].emplace(itr.agent_id);
+            auto name = buffer_names.at(itr.kind, itr.operation);
+
+            // TODO: add attributes for memory copy parameters
+
+            add_event(location_base{pid,
+                                    itr.thread_id,
+                                    itr.dst_agent_id,
+                                    ROCPROFILER_AGENT_MEMORY_COPY_TYPE},
+                      name,
+                      add_region(name, OTF2_REGION_ROLE_DATA_TRANSFER, OTF2_PARADIGM_HIP),
+                      get_category(sdk::category::memory_copy{}),
+                      itr);
         }
+    }
 
-        for(auto itr : *kernel_dispatch_data)
+    for(auto ditr : memory_allocation_gen)
+    {
+        for(auto itr : memory_allocation_gen.get(ditr))
         {
-            tids.emplace(itr.thread_id);
-            agent_queue_ids[itr.thread_id][itr.dispatch_info.agent_id].emplace(
-                itr.dispatch_info.queue_id);
+            auto name = buffer_names.at(itr.kind, itr.operation);
+
+            // TODO: add attributes for memory allocation parameters
+
+            add_event(location_base{pid,
+                                    itr.thread_id,
+                                    itr.agent_id,
+                                    ROCPROFILER_AGENT_MEMORY_ALLOC_TYPE},
+                      name,
+                      add_region(name, OTF2_REGION_ROLE_ALLOCATE, OTF2_PARADIGM_HIP),
+                      get_category(sdk::category::memory_allocation{}),
+                      itr);
         }
     }
 
+    for(auto ditr : kernel_dispatch_gen)
     {
-        for(auto itr : tids)
-            thread_event_info.emplace(itr, location_base{pid, itr});
-
-        for(const auto& [tid, itr] : agent_thread_ids)
-            for(auto agent : itr)
-                agent_memcpy_info[tid].emplace(
-                    agent, location_base{pid, tid, agent, ROCPROFILER_AGENT_MEMORY_COPY_TYPE});
-
-        for(const auto& [tid, itr] : agent_thread_ids_alloc)
-            for(auto agent : itr)
-                agent_memalloc_info[tid].emplace(
-                    agent, location_base{pid, tid, agent, ROCPROFILER_AGENT_MEMORY_ALLOC_TYPE});
-
-        for(const auto& [tid, itr] : agent_queue_ids)
-            for(const auto& [agent, qitr] : itr)
-                for(auto queue : qitr)
-                    agent_dispatch_info[tid][agent].emplace(
-                        queue,
-                        location_base{pid, tid, agent, ROCPROFILER_AGENT_DISPATCH_TYPE, queue});
+        for(auto itr : kernel_dispatch_gen.get(ditr))
+        {
+            const auto& info = itr.dispatch_info;
+            CHECK(tool_metadata.get_kernel_symbol(info.kernel_id) != nullptr);
+
+            auto name =
+                tool_metadata.get_kernel_name(info.kernel_id, itr.correlation_id.external.value);
+
+            // TODO: add attributes for kernel dispatch parameters
+
+            add_event(location_base{pid,
+                                    itr.thread_id,
+                                    info.agent_id,
+                                    ROCPROFILER_AGENT_DISPATCH_TYPE,
+                                    info.queue_id},
+                      name,
+                      add_region(name, OTF2_REGION_ROLE_FUNCTION, OTF2_PARADIGM_HIP),
+                      get_category(sdk::category::kernel_dispatch{}),
+                      itr);
+        }
     }
 
-    for(auto& [tid, evt] : thread_event_info)
+    auto _ordered = std::vector<location_entry_t*>{};
+    _ordered.reserve(_locations.size());
+    for(auto& itr : _locations)
+        _ordered.emplace_back(&itr);
+    std::sort(_ordered.begin(), _ordered.end(), location_order);
+
+    auto _queue_ids = std::map<rocprofiler_queue_id_t, uint64_t>{};
+    for(const auto* itr : _ordered)
+        if(itr->first.type == ROCPROFILER_AGENT_DISPATCH_TYPE)
+            _queue_ids.emplace(itr->first.queue, 0);
+
     {
-        evt.name = fmt::format("Thread {}", tid);
+        uint64_t _n = 0;
+        for(auto& qitr : _queue_ids)
+            qitr.second = _n++;
     }
 
-    for(auto& [tid, itr] : agent_memcpy_info)
+    for(auto* itr : _ordered)
     {
-        for(auto& [agent, evt] : itr)
+        const auto& _loc = itr->first;
+        auto&       _evt = itr->second;
+
+        _evt.location = get_locations().emplace_back(std::make_unique<location_data>(_loc)).get();
+
+        if(_loc.type == ROCPROFILER_AGENT_NO_TYPE)
         {
-            const auto* _agent = _get_agent(agent);
+            _evt.name = fmt::format("Thread {}", _loc.tid);
+        }
+        else if(_loc.type == ROCPROFILER_AGENT_MEMORY_COPY_TYPE)
+        {
+            const auto* _agent = _get_agent(_loc.agent);
             auto        agent_index_info =
                 tool_metadata.get_agent_index(_agent->id, cfg.agent_index_value);
-            evt.name = fmt::format("Thread {}, Copy to {} {}",
-                                   tid,
-                                   std::string{agent_index_info.type},
-                                   agent_index_info.as_string("-"));
+            _evt.name = fmt::format("Thread {}, Copy to {} {}",
+                                    _loc.tid,
+                                    std::string{agent_index_info.type},
+                                    agent_index_info.as_string("-"));
         }
-    }
-
-    for(auto& [tid, itr] : agent_memalloc_info)
-    {
-        for(auto& [agent, evt] : itr)
+        else if(_loc.type == ROCPROFILER_AGENT_MEMORY_ALLOC_TYPE)
         {
             // Free functions do not track agent information. Below handles case where
             // null rocprof agent id is passed to generate OTF2
             constexpr auto             null_rocp_agent_id = rocprofiler_agent_id_t{.handle = 0};
             const rocprofiler_agent_t* _agent             = nullptr;
-            if(agent != null_rocp_agent_id)
+            if(_loc.agent != null_rocp_agent_id)
             {
-                _agent = _get_agent(agent);
+                _agent = _get_agent(_loc.agent);
             }
             if(_agent)
             {
                 auto agent_index_info =
                     tool_metadata.get_agent_index(_agent->id, cfg.agent_index_value);
-                evt.name = fmt::format("Thread {}, Memory Operation at {} {}",
-                                       tid,
-                                       agent_index_info.type,
-                                       agent_index_info.as_string("-"));
+                _evt.name = fmt::format("Thread {}, Memory Operation at {} {}",
+                                        _loc.tid,
+                                        agent_index_info.type,
+                                        agent_index_info.as_string("-"));
             }
             else
             {
                 auto _type_name = std::string_view{"UNK"};
-                evt.name = fmt::format("Thread {}, Memory Operation at {} {}", tid, _type_name, 0);
+                _evt.name =
+                    fmt::format("Thread {}, Memory Operation at {} {}", _loc.tid, _type_name, 0);
             }
         }
-    }
-
-    auto _queue_ids = std::map<rocprofiler_queue_id_t, uint64_t>{};
-    for(auto& [tid, itr] : agent_dispatch_info)
-        for(auto& [agent, qitr] : itr)
-            for(auto& [queue, evt] : qitr)
-                _queue_ids.emplace(queue, 0);
-
-    {
-        uint64_t _n = 0;
-        for(auto& qitr : _queue_ids)
-            qitr.second = _n++;
-    }
-
-    for(auto& [tid, itr] : agent_dispatch_info)
-    {
-        for(auto& [agent, qitr] : itr)
+        else if(_loc.type == ROCPROFILER_AGENT_DISPATCH_TYPE)
         {
-            for(auto& [queue, evt] : qitr)
-            {
-                const auto* _agent = _get_agent(agent);
-                auto        agent_index_info =
-                    tool_metadata.get_agent_index(_agent->id, cfg.agent_index_value);
-                evt.name = fmt::format("Thread {}, Compute on {} {}, Queue {}",
-                                       tid,
-                                       agent_index_info.type,
-                                       agent_index_info.as_string("-"),
-                                       _queue_ids.at(queue));
-            }
+            const auto* _agent = _get_agent(_loc.agent);
+            auto        agent_index_info =
+                tool_metadata.get_agent_index(_agent->id, cfg.agent_index_value);
+            _evt.name = fmt::format("Thread {}, Compute on {} {}, Queue {}",
+                                    _loc.tid,
+                                    agent_index_info.type,
+                                    agent_index_info.as_string("-"),
+                                    _queue_ids.at(_loc.queue));
         }
     }
 
-    auto _hash_data = hash_map_t{};
-
-    struct evt_data
-    {
-        rocprofiler_callback_phase_t phase      = ROCPROFILER_CALLBACK_PHASE_NONE;
-        std::string_view             name       = {};
-        const location_base*         location   = nullptr;
-        uint64_t                     timestamp  = 0;
-        OTF2_AttributeList*          attributes = nullptr;
-    };
-
-    auto _data     = std::deque<evt_data>{};
-    auto _attr_str = std::unordered_map<size_t, std::string_view>{};
-    auto get_attr  = [&_attr_str](auto _category) {
-        using category_t = common::mpl::unqualified_type_t<decltype(_category)>;
-        auto _name       = sdk::perfetto_category<category_t>::name;
-        _attr_str.emplace(get_hash_id(_name), _name);
-        return create_attribute_list<category_t>();
-    };
-
-    // trace events
+    // each worker takes the next unwritten location, largest locations first
     {
-        auto callbk_name_info = sdk::get_callback_tracing_names();
-
-        auto add_event_data = [&buffer_names,
-                               &_hash_data,
-                               &_data,
-                               &tool_metadata,
-                               &thread_event_info,
-                               &get_attr](const auto* _inp, auto _attrib) {
-            if(!_inp) return;
-            for(auto itr : *_inp)
-            {
-                if(itr.kind == ROCPROFILER_BUFFER_TRACING_MARKER_CORE_RANGE_API &&
-                   itr.operation == ROCPROFILER_MARKER_CORE_RANGE_API_ID_roctxMarkA)
-                    continue;
-
-                using value_type = common::mpl::unqualified_type_t<decltype(itr)>;
-                auto name        = buffer_names.at(itr.kind, itr.operation);
-                auto paradigm    = OTF2_PARADIGM_HIP;
-                if constexpr(std::is_same<value_type,
-                                          rocprofiler_buffer_tracing_marker_api_record_t>::value)
-                {
-                    paradigm = OTF2_PARADIGM_USER;
-                    if(itr.kind == ROCPROFILER_BUFFER_TRACING_MARKER_CORE_RANGE_API &&
-                       itr.operation != ROCPROFILER_MARKER_CORE_RANGE_API_ID_roctxGetThreadId)
-                        name = tool_metadata.get_marker_message(itr.correlation_id.internal);
-                }
-
-                _hash_data.emplace(
-                    get_hash_id(name),
-                    region_info{std::string{name}, OTF2_REGION_ROLE_FUNCTION, paradigm});
-
-                auto& _evt_info = thread_event_info.at(itr.thread_id);
-                _evt_info.event_count += 1;
-                _data.emplace_back(evt_data{ROCPROFILER_CALLBACK_PHASE_ENTER,
-                                            name,
-                                            _evt_info.get_location(),
-                                            itr.start_timestamp,
-                                            get_attr(_attrib)});
-                _data.emplace_back(evt_data{ROCPROFILER_CALLBACK_PHASE_EXIT,
-                                            name,
-                                            _evt_info.get_location(),
-                                            itr.end_timestamp,
-                                            nullptr});
-            }
-        };
-
-        add_event_data(hsa_api_data, sdk::category::hsa_api{});
-        add_event_data(hip_api_data, sdk::category::hip_api{});
-        add_event_data(marker_api_data, sdk::category::marker_api{});
-        add_event_data(rccl_api_data, sdk::category::rccl_api{});
-        add_event_data(rocjpeg_api_data, sdk::category::rocjpeg_api{});
-    }
-
-    for(auto itr : *rocdecode_api_data)
-    {
-        auto name = buffer_names.at(itr.kind, itr.operation);
-        _hash_data.emplace(
-            get_hash_id(name),
-            region_info{std::string{name}, OTF2_REGION_ROLE_FUNCTION, OTF2_PARADIGM_USER});
-
-        auto& _evt_info = thread_event_info.at(itr.thread_id);
-        _evt_info.event_count += 1;
-
-        _data.emplace_back(evt_data{ROCPROFILER_CALLBACK_PHASE_ENTER,
-                                    name,
-                                    _evt_info.get_location(),
-                                    itr.start_timestamp,
-                                    get_attr(sdk::category::rocdecode_api{})});
-        _data.emplace_back(evt_data{ROCPROFILER_CALLBACK_PHASE_EXIT,
-                                    name,
-                                    _evt_info.get_location(),
-                                    itr.end_timestamp,
-                                    nullptr});
-    }
-
-    for(auto itr : *memory_copy_data)
-    {
-        auto name = buffer_names.at(itr.kind, itr.operation);
-        _hash_data.emplace(
-            get_hash_id(name),
-            region_info{std::string{name}, OTF2_REGION_ROLE_DATA_TRANSFER, OTF2_PARADIGM_HIP});
-
-        // TODO: add attributes for memory copy parameters
-
-        auto& _evt_info = agent_memcpy_info.at(itr.thread_id).at(itr.dst_agent_id);
-        _evt_info.event_count += 1;
-
-        _data.emplace_back(evt_data{ROCPROFILER_CALLBACK_PHASE_ENTER,
-                                    name,
-                                    _evt_info.get_location(),
-                                    itr.start_timestamp,
-                                    get_attr(sdk::category::memory_copy{})});
-        _data.emplace_back(evt_data{ROCPROFILER_CALLBACK_PHASE_EXIT,
-                                    name,
-                                    _evt_info.get_location(),
-                                    itr.end_timestamp,
-                                    nullptr});
-    }
-
-    for(auto itr : *memory_allocation_data)
-    {
-        auto name = buffer_names.at(itr.kind, itr.operation);
-        _hash_data.emplace(
-            get_hash_id(name),
-            region_info{std::string{name}, OTF2_REGION_ROLE_ALLOCATE, OTF2_PARADIGM_HIP});
-
-        // TODO: add attributes for memory allocation parameters
-
-        auto& _evt_info = agent_memalloc_info.at(itr.thread_id).at(itr.agent_id);
-        _evt_info.event_count += 1;
-
-        _data.emplace_back(evt_data{ROCPROFILER_CALLBACK_PHASE_ENTER,
-                                    name,
-                                    _evt_info.get_location(),
-                                    itr.start_timestamp,
-                                    get_attr(sdk::category::memory_allocation{})});
-        _data.emplace_back(evt_data{ROCPROFILER_CALLBACK_PHASE_EXIT,
-                                    name,
-                                    _evt_info.get_location(),
-                                    itr.end_timestamp,
-                                    nullptr});
-    }
-
-    for(auto itr : *kernel_dispatch_data)
-    {
-        const auto& info = itr.dispatch_info;
-        const auto* sym  = _get_kernel_sym_data(info);
-        CHECK(sym != nullptr);
-
-        auto name =
-            tool_metadata.get_kernel_name(info.kernel_id, itr.correlation_id.external.value);
-        _hash_data.emplace(
-            get_hash_id(name),
-            region_info{std::string{name}, OTF2_REGION_ROLE_FUNCTION, OTF2_PARADIGM_HIP});
-
-        // TODO: add attributes for kernel dispatch parameters
-
-        auto& _evt_info = agent_dispatch_info.at(itr.thread_id).at(info.agent_id).at(info.queue_id);
-        _evt_info.event_count += 1;
-
-        _data.emplace_back(evt_data{ROCPROFILER_CALLBACK_PHASE_ENTER,
-                                    name,
-                                    _evt_info.get_location(),
-                                    itr.start_timestamp,
-                                    get_attr(sdk::category::kernel_dispatch{})});
-        _data.emplace_back(evt_data{ROCPROFILER_CALLBACK_PHASE_EXIT,
-                                    name,
-                                    _evt_info.get_location(),
-                                    itr.end_timestamp,
-                                    nullptr});
-    }
-
-    std::sort(_data.begin(), _data.end(), [](const evt_data& lhs, const evt_data& rhs) {
-        if(lhs.timestamp != rhs.timestamp) return (lhs.timestamp < rhs.timestamp);
-        if(lhs.phase != rhs.phase) return (lhs.phase > rhs.phase);
-        return (*lhs.location < *rhs.location);
-    });
-
-    for(const auto& itr : _data)
-    {
-        add_event(itr.name, *itr.location, itr.phase, itr.timestamp, itr.attributes);
-        ROCP_ERROR_IF(itr.timestamp < _app_ts.app_start_time)
-            << "event found with timestamp < app start time by "
-            << (_app_ts.app_start_time - itr.timestamp) << " nsec :: " << itr.name;
-        ROCP_ERROR_IF(itr.timestamp > _app_ts.app_end_time)
-            << "event found with timestamp > app end time by "
-            << (itr.timestamp - _app_ts.app_end_time) << " nsec :: " << itr.name;
-    }
+        auto _pending = _ordered;
+        std::sort(_pending.begin(), _pending.end(), [](const auto* lhs, const auto* rhs) {
+            return (lhs->second.events.size() > rhs->second.events.size());
+        });
+
+        auto _next     = std::atomic<size_t>{0};
+        auto _nworkers = std::min<size_t>(_pending.size(),
+                                          std::max<size_t>(std::thread::hardware_concurrency(), 1));
+        auto _tasks    = std::vector<std::future<void>>{};
+        for(size_t i = 0; i < _nworkers; ++i)
+        {
+            _tasks.emplace_back(std::async(std::launch::async, [&_pending, &_next, &_app_ts]() {
+                for(auto _idx = _next++; _idx < _pending.size(); _idx = _next++)
+                    write_events(_pending.at(_idx)->second, _app_ts);
+            }));
+        }
 
-    for(const auto& itr : _data)
-    {
-        if(itr.attributes) OTF2_AttributeList_Delete(itr.attributes);
+        for(auto& itr : _tasks)
+            itr.get();
     }
 
     OTF2_CHECK(OTF2_Archive_CloseEvtFiles(archive));
@@ -854,83 +754,30 @@ write_otf2(const output_config&                                          cfg,
                                                            OTF2_UNDEFINED_LOCATION_GROUP));
     }
 
-    // Thread Events
-    for(auto& [tid, evt] : thread_event_info)
+    // Locations
+    for(const auto* itr : _ordered)
     {
-        auto _hash = get_hash_id(evt.name);
-
-        add_write_string(_hash, evt.name);
+        const auto& _loc  = itr->first;
+        const auto& _evt  = itr->second;
+        auto        _hash = get_hash_id(_evt.name);
+
+        // Using max numeric limits results in an out-of-bound runtime error for OTF2
+        // and perfetto for agent ids. Free functions have a null agent and use group 0.
+        auto _is_thread = (_loc.type == ROCPROFILER_AGENT_NO_TYPE);
+        auto _type      = (_is_thread) ? OTF2_LOCATION_TYPE_CPU_THREAD
+                                       : OTF2_LOCATION_TYPE_ACCELERATOR_STREAM;
+        auto _group     = (_is_thread) ? uint64_t{0} : _loc.agent.handle;
+
+        add_write_string(_hash, _evt.name);
         OTF2_CHECK(OTF2_GlobalDefWriter_WriteLocation(global_def_writer,
-                                                      evt.id(),  // id
+                                                      _evt.location->index,  // id
                                                       _hash,
-                                                      OTF2_LOCATION_TYPE_CPU_THREAD,
-                                                      2 * evt.event_count,  // # events
-                                                      0                     // location group
+                                                      _type,
+                                                      _evt.events.size(),  // # events
+                                                      _group               // location group
                                                       ));
     }
 
-    // Memcpy Events
-    for(auto& [tid, itr] : agent_memcpy_info)
-    {
-        for(auto& [agent, evt] : itr)
-        {
-            auto _hash = get_hash_id(evt.name);
-
-            add_write_string(_hash, evt.name);
-            OTF2_CHECK(OTF2_GlobalDefWriter_WriteLocation(global_def_writer,
-                                                          evt.id(),  // id
-                                                          _hash,
-                                                          OTF2_LOCATION_TYPE_ACCELERATOR_STREAM,
-                                                          2 * evt.event_count,  // # events
-                                                          agent.handle          // location group
-                                                          ));
-        }
-    }
-
-    // Memalloc Events
-    for(auto& [tid, itr] : agent_memalloc_info)
-    {
-        for(auto& [agent, evt] : itr)
-        {
-            auto _hash = get_hash_id(evt.name);
-            // Using max numeric limits results in an out-of-bound runtime error for OTF2
-            // and perfetto for agent ids. Setting handle to 0 for free functions.
-            constexpr auto null_rocp_agent_id = rocprofiler_agent_id_t{.handle = 0};
-            auto           handle             = agent.handle;
-            if(agent == null_rocp_agent_id) handle = 0;
-
-            add_write_string(_hash, evt.name);
-            OTF2_CHECK(OTF2_GlobalDefWriter_WriteLocation(global_def_writer,
-                                                          evt.id(),  // id
-                                                          _hash,
-                                                          OTF2_LOCATION_TYPE_ACCELERATOR_STREAM,
-                                                          2 * evt.event_count,  // # events
-                                                          handle                // location group
-                                                          ));
-        }
-    }
-
-    // Dispatch Events
-    for(auto& [tid, itr] : agent_dispatch_info)
-    {
-        for(auto& [agent, qitr] : itr)
-        {
-            for(auto& [queue, evt] : qitr)
-            {
-                auto _hash = get_hash_id(evt.name);
-
-                add_write_string(_hash, evt.name);
-                OTF2_CHECK(OTF2_GlobalDefWriter_WriteLocation(global_def_writer,
-                                                              evt.id(),  // id
-                                                              _hash,
-                                                              OTF2_LOCATION_TYPE_ACCELERATOR_STREAM,
-                                                              2 * evt.event_count,  // # events
-                                                              agent.handle  // location group
-                                                              ));
-            }
-        }
-    }
-
     shutdown();
 }
 
@@ -23,31 +23,33 @@
 #pragma once
 
 #include "agent_info.hpp"
+#include "generator.hpp"
 #include "metadata.hpp"
 #include "output_config.hpp"
 #include "stream_info.hpp"
 
 #include <cstdint>
-#include <deque>
+#include <vector>
 
 namespace rocprofiler
 {
 namespace tool
 {
 void
-write_otf2(const output_config&                                            cfg,
-           const metadata&                                                 tool_metadata,
-           uint64_t                                                        pid,
-           const std::vector<agent_info>&                                  agent_data,
-           std::deque<tool_buffer_tracing_hip_api_ext_record_t>*           hip_api_data,
-           std::deque<rocprofiler_buffer_tracing_hsa_api_record_t>*        hsa_api_data,
-           std::deque<tool_buffer_tracing_kernel_dispatch_ext_record_t>*   kernel_dispatch_data,
-           std::deque<tool_buffer_tracing_memory_copy_ext_record_t>*       memory_copy_data,
-           std::deque<rocprofiler_buffer_tracing_marker_api_record_t>*     marker_api_data,
-           std::deque<rocprofiler_buffer_tracing_scratch_memory_record_t>* scratch_memory_data,
-           std::deque<rocprofiler_buffer_tracing_rccl_api_record_t>*       rccl_api_data,
-           std::deque<tool_buffer_tracing_memory_allocation_ext_record_t>* memory_allocation_data,
-           std::deque<rocprofiler_buffer_tracing_rocdecode_api_ext_record_t>* rocdecode_api_data,
-           std::deque<rocprofiler_buffer_tracing_rocjpeg_api_record_t>*       rocjpeg_api_data);
+write_otf2(
+    const output_config&                                                    cfg,
+    const metadata&                                                         tool_metadata,
+    uint64_t                                                                pid,
+    const std::vector<agent_info>&                                          agent_data,
+    const generator<tool_buffer_tracing_hip_api_ext_record_t>&              hip_api_gen,
+    const generator<rocprofiler_buffer_tracing_hsa_api_record_t>&           hsa_api_gen,
+    const generator<tool_buffer_tracing_kernel_dispatch_ext_record_t>&      kernel_dispatch_gen,
+    const generator<tool_buffer_tracing_memory_copy_ext_record_t>&          memory_copy_gen,
+    const generator<rocprofiler_buffer_tracing_marker_api_record_t>&        marker_api_gen,
+    const generator<rocprofiler_buffer_tracing_scratch_memory_record_t>&    scratch_memory_gen,
+    const generator<rocprofiler_buffer_tracing_rccl_api_record_t>&          rccl_api_gen,
+    const generator<tool_buffer_tracing_memory_allocation_ext_record_t>&    memory_allocation_gen,
+    const generator<rocprofiler_buffer_tracing_rocdecode_api_ext_record_t>& rocdecode_api_gen,
+    const generator<rocprofiler_buffer_tracing_rocjpeg_api_record_t>&       rocjpeg_api_gen);
 }  // namespace tool
 }  // namespace rocprofiler
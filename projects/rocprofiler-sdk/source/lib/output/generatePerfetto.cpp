@@ -22,6 +22,7 @@
 
 #include "generatePerfetto.hpp"
 #include "output_stream.hpp"
+#include "pftrace_writer.hpp"
 #include "timestamps.hpp"
 
 #include "lib/common/utility.hpp"
@@ -37,9 +38,12 @@
 #include <atomic>
 #include <future>
 #include <iostream>
+#include <limits>
 #include <map>
+#include <set>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 namespace rocprofiler
@@ -61,6 +65,893 @@ get_hash_id(Tp&& _val)
     else
         return get_hash_id(*_val);
 }
+
+constexpr auto timestamp_buffer         = 1000;
+constexpr auto extremes_endpoint_buffer = 5000;
+constexpr auto bytes_multiplier         = 1024;
+
+struct memory_information
+{
+    uint64_t              alloc_size  = {0};
+    rocprofiler_address_t address     = {.handle = 0};
+    bool                  is_alloc_op = {false};
+};
+
+using memory_copy_endpoints_t =
+    std::map<rocprofiler_agent_id_t, std::map<rocprofiler_timestamp_t, uint64_t>>;
+using memory_allocation_endpoints_t =
+    std::unordered_map<rocprofiler_agent_id_t,
+                       std::map<rocprofiler_timestamp_t, memory_information>>;
+using scratch_memory_endpoints_t =
+    std::unordered_map<rocprofiler_agent_id_t, std::map<rocprofiler_timestamp_t, uint64_t>>;
+// Map: correlation_id -> map<counter_id, value>
+using dispatch_counter_values_t =
+    std::unordered_map<uint64_t, std::unordered_map<rocprofiler_counter_id_t, double>>;
+using counter_endpoints_t = std::unordered_map<
+    rocprofiler_agent_id_t,
+    std::unordered_map<rocprofiler_counter_id_t, std::map<uint64_t, uint64_t>>>;
+
+std::string
+get_thread_track_name(uint64_t thread_index, rocprofiler_thread_id_t tid)
+{
+    return fmt::format("THREAD {} ({})", thread_index, tid);
+}
+
+std::string
+get_copy_track_name(const rocprofiler_agent_t* agent, uint64_t thread_index)
+{
+    auto _type = std::string_view{"(UNK)"};
+    if(agent->type == ROCPROFILER_AGENT_TYPE_CPU)
+        _type = "(CPU)";
+    else if(agent->type == ROCPROFILER_AGENT_TYPE_GPU)
+        _type = "(GPU)";
+
+    return fmt::format(
+        "COPY to AGENT [{}] THREAD [{}] {}", agent->logical_node_id, thread_index, _type);
+}
+
+std::string
+get_queue_track_name(const agent_index& agent_index_info, uint32_t queue_index)
+{
+    return fmt::format("COMPUTE {} [{}] QUEUE [{}] {}",
+                       agent_index_info.label,
+                       agent_index_info.index,
+                       queue_index,
+                       agent_index_info.type);
+}
+
+std::string
+get_stream_track_name(uint64_t stream_id)
+{
+    return fmt::format("STREAM [\" {} \"] ", stream_id);
+}
+
+// e.g. "COPY BYTES to GPU [0] (GPU)"
+std::string
+get_agent_counter_track_name(std::string_view prefix, const agent_index& agent_index_info)
+{
+    return fmt::format("{} {} [{}] ({})",
+                       prefix,
+                       agent_index_info.label,
+                       agent_index_info.index,
+                       agent_index_info.type);
+}
+
+std::string
+get_pmc_track_name(const agent_index& agent_index_info, std::string_view counter_name)
+{
+    return fmt::format(
+        "{} [{}] PMC {}", agent_index_info.label, agent_index_info.index, counter_name);
+}
+
+// bytes in flight to each agent, sampled at the endpoints and midpoint of every copy
+memory_copy_endpoints_t
+get_memory_copy_endpoints(
+    const generator<tool_buffer_tracing_memory_copy_ext_record_t>& memory_copy_gen)
+{
+    auto mem_cpy_endpoints = memory_copy_endpoints_t{};
+    auto mem_cpy_extremes  = std::pair<uint64_t, uint64_t>{std::numeric_limits<uint64_t>::max(),
+                                                          std::numeric_limits<uint64_t>::min()};
+    for(auto ditr : memory_copy_gen)
+        for(auto itr : memory_copy_gen.get(ditr))
+        {
+            uint64_t _mean_timestamp =
+                itr.start_timestamp + (0.5 * (itr.end_timestamp - itr.start_timestamp));
+
+            mem_cpy_endpoints[itr.dst_agent_id].emplace(itr.start_timestamp - timestamp_buffer, 0);
+            mem_cpy_endpoints[itr.dst_agent_id].emplace(itr.start_timestamp, 0);
+            mem_cpy_endpoints[itr.dst_agent_id].emplace(_mean_timestamp, 0);
+            mem_cpy_endpoints[itr.dst_agent_id].emplace(itr.end_timestamp, 0);
+            mem_cpy_endpoints[itr.dst_agent_id].emplace(itr.end_timestamp + timestamp_buffer, 0);
+
+            mem_cpy_extremes = std::make_pair(std::min(mem_cpy_extremes.first, itr.start_timestamp),
+                                              std::max(mem_cpy_extremes.second, itr.end_timestamp));
+        }
+
+    for(auto ditr : memory_copy_gen)
+        for(auto itr : memory_copy_gen.get(ditr))
+        {
+            auto mbeg = mem_cpy_endpoints.at(itr.dst_agent_id).lower_bound(itr.start_timestamp);
+            auto mend = mem_cpy_endpoints.at(itr.dst_agent_id).upper_bound(itr.end_timestamp);
+
+            LOG_IF(FATAL, mbeg == mend) << "Missing range for timestamp [" << itr.start_timestamp
+                                        << ", " << itr.end_timestamp << "]";
+
+            for(auto mitr = mbeg; mitr != mend; ++mitr)
+                mitr->second += itr.bytes;
+        }
+
+    for(auto& mitr : mem_cpy_endpoints)
+    {
+        mitr.second.emplace(mem_cpy_extremes.first - extremes_endpoint_buffer, 0);
+        mitr.second.emplace(mem_cpy_extremes.second + extremes_endpoint_buffer, 0);
+    }
+
+    return mem_cpy_endpoints;
+}
+
+// running sum of the memory allocated on each agent
+memory_allocation_endpoints_t
+get_memory_allocation_endpoints(
+    const generator<tool_buffer_tracing_memory_allocation_ext_record_t>& memory_allocation_gen)
+{
+    constexpr auto null_rocp_agent_id = rocprofiler_agent_id_t{.handle = 0};
+    struct free_memory_information
+    {
+        rocprofiler_timestamp_t start_timestamp = 0;
+        rocprofiler_timestamp_t end_timestamp   = 0;
+        rocprofiler_address_t   address         = {.handle = 0};
+    };
+
+    struct agent_and_size
+    {
+        rocprofiler_agent_id_t agent_id = rocprofiler_agent_id_t{.handle = 0};
+        uint64_t               size     = {0};
+    };
+
+    auto mem_alloc_endpoints       = memory_allocation_endpoints_t{};
+    auto mem_alloc_extremes        = std::pair<uint64_t, uint64_t>{
+        std::numeric_limits<uint64_t>::max(), std::numeric_limits<uint64_t>::min()};
+    auto address_to_agent_and_size = std::unordered_map<rocprofiler_address_t, agent_and_size>{};
+    auto free_mem_info             = std::vector<free_memory_information>{};
+
+    // Load memory allocation endpoints
+    for(auto ditr : memory_allocation_gen)
+        for(auto itr : memory_allocation_gen.get(ditr))
+        {
+            if(itr.operation == ROCPROFILER_MEMORY_ALLOCATION_ALLOCATE ||
+               itr.operation == ROCPROFILER_MEMORY_ALLOCATION_VMEM_ALLOCATE)
+            {
+                LOG_IF(FATAL, itr.agent_id == null_rocp_agent_id)
+                    << "Missing agent id for memory allocation trace";
+                mem_alloc_endpoints[itr.agent_id].emplace(
+                    itr.start_timestamp,
+                    memory_information{itr.allocation_size, itr.address, true});
+                mem_alloc_endpoints[itr.agent_id].emplace(
+                    itr.end_timestamp, memory_information{itr.allocation_size, itr.address, true});
+                address_to_agent_and_size.emplace(
+                    itr.address, agent_and_size{itr.agent_id, itr.allocation_size});
+            }
+            else if(itr.operation == ROCPROFILER_MEMORY_ALLOCATION_FREE ||
+                    itr.operation == ROCPROFILER_MEMORY_ALLOCATION_VMEM_FREE)
+            {
+                // Store free memory operations in seperate vector to pair with agent
+                // and allocation size in following loop
+                free_mem_info.push_back(
+                    free_memory_information{itr.start_timestamp, itr.end_timestamp, itr.address});
+            }
+            else
+            {
+                ROCP_CI_LOG(WARNING) << "unhandled memory allocation type " << itr.operation;
+            }
+        }
+    // Add free memory operations to the endpoint map
+    for(const auto& itr : free_mem_info)
+    {
+        if(address_to_agent_and_size.count(itr.address) == 0)
+        {
+            if(itr.address.handle == 0)
+            {
+                // Freeing null pointers is expected behavior and is occurs in HSA functions
+                // like hipStreamDestroy
+                ROCP_INFO << "null pointer freed due to HSA operation";
+            }
+            else
+            {
+                // Following should not occur
+                ROCP_INFO << "Unpaired free operation occurred";
+            }
+            continue;
+        }
+        auto [agent_id, allocation_size] = address_to_agent_and_size[itr.address];
+        mem_alloc_endpoints[agent_id].emplace(
+            itr.start_timestamp, memory_information{allocation_size, itr.address, false});
+        mem_alloc_endpoints[agent_id].emplace(
+            itr.end_timestamp, memory_information{allocation_size, itr.address, false});
+    }
+    // Create running sum of allocated memory
+    for(auto& [_, endpoint_map] : mem_alloc_endpoints)
+    {
+        if(!endpoint_map.empty())
+        {
+            auto earliest_agent_timestamp = endpoint_map.begin()->first;
+            auto latest_agent_timestamp   = (--endpoint_map.end())->first;
+            mem_alloc_extremes =
+                std::make_pair(std::min(mem_alloc_extremes.first, earliest_agent_timestamp),
+                               std::max(mem_alloc_extremes.second, latest_agent_timestamp));
+        }
+        if(endpoint_map.size() <= 1)
+        {
+            continue;
+        }
+
+        auto prev = endpoint_map.begin();
+        auto itr  = std::next(prev);
+        for(; itr != endpoint_map.end(); ++itr, ++prev)
+        {
+            // If address or allocation type are different, add or subtract from running sum
+            if(prev->second.address != itr->second.address ||
+               prev->second.is_alloc_op != itr->second.is_alloc_op)
+            {
+                if(itr->second.is_alloc_op)
+                {
+                    itr->second.alloc_size += prev->second.alloc_size;
+                }
+                else if(prev->second.alloc_size >= itr->second.alloc_size)
+                {
+                    itr->second.alloc_size = prev->second.alloc_size - itr->second.alloc_size;
+                }
+            }
+            else
+            {
+                itr->second.alloc_size = prev->second.alloc_size;
+            }
+        }
+    }
+
+    for(auto& alloc_itr : mem_alloc_endpoints)
+    {
+        alloc_itr.second.emplace(mem_alloc_extremes.first - extremes_endpoint_buffer,
+                                 memory_information{0, {0}, false});
+        alloc_itr.second.emplace(mem_alloc_extremes.second + extremes_endpoint_buffer,
+                                 memory_information{0, {0}, false});
+    }
+
+    return mem_alloc_endpoints;
+}
+
+// scratch memory held by each agent
+scratch_memory_endpoints_t
+get_scratch_memory_endpoints(
+    const generator<rocprofiler_buffer_tracing_scratch_memory_record_t>& scratch_memory_gen)
+{
+    auto scratch_mem_endpoints = scratch_memory_endpoints_t{};
+    auto scratch_mem_extremes  = std::pair<uint64_t, uint64_t>{
+        std::numeric_limits<uint64_t>::max(), std::numeric_limits<uint64_t>::min()};
+
+    // Load scratch memory usage endpoints
+    for(auto ditr : scratch_memory_gen)
+        for(auto itr : scratch_memory_gen.get(ditr))
+        {
+            // Track start and end timestamps for this scratch memory record
+            scratch_mem_endpoints[itr.agent_id].emplace(itr.start_timestamp, 0);
+            scratch_mem_endpoints[itr.agent_id].emplace(itr.end_timestamp, 0);
+
+            // Update overall time range
+            scratch_mem_extremes =
+                std::make_pair(std::min(scratch_mem_extremes.first, itr.start_timestamp),
+                               std::max(scratch_mem_extremes.second, itr.end_timestamp));
+        }
+
+    // Load values at each endpoint
+    for(auto ditr : scratch_memory_gen)
+        for(auto itr : scratch_memory_gen.get(ditr))
+        {
+            // For each timestamp in the range of this record
+            auto begin = scratch_mem_endpoints.at(itr.agent_id).lower_bound(itr.start_timestamp);
+            auto end   = scratch_mem_endpoints.at(itr.agent_id).upper_bound(itr.end_timestamp);
+
+            for(auto mitr = begin; mitr != end; ++mitr)
+            {
+                // Add scratch memory size to the counter value at this timestamp
+                if(itr.operation == ROCPROFILER_SCRATCH_MEMORY_ALLOC)
+                    mitr->second = itr.allocation_size;
+                else if(itr.operation == ROCPROFILER_SCRATCH_MEMORY_FREE)
+                    mitr->second = 0;  // For all free events current allocation drops to 0.
+            }
+        }
+
+    // Add buffer timestamps for better visualization
+    for(auto& mitr : scratch_mem_endpoints)
+    {
+        if(!mitr.second.empty())
+        {
+            mitr.second.emplace(scratch_mem_extremes.first - extremes_endpoint_buffer, 0);
+            mitr.second.emplace(scratch_mem_extremes.second + extremes_endpoint_buffer, 0);
+        }
+    }
+
+    return scratch_mem_endpoints;
+}
+
+// Accumulate counters based on ID for each dispatch
+dispatch_counter_values_t
+get_dispatch_counter_values(const generator<tool_counter_record_t>& counter_collection_gen)
+{
+    auto dispatch_counter_id_value = dispatch_counter_values_t{};
+    for(auto ditr : counter_collection_gen)
+        for(const auto& record : counter_collection_gen.get(ditr))
+        {
+            auto& counter_id_value =
+                dispatch_counter_id_value[record.dispatch_data.correlation_id.internal];
+            auto record_vector = record.read();
+
+            for(auto& count : record_vector)
+            {
+                counter_id_value[count.id] += count.value;
+            }
+        }
+    return dispatch_counter_id_value;
+}
+
+// value of each counter per agent, held for the duration of the dispatch
+counter_endpoints_t
+get_counter_endpoints(const generator<tool_counter_record_t>& counter_collection_gen,
+                      const dispatch_counter_values_t&        dispatch_counter_id_value)
+{
+    auto counters_endpoints = counter_endpoints_t{};
+    auto counters_extremes  = std::pair<uint64_t, uint64_t>{std::numeric_limits<uint64_t>::max(),
+                                                           std::numeric_limits<uint64_t>::min()};
+
+    for(auto ditr : counter_collection_gen)
+        for(const auto& record : counter_collection_gen.get(ditr))
+        {
+            const auto& info = record.dispatch_data.dispatch_info;
+
+            const auto& start_timestamp = record.dispatch_data.start_timestamp;
+            const auto& end_timestamp   = record.dispatch_data.end_timestamp;
+
+            uint64_t _mean_timestamp = start_timestamp + (0.5 * (end_timestamp - start_timestamp));
+
+            auto corr_id = record.dispatch_data.correlation_id.internal;
+            auto it      = dispatch_counter_id_value.find(corr_id);
+            if(it != dispatch_counter_id_value.end())
+            {
+                for(const auto& [counter_id, counter_value] : it->second)
+                {
+                    auto& endpoints = counters_endpoints[info.agent_id][counter_id];
+                    endpoints.emplace(start_timestamp - timestamp_buffer, 0);
+                    endpoints.emplace(start_timestamp, counter_value);
+                    endpoints.emplace(_mean_timestamp, counter_value);
+                    endpoints.emplace(end_timestamp, 0);
+                    endpoints.emplace(end_timestamp + timestamp_buffer, 0);
+                }
+            }
+
+            counters_extremes = std::make_pair(std::min(counters_extremes.first, start_timestamp),
+                                               std::max(counters_extremes.second, end_timestamp));
+        }
+
+    for(auto& aitr : counters_endpoints)
+        for(auto& citr : aitr.second)
+        {
+            citr.second.emplace(counters_extremes.first - extremes_endpoint_buffer, 0);
+            citr.second.emplace(counters_extremes.second + extremes_endpoint_buffer, 0);
+        }
+
+    return counters_endpoints;
+}
+
+// Serializes the trace packets directly from the generators instead of going through a
+// perfetto tracing session. Each domain is written by its own task on its own packet
+// sequence, so the strings are interned per domain and the domains are encoded in parallel.
+void
+write_perfetto_direct(
+    const output_config&                                                    ocfg,
+    const metadata&                                                         tool_metadata,
+    const std::vector<agent_info>&                                          agent_data,
+    const generator<tool_buffer_tracing_hip_api_ext_record_t>&              hip_api_gen,
+    const generator<rocprofiler_buffer_tracing_hsa_api_record_t>&           hsa_api_gen,
+    const generator<tool_buffer_tracing_kernel_dispatch_ext_record_t>&      kernel_dispatch_gen,
+    const generator<tool_buffer_tracing_memory_copy_ext_record_t>&          memory_copy_gen,
+    const generator<tool_counter_record_t>&                                 counter_collection_gen,
+    const generator<rocprofiler_buffer_tracing_marker_api_record_t>&        marker_api_gen,
+    const generator<rocprofiler_buffer_tracing_scratch_memory_record_t>&    scratch_memory_gen,
+    const generator<rocprofiler_buffer_tracing_rccl_api_record_t>&          rccl_api_gen,
+    const generator<tool_buffer_tracing_memory_allocation_ext_record_t>&    memory_allocation_gen,
+    const generator<rocprofiler_buffer_tracing_rocdecode_api_ext_record_t>& rocdecode_api_gen,
+    const generator<rocprofiler_buffer_tracing_rocjpeg_api_record_t>&       rocjpeg_api_gen)
+{
+    namespace sdk = ::rocprofiler::sdk;
+
+    using pftrace::annotation;
+    using pftrace::counter_unit;
+    using pftrace::sequence_writer;
+
+    const auto is_hip_initialized =
+        tool_metadata.is_runtime_initialized(ROCPROFILER_RUNTIME_INITIALIZATION_HIP);
+    const auto group_by_queue = ocfg.group_by_queue || !is_hip_initialized;
+    const auto process_uuid =
+        (tool_metadata.process_start_ns ^ static_cast<uint64_t>(tool_metadata.process_id)) | 1;
+
+    auto get_track_uuid = [process_uuid](std::string_view _name) {
+        return get_hash_id(std::string_view{_name}) ^ process_uuid;
+    };
+    auto get_flow_id = [process_uuid](uint64_t _corr_id) { return _corr_id ^ process_uuid; };
+
+    auto _get_agent = [&agent_data](rocprofiler_agent_id_t _id) -> const rocprofiler_agent_t* {
+        for(const auto& itr : agent_data)
+        {
+            if(_id == itr.id) return &itr;
+        }
+        return CHECK_NOTNULL(nullptr);
+    };
+
+    auto tids             = std::set<rocprofiler_thread_id_t>{};
+    auto agent_thread_ids = std::unordered_map<rocprofiler_agent_id_t, std::set<uint64_t>>{};
+    auto agent_queue_ids =
+        std::unordered_map<rocprofiler_agent_id_t, std::unordered_set<rocprofiler_queue_id_t>>{};
+    auto agent_stream_ids = std::unordered_set<rocprofiler_stream_id_t>{};
+
+    {
+        auto _add_tids = [&tids](const auto& _gen) {
+            for(auto ditr : _gen)
+                for(const auto& itr : _gen.get(ditr))
+                    tids.emplace(itr.thread_id);
+        };
+
+        _add_tids(hsa_api_gen);
+        _add_tids(hip_api_gen);
+        _add_tids(marker_api_gen);
+        _add_tids(rccl_api_gen);
+        _add_tids(rocdecode_api_gen);
+        _add_tids(rocjpeg_api_gen);
+        _add_tids(memory_allocation_gen);
+
+        for(auto ditr : memory_copy_gen)
+            for(auto itr : memory_copy_gen.get(ditr))
+            {
+                tids.emplace(itr.thread_id);
+                agent_stream_ids.emplace(itr.stream_id);
+                if(group_by_queue) agent_thread_ids[itr.dst_agent_id].emplace(itr.thread_id);
+            }
+
+        for(auto ditr : kernel_dispatch_gen)
+            for(auto itr : kernel_dispatch_gen.get(ditr))
+            {
+                tids.emplace(itr.thread_id);
+                agent_stream_ids.emplace(itr.stream_id);
+                if(group_by_queue)
+                    agent_queue_ids[itr.dispatch_info.agent_id].emplace(
+                        itr.dispatch_info.queue_id);
+            }
+    }
+
+    auto filename = std::string{"results"};
+    auto ofs      = get_output_stream(ocfg, filename, ".pftrace");
+    auto _output  = pftrace::output{*ofs.stream};
+
+    auto thread_indexes = std::unordered_map<rocprofiler_thread_id_t, uint64_t>{};
+    auto thread_tracks  = std::unordered_map<rocprofiler_thread_id_t, uint64_t>{};
+    auto agent_thread_tracks =
+        std::unordered_map<rocprofiler_agent_id_t, std::unordered_map<uint64_t, uint64_t>>{};
+    auto agent_queue_tracks =
+        std::unordered_map<rocprofiler_agent_id_t,
+                           std::unordered_map<rocprofiler_queue_id_t, uint64_t>>{};
+    auto stream_tracks = std::unordered_map<rocprofiler_stream_id_t, uint64_t>{};
+
+    // the track descriptors are written up front on the first sequence
+    uint32_t sequence_id = 1;
+    {
+        auto _seq = sequence_writer{_output, sequence_id};
+
+        auto _process_name = std::string{};
+        for(const auto& itr : tool_metadata.command_line)
+            _process_name += (_process_name.empty()) ? itr : fmt::format(" {}", itr);
+        _seq.process_track(process_uuid, tool_metadata.process_id, _process_name);
+
+        uint64_t nthrn = 0;
+        for(auto itr : tids)
+        {
+            auto _uuid = itr ^ process_uuid;
+            if(itr == main_tid)
+            {
+                thread_indexes.emplace(itr, 0);
+                _seq.thread_track(
+                    _uuid, process_uuid, tool_metadata.process_id, static_cast<int32_t>(itr));
+            }
+            else
+            {
+                auto _idx = ++nthrn;
+                thread_indexes.emplace(itr, _idx);
+                _seq.track(_uuid, process_uuid, get_thread_track_name(_idx, itr));
+            }
+            thread_tracks.emplace(itr, _uuid);
+        }
+
+        for(const auto& itr : agent_thread_ids)
+        {
+            const auto* _agent = _get_agent(itr.first);
+            for(auto titr : itr.second)
+            {
+                auto _name = get_copy_track_name(_agent, thread_indexes.at(titr));
+                auto _uuid = get_track_uuid(_name);
+                _seq.track(_uuid, process_uuid, _name);
+                agent_thread_tracks[itr.first].emplace(titr, _uuid);
+            }
+        }
+
+        for(const auto& aitr : agent_queue_ids)
+        {
+            uint32_t nqueue = 0;
+            auto     agent_index_info =
+                tool_metadata.get_agent_index(aitr.first, ocfg.agent_index_value);
+            for(auto qitr : aitr.second)
+            {
+                auto _name = get_queue_track_name(agent_index_info, nqueue++);
+                auto _uuid = get_track_uuid(_name);
+                _seq.track(_uuid, process_uuid, _name);
+                agent_queue_tracks[aitr.first].emplace(qitr, _uuid);
+            }
+        }
+
+        for(const auto& sitr : agent_stream_ids)
+        {
+            auto _name = get_stream_track_name(sitr.handle);
+            auto _uuid = get_track_uuid(_name);
+            _seq.track(_uuid, process_uuid, _name);
+            stream_tracks.emplace(sitr, _uuid);
+        }
+    }
+
+    auto counter_id_to_name = std::unordered_map<rocprofiler_counter_id_t, std::string_view>{};
+    for(const auto& itr : tool_metadata.get_counter_info())
+        counter_id_to_name.emplace(itr.id, itr.name);
+
+    const auto dispatch_counter_id_value = get_dispatch_counter_values(counter_collection_gen);
+    const auto buffer_names              = sdk::get_buffer_tracing_names();
+
+    auto _write_counter_track = [&](sequence_writer&  _seq,
+                                    std::string_view  _name,
+                                    counter_unit      _unit,
+                                    const auto&       _endpoints,
+                                    auto&&            _get_value) {
+        auto _uuid = get_track_uuid(_name);
+        _seq.counter_track(_uuid,
+                           process_uuid,
+                           _name,
+                           _unit,
+                           (_unit == counter_unit::size_bytes) ? bytes_multiplier : 0,
+                           false);
+        for(const auto& itr : _endpoints)
+            _seq.counter(_uuid, itr.first, static_cast<int64_t>(_get_value(itr.second)));
+    };
+
+    auto _write_api_trace = [&](sequence_writer&                _seq,
+                                std::string_view                _category,
+                                const auto&                     _record,
+                                std::string_view                _name,
+                                const std::vector<annotation>& _extra = {}) {
+        auto _track = thread_tracks.at(_record.thread_id);
+        _seq.slice_begin(_track,
+                         _record.start_timestamp,
+                         _category,
+                         _name,
+                         get_flow_id(_record.correlation_id.internal),
+                         {{"begin_ns", _record.start_timestamp},
+                          {"end_ns", _record.end_timestamp},
+                          {"delta_ns", (_record.end_timestamp - _record.start_timestamp)},
+                          {"tid", _record.thread_id},
+                          {"kind", _record.kind},
+                          {"operation", _record.operation},
+                          {"corr_id", _record.correlation_id.internal},
+                          {"ancestor_id", _record.correlation_id.ancestor}},
+                         _extra);
+        _seq.slice_end(_track, _record.end_timestamp, _category);
+    };
+
+    auto _tasks = std::vector<std::future<void>>{};
+    auto _write = [&_tasks, &_output, &sequence_id](auto&& _func) {
+        auto _id = ++sequence_id;
+        _tasks.emplace_back(std::async(std::launch::async, [&_output, _func, _id]() {
+            auto _seq = sequence_writer{_output, _id};
+            _func(_seq);
+        }));
+    };
+
+    _write([&](sequence_writer& _seq) {
+        constexpr auto category = sdk::perfetto_category<sdk::category::hsa_api>::name;
+        for(auto ditr : hsa_api_gen)
+            for(auto itr : hsa_api_gen.get(ditr))
+                _write_api_trace(_seq, category, itr, buffer_names.at(itr.kind, itr.operation));
+    });
+
+    _write([&](sequence_writer& _seq) {
+        constexpr auto category = sdk::perfetto_category<sdk::category::hip_api>::name;
+        auto           _extra   = std::vector<annotation>{};
+        for(auto ditr : hip_api_gen)
+            for(auto itr : hip_api_gen.get(ditr))
+            {
+                _extra.clear();
+                _extra.emplace_back("stream_ID", itr.stream_id.handle);
+                _write_api_trace(
+                    _seq, category, itr, buffer_names.at(itr.kind, itr.operation), _extra);
+            }
+    });
+
+    _write([&](sequence_writer& _seq) {
+        constexpr auto category = sdk::perfetto_category<sdk::category::marker_api>::name;
+        for(auto ditr : marker_api_gen)
+            for(auto itr : marker_api_gen.get(ditr))
+            {
+                auto name = (itr.kind == ROCPROFILER_BUFFER_TRACING_MARKER_CORE_RANGE_API &&
+                             itr.operation != ROCPROFILER_MARKER_CORE_RANGE_API_ID_roctxGetThreadId)
+                                ? tool_metadata.get_marker_message(itr.correlation_id.internal)
+                                : buffer_names.at(itr.kind, itr.operation);
+                _write_api_trace(_seq, category, itr, name);
+            }
+    });
+
+    _write([&](sequence_writer& _seq) {
+        constexpr auto category = sdk::perfetto_category<sdk::category::rccl_api>::name;
+        for(auto ditr : rccl_api_gen)
+            for(auto itr : rccl_api_gen.get(ditr))
+                _write_api_trace(_seq, category, itr, buffer_names.at(itr.kind, itr.operation));
+    });
+
+    _write([&](sequence_writer& _seq) {
+        constexpr auto category = sdk::perfetto_category<sdk::category::rocdecode_api>::name;
+        auto           _extra   = std::vector<annotation>{};
+        for(auto ditr : rocdecode_api_gen)
+            for(auto itr : rocdecode_api_gen.get(ditr))
+            {
+                auto rocdecode_args = sdk::serialization::get_buffer_tracing_args(itr);
+                _extra.clear();
+                for(const auto& rocdecode_arg : rocdecode_args)
+                    _extra.emplace_back(rocdecode_arg.name, rocdecode_arg.value);
+                _write_api_trace(
+                    _seq, category, itr, buffer_names.at(itr.kind, itr.operation), _extra);
+            }
+    });
+
+    _write([&](sequence_writer& _seq) {
+        constexpr auto category = sdk::perfetto_category<sdk::category::rocjpeg_api>::name;
+        for(auto ditr : rocjpeg_api_gen)
+            for(auto itr : rocjpeg_api_gen.get(ditr))
+                _write_api_trace(_seq, category, itr, buffer_names.at(itr.kind, itr.operation));
+    });
+
+    // memory copy slices and the copy bytes counter tracks both read the memory copy generator
+    _write([&](sequence_writer& _seq) {
+        constexpr auto category = sdk::perfetto_category<sdk::category::memory_copy>::name;
+        for(auto ditr : memory_copy_gen)
+            for(auto itr : memory_copy_gen.get(ditr))
+            {
+                auto _track = (group_by_queue)
+                                  ? agent_thread_tracks.at(itr.dst_agent_id).at(itr.thread_id)
+                                  : stream_tracks.at(itr.stream_id);
+
+                _seq.slice_begin(
+                    _track,
+                    itr.start_timestamp,
+                    category,
+                    buffer_names.at(itr.kind, itr.operation),
+                    get_flow_id(itr.correlation_id.internal),
+                    {{"begin_ns", itr.start_timestamp},
+                     {"end_ns", itr.end_timestamp},
+                     {"delta_ns", (itr.end_timestamp - itr.start_timestamp)},
+                     {"kind", itr.kind},
+                     {"operation", itr.operation},
+                     {"src_agent",
+                      tool_metadata.get_agent_index(itr.src_agent_id, ocfg.agent_index_value)
+                          .as_string("-")},
+                     {"dst_agent",
+                      tool_metadata.get_agent_index(itr.dst_agent_id, ocfg.agent_index_value)
+                          .as_string("-")},
+                     {"copy_bytes", itr.bytes},
+                     {"corr_id", itr.correlation_id.internal},
+                     {"tid", itr.thread_id},
+                     {"stream_ID", itr.stream_id.handle}});
+                _seq.slice_end(_track, itr.end_timestamp, category);
+            }
+
+        for(const auto& mitr : get_memory_copy_endpoints(memory_copy_gen))
+        {
+            auto agent_index_info =
+                tool_metadata.get_agent_index(mitr.first, ocfg.agent_index_value);
+            _write_counter_track(_seq,
+                                 get_agent_counter_track_name("COPY BYTES to", agent_index_info),
+                                 counter_unit::size_bytes,
+                                 mitr.second,
+                                 [](uint64_t _val) { return _val / bytes_multiplier; });
+        }
+    });
+
+    _write([&](sequence_writer& _seq) {
+        constexpr auto category = sdk::perfetto_category<sdk::category::kernel_dispatch>::name;
+        auto           demangled = std::unordered_map<std::string_view, std::string>{};
+        auto           _extra    = std::vector<annotation>{};
+        for(auto ditr : kernel_dispatch_gen)
+        {
+            auto generator = kernel_dispatch_gen.get(ditr);
+            // Group kernels on the same queue and agent. Temporary fix for firmware timestamp bug
+            // Can be removed once bug is resolved.
+            auto dispatch_bins = std::unordered_map<
+                rocprofiler_agent_id_t,
+                std::unordered_map<
+                    rocprofiler_queue_id_t,
+                    std::vector<tool_buffer_tracing_kernel_dispatch_ext_record_t*>>>{};
+            for(auto& itr : generator)
+            {
+                const auto& info = itr.dispatch_info;
+                dispatch_bins[info.agent_id][info.queue_id].emplace_back(&itr);
+            }
+
+            for(auto& aitr : dispatch_bins)
+            {
+                for(auto& qitr : aitr.second)
+                {
+                    // Sort kernels on the same queue and agent by timestamp
+                    std::sort(qitr.second.begin(),
+                              qitr.second.end(),
+                              [](const auto* lhs, const auto* rhs) {
+                                  return lhs->start_timestamp < rhs->start_timestamp;
+                              });
+
+                    for(auto it = qitr.second.begin(); it != qitr.second.end(); ++it)
+                    {
+                        auto&                     current = **it;
+                        const auto&               info    = current.dispatch_info;
+                        const kernel_symbol_info* sym =
+                            tool_metadata.get_kernel_symbol(info.kernel_id);
+
+                        CHECK(sym != nullptr);
+
+                        auto name      = std::string_view{sym->kernel_name};
+                        auto stream_id = current.stream_id;
+                        auto _track =
+                            (group_by_queue)
+                                ? agent_queue_tracks.at(info.agent_id).at(info.queue_id)
+                                : stream_tracks.at(stream_id);
+
+                        // Same firmware timestamp fixup as the tracing session path: overlapping
+                        // dispatches on a queue are split at the midpoint of the overlap.
+                        auto next = std::next(it);
+                        if(next != qitr.second.end() &&
+                           (*next)->start_timestamp < current.end_timestamp)
+                        {
+                            auto start = (*next)->start_timestamp;
+                            auto end   = std::min(current.end_timestamp, (*next)->end_timestamp);
+                            auto mid   = start + (end - start) / 2;
+                            ROCP_INFO << fmt::format(
+                                "Kernel ending timestamp increased by {} ns to {} ns with "
+                                "following kernel starting timestamp decreased by {} ns to {} ns "
+                                "due to firmware timestamp error.",
+                                (current.end_timestamp - mid),
+                                mid,
+                                (mid - (*next)->start_timestamp),
+                                mid);
+                            current.end_timestamp    = mid;
+                            (*next)->start_timestamp = mid;
+                        }
+
+                        if(demangled.find(name) == demangled.end())
+                        {
+                            demangled.emplace(name, common::cxx_demangle(name));
+                        }
+                        // Queue IDs are 1 higher than the track name. Subtracting 1 for consistency
+                        auto queue_id = info.queue_id.handle > 0 ? info.queue_id.handle - 1 : 0;
+                        auto agent_index_info =
+                            tool_metadata.get_agent_index(info.agent_id, ocfg.agent_index_value);
+
+                        _extra.clear();
+                        auto counter_it =
+                            dispatch_counter_id_value.find(current.correlation_id.internal);
+                        if(counter_it != dispatch_counter_id_value.end())
+                        {
+                            for(const auto& [counter_id, counter_value] : counter_it->second)
+                            {
+                                auto name_it = counter_id_to_name.find(counter_id);
+                                if(name_it != counter_id_to_name.end())
+                                    _extra.emplace_back(name_it->second, counter_value);
+                            }
+                        }
+
+                        _seq.slice_begin(
+                            _track,
+                            current.start_timestamp,
+                            category,
+                            demangled.at(name),
+                            get_flow_id(current.correlation_id.internal),
+                            {{"begin_ns", current.start_timestamp},
+                             {"end_ns", current.end_timestamp},
+                             {"delta_ns", (current.end_timestamp - current.start_timestamp)},
+                             {"kind", current.kind},
+                             {"agent", agent_index_info.as_string("-")},
+                             {"agent_type", agent_index_info.type},
+                             {"corr_id", current.correlation_id.internal},
+                             {"queue", queue_id},
+                             {"tid", current.thread_id},
+                             {"kernel_id", info.kernel_id},
+                             {"Scratch_Size", info.private_segment_size},
+                             {"LDS_Block_Size", info.group_segment_size},
+                             {"VGPR_Count", sym->arch_vgpr_count},
+                             {"Accum_VGPR_Count", sym->accum_vgpr_count},
+                             {"SGPR_Count", sym->sgpr_count},
+                             {"workgroup_size",
+                              info.workgroup_size.x * info.workgroup_size.y *
+                                  info.workgroup_size.z},
+                             {"grid_size", info.grid_size.x * info.grid_size.y * info.grid_size.z},
+                             {"stream_ID", stream_id.handle}},
+                            _extra);
+                        _seq.slice_end(_track, current.end_timestamp, category);
+                    }
+                }
+            }
+        }
+    });
+
+    _write([&](sequence_writer& _seq) {
+        for(const auto& alloc_itr : get_memory_allocation_endpoints(memory_allocation_gen))
+        {
+            auto agent_index_info =
+                tool_metadata.get_agent_index(alloc_itr.first, ocfg.agent_index_value);
+            _write_counter_track(
+                _seq,
+                get_agent_counter_track_name("ALLOCATE BYTES on", agent_index_info),
+                counter_unit::size_bytes,
+                alloc_itr.second,
+                [](const memory_information& _val) { return _val.alloc_size / bytes_multiplier; });
+        }
+    });
+
+    _write([&](sequence_writer& _seq) {
+        for(const auto& mitr : get_scratch_memory_endpoints(scratch_memory_gen))
+        {
+            if(mitr.second.empty()) continue;
+
+            auto agent_index_info =
+                tool_metadata.get_agent_index(mitr.first, ocfg.agent_index_value);
+            _write_counter_track(
+                _seq,
+                get_agent_counter_track_name("SCRATCH MEMORY on", agent_index_info),
+                counter_unit::size_bytes,
+                mitr.second,
+                [](uint64_t _val) { return _val / bytes_multiplier; });
+        }
+    });
+
+    // each PMC track is written once with all of its endpoints
+    _write([&](sequence_writer& _seq) {
+        auto counters_endpoints =
+            get_counter_endpoints(counter_collection_gen, dispatch_counter_id_value);
+        for(const auto& aitr : counters_endpoints)
+        {
+            auto agent_index_info =
+                tool_metadata.get_agent_index(aitr.first, ocfg.agent_index_value);
+            for(const auto& citr : aitr.second)
+            {
+                _write_counter_track(
+                    _seq,
+                    get_pmc_track_name(agent_index_info, counter_id_to_name.at(citr.first)),
+                    counter_unit::unspecified,
+                    citr.second,
+                    [](uint64_t _val) { return _val; });
+            }
+        }
+    });
+
+    for(auto& itr : _tasks)
+        itr.get();
+
+    ROCP_INFO << "Wrote " << _output.bytes_written() << " B to perfetto trace file";
+
+    ROCP_TRACE << "Flushing trace output stream...";
+    (*ofs.stream) << std::flush;
+
+    ROCP_TRACE << "Destroying trace output stream...";
+    ofs.close();
+}
 }  // namespace
 
 void
@@ -82,6 +973,25 @@ write_perfetto(
 {
     namespace sdk = ::rocprofiler::sdk;
 
+    if(ocfg.perfetto_backend == "direct")
+    {
+        write_perfetto_direct(ocfg,
+                              tool_metadata,
+                              agent_data,
+                              hip_api_gen,
+                              hsa_api_gen,
+                              kernel_dispatch_gen,
+                              memory_copy_gen,
+                              counter_collection_gen,
+                              marker_api_gen,
+                              scratch_memory_gen,
+                              rccl_api_gen,
+                              memory_allocation_gen,
+                              rocdecode_api_gen,
+                              rocjpeg_api_gen);
+        return;
+    }
+
     // auto     root_process_track = ::perfetto::Track{};
     // uint64_t process_uuid       = tool_metadata.process_start_ns ^ tool_metadata.process_id;
     // auto     process_track      = ::perfetto::Track{process_uuid, root_process_track};
@@ -124,7 +1034,7 @@ write_perfetto(
         args.backends |= ::perfetto::kSystemBackend;
     else
         ROCP_FATAL << "Unsupport perfetto backend: '" << ocfg.perfetto_backend
-                   << "'. Supported: inprocess, system";
+                   << "'. Supported: inprocess, system, direct";
 
     ::perfetto::Tracing::Initialize(args);
     ::perfetto::TrackEvent::Register();
@@ -229,9 +1139,7 @@ write_perfetto(
             thread_indexes.emplace(itr, _idx);
             auto _track  = ::perfetto::Track{itr};
             auto _desc   = _track.Serialize();
-            auto _namess = std::stringstream{};
-            _namess << "THREAD " << _idx << " (" << itr << ")";
-            _desc.set_name(_namess.str());
+            _desc.set_name(get_thread_track_name(_idx, itr));
             perfetto::TrackEvent::SetTrackDescriptor(_track, _desc);
 
             thread_tracks.emplace(itr, _track);
@@ -244,20 +1152,10 @@ write_perfetto(
 
         for(auto titr : itr.second)
         {
-            auto _namess = std::stringstream{};
-            _namess << "COPY to AGENT [" << _agent->logical_node_id << "] THREAD ["
-                    << thread_indexes.at(titr) << "] ";
-
-            if(_agent->type == ROCPROFILER_AGENT_TYPE_CPU)
-                _namess << "(CPU)";
-            else if(_agent->type == ROCPROFILER_AGENT_TYPE_GPU)
-                _namess << "(GPU)";
-            else
-                _namess << "(UNK)";
-
-            auto _track = ::perfetto::Track{get_hash_id(_namess.str())};
+            auto _name  = get_copy_track_name(_agent, thread_indexes.at(titr));
+            auto _track = ::perfetto::Track{get_hash_id(std::string_view{_name})};
             auto _desc  = _track.Serialize();
-            _desc.set_name(_namess.str());
+            _desc.set_name(_name);
 
             perfetto::TrackEvent::SetTrackDescriptor(_track, _desc);
 
@@ -272,16 +1170,12 @@ write_perfetto(
         {
             const auto* _agent = _get_agent(aitr.first);
 
-            auto _namess = std::stringstream{};
             auto agent_index_info =
                 tool_metadata.get_agent_index(_agent->id, ocfg.agent_index_value);
-            _namess << "COMPUTE " << agent_index_info.label << " [" << agent_index_info.index
-                    << "] QUEUE [" << nqueue++ << "] ";
-            _namess << agent_index_info.type;
-
-            auto _track = ::perfetto::Track{get_hash_id(_namess.str())};
+            auto _name  = get_queue_track_name(agent_index_info, nqueue++);
+            auto _track = ::perfetto::Track{get_hash_id(std::string_view{_name})};
             auto _desc  = _track.Serialize();
-            _desc.set_name(_namess.str());
+            _desc.set_name(_name);
 
             perfetto::TrackEvent::SetTrackDescriptor(_track, _desc);
 
@@ -294,12 +1188,10 @@ write_perfetto(
         const auto stream_id = sitr.handle;
 
         {
-            auto _namess = std::stringstream{};
-            _namess << fmt::format("STREAM [\" {} \"] ", stream_id);
-
-            auto _track = ::perfetto::Track{get_hash_id(_namess.str())};
+            auto _name  = get_stream_track_name(stream_id);
+            auto _track = ::perfetto::Track{get_hash_id(std::string_view{_name})};
             auto _desc  = _track.Serialize();
-            _desc.set_name(_namess.str());
+            _desc.set_name(_name);
 
             perfetto::TrackEvent::SetTrackDescriptor(_track, _desc);
 
@@ -311,9 +1203,7 @@ write_perfetto(
     for(const auto& itr : tool_metadata.get_counter_info())
         counter_id_to_name.emplace(itr.id, itr.name);
 
-    // Map: correlation_id -> map<counter_id, value>
-    auto dispatch_counter_id_value =
-        std::unordered_map<uint64_t, std::unordered_map<rocprofiler_counter_id_t, double>>{};
+    const auto dispatch_counter_id_value = get_dispatch_counter_values(counter_collection_gen);
 
     // trace events
     {
@@ -583,20 +1473,6 @@ write_perfetto(
                 tracing_session->FlushBlocking();
             }
 
-        for(auto ditr : counter_collection_gen)
-            for(const auto& record : counter_collection_gen.get(ditr))
-            {
-                auto& counter_id_value =
-                    dispatch_counter_id_value[record.dispatch_data.correlation_id.internal];
-                auto record_vector = record.read();
-
-                // Accumulate counters based on ID for this dispatch
-                for(auto& count : record_vector)
-                {
-                    counter_id_value[count.id] += count.value;
-                }
-            }
-
         for(auto ditr : kernel_dispatch_gen)
         {
             auto generator = kernel_dispatch_gen.get(ditr);
@@ -756,67 +1632,20 @@ write_perfetto(
     // counter tracks
     {
         // memory copy counter track
-        auto mem_cpy_endpoints =
-            std::map<rocprofiler_agent_id_t, std::map<rocprofiler_timestamp_t, uint64_t>>{};
-        auto mem_cpy_extremes = std::pair<uint64_t, uint64_t>{std::numeric_limits<uint64_t>::max(),
-                                                              std::numeric_limits<uint64_t>::min()};
-        auto constexpr timestamp_buffer = 1000;
-        for(auto ditr : memory_copy_gen)
-            for(auto itr : memory_copy_gen.get(ditr))
-            {
-                uint64_t _mean_timestamp =
-                    itr.start_timestamp + (0.5 * (itr.end_timestamp - itr.start_timestamp));
-
-                mem_cpy_endpoints[itr.dst_agent_id].emplace(itr.start_timestamp - timestamp_buffer,
-                                                            0);
-                mem_cpy_endpoints[itr.dst_agent_id].emplace(itr.start_timestamp, 0);
-                mem_cpy_endpoints[itr.dst_agent_id].emplace(_mean_timestamp, 0);
-                mem_cpy_endpoints[itr.dst_agent_id].emplace(itr.end_timestamp, 0);
-                mem_cpy_endpoints[itr.dst_agent_id].emplace(itr.end_timestamp + timestamp_buffer,
-                                                            0);
-
-                mem_cpy_extremes =
-                    std::make_pair(std::min(mem_cpy_extremes.first, itr.start_timestamp),
-                                   std::max(mem_cpy_extremes.second, itr.end_timestamp));
-            }
-
-        for(auto ditr : memory_copy_gen)
-            for(auto itr : memory_copy_gen.get(ditr))
-            {
-                auto mbeg = mem_cpy_endpoints.at(itr.dst_agent_id).lower_bound(itr.start_timestamp);
-                auto mend = mem_cpy_endpoints.at(itr.dst_agent_id).upper_bound(itr.end_timestamp);
-
-                LOG_IF(FATAL, mbeg == mend)
-                    << "Missing range for timestamp [" << itr.start_timestamp << ", "
-                    << itr.end_timestamp << "]";
-
-                for(auto mitr = mbeg; mitr != mend; ++mitr)
-                    mitr->second += itr.bytes;
-            }
-
-        constexpr auto bytes_multiplier         = 1024;
-        constexpr auto extremes_endpoint_buffer = 5000;
-
+        auto mem_cpy_endpoints = get_memory_copy_endpoints(memory_copy_gen);
         auto mem_cpy_tracks =
             std::unordered_map<rocprofiler_agent_id_t, ::perfetto::CounterTrack>{};
         auto mem_cpy_cnt_names = std::vector<std::string>{};
         mem_cpy_cnt_names.reserve(mem_cpy_endpoints.size());
         for(auto& mitr : mem_cpy_endpoints)
         {
-            mem_cpy_endpoints[mitr.first].emplace(mem_cpy_extremes.first - extremes_endpoint_buffer,
-                                                  0);
-            mem_cpy_endpoints[mitr.first].emplace(
-                mem_cpy_extremes.second + extremes_endpoint_buffer, 0);
-
-            auto        _track_name = std::stringstream{};
-            const auto* _agent      = _get_agent(mitr.first);
+            const auto* _agent = _get_agent(mitr.first);
             auto        agent_index_info =
                 tool_metadata.get_agent_index(_agent->id, ocfg.agent_index_value);
-            _track_name << "COPY BYTES to " << agent_index_info.label << " ["
-                        << agent_index_info.index << "] (" << agent_index_info.type << ")";
 
             constexpr auto _unit = ::perfetto::CounterTrack::Unit::UNIT_SIZE_BYTES;
-            auto&          _name = mem_cpy_cnt_names.emplace_back(_track_name.str());
+            auto&          _name = mem_cpy_cnt_names.emplace_back(
+                get_agent_counter_track_name("COPY BYTES to", agent_index_info));
             mem_cpy_tracks.emplace(mitr.first,
                                    ::perfetto::CounterTrack{_name.c_str()}
                                        .set_unit(_unit)
@@ -837,159 +1666,25 @@ write_perfetto(
         }
 
         // memory allocation counter track
-        constexpr auto null_rocp_agent_id = rocprofiler_agent_id_t{.handle = 0};
-        struct free_memory_information
-        {
-            rocprofiler_timestamp_t start_timestamp = 0;
-            rocprofiler_timestamp_t end_timestamp   = 0;
-            rocprofiler_address_t   address         = {.handle = 0};
-        };
-
-        struct memory_information
-        {
-            uint64_t              alloc_size  = {0};
-            rocprofiler_address_t address     = {.handle = 0};
-            bool                  is_alloc_op = {false};
-        };
-
-        struct agent_and_size
-        {
-            rocprofiler_agent_id_t agent_id = rocprofiler_agent_id_t{.handle = 0};
-            uint64_t               size     = {0};
-        };
-
-        auto mem_alloc_endpoints =
-            std::unordered_map<rocprofiler_agent_id_t,
-                               std::map<rocprofiler_timestamp_t, memory_information>>{};
-        auto mem_alloc_extremes = std::pair<uint64_t, uint64_t>{
-            std::numeric_limits<uint64_t>::max(), std::numeric_limits<uint64_t>::min()};
-        auto address_to_agent_and_size =
-            std::unordered_map<rocprofiler_address_t, agent_and_size>{};
-        auto free_mem_info = std::vector<free_memory_information>{};
-
-        // Load memory allocation endpoints
-        for(auto ditr : memory_allocation_gen)
-            for(auto itr : memory_allocation_gen.get(ditr))
-            {
-                if(itr.operation == ROCPROFILER_MEMORY_ALLOCATION_ALLOCATE ||
-                   itr.operation == ROCPROFILER_MEMORY_ALLOCATION_VMEM_ALLOCATE)
-                {
-                    LOG_IF(FATAL, itr.agent_id == null_rocp_agent_id)
-                        << "Missing agent id for memory allocation trace";
-                    mem_alloc_endpoints[itr.agent_id].emplace(
-                        itr.start_timestamp,
-                        memory_information{itr.allocation_size, itr.address, true});
-                    mem_alloc_endpoints[itr.agent_id].emplace(
-                        itr.end_timestamp,
-                        memory_information{itr.allocation_size, itr.address, true});
-                    address_to_agent_and_size.emplace(
-                        itr.address, agent_and_size{itr.agent_id, itr.allocation_size});
-                }
-                else if(itr.operation == ROCPROFILER_MEMORY_ALLOCATION_FREE ||
-                        itr.operation == ROCPROFILER_MEMORY_ALLOCATION_VMEM_FREE)
-                {
-                    // Store free memory operations in seperate vector to pair with agent
-                    // and allocation size in following loop
-                    free_mem_info.push_back(free_memory_information{
-                        itr.start_timestamp, itr.end_timestamp, itr.address});
-                }
-                else
-                {
-                    ROCP_CI_LOG(WARNING) << "unhandled memory allocation type " << itr.operation;
-                }
-            }
-        // Add free memory operations to the endpoint map
-        for(const auto& itr : free_mem_info)
-        {
-            if(address_to_agent_and_size.count(itr.address) == 0)
-            {
-                if(itr.address.handle == 0)
-                {
-                    // Freeing null pointers is expected behavior and is occurs in HSA functions
-                    // like hipStreamDestroy
-                    ROCP_INFO << "null pointer freed due to HSA operation";
-                }
-                else
-                {
-                    // Following should not occur
-                    ROCP_INFO << "Unpaired free operation occurred";
-                }
-                continue;
-            }
-            auto [agent_id, allocation_size] = address_to_agent_and_size[itr.address];
-            mem_alloc_endpoints[agent_id].emplace(
-                itr.start_timestamp, memory_information{allocation_size, itr.address, false});
-            mem_alloc_endpoints[agent_id].emplace(
-                itr.end_timestamp, memory_information{allocation_size, itr.address, false});
-        }
-        // Create running sum of allocated memory
-        for(auto& [_, endpoint_map] : mem_alloc_endpoints)
-        {
-            if(!endpoint_map.empty())
-            {
-                auto earliest_agent_timestamp = endpoint_map.begin()->first;
-                auto latest_agent_timestamp   = (--endpoint_map.end())->first;
-                mem_alloc_extremes =
-                    std::make_pair(std::min(mem_alloc_extremes.first, earliest_agent_timestamp),
-                                   std::max(mem_alloc_extremes.second, latest_agent_timestamp));
-            }
-            if(endpoint_map.size() <= 1)
-            {
-                continue;
-            }
-
-            auto prev = endpoint_map.begin();
-            auto itr  = std::next(prev);
-            for(; itr != endpoint_map.end(); ++itr, ++prev)
-            {
-                // If address or allocation type are different, add or subtract from running sum
-                if(prev->second.address != itr->second.address ||
-                   prev->second.is_alloc_op != itr->second.is_alloc_op)
-                {
-                    if(itr->second.is_alloc_op)
-                    {
-                        itr->second.alloc_size += prev->second.alloc_size;
-                    }
-                    else if(prev->second.alloc_size >= itr->second.alloc_size)
-                    {
-                        itr->second.alloc_size = prev->second.alloc_size - itr->second.alloc_size;
-                    }
-                }
-                else
-                {
-                    itr->second.alloc_size = prev->second.alloc_size;
-                }
-            }
-        }
-
+        auto mem_alloc_endpoints = get_memory_allocation_endpoints(memory_allocation_gen);
         auto mem_alloc_tracks =
             std::unordered_map<rocprofiler_agent_id_t, ::perfetto::CounterTrack>{};
         auto mem_alloc_cnt_names = std::vector<std::string>{};
         mem_alloc_cnt_names.reserve(mem_alloc_endpoints.size());
         for(auto& alloc_itr : mem_alloc_endpoints)
         {
-            mem_alloc_endpoints[alloc_itr.first].emplace(
-                mem_alloc_extremes.first - extremes_endpoint_buffer,
-                memory_information{0, {0}, false});
-            mem_alloc_endpoints[alloc_itr.first].emplace(
-                mem_alloc_extremes.second + extremes_endpoint_buffer,
-                memory_information{0, {0}, false});
-
-            auto                       _track_name = std::stringstream{};
+            auto                       _track_name = std::string{"FREE BYTES"};
             const rocprofiler_agent_t* _agent      = _get_agent(alloc_itr.first);
 
             if(_agent != nullptr)
             {
                 auto agent_index_info =
                     tool_metadata.get_agent_index(_agent->id, ocfg.agent_index_value);
-                _track_name << "ALLOCATE BYTES on " << agent_index_info.label << " ["
-                            << agent_index_info.index << "] (" << agent_index_info.type << ")";
+                _track_name = get_agent_counter_track_name("ALLOCATE BYTES on", agent_index_info);
             }
-            else
-                _track_name << "FREE BYTES";
 
             constexpr auto _unit = ::perfetto::CounterTrack::Unit::UNIT_SIZE_BYTES;
-            auto&          _name = mem_alloc_cnt_names.emplace_back(_track_name.str());
+            auto&          _name = mem_alloc_cnt_names.emplace_back(_track_name);
             mem_alloc_tracks.emplace(alloc_itr.first,
                                      ::perfetto::CounterTrack{_name.c_str()}
                                          .set_unit(_unit)
@@ -1010,44 +1705,7 @@ write_perfetto(
         }
 
         // scratch memory counter track
-        auto scratch_mem_endpoints =
-            std::unordered_map<rocprofiler_agent_id_t,
-                               std::map<rocprofiler_timestamp_t, uint64_t>>{};
-        auto scratch_mem_extremes = std::pair<uint64_t, uint64_t>{
-            std::numeric_limits<uint64_t>::max(), std::numeric_limits<uint64_t>::min()};
-
-        // Load scratch memory usage endpoints
-        for(auto ditr : scratch_memory_gen)
-            for(auto itr : scratch_memory_gen.get(ditr))
-            {
-                // Track start and end timestamps for this scratch memory record
-                scratch_mem_endpoints[itr.agent_id].emplace(itr.start_timestamp, 0);
-                scratch_mem_endpoints[itr.agent_id].emplace(itr.end_timestamp, 0);
-
-                // Update overall time range
-                scratch_mem_extremes =
-                    std::make_pair(std::min(scratch_mem_extremes.first, itr.start_timestamp),
-                                   std::max(scratch_mem_extremes.second, itr.end_timestamp));
-            }
-
-        // Load values at each endpoint
-        for(auto ditr : scratch_memory_gen)
-            for(auto itr : scratch_memory_gen.get(ditr))
-            {
-                // For each timestamp in the range of this record
-                auto begin =
-                    scratch_mem_endpoints.at(itr.agent_id).lower_bound(itr.start_timestamp);
-                auto end = scratch_mem_endpoints.at(itr.agent_id).upper_bound(itr.end_timestamp);
-
-                for(auto mitr = begin; mitr != end; ++mitr)
-                {
-                    // Add scratch memory size to the counter value at this timestamp
-                    if(itr.operation == ROCPROFILER_SCRATCH_MEMORY_ALLOC)
-                        mitr->second = itr.allocation_size;
-                    else if(itr.operation == ROCPROFILER_SCRATCH_MEMORY_FREE)
-                        mitr->second = 0;  // For all free events current allocation drops to 0.
-                }
-            }
+        auto scratch_mem_endpoints = get_scratch_memory_endpoints(scratch_memory_gen);
 
         // Create counter tracks for visualization
         auto scratch_mem_tracks =
@@ -1057,23 +1715,15 @@ write_perfetto(
 
         for(auto& mitr : scratch_mem_endpoints)
         {
-            // Add buffer timestamps for better visualization
             if(!mitr.second.empty())
             {
-                scratch_mem_endpoints[mitr.first].emplace(
-                    scratch_mem_extremes.first - extremes_endpoint_buffer, 0);
-                scratch_mem_endpoints[mitr.first].emplace(
-                    scratch_mem_extremes.second + extremes_endpoint_buffer, 0);
-
-                auto        _track_name = std::stringstream{};
-                const auto* _agent      = _get_agent(mitr.first);
+                const auto* _agent = _get_agent(mitr.first);
                 auto        agent_index_info =
                     tool_metadata.get_agent_index(_agent->id, ocfg.agent_index_value);
-                _track_name << "SCRATCH MEMORY on " << agent_index_info.label << " ["
-                            << agent_index_info.index << "] (" << agent_index_info.type << ")";
 
                 constexpr auto _unit = ::perfetto::CounterTrack::Unit::UNIT_SIZE_BYTES;
-                auto&          _name = scratch_mem_names.emplace_back(_track_name.str());
+                auto&          _name = scratch_mem_names.emplace_back(
+                    get_agent_counter_track_name("SCRATCH MEMORY on", agent_index_info));
                 scratch_mem_tracks.emplace(mitr.first,
                                            ::perfetto::CounterTrack{_name.c_str()}
                                                .set_unit(_unit)
@@ -1101,54 +1751,12 @@ write_perfetto(
 
     // Create counter tracks per agent
     {
-        auto counters_endpoints = std::unordered_map<
-            rocprofiler_agent_id_t,
-            std::unordered_map<rocprofiler_counter_id_t, std::map<uint64_t, uint64_t>>>{};
-
-        auto counters_extremes = std::pair<uint64_t, uint64_t>{
-            std::numeric_limits<uint64_t>::max(), std::numeric_limits<uint64_t>::min()};
-
-        auto constexpr timestamp_buffer = 1000;
-
-        for(auto ditr : counter_collection_gen)
-            for(const auto& record : counter_collection_gen.get(ditr))
-            {
-                const auto& info = record.dispatch_data.dispatch_info;
-
-                const auto& start_timestamp = record.dispatch_data.start_timestamp;
-                const auto& end_timestamp   = record.dispatch_data.end_timestamp;
-
-                uint64_t _mean_timestamp =
-                    start_timestamp + (0.5 * (end_timestamp - start_timestamp));
-
-                auto corr_id = record.dispatch_data.correlation_id.internal;
-                auto it      = dispatch_counter_id_value.find(corr_id);
-                if(it != dispatch_counter_id_value.end())
-                {
-                    for(auto& [counter_id, counter_value] : it->second)
-                    {
-                        counters_endpoints[info.agent_id][counter_id].emplace(
-                            start_timestamp - timestamp_buffer, 0);
-                        counters_endpoints[info.agent_id][counter_id].emplace(start_timestamp,
-                                                                              counter_value);
-                        counters_endpoints[info.agent_id][counter_id].emplace(_mean_timestamp,
-                                                                              counter_value);
-                        counters_endpoints[info.agent_id][counter_id].emplace(end_timestamp, 0);
-                        counters_endpoints[info.agent_id][counter_id].emplace(
-                            end_timestamp + timestamp_buffer, 0);
-                    }
-                }
-
-                counters_extremes = std::make_pair(
-                    std::min(counters_extremes.first, record.dispatch_data.start_timestamp),
-                    std::max(counters_extremes.second, record.dispatch_data.end_timestamp));
-            }
+        auto counters_endpoints =
+            get_counter_endpoints(counter_collection_gen, dispatch_counter_id_value);
 
         auto counter_tracks = std::unordered_map<rocprofiler_agent_id_t,
                                                  std::map<std::string, ::perfetto::CounterTrack>>{};
 
-        constexpr auto extremes_endpoint_buffer = 5000;
-
         for(auto ditr : counter_collection_gen)
             for(const auto& record : counter_collection_gen.get(ditr))
             {
@@ -1157,27 +1765,17 @@ write_perfetto(
 
                 CHECK(sym != nullptr);
 
-                auto name = sym->formatted_kernel_name;
-
                 auto corr_id = record.dispatch_data.correlation_id.internal;
                 auto it      = dispatch_counter_id_value.find(corr_id);
                 if(it != dispatch_counter_id_value.end())
                 {
-                    for(auto& [counter_id, counter_value] : it->second)
+                    for(const auto& citr : it->second)
                     {
-                        counters_endpoints[info.agent_id][counter_id].emplace(
-                            counters_extremes.first - extremes_endpoint_buffer, 0);
-                        counters_endpoints[info.agent_id][counter_id].emplace(
-                            counters_extremes.second + extremes_endpoint_buffer, 0);
-
-                        auto agent_index_info =
+                        const auto counter_id = citr.first;
+                        auto       agent_index_info =
                             tool_metadata.get_agent_index(info.agent_id, ocfg.agent_index_value);
-                        auto track_name_ss = std::stringstream{};
-                        track_name_ss << agent_index_info.label << " [" << agent_index_info.index
-                                      << "] "
-                                      << "PMC " << counter_id_to_name.at(counter_id);
-
-                        auto track_name = track_name_ss.str();
+                        auto track_name =
+                            get_pmc_track_name(agent_index_info, counter_id_to_name.at(counter_id));
 
                         counter_tracks[info.agent_id].emplace(
                             track_name, ::perfetto::CounterTrack(track_name.c_str()));
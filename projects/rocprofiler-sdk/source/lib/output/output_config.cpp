@@ -96,7 +96,8 @@ output_config::parse_env()
     else
         agent_index_value = agent_indexing::logical_node;
 
-    const auto supported_perfetto_backends = std::set<std::string_view>{"inprocess", "system"};
+    const auto supported_perfetto_backends =
+        std::set<std::string_view>{"inprocess", "system", "direct"};
     LOG_IF(FATAL, supported_perfetto_backends.count(perfetto_backend) == 0)
         << "Unsupported perfetto backend type: " << perfetto_backend;
 
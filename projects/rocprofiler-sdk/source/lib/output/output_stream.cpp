@@ -86,6 +86,15 @@ get_output_filename(const output_config& cfg, std::string_view fname, std::strin
     return _ofname;
 }
 
+bool
+is_standard_output(const output_config& cfg)
+{
+    auto cfg_output_path = tool::format_path(cfg.output_path);
+
+    return (cfg_output_path.empty() || stdout_names.count(cfg_output_path) > 0 ||
+            stderr_names.count(cfg_output_path) > 0);
+}
+
 output_stream
 get_output_stream(const output_config& cfg,
                   std::string_view     fname,
@@ -79,6 +79,10 @@ struct output_stream
 std::string
 get_output_filename(const output_config& cfg, std::string_view fname, std::string_view ext);
 
+/// true when output streams of the configuration are shared standard streams instead of files
+bool
+is_standard_output(const output_config& cfg);
+
 output_stream
 get_output_stream(const output_config& cfg,
                   std::string_view     fname,
@@ -0,0 +1,388 @@
+// MIT License
+//
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pftrace_writer.hpp"
+
+#include <cstring>
+
+namespace rocprofiler
+{
+namespace tool
+{
+namespace pftrace
+{
+namespace
+{
+// protobuf wire types
+enum wire_type : uint32_t
+{
+    wire_varint  = 0,
+    wire_fixed64 = 1,
+    wire_length  = 2,
+};
+
+// field numbers of perfetto.protos.Trace
+constexpr uint32_t trace_packet = 1;
+
+// field numbers of perfetto.protos.TracePacket
+constexpr uint32_t packet_timestamp                = 8;
+constexpr uint32_t packet_sequence_id              = 10;
+constexpr uint32_t packet_track_event              = 11;
+constexpr uint32_t packet_interned_data            = 12;
+constexpr uint32_t packet_sequence_flags           = 13;
+constexpr uint32_t packet_track_descriptor         = 60;
+constexpr uint32_t packet_first_packet_on_sequence = 87;
+
+// values of perfetto.protos.TracePacket.SequenceFlags
+constexpr uint32_t seq_incremental_state_cleared = 1;
+constexpr uint32_t seq_needs_incremental_state   = 2;
+
+// field numbers of perfetto.protos.TrackEvent
+constexpr uint32_t event_category_iids        = 3;
+constexpr uint32_t event_debug_annotations    = 4;
+constexpr uint32_t event_type                 = 9;
+constexpr uint32_t event_name_iid             = 10;
+constexpr uint32_t event_track_uuid           = 11;
+constexpr uint32_t event_counter_value        = 30;
+constexpr uint32_t event_flow_ids             = 47;
+constexpr uint32_t event_type_slice_begin     = 1;
+constexpr uint32_t event_type_slice_end       = 2;
+constexpr uint32_t event_type_counter         = 4;
+constexpr uint32_t annotation_name_iid        = 1;
+constexpr uint32_t annotation_bool_value      = 2;
+constexpr uint32_t annotation_uint_value      = 3;
+constexpr uint32_t annotation_int_value       = 4;
+constexpr uint32_t annotation_double_value    = 5;
+constexpr uint32_t annotation_string_value    = 6;
+constexpr uint32_t interned_event_categories  = 1;
+constexpr uint32_t interned_event_names       = 2;
+constexpr uint32_t interned_annotation_names  = 3;
+constexpr uint32_t interned_string_iid        = 1;
+constexpr uint32_t interned_string_name       = 2;
+
+// field numbers of perfetto.protos.TrackDescriptor
+constexpr uint32_t track_uuid                 = 1;
+constexpr uint32_t track_name                 = 2;
+constexpr uint32_t track_process              = 3;
+constexpr uint32_t track_thread               = 4;
+constexpr uint32_t track_parent_uuid          = 5;
+constexpr uint32_t track_counter              = 8;
+constexpr uint32_t process_pid                = 1;
+constexpr uint32_t process_name               = 6;
+constexpr uint32_t thread_pid                 = 1;
+constexpr uint32_t thread_tid                 = 2;
+constexpr uint32_t counter_unit_field         = 3;
+constexpr uint32_t counter_unit_multiplier    = 4;
+constexpr uint32_t counter_is_incremental     = 5;
+
+size_t
+varint_size(uint64_t _val)
+{
+    size_t _n = 1;
+    while(_val >= 0x80)
+    {
+        _val >>= 7;
+        ++_n;
+    }
+    return _n;
+}
+
+void
+append_varint(std::string& _buf, uint64_t _val)
+{
+    while(_val >= 0x80)
+    {
+        _buf.push_back(static_cast<char>((_val & 0x7f) | 0x80));
+        _val >>= 7;
+    }
+    _buf.push_back(static_cast<char>(_val));
+}
+
+void
+append_tag(std::string& _buf, uint32_t _field, wire_type _type)
+{
+    append_varint(_buf, (static_cast<uint64_t>(_field) << 3) | _type);
+}
+
+void
+append_uint(std::string& _buf, uint32_t _field, uint64_t _val)
+{
+    append_tag(_buf, _field, wire_varint);
+    append_varint(_buf, _val);
+}
+
+// int32/int64 fields are encoded as the two's complement of the value, not zigzag
+void
+append_int(std::string& _buf, uint32_t _field, int64_t _val)
+{
+    append_uint(_buf, _field, static_cast<uint64_t>(_val));
+}
+
+void
+append_fixed64(std::string& _buf, uint32_t _field, uint64_t _val)
+{
+    append_tag(_buf, _field, wire_fixed64);
+    for(size_t i = 0; i < sizeof(uint64_t); ++i)
+        _buf.push_back(static_cast<char>((_val >> (8 * i)) & 0xff));
+}
+
+void
+append_double(std::string& _buf, uint32_t _field, double _val)
+{
+    auto _bits = uint64_t{0};
+    static_assert(sizeof(_bits) == sizeof(_val), "Error! double is not 64 bits");
+    std::memcpy(&_bits, &_val, sizeof(_val));
+    append_fixed64(_buf, _field, _bits);
+}
+
+void
+append_bytes(std::string& _buf, uint32_t _field, std::string_view _val)
+{
+    append_tag(_buf, _field, wire_length);
+    append_varint(_buf, _val.size());
+    _buf.append(_val.data(), _val.size());
+}
+}  // namespace
+
+void
+output::write(std::string_view _packets)
+{
+    if(_packets.empty()) return;
+
+    auto _lk = std::unique_lock<std::mutex>{m_mutex};
+    m_stream.write(_packets.data(), _packets.size());
+    m_bytes += _packets.size();
+}
+
+sequence_writer::sequence_writer(output& _output, uint32_t _sequence_id, size_t _flush_threshold)
+: m_output{_output}
+, m_sequence_id{_sequence_id}
+, m_flush_threshold{_flush_threshold}
+{}
+
+sequence_writer::~sequence_writer() { flush(); }
+
+void
+sequence_writer::flush()
+{
+    m_output.write(m_buffer);
+    m_buffer.clear();
+}
+
+uint64_t
+sequence_writer::intern(interned_map_t& _map, std::string_view _value, uint32_t _field)
+{
+    if(auto itr = _map.find(_value); itr != _map.end()) return itr->second;
+
+    // the map keys must outlive the caller's string so keep a copy
+    const auto& _stored = m_interned_strings.emplace_back(_value);
+    auto        _iid    = static_cast<uint64_t>(_map.size() + 1);
+    _map.emplace(_stored, _iid);
+
+    // EventCategory, EventName, and DebugAnnotationName are all { iid = 1, name = 2 }
+    append_tag(m_interned, _field, wire_length);
+    append_varint(m_interned,
+                  1 + varint_size(_iid) + 1 + varint_size(_stored.size()) + _stored.size());
+    append_uint(m_interned, interned_string_iid, _iid);
+    append_bytes(m_interned, interned_string_name, _stored);
+
+    return _iid;
+}
+
+void
+sequence_writer::add_annotation(const annotation& _annotation)
+{
+    auto _name_iid =
+        intern(m_annotation_names, _annotation.name, interned_annotation_names);
+
+    m_nested.clear();
+    append_uint(m_nested, annotation_name_iid, _name_iid);
+    switch(_annotation.type)
+    {
+        case annotation::value_type::uint_value:
+            append_uint(m_nested, annotation_uint_value, _annotation.uint_value);
+            break;
+        case annotation::value_type::int_value:
+            append_int(m_nested, annotation_int_value, _annotation.int_value);
+            break;
+        case annotation::value_type::double_value:
+            append_double(m_nested, annotation_double_value, _annotation.double_value);
+            break;
+        case annotation::value_type::bool_value:
+            append_uint(m_nested, annotation_bool_value, _annotation.uint_value);
+            break;
+        case annotation::value_type::string_value:
+            append_bytes(m_nested, annotation_string_value, _annotation.string_value);
+            break;
+    }
+    append_bytes(m_event, event_debug_annotations, m_nested);
+}
+
+void
+sequence_writer::write_track_descriptor()
+{
+    m_packet.clear();
+    append_uint(m_packet, packet_sequence_id, m_sequence_id);
+    append_bytes(m_packet, packet_track_descriptor, m_event);
+    m_event.clear();
+
+    append_bytes(m_buffer, trace_packet, m_packet);
+    if(m_buffer.size() >= m_flush_threshold) flush();
+}
+
+void
+sequence_writer::write_track_event(uint64_t _timestamp)
+{
+    m_packet.clear();
+    append_uint(m_packet, packet_timestamp, _timestamp);
+    append_uint(m_packet, packet_sequence_id, m_sequence_id);
+    if(!m_incremental_state_set)
+    {
+        // the first event of the sequence resets the interning state
+        append_uint(m_packet, packet_sequence_flags, seq_incremental_state_cleared);
+        append_uint(m_packet, packet_first_packet_on_sequence, 1);
+        m_incremental_state_set = true;
+    }
+    else
+    {
+        append_uint(m_packet, packet_sequence_flags, seq_needs_incremental_state);
+    }
+    if(!m_interned.empty())
+    {
+        append_bytes(m_packet, packet_interned_data, m_interned);
+        m_interned.clear();
+    }
+    append_bytes(m_packet, packet_track_event, m_event);
+    m_event.clear();
+
+    append_bytes(m_buffer, trace_packet, m_packet);
+    if(m_buffer.size() >= m_flush_threshold) flush();
+}
+
+void
+sequence_writer::process_track(uint64_t _uuid, int32_t _pid, std::string_view _name)
+{
+    m_nested.clear();
+    append_int(m_nested, process_pid, _pid);
+    if(!_name.empty()) append_bytes(m_nested, process_name, _name);
+
+    m_event.clear();
+    append_uint(m_event, track_uuid, _uuid);
+    append_bytes(m_event, track_process, m_nested);
+    write_track_descriptor();
+}
+
+void
+sequence_writer::thread_track(uint64_t _uuid, uint64_t _parent_uuid, int32_t _pid, int32_t _tid)
+{
+    m_nested.clear();
+    append_int(m_nested, thread_pid, _pid);
+    append_int(m_nested, thread_tid, _tid);
+
+    m_event.clear();
+    append_uint(m_event, track_uuid, _uuid);
+    if(_parent_uuid != 0) append_uint(m_event, track_parent_uuid, _parent_uuid);
+    append_bytes(m_event, track_thread, m_nested);
+    write_track_descriptor();
+}
+
+void
+sequence_writer::track(uint64_t _uuid, uint64_t _parent_uuid, std::string_view _name)
+{
+    m_event.clear();
+    append_uint(m_event, track_uuid, _uuid);
+    append_bytes(m_event, track_name, _name);
+    if(_parent_uuid != 0) append_uint(m_event, track_parent_uuid, _parent_uuid);
+    write_track_descriptor();
+}
+
+void
+sequence_writer::counter_track(uint64_t         _uuid,
+                               uint64_t         _parent_uuid,
+                               std::string_view _name,
+                               counter_unit     _unit,
+                               int64_t          _unit_multiplier,
+                               bool             _is_incremental)
+{
+    m_nested.clear();
+    if(_unit != counter_unit::unspecified)
+        append_uint(m_nested, counter_unit_field, static_cast<uint32_t>(_unit));
+    if(_unit_multiplier != 0) append_int(m_nested, counter_unit_multiplier, _unit_multiplier);
+    if(_is_incremental) append_uint(m_nested, counter_is_incremental, 1);
+
+    m_event.clear();
+    append_uint(m_event, track_uuid, _uuid);
+    append_bytes(m_event, track_name, _name);
+    if(_parent_uuid != 0) append_uint(m_event, track_parent_uuid, _parent_uuid);
+    append_bytes(m_event, track_counter, m_nested);
+    write_track_descriptor();
+}
+
+void
+sequence_writer::slice_begin(uint64_t                          _track_uuid,
+                             uint64_t                          _timestamp,
+                             std::string_view                  _category,
+                             std::string_view                  _name,
+                             uint64_t                          _flow_id,
+                             std::initializer_list<annotation> _annotations,
+                             const std::vector<annotation>&    _extra_annotations)
+{
+    m_event.clear();
+    append_uint(
+        m_event, event_category_iids, intern(m_categories, _category, interned_event_categories));
+    append_uint(m_event, event_type, event_type_slice_begin);
+    append_uint(m_event, event_name_iid, intern(m_event_names, _name, interned_event_names));
+    append_uint(m_event, event_track_uuid, _track_uuid);
+    if(_flow_id != 0) append_fixed64(m_event, event_flow_ids, _flow_id);
+    for(const auto& itr : _annotations)
+        add_annotation(itr);
+    for(const auto& itr : _extra_annotations)
+        add_annotation(itr);
+
+    write_track_event(_timestamp);
+}
+
+void
+sequence_writer::slice_end(uint64_t _track_uuid, uint64_t _timestamp, std::string_view _category)
+{
+    m_event.clear();
+    append_uint(
+        m_event, event_category_iids, intern(m_categories, _category, interned_event_categories));
+    append_uint(m_event, event_type, event_type_slice_end);
+    append_uint(m_event, event_track_uuid, _track_uuid);
+
+    write_track_event(_timestamp);
+}
+
+void
+sequence_writer::counter(uint64_t _track_uuid, uint64_t _timestamp, int64_t _value)
+{
+    m_event.clear();
+    append_uint(m_event, event_type, event_type_counter);
+    append_uint(m_event, event_track_uuid, _track_uuid);
+    append_int(m_event, event_counter_value, _value);
+
+    write_track_event(_timestamp);
+}
+}  // namespace pftrace
+}  // namespace tool
+}  // namespace rocprofiler
@@ -0,0 +1,203 @@
+// MIT License
+//
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <initializer_list>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace rocprofiler
+{
+namespace tool
+{
+namespace pftrace
+{
+/// Serializes Perfetto trace packets (perfetto/trace/trace_packet.proto) straight into a
+/// .pftrace stream, without going through a Perfetto tracing session. A trace file is a
+/// sequence of `Trace.packet` entries, so packets written by independent sequences can be
+/// concatenated in any order.
+
+/// matches perfetto.protos.CounterDescriptor.Unit
+enum class counter_unit : uint32_t
+{
+    unspecified = 0,
+    time_ns     = 1,
+    count       = 2,
+    size_bytes  = 3,
+};
+
+/// a debug annotation of a slice. The name and string values must outlive the call writing
+/// the slice.
+struct annotation
+{
+    enum class value_type
+    {
+        uint_value,
+        int_value,
+        double_value,
+        bool_value,
+        string_value,
+    };
+
+    template <typename Tp>
+    annotation(std::string_view _name, Tp&& _val)
+    : name{_name}
+    {
+        using value_t = std::decay_t<Tp>;
+
+        if constexpr(std::is_same<value_t, bool>::value)
+        {
+            type       = value_type::bool_value;
+            uint_value = (_val) ? 1 : 0;
+        }
+        else if constexpr(std::is_enum<value_t>::value)
+        {
+            type      = value_type::int_value;
+            int_value = static_cast<int64_t>(_val);
+        }
+        else if constexpr(std::is_floating_point<value_t>::value)
+        {
+            type         = value_type::double_value;
+            double_value = static_cast<double>(_val);
+        }
+        else if constexpr(std::is_integral<value_t>::value && std::is_unsigned<value_t>::value)
+        {
+            type       = value_type::uint_value;
+            uint_value = _val;
+        }
+        else if constexpr(std::is_integral<value_t>::value)
+        {
+            type      = value_type::int_value;
+            int_value = _val;
+        }
+        else
+        {
+            static_assert(std::is_convertible<value_t, std::string_view>::value,
+                          "Error! unsupported annotation type");
+            type         = value_type::string_value;
+            string_value = std::string_view{_val};
+        }
+    }
+
+    std::string_view name = {};
+    value_type       type = value_type::uint_value;
+    union
+    {
+        uint64_t uint_value = 0;
+        int64_t  int_value;
+        double   double_value;
+    };
+    std::string_view string_value = {};
+};
+
+/// thread-safe sink shared by all the sequences of a trace
+class output
+{
+public:
+    explicit output(std::ostream& _os)
+    : m_stream{_os}
+    {}
+
+    void   write(std::string_view _packets);
+    size_t bytes_written() const { return m_bytes; }
+
+private:
+    std::ostream& m_stream;
+    std::mutex    m_mutex = {};
+    size_t        m_bytes = 0;
+};
+
+/// Writes the packets of one trusted packet sequence. The strings of the events are
+/// interned per sequence, so each sequence must only be used by one thread. The packets
+/// are buffered and handed to the output in chunks of complete packets.
+class sequence_writer
+{
+public:
+    static constexpr size_t default_flush_threshold = 4 * 1024 * 1024;
+
+    sequence_writer(output& _output,
+                    uint32_t _sequence_id,
+                    size_t   _flush_threshold = default_flush_threshold);
+    ~sequence_writer();
+
+    sequence_writer(const sequence_writer&) = delete;
+    sequence_writer(sequence_writer&&)      = delete;
+    sequence_writer& operator=(const sequence_writer&) = delete;
+    sequence_writer& operator=(sequence_writer&&) = delete;
+
+    void process_track(uint64_t _uuid, int32_t _pid, std::string_view _name);
+    void thread_track(uint64_t _uuid, uint64_t _parent_uuid, int32_t _pid, int32_t _tid);
+    void track(uint64_t _uuid, uint64_t _parent_uuid, std::string_view _name);
+    void counter_track(uint64_t         _uuid,
+                       uint64_t         _parent_uuid,
+                       std::string_view _name,
+                       counter_unit     _unit,
+                       int64_t          _unit_multiplier,
+                       bool             _is_incremental);
+
+    void slice_begin(uint64_t                          _track_uuid,
+                     uint64_t                          _timestamp,
+                     std::string_view                  _category,
+                     std::string_view                  _name,
+                     uint64_t                          _flow_id,
+                     std::initializer_list<annotation> _annotations,
+                     const std::vector<annotation>&    _extra_annotations = {});
+    void slice_end(uint64_t _track_uuid, uint64_t _timestamp, std::string_view _category);
+    void counter(uint64_t _track_uuid, uint64_t _timestamp, int64_t _value);
+
+    /// hands the buffered packets to the output
+    void flush();
+
+private:
+    using interned_map_t = std::unordered_map<std::string_view, uint64_t>;
+
+    uint64_t intern(interned_map_t& _map, std::string_view _value, uint32_t _field);
+    void     add_annotation(const annotation& _annotation);
+    void     write_track_descriptor();
+    void     write_track_event(uint64_t _timestamp);
+
+    output&                 m_output;
+    uint32_t                m_sequence_id           = 0;
+    size_t                  m_flush_threshold       = 0;
+    bool                    m_incremental_state_set = false;
+    std::string             m_buffer                = {};
+    std::string             m_packet                = {};
+    std::string             m_event                 = {};
+    std::string             m_nested                = {};
+    std::string             m_interned              = {};
+    std::deque<std::string> m_interned_strings      = {};
+    interned_map_t          m_categories            = {};
+    interned_map_t          m_event_names           = {};
+    interned_map_t          m_annotation_names      = {};
+};
+}  // namespace pftrace
+}  // namespace tool
+}  // namespace rocprofiler
@@ -2292,7 +2292,8 @@ void
 generate_output(tool::buffered_output<Tp, DomainT>& output_v,
                 output_data&                        output_data_v,
                 domain_stats_vec_t&                 contributions_v,
-                cleanup_vec_t&                      cleanups_v)
+                cleanup_vec_t&                      cleanups_v,
+                std::vector<std::future<void>>&     csv_tasks_v)
 {
     cleanups_v.emplace_back([&output_v]() { output_v.destroy(); });
 
@@ -2324,8 +2325,14 @@ generate_output(tool::buffered_output<Tp, DomainT>& output_v,
 
     if(tool::get_config().csv_output && _num_bytes >= tool::get_config().minimum_output_bytes)
     {
-        tool::generate_csv(
-            tool::get_config(), *tool_metadata, output_v.get_generator(), output_v.stats);
+        // each domain writes its own files so the files are generated concurrently. Output to
+        // the standard streams is deferred to keep the rows of the domains from interleaving
+        auto _policy = (tool::is_standard_output(tool::get_config())) ? std::launch::deferred
+                                                                      : std::launch::async;
+        csv_tasks_v.emplace_back(std::async(_policy, [&output_v]() {
+            tool::generate_csv(
+                tool::get_config(), *tool_metadata, output_v.get_generator(), output_v.stats);
+        }));
     }
 }
 
@@ -2384,6 +2391,7 @@ tool_fini(void* /*tool_data*/)
     auto outdata       = output_data{};
     auto contributions = domain_stats_vec_t{};
     auto cleanups      = cleanup_vec_t{};
+    auto csv_tasks     = std::vector<std::future<void>>{};
 
     auto run_cleanup = [&cleanups]() {
         for(const auto& itr : cleanups)
@@ -2401,19 +2409,23 @@ tool_fini(void* /*tool_data*/)
 
     auto _dtor = common::scope_destructor{run_cleanup};
 
-    generate_output(kernel_dispatch_output, outdata, contributions, cleanups);
-    generate_output(hsa_output, outdata, contributions, cleanups);
-    generate_output(hip_output, outdata, contributions, cleanups);
-    generate_output(memory_copy_output, outdata, contributions, cleanups);
-    generate_output(memory_allocation_output, outdata, contributions, cleanups);
-    generate_output(marker_output, outdata, contributions, cleanups);
-    generate_output(rccl_output, outdata, contributions, cleanups);
-    generate_output(counters_output, outdata, contributions, cleanups);
-    generate_output(scratch_memory_output, outdata, contributions, cleanups);
-    generate_output(rocdecode_output, outdata, contributions, cleanups);
-    generate_output(pc_sampling_host_trap_output, outdata, contributions, cleanups);
-    generate_output(rocjpeg_output, outdata, contributions, cleanups);
-    generate_output(pc_sampling_stochastic_output, outdata, contributions, cleanups);
+    generate_output(kernel_dispatch_output, outdata, contributions, cleanups, csv_tasks);
+    generate_output(hsa_output, outdata, contributions, cleanups, csv_tasks);
+    generate_output(hip_output, outdata, contributions, cleanups, csv_tasks);
+    generate_output(memory_copy_output, outdata, contributions, cleanups, csv_tasks);
+    generate_output(memory_allocation_output, outdata, contributions, cleanups, csv_tasks);
+    generate_output(marker_output, outdata, contributions, cleanups, csv_tasks);
+    generate_output(rccl_output, outdata, contributions, cleanups, csv_tasks);
+    generate_output(counters_output, outdata, contributions, cleanups, csv_tasks);
+    generate_output(scratch_memory_output, outdata, contributions, cleanups, csv_tasks);
+    generate_output(rocdecode_output, outdata, contributions, cleanups, csv_tasks);
+    generate_output(pc_sampling_host_trap_output, outdata, contributions, cleanups, csv_tasks);
+    generate_output(rocjpeg_output, outdata, contributions, cleanups, csv_tasks);
+    generate_output(pc_sampling_stochastic_output, outdata, contributions, cleanups, csv_tasks);
+
+    for(auto& itr : csv_tasks)
+        itr.get();
+    csv_tasks.clear();
 
     if(tool::get_config().advanced_thread_trace && !tool_metadata->att_filenames.empty())
     {
@@ -2505,31 +2517,20 @@ tool_fini(void* /*tool_data*/)
     if(tool::get_config().otf2_output && outdata.num_output > 0 &&
        outdata.num_bytes >= tool::get_config().minimum_output_bytes)
     {
-        auto hip_elem_data               = hip_output.load_all();
-        auto hsa_elem_data               = hsa_output.load_all();
-        auto kernel_dispatch_elem_data   = kernel_dispatch_output.load_all();
-        auto memory_copy_elem_data       = memory_copy_output.load_all();
-        auto marker_elem_data            = marker_output.load_all();
-        auto scratch_memory_elem_data    = scratch_memory_output.load_all();
-        auto rccl_elem_data              = rccl_output.load_all();
-        auto memory_allocation_elem_data = memory_allocation_output.load_all();
-        auto rocdecode_elem_data         = rocdecode_output.load_all();
-        auto rocjpeg_elem_data           = rocjpeg_output.load_all();
-
         tool::write_otf2(tool::get_config(),
                          *tool_metadata,
                          getpid(),
                          agents_output,
-                         &hip_elem_data,
-                         &hsa_elem_data,
-                         &kernel_dispatch_elem_data,
-                         &memory_copy_elem_data,
-                         &marker_elem_data,
-                         &scratch_memory_elem_data,
-                         &rccl_elem_data,
-                         &memory_allocation_elem_data,
-                         &rocdecode_elem_data,
-                         &rocjpeg_elem_data);
+                         hip_output.get_generator(),
+                         hsa_output.get_generator(),
+                         kernel_dispatch_output.get_generator(),
+                         memory_copy_output.get_generator(),
+                         marker_output.get_generator(),
+                         scratch_memory_output.get_generator(),
+                         rccl_output.get_generator(),
+                         memory_allocation_output.get_generator(),
+                         rocdecode_output.get_generator(),
+                         rocjpeg_output.get_generator());
     }
 
     if(tool::get_config().summary_output && outdata.num_output > 0 &&
@@ -21,6 +21,7 @@
 // THE SOFTWARE.
 
 #include "lib/rocprofiler-sdk/code_object/code_object.hpp"
+#include "lib/common/container/rcu_flat_map.hpp"
 #include "lib/common/logging.hpp"
 #include "lib/common/scope_destructor.hpp"
 #include "lib/common/static_object.hpp"
@@ -371,7 +372,7 @@ get_host_function_id()
     return _v;
 }
 
-using kernel_object_map_t        = std::unordered_map<uint64_t, uint64_t>;
+using kernel_object_map_t        = common::container::rcu_flat_map<uint64_t, uint64_t>;
 using executable_array_t         = std::vector<hsa_executable_t>;
 using code_object_unload_array_t = std::vector<hsa::code_object_unload>;
 
@@ -398,8 +399,7 @@ get_code_objects()
 auto*
 get_kernel_object_map()
 {
-    static auto*& _v =
-        common::static_object<common::Synchronized<kernel_object_map_t>>::construct();
+    static auto*& _v = common::static_object<kernel_object_map_t>::construct();
     return _v;
 }
 
@@ -503,14 +503,6 @@ executable_iterate_agent_symbols_load_callback(hsa_executable_t        executabl
     // generate a unique kernel symbol id
     data.kernel_id = ++get_kernel_symbol_id();
 
-    CHECK_NOTNULL(get_kernel_object_map())
-        ->wlock(
-            [](kernel_object_map_t& object_map, uint64_t _kern_obj, uint64_t _kern_id) {
-                object_map[_kern_obj] = _kern_id;
-            },
-            data.kernel_object,
-            data.kernel_id);
-
     code_obj_v->symbols.emplace_back(std::make_unique<hsa::kernel_symbol>(std::move(symbol_v)));
 
     return HSA_STATUS_SUCCESS;
@@ -818,6 +810,20 @@ executable_freeze(hsa_executable_t executable, const char* options)
     CHECK_NOTNULL(code_obj_vec)->wlock([executable](code_object_array_t& _vec) {
         get_loader_table().hsa_ven_amd_loader_executable_iterate_loaded_code_objects(
             executable, code_object_load_callback, &_vec);
+
+        // publish the kernel objects of the executable to the dispatch path in one update
+        CHECK_NOTNULL(get_kernel_object_map())
+            ->update([executable, &_vec](kernel_object_map_t::map_type& object_map) {
+                for(const auto& itr : _vec)
+                {
+                    if(!itr || itr->hsa_executable.handle != executable.handle) continue;
+                    for(const auto& sitr : itr->symbols)
+                    {
+                        if(!sitr) continue;
+                        object_map[sitr->rocp_data.kernel_object] = sitr->rocp_data.kernel_id;
+                    }
+                }
+            });
     });
 
     constexpr auto CODE_OBJECT_KIND = ROCPROFILER_CALLBACK_TRACING_CODE_OBJECT;
@@ -962,15 +968,16 @@ executable_destroy(hsa_executable_t executable)
 
     if(get_kernel_object_map())
     {
-        CHECK_NOTNULL(get_kernel_object_map())->wlock([_unloaded](kernel_object_map_t& data) {
-            for(const auto& uitr : _unloaded)
-            {
-                for(const auto& sitr : uitr.symbols)
+        CHECK_NOTNULL(get_kernel_object_map())
+            ->update([&_unloaded](kernel_object_map_t::map_type& data) {
+                for(const auto& uitr : _unloaded)
                 {
-                    data.erase(sitr->rocp_data.kernel_id);
+                    for(const auto& sitr : uitr.symbols)
+                    {
+                        data.erase(sitr->rocp_data.kernel_object);
+                    }
                 }
-            }
-        });
+            });
     }
 
     if(get_code_objects())
@@ -1177,13 +1184,8 @@ initialize(HipCompilerDispatchTable* table)
 uint64_t
 get_kernel_id(uint64_t kernel_object)
 {
-    return CHECK_NOTNULL(get_kernel_object_map())
-        ->rlock(
-            [](const kernel_object_map_t& object_map, uint64_t _kern_obj) -> uint64_t {
-                auto itr = object_map.find(_kern_obj);
-                return (itr == object_map.end()) ? 0 : itr->second;
-            },
-            kernel_object);
+    // lock-free read of the published snapshot: dispatches never wait on code object updates
+    return CHECK_NOTNULL(get_kernel_object_map())->find(kernel_object, 0);
 }
 
 void
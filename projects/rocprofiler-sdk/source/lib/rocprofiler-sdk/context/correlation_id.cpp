@@ -30,20 +30,160 @@
 
 #include <rocprofiler-sdk/fwd.h>
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 namespace rocprofiler
 {
 namespace context
 {
+/**
+ * Correlation ids are allocated in slabs from a pool owned by the thread which constructs them
+ * and are returned to that pool when they are retired. Retirement can happen on any thread
+ * (e.g. at kernel completion) so retired ids are pushed onto a lock-free list which the owning
+ * thread takes over as a whole once its own free list is empty. The pool of an exited thread
+ * is adopted by the next thread which needs one, so memory is bounded by the peak number of
+ * live correlation ids instead of growing with every traced call.
+ */
+struct correlation_id_pool
+{
+    static constexpr size_t slab_size = 256;
+
+    correlation_id* acquire(uint32_t _cnt, rocprofiler_thread_id_t _tid, uint64_t _internal);
+    void            release(correlation_id* _val);
+
+    template <typename FuncT>
+    void for_each(FuncT&& _func);
+
+    size_t get_slab_count();
+
+private:
+    void add_slab();
+
+    std::mutex                                     m_slab_mutex = {};
+    std::vector<std::unique_ptr<correlation_id[]>> m_slabs      = {};
+    correlation_id*                                m_free       = nullptr;
+    std::atomic<correlation_id*>                   m_retired    = {nullptr};
+};
+
+correlation_id*
+correlation_id_pool::acquire(uint32_t _cnt, rocprofiler_thread_id_t _tid, uint64_t _internal)
+{
+    if(!m_free) m_free = m_retired.exchange(nullptr, std::memory_order_acquire);
+    if(!m_free) add_slab();
+
+    auto* _val = m_free;
+    m_free     = _val->m_next_free;
+
+    _val->m_next_free = nullptr;
+    _val->thread_idx  = _tid;
+    _val->internal    = _internal;
+    _val->ancestor    = 0;
+    _val->m_kern_count.store(0);
+    _val->m_ref_count.store(_cnt);
+
+    return _val;
+}
+
+void
+correlation_id_pool::release(correlation_id* _val)
+{
+    auto* _head = m_retired.load(std::memory_order_relaxed);
+    do
+    {
+        _val->m_next_free = _head;
+    } while(!m_retired.compare_exchange_weak(
+        _head, _val, std::memory_order_release, std::memory_order_relaxed));
+}
+
+template <typename FuncT>
+void
+correlation_id_pool::for_each(FuncT&& _func)
+{
+    auto _lk = std::unique_lock<std::mutex>{m_slab_mutex};
+    for(auto& itr : m_slabs)
+        for(size_t i = 0; i < slab_size; ++i)
+            _func(itr[i]);
+}
+
+size_t
+correlation_id_pool::get_slab_count()
+{
+    auto _lk = std::unique_lock<std::mutex>{m_slab_mutex};
+    return m_slabs.size();
+}
+
+void
+correlation_id_pool::add_slab()
+{
+    auto _slab = std::make_unique<correlation_id[]>(slab_size);
+    for(size_t i = 0; i < slab_size; ++i)
+    {
+        _slab[i].m_pool      = this;
+        _slab[i].m_next_free = (i + 1 < slab_size) ? &_slab[i + 1] : m_free;
+    }
+    m_free = &_slab[0];
+
+    auto _lk = std::unique_lock<std::mutex>{m_slab_mutex};
+    m_slabs.emplace_back(std::move(_slab));
+}
+
 namespace
 {
+struct correlation_id_pools
+{
+    std::vector<std::unique_ptr<correlation_id_pool>> pools    = {};
+    std::vector<correlation_id_pool*>                 orphaned = {};
+};
+
 auto*&
-get_correlation_id_map()
+get_correlation_id_pools()
 {
-    using data_type  = common::container::stable_vector<std::unique_ptr<correlation_id>>;
-    static auto*& _v = common::static_object<common::Synchronized<data_type>>::construct();
+    static auto*& _v =
+        common::static_object<common::Synchronized<correlation_id_pools>>::construct();
     return _v;
 }
 
+// pool owned by this thread, handed to another thread when this thread exits
+struct thread_correlation_id_pool
+{
+    ~thread_correlation_id_pool()
+    {
+        auto* _pools = get_correlation_id_pools();
+        if(pool && _pools) _pools->wlock([this](auto& data) { data.orphaned.emplace_back(pool); });
+    }
+
+    correlation_id_pool* get()
+    {
+        if(pool) return pool;
+
+        auto* _pools = get_correlation_id_pools();
+        if(!_pools) return nullptr;
+
+        pool = _pools->wlock([](auto& data) {
+            if(!data.orphaned.empty())
+            {
+                auto* _ret = data.orphaned.back();
+                data.orphaned.pop_back();
+                return _ret;
+            }
+            return data.pools.emplace_back(std::make_unique<correlation_id_pool>()).get();
+        });
+        return pool;
+    }
+
+    correlation_id_pool* pool = nullptr;
+};
+
+correlation_id_pool*
+get_thread_correlation_id_pool()
+{
+    static thread_local auto _v = thread_correlation_id_pool{};
+    return _v.get();
+}
+
 auto&
 get_latest_correlation_id_impl()
 {
@@ -117,6 +257,10 @@ correlation_id::sub_ref_count()
                     << fmt::format("failed to emplace correlation id retirement for {}", internal);
             }
         }
+
+        // no longer referenced: any further use of this object is stale
+        m_generation.fetch_add(1, std::memory_order_release);
+        if(m_pool) m_pool->release(this);
     }
 
     return _ret;
@@ -139,19 +283,17 @@ correlation_tracing_service::construct(uint32_t _init_ref_count)
 {
     ROCP_FATAL_IF(_init_ref_count == 0) << "must have reference count > 0";
 
-    auto  _internal_id = get_unique_internal_id();
-    auto* corr_id_map  = get_correlation_id_map();
-    if(!corr_id_map) return nullptr;
-    auto& ret = corr_id_map->wlock([](auto& data) -> auto& { return data.emplace_back(); });
+    auto* _pool = get_thread_correlation_id_pool();
+    if(!_pool) return nullptr;
 
-    ret = std::make_unique<correlation_id>(_init_ref_count, common::get_tid(), _internal_id);
+    auto* ret = _pool->acquire(_init_ref_count, common::get_tid(), get_unique_internal_id());
 
     if(auto* prev_api_corr_id = get_latest_correlation_id())
         ret->ancestor = prev_api_corr_id->internal;
 
-    get_latest_correlation_id_impl().emplace_back(ret.get());
+    get_latest_correlation_id_impl().emplace_back(ret);
 
-    return ret.get();
+    return ret;
 }
 
 correlation_id*
@@ -216,24 +358,39 @@ dump_correlation_stack(const char* s)
     printf("%s", info.str().c_str());
 }
 
+size_t
+get_correlation_id_slab_count()
+{
+    if(!get_correlation_id_pools()) return 0;
+
+    return get_correlation_id_pools()->rlock([](const auto& data) {
+        size_t _count = 0;
+        for(const auto& pool : data.pools)
+            _count += pool->get_slab_count();
+        return _count;
+    });
+}
+
 void
 correlation_id_finalize()
 {
-    if(!get_correlation_id_map()) return;
+    if(!get_correlation_id_pools()) return;
 
-    get_correlation_id_map()->rlock([](const auto& data) {
+    get_correlation_id_pools()->rlock([](const auto& data) {
         uint64_t ndangling = 0;
-        for(const auto& itr : data)
+        for(const auto& pool : data.pools)
         {
-            if(itr && itr->get_ref_count() > 0)
-            {
-                ++ndangling;
-                ROCP_WARNING << "retiring dangling correlation ID " << itr->internal
-                             << " from thread " << itr->thread_idx
-                             << " :: remaining reference count: " << itr->get_ref_count();
-                while(itr && itr->get_ref_count() > 0 && itr->sub_ref_count() > 1)
-                {}
-            }
+            pool->for_each([&ndangling](correlation_id& itr) {
+                if(itr.get_ref_count() > 0)
+                {
+                    ++ndangling;
+                    ROCP_WARNING << "retiring dangling correlation ID " << itr.internal
+                                 << " from thread " << itr.thread_idx
+                                 << " :: remaining reference count: " << itr.get_ref_count();
+                    while(itr.get_ref_count() > 0 && itr.sub_ref_count() > 1)
+                    {}
+                }
+            });
         }
         ROCP_CI_LOG_IF(INFO, ndangling > 0) << "retired dangling correlation IDs: " << ndangling;
     });
@@ -33,6 +33,8 @@ namespace rocprofiler
 {
 namespace context
 {
+struct correlation_id_pool;
+
 struct correlation_id
 {
     // reference count starts at 5:
@@ -70,9 +72,18 @@ struct correlation_id
     uint32_t add_kern_count();
     uint32_t sub_kern_count();
 
+    // correlation ids are recycled once retired. The generation is incremented at retirement
+    // so holders of a pointer can detect that it now refers to a different correlation id
+    uint32_t get_generation() const { return m_generation.load(std::memory_order_acquire); }
+
 private:
+    friend struct correlation_id_pool;
+
     std::atomic<uint32_t> m_kern_count = {0};
     std::atomic<uint32_t> m_ref_count  = {0};
+    std::atomic<uint32_t> m_generation = {0};
+    correlation_id_pool*  m_pool       = nullptr;
+    correlation_id*       m_next_free  = nullptr;
 };
 
 // latest correlation id for thread
@@ -90,6 +101,10 @@ push_correlation_id(correlation_id*);
 void
 dump_correlation_stack(const char*);
 
+// number of slabs allocated for correlation ids by all threads
+size_t
+get_correlation_id_slab_count();
+
 void
 correlation_id_finalize();
 
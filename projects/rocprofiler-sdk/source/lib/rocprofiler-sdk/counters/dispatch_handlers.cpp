@@ -167,7 +167,20 @@ completed_cb(const context::context*                            ctx,
     // We have no profile config, nothing to output.
     if(!pkt || !prof_config) return;
 
-    completed_cb_params_t params{info, ptr_session, dispatch_time, prof_config, std::move(pkt)};
+    auto _corr_id_v =
+        rocprofiler_async_correlation_id_t{.internal = 0, .external = context::null_user_data};
+    if(const auto* _corr_id = ptr_session->correlation_id)
+    {
+        _corr_id_v.internal = _corr_id->internal;
+        if(const auto* external = rocprofiler::common::get_val(
+               ptr_session->tracing_data.external_correlation_ids, info->internal_context))
+        {
+            _corr_id_v.external = *external;
+        }
+    }
+
+    completed_cb_params_t params{
+        info, ptr_session, dispatch_time, prof_config, std::move(pkt), _corr_id_v};
     process_callback_data(std::move(params));
 }
 
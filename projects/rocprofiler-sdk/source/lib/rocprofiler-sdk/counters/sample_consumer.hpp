@@ -25,9 +25,17 @@
 #include "lib/rocprofiler-sdk/counters/sample_processing.hpp"
 #include "lib/rocprofiler-sdk/internal_threading.hpp"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <condition_variable>
+#include <deque>
+#include <functional>
 #include <mutex>
+#include <optional>
 #include <thread>
+#include <utility>
+#include <vector>
 
 namespace rocprofiler
 {
@@ -116,5 +124,153 @@ protected:
     std::condition_variable    cv;
 };
 
+/**
+ * Pool of worker threads which process the added data concurrently and commit the results
+ * in the order the data was added. Each element gets a sequence number when it is added;
+ * finished results wait in a reorder window until every earlier element has been committed.
+ * The process function runs concurrently on the workers, the commit function is called by
+ * one thread at a time. When the pool is not started or its queue is full, the adding thread
+ * processes the element itself and hands the result to the same ordered commit stage.
+ * At most PENDING_SIZE elements are in flight past the oldest uncommitted one: adding
+ * blocks until that element is committed, so a slow element holds back the producers
+ * instead of growing the reorder window.
+ */
+template <typename DataType, typename ResultType>
+class ordered_consumer_pool_t
+{
+    static constexpr size_t SIZE         = 128;
+    static constexpr size_t PENDING_SIZE = 64 * SIZE;
+    using process_func_t                 = std::function<ResultType(DataType&&)>;
+    using commit_func_t                  = std::function<void(ResultType&&)>;
+
+public:
+    ordered_consumer_pool_t(process_func_t process, commit_func_t commit, size_t num_workers = 1)
+    : process_fn{std::move(process)}
+    , commit_fn{std::move(commit)}
+    , num_workers{std::max<size_t>(num_workers, 1)}
+    {}
+
+    virtual ~ordered_consumer_pool_t() { exit(); }
+
+    void start()
+    {
+        std::unique_lock<std::mutex> lk(mut);
+
+        if(valid) return;
+        valid = true;
+
+        internal_threading::notify_pre_internal_thread_create(ROCPROFILER_LIBRARY);
+        for(size_t i = 0; i < num_workers; ++i)
+            workers.emplace_back(&ordered_consumer_pool_t::worker_loop, this);
+        internal_threading::notify_post_internal_thread_create(ROCPROFILER_LIBRARY);
+    }
+
+    /// waits for the workers to drain the queue. Results are all committed once every
+    /// thread processing inline has returned from add().
+    void exit()
+    {
+        std::unique_lock<std::mutex> exit_lk(exit_mut);
+        {
+            std::unique_lock<std::mutex> lk(mut);
+            valid = false;
+            cv.notify_all();
+            window_cv.notify_all();
+        }
+
+        for(auto& itr : workers)
+            if(itr.joinable()) itr.join();
+        workers.clear();
+    }
+
+    void add(DataType&& params)
+    {
+        std::unique_lock<std::mutex> lk(mut);
+
+        if(valid && next_seq - next_commit.load() >= PENDING_SIZE)
+        {
+            ++window_waiters;
+            window_cv.wait(
+                lk, [&] { return next_seq - next_commit.load() < PENDING_SIZE || !valid; });
+            --window_waiters;
+        }
+
+        auto seq = next_seq++;
+        if(read_ptr + buffer.size() <= write_ptr || !valid)
+        {
+            lk.unlock();
+            // If not possible to use a worker, proccess with this thread
+            commit(seq, process_fn(std::move(params)));
+            return;
+        }
+
+        buffer.at(write_ptr % buffer.size()) = {seq, std::move(params)};
+        ++write_ptr;
+        cv.notify_one();
+    }
+
+    size_t size() const { return num_workers; }
+
+protected:
+    void worker_loop()
+    {
+        while(true)
+        {
+            std::unique_lock<std::mutex> lk(mut);
+            cv.wait(lk, [&] { return read_ptr != write_ptr || !valid; });
+            if(read_ptr == write_ptr) return;
+
+            auto retrieved = std::move(buffer.at(read_ptr % buffer.size()));
+            ++read_ptr;
+            lk.unlock();
+
+            commit(retrieved.first, process_fn(std::move(retrieved.second)));
+        }
+    }
+
+    void commit(size_t seq, ResultType&& result)
+    {
+        std::unique_lock<std::mutex> lk(commit_mut);
+
+        auto idx = seq - next_commit;
+        if(pending.size() <= idx) pending.resize(idx + 1);
+        pending.at(idx) = std::move(result);
+
+        // whichever thread fills the oldest slot commits every result that is ready
+        if(!pending.front()) return;
+        while(!pending.empty() && pending.front())
+        {
+            commit_fn(std::move(*pending.front()));
+            pending.pop_front();
+            ++next_commit;
+        }
+
+        if(window_waiters.load() > 0)
+        {
+            std::unique_lock<std::mutex> window_lk(mut);
+            window_cv.notify_all();
+        }
+    }
+
+    using item_t = std::pair<size_t, DataType>;
+
+    process_func_t                        process_fn;
+    commit_func_t                         commit_fn;
+    size_t                                num_workers = 1;
+    bool                                  valid       = false;
+    size_t                                next_seq    = 0;
+    size_t                                write_ptr   = 0;
+    size_t                                read_ptr    = 0;
+    std::array<item_t, SIZE>              buffer      = {};
+    std::vector<std::thread>              workers     = {};
+    std::mutex                            mut         = {};
+    std::mutex                            exit_mut    = {};
+    std::condition_variable               cv          = {};
+    std::condition_variable               window_cv   = {};
+    std::atomic<size_t>                   window_waiters{0};
+    std::mutex                            commit_mut = {};
+    std::atomic<size_t>                   next_commit{0};
+    std::deque<std::optional<ResultType>> pending = {};
+};
+
 }  // namespace counters
 }  // namespace rocprofiler
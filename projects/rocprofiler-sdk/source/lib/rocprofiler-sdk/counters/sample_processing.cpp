@@ -25,6 +25,7 @@
 #include "lib/rocprofiler-sdk/counters/sample_processing.hpp"
 
 #include "lib/common/container/small_vector.hpp"
+#include "lib/common/environment.hpp"
 #include "lib/common/synchronized.hpp"
 #include "lib/common/utility.hpp"
 #include "lib/rocprofiler-sdk/buffer.hpp"
@@ -36,28 +37,45 @@
 
 #include <rocprofiler-sdk/fwd.h>
 
+#include <algorithm>
+#include <thread>
+#include <vector>
+
 namespace rocprofiler
 {
 namespace counters
 {
-std::mutex&
-get_buffer_mut()
+namespace
+{
+using counter_records_t = common::container::small_vector<rocprofiler_counter_record_t, 128>;
+
+/**
+ * Counter values of a completed dispatch, waiting to be delivered to the tool
+ */
+struct completed_cb_result_t
 {
-    static auto*& mut = common::static_object<std::mutex>::construct();
-    return *CHECK_NOTNULL(mut);
+    completed_cb_params_t params  = {};
+    counter_records_t     records = {};
+};
+
+size_t
+get_num_processing_threads()
+{
+    auto _default = std::clamp<size_t>(std::thread::hardware_concurrency() / 4, 1, 4);
+    return std::max<size_t>(
+        common::get_env("ROCPROFILER_COUNTER_PROCESSING_THREADS", _default), 1);
 }
 
 /**
- * Callback called by HSA interceptor when the kernel has completed processing.
+ * Decodes the AQL packet of a completed kernel and evaluates the counters. Runs concurrently
+ * on the workers of the post-processing pool.
  */
-void
-proccess_completed_cb(completed_cb_params_t&& params)
+completed_cb_result_t
+evaluate_completed_cb(completed_cb_params_t&& params)
 {
-    auto& info          = params.info;
-    auto& session       = *params.session;
-    auto& dispatch_time = params.dispatch_time;
-    auto& prof_config   = params.prof_config;
-    auto& pkt           = params.pkt;
+    auto& session     = *params.session;
+    auto& prof_config = params.prof_config;
+    auto& pkt         = params.pkt;
 
     ROCP_FATAL_IF(pkt == nullptr) << "AQL packet is a nullptr!";
 
@@ -67,31 +85,17 @@ proccess_completed_cb(completed_cb_params_t&& params)
 
     prof_config->packets.wlock([&](auto& pkt_vector) { pkt_vector.emplace_back(std::move(pkt)); });
 
-    common::container::small_vector<rocprofiler_counter_record_t, 128> out;
-    rocprofiler::buffer::instance*                                     buf = nullptr;
+    auto out = counter_records_t{};
 
-    if(info->buffer)
-    {
-        buf = CHECK_NOTNULL(buffer::get_buffer(info->buffer->handle));
-    }
-
-    auto _corr_id_v =
-        rocprofiler_async_correlation_id_t{.internal = 0, .external = context::null_user_data};
-
-    if(const auto* _corr_id = session.correlation_id)
-    {
-        _corr_id_v.internal = _corr_id->internal;
-        if(const auto* external = rocprofiler::common::get_val(
-               session.tracing_data.external_correlation_ids, info->internal_context))
-        {
-            _corr_id_v.external = *external;
-        }
-    }
+    // intermediate results of the evaluation. The outer vector keeps its capacity across the
+    // dispatches of this thread, the evaluation allocates the inner vectors for each dispatch.
+    static thread_local auto cache =
+        std::vector<std::unique_ptr<std::vector<rocprofiler_counter_record_t>>>{};
 
     auto _dispatch_id = session.callback_record.dispatch_info.dispatch_id;
     for(auto& ast : prof_config->asts)
     {
-        std::vector<std::unique_ptr<std::vector<rocprofiler_counter_record_t>>> cache;
+        cache.clear();
         auto* ret = ast.evaluate(decoded_pkt, cache);
         CHECK(ret);
         ast.set_out_id(*ret);
@@ -104,61 +108,79 @@ proccess_completed_cb(completed_cb_params_t&& params)
             out.emplace_back(val);
         }
     }
+    cache.clear();
 
-    if(!out.empty())
+    return completed_cb_result_t{std::move(params), std::move(out)};
+}
+
+/**
+ * Delivers the counter values of a completed kernel to the buffer or the callback. The
+ * post-processing pool calls this one dispatch at a time, in the order the dispatches
+ * completed, so buffer records stay in order.
+ */
+void
+commit_completed_cb(completed_cb_result_t&& result)
+{
+    auto& info          = result.params.info;
+    auto& session       = *result.params.session;
+    auto& dispatch_time = result.params.dispatch_time;
+    auto& out           = result.records;
+
+    if(out.empty()) return;
+
+    if(info->buffer)
     {
-        if(buf)
+        auto* buf = CHECK_NOTNULL(buffer::get_buffer(info->buffer->handle));
+
+        auto _header =
+            common::init_public_api_struct(rocprofiler_dispatch_counting_service_record_t{});
+        _header.num_records    = out.size();
+        _header.correlation_id = result.params.correlation_id;
+        if(dispatch_time.status == HSA_STATUS_SUCCESS)
         {
-            auto _header =
-                common::init_public_api_struct(rocprofiler_dispatch_counting_service_record_t{});
-            _header.num_records    = out.size();
-            _header.correlation_id = _corr_id_v;
-            if(dispatch_time.status == HSA_STATUS_SUCCESS)
-            {
-                _header.start_timestamp = dispatch_time.start;
-                _header.end_timestamp   = dispatch_time.end;
-            }
-            _header.dispatch_info = session.callback_record.dispatch_info;
-
-            auto _lk = std::unique_lock{get_buffer_mut()};  // Buffer records need to be in order
-
-            buf->emplace(ROCPROFILER_BUFFER_CATEGORY_COUNTERS,
-                         ROCPROFILER_COUNTER_RECORD_PROFILE_COUNTING_DISPATCH_HEADER,
-                         _header);
-
-            for(auto itr : out)
-                buf->emplace(
-                    ROCPROFILER_BUFFER_CATEGORY_COUNTERS, ROCPROFILER_COUNTER_RECORD_VALUE, itr);
+            _header.start_timestamp = dispatch_time.start;
+            _header.end_timestamp   = dispatch_time.end;
         }
-        else
+        _header.dispatch_info = session.callback_record.dispatch_info;
+
+        buf->emplace(ROCPROFILER_BUFFER_CATEGORY_COUNTERS,
+                     ROCPROFILER_COUNTER_RECORD_PROFILE_COUNTING_DISPATCH_HEADER,
+                     _header);
+
+        for(auto itr : out)
+            buf->emplace(
+                ROCPROFILER_BUFFER_CATEGORY_COUNTERS, ROCPROFILER_COUNTER_RECORD_VALUE, itr);
+    }
+    else
+    {
+        CHECK(info->record_callback);
+
+        auto dispatch_data =
+            common::init_public_api_struct(rocprofiler_dispatch_counting_service_data_t{});
+
+        dispatch_data.dispatch_info  = session.callback_record.dispatch_info;
+        dispatch_data.correlation_id = result.params.correlation_id;
+        if(dispatch_time.status == HSA_STATUS_SUCCESS)
         {
-            CHECK(info->record_callback);
-
-            auto dispatch_data =
-                common::init_public_api_struct(rocprofiler_dispatch_counting_service_data_t{});
-
-            dispatch_data.dispatch_info  = session.callback_record.dispatch_info;
-            dispatch_data.correlation_id = _corr_id_v;
-            if(dispatch_time.status == HSA_STATUS_SUCCESS)
-            {
-                dispatch_data.start_timestamp = dispatch_time.start;
-                dispatch_data.end_timestamp   = dispatch_time.end;
-            }
-
-            info->record_callback(dispatch_data,
-                                  out.data(),
-                                  out.size(),
-                                  session.user_data,
-                                  info->record_callback_args);
+            dispatch_data.start_timestamp = dispatch_time.start;
+            dispatch_data.end_timestamp   = dispatch_time.end;
         }
+
+        info->record_callback(dispatch_data,
+                              out.data(),
+                              out.size(),
+                              session.user_data,
+                              info->record_callback_args);
     }
 }
+}  // namespace
 
 auto&
 callback_thread_get()
 {
-    using consumer_t = consumer_thread_t<completed_cb_params_t>;
-    static auto*& _v = common::static_object<consumer_t>::construct(proccess_completed_cb);
+    using consumer_t = ordered_consumer_pool_t<completed_cb_params_t, completed_cb_result_t>;
+    static auto*& _v = common::static_object<consumer_t>::construct(
+        evaluate_completed_cb, commit_completed_cb, get_num_processing_threads());
     return *CHECK_NOTNULL(_v);
 }
 
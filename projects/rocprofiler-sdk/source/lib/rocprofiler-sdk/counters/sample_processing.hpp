@@ -37,6 +37,9 @@ struct completed_cb_params_t
     kernel_dispatch::profiling_time                   dispatch_time;
     std::shared_ptr<counter_config>                   prof_config;
     std::unique_ptr<rocprofiler::hsa::AQLPacket>      pkt;
+    // captured at completion: the correlation id object may be retired and recycled before
+    // the dispatch is processed
+    rocprofiler_async_correlation_id_t correlation_id = {};
 };
 
 void
@@ -22,9 +22,12 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <future>
 #include <mutex>
+#include <thread>
 #include <tuple>
 #include <unordered_map>
 #include <utility>
@@ -112,5 +115,169 @@ TEST(consumer, multithreaded)
         EXPECT_EQ(var.load(), expected);
 }
 
+// synthetic decoded packet: the samples of one dispatch which the workers reduce
+struct SyntheticPacket
+{
+    size_t                producer = 0;
+    size_t                index    = 0;
+    std::vector<uint64_t> samples  = {};
+};
+
+struct SyntheticResult
+{
+    size_t   producer = 0;
+    size_t   index    = 0;
+    uint64_t value    = 0;
+};
+
+using ordered_pool_t = ordered_consumer_pool_t<SyntheticPacket, SyntheticResult>;
+
+constexpr size_t NUM_WORKERS         = 4;
+constexpr size_t NUM_ORDERED_PACKETS = 1ul << 14;
+
+SyntheticPacket
+make_packet(size_t producer, size_t index)
+{
+    // uneven amount of work so that the workers finish out of order
+    auto _samples = std::vector<uint64_t>((index * 7919) % 61 + 1, index);
+    return SyntheticPacket{producer, index, std::move(_samples)};
+}
+
+SyntheticResult
+reduce_fn(SyntheticPacket&& data)
+{
+    auto _sum = uint64_t{0};
+    for(auto itr : data.samples)
+        _sum += itr;
+    return SyntheticResult{data.producer, data.index, _sum};
+}
+
+uint64_t
+expected_value(size_t index)
+{
+    return index * ((index * 7919) % 61 + 1);
+}
+
+TEST(ordered_consumer, nothread)
+{
+    auto committed = std::vector<SyntheticResult>{};
+
+    ordered_pool_t pool(reduce_fn, [&](SyntheticResult&& res) { committed.emplace_back(res); });
+    for(size_t i = 0; i < 16; i++)
+        pool.add(make_packet(0, i));
+
+    ASSERT_EQ(committed.size(), 16);
+    for(size_t i = 0; i < committed.size(); i++)
+    {
+        EXPECT_EQ(committed.at(i).index, i);
+        EXPECT_EQ(committed.at(i).value, expected_value(i));
+    }
+}
+
+TEST(ordered_consumer, single_producer)
+{
+    auto committed = std::vector<SyntheticResult>{};
+    {
+        ordered_pool_t pool(
+            reduce_fn, [&](SyntheticResult&& res) { committed.emplace_back(res); }, NUM_WORKERS);
+        pool.start();
+
+        for(size_t i = 0; i < NUM_ORDERED_PACKETS; i++)
+            pool.add(make_packet(0, i));
+    }
+
+    ASSERT_EQ(committed.size(), NUM_ORDERED_PACKETS);
+    for(size_t i = 0; i < committed.size(); i++)
+    {
+        EXPECT_EQ(committed.at(i).index, i);
+        EXPECT_EQ(committed.at(i).value, expected_value(i));
+    }
+}
+
+TEST(ordered_consumer, stalled_packet)
+{
+    // number of packets which may be added past the oldest uncommitted one
+    constexpr size_t PENDING_SIZE = 64 * 128;
+    constexpr size_t NUM_PACKETS  = 4 * PENDING_SIZE;
+
+    auto committed     = std::vector<SyntheticResult>{};
+    auto num_added     = std::atomic<size_t>{0};
+    auto num_committed = std::atomic<size_t>{0};
+    auto release       = std::promise<void>{};
+    auto released      = release.get_future().share();
+
+    ordered_pool_t pool(
+        [&](SyntheticPacket&& data) {
+            if(data.index == 0) released.wait();
+            return reduce_fn(std::move(data));
+        },
+        [&](SyntheticResult&& res) {
+            committed.emplace_back(res);
+            ++num_committed;
+        },
+        NUM_WORKERS);
+    pool.start();
+
+    auto producer = std::async(std::launch::async, [&]() {
+        for(size_t i = 0; i < NUM_PACKETS; i++)
+        {
+            pool.add(make_packet(0, i));
+            ++num_added;
+        }
+    });
+
+    // the producer blocks once the window behind the stalled packet is full
+    while(num_added.load() < PENDING_SIZE)
+        std::this_thread::yield();
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    EXPECT_EQ(num_added.load(), PENDING_SIZE);
+    EXPECT_EQ(num_committed.load(), 0);
+
+    release.set_value();
+    producer.wait();
+    pool.exit();
+
+    ASSERT_EQ(committed.size(), NUM_PACKETS);
+    for(size_t i = 0; i < committed.size(); i++)
+    {
+        EXPECT_EQ(committed.at(i).index, i);
+        EXPECT_EQ(committed.at(i).value, expected_value(i));
+    }
+}
+
+TEST(ordered_consumer, multiple_producers)
+{
+    auto committed = std::vector<SyntheticResult>{};
+
+    ordered_pool_t pool(
+        reduce_fn, [&](SyntheticResult&& res) { committed.emplace_back(res); }, NUM_WORKERS);
+
+    auto produce_fn = [&](size_t tid) {
+        for(size_t i = 0; i < NUM_ORDERED_PACKETS; i++)
+            pool.add(make_packet(tid, i));
+    };
+
+    {
+        std::vector<std::future<void>> threads{};
+        for(size_t i = 0; i < NUM_THREADS; i++)
+            threads.push_back(std::async(std::launch::async, produce_fn, i));
+
+        // some packets are added before the workers exist and are processed inline
+        pool.start();
+    }
+
+    pool.exit();
+
+    // the packets of each producer are committed in the order they were added
+    ASSERT_EQ(committed.size(), NUM_THREADS * NUM_ORDERED_PACKETS);
+    auto next_index = std::vector<size_t>(NUM_THREADS, 0);
+    for(const auto& itr : committed)
+    {
+        ASSERT_LT(itr.producer, NUM_THREADS);
+        EXPECT_EQ(itr.index, next_index.at(itr.producer)++);
+        EXPECT_EQ(itr.value, expected_value(itr.index));
+    }
+}
+
 }  // namespace counters
 }  // namespace rocprofiler
@@ -30,6 +30,11 @@
 
 #include <unistd.h>
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 namespace rocprofiler
 {
 namespace external_correlation
@@ -107,19 +112,57 @@ get_default_data()
 auto f_default_tid = get_default_tid();  // make sure it is initialized
 }  // namespace
 
-rocprofiler_user_data_t
-external_correlation::get(rocprofiler_thread_id_t tid) const
+size_t
+get_next_index()
 {
-    return data.rlock(
-        [](const external_correlation_map_t& _data, rocprofiler_thread_id_t tid_v) {
-            if(_data.count(tid_v) == 0) return get_default_data();
-            const auto& itr = _data.at(tid_v);
-            return itr.rlock([](const external_correlation_stack_t& data_stack) {
-                if(data_stack.empty()) return get_default_data();
-                return data_stack.back();
-            });
+    static auto _v = std::atomic<size_t>{0};
+    return _v++;
+}
+
+external_correlation_thread_data*
+external_correlation::get_thread_data(rocprofiler_thread_id_t tid, bool create) const
+{
+    // thread-local pointers to the data of the calling thread, indexed by instance
+    static thread_local auto _cache = std::vector<external_correlation_thread_data*>{};
+
+    const bool is_this_thread = (tid == common::get_tid());
+    if(is_this_thread && index < _cache.size() && _cache[index]) return _cache[index];
+
+    auto* _data = data.rlock(
+        [](const external_correlation_map_t& _data_v,
+           rocprofiler_thread_id_t           tid_v) -> external_correlation_thread_data* {
+            auto itr = _data_v.find(tid_v);
+            return (itr != _data_v.end()) ? itr->second.get() : nullptr;
         },
         tid);
+
+    // always create the entry of the calling thread so that later lookups hit the cache
+    if(!_data && (create || is_this_thread))
+    {
+        _data = data.wlock(
+            [](external_correlation_map_t& _data_v, rocprofiler_thread_id_t tid_v) {
+                auto& itr = _data_v[tid_v];
+                if(!itr) itr = std::make_unique<external_correlation_thread_data>();
+                return itr.get();
+            },
+            tid);
+    }
+
+    if(is_this_thread)
+    {
+        if(_cache.size() <= index) _cache.resize(index + 1, nullptr);
+        _cache[index] = _data;
+    }
+
+    return _data;
+}
+
+rocprofiler_user_data_t
+external_correlation::get(rocprofiler_thread_id_t tid) const
+{
+    const auto* _data = get_thread_data(tid, false);
+    if(!_data || !_data->has_value.load(std::memory_order_acquire)) return get_default_data();
+    return rocprofiler_user_data_t{.value = _data->value.load(std::memory_order_relaxed)};
 }
 
 rocprofiler_user_data_t
@@ -153,37 +196,16 @@ external_correlation::push(rocprofiler_thread_id_t tid, rocprofiler_user_data_t
 {
     static auto default_tid = get_default_tid();
 
-    // ensure that data contains key for provided thread id
-    while(!data.ulock(
-        [](const external_correlation_map_t& _data, rocprofiler_thread_id_t tid_v) {
-            return (_data.find(tid_v) != _data.end());
-        },
-        [](external_correlation_map_t& _data, rocprofiler_thread_id_t tid_v) {
-            _data.emplace(tid_v, external_correlation_stack_t{});
-            return true;
-        },
-        tid))
-    {}
-
-    // since we know from above that there will be a key for the tid, we start with a read
-    // lock and then once we have have the mapped data for the key, we leverage the enabling
-    // of the wlock const overload to remove the constness and use a write lock. If we were to use a
-    // write lock at the top lovel, then we would unnecessarily block other threads from writing to
-    // the stack of another thread
-    data.rlock(
-        [](const external_correlation_map_t& _data,
-           rocprofiler_thread_id_t           tid_v,
-           rocprofiler_user_data_t           user_data_v) {
-            const auto& itr = _data.at(tid_v);
-            itr.wlock([](external_correlation_stack_t& data_stack,
-                         rocprofiler_user_data_t       value) { data_stack.emplace_back(value); },
-                      user_data_v);
-            // child threads inherit the current value on default thread
-            if(tid_v == default_tid)
-                get_default_data_impl().store(user_data_v.value, std::memory_order_relaxed);
-        },
-        tid,
-        user_data);
+    auto* _data = get_thread_data(tid, true);
+    auto  _lk   = std::unique_lock<std::mutex>{_data->mutex};
+
+    _data->stack.emplace_back(user_data);
+    _data->value.store(user_data.value, std::memory_order_relaxed);
+    _data->has_value.store(true, std::memory_order_release);
+
+    // child threads inherit the current value on default thread
+    if(tid == default_tid)
+        get_default_data_impl().store(user_data.value, std::memory_order_relaxed);
 }
 
 rocprofiler_user_data_t
@@ -191,24 +213,25 @@ external_correlation::pop(rocprofiler_thread_id_t tid)
 {
     static auto default_tid = get_default_tid();
 
-    return data.rlock(
-        [](const external_correlation_map_t& _data, rocprofiler_thread_id_t tid_v) {
-            if(_data.count(tid_v) == 0) return empty_user_data;
-            const auto& itr = _data.at(tid_v);
-            return itr.wlock([tid_v](external_correlation_stack_t& data_stack) {
-                if(data_stack.empty()) return empty_user_data;
-                auto ret = data_stack.back();
-                data_stack.pop_back();
-                // child threads inherit the current value on default thread
-                if(tid_v == default_tid)
-                {
-                    uint64_t value = (!data_stack.empty()) ? data_stack.back().value : 0;
-                    get_default_data_impl().store(value, std::memory_order_relaxed);
-                }
-                return ret;
-            });
-        },
-        tid);
+    auto* _data = get_thread_data(tid, false);
+    if(!_data) return empty_user_data;
+
+    auto _lk = std::unique_lock<std::mutex>{_data->mutex};
+    if(_data->stack.empty()) return empty_user_data;
+
+    auto ret = _data->stack.back();
+    _data->stack.pop_back();
+
+    uint64_t value = (!_data->stack.empty()) ? _data->stack.back().value : 0;
+    if(_data->stack.empty())
+        _data->has_value.store(false, std::memory_order_release);
+    else
+        _data->value.store(value, std::memory_order_release);
+
+    // child threads inherit the current value on default thread
+    if(tid == default_tid) get_default_data_impl().store(value, std::memory_order_relaxed);
+
+    return ret;
 }
 
 rocprofiler_status_t
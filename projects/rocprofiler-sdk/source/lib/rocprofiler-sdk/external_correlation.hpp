@@ -29,8 +29,11 @@
 #include "lib/common/synchronized.hpp"
 #include "lib/common/utility.hpp"
 
+#include <atomic>
 #include <bitset>
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -45,15 +48,26 @@ struct context;
 
 namespace external_correlation
 {
-static constexpr bool enable_const_wlock_v = true;
-
 using external_correlation_stack_t = std::vector<rocprofiler_user_data_t>;
 
-// we enable the wlock(...) const for the mapped type so that we can use wlock on the mapped type
-// within a rlock of the external correlation map
+// external correlation ids pushed for one thread. The top of the stack is mirrored in atomics so
+// that it can be read without locking; the mutex only serializes push and pop
+struct external_correlation_thread_data
+{
+    std::mutex                   mutex     = {};
+    external_correlation_stack_t stack     = {};
+    std::atomic<bool>            has_value = {false};
+    std::atomic<uint64_t>        value     = {0};
+};
+
+// owns the data of every thread. The calling thread reaches its own entry through a thread-local
+// pointer so this map is only locked the first time a thread is seen or for other threads
 using external_correlation_map_t =
-    std::unordered_map<rocprofiler_thread_id_t,
-                       common::Synchronized<external_correlation_stack_t, enable_const_wlock_v>>;
+    std::unordered_map<rocprofiler_thread_id_t, std::unique_ptr<external_correlation_thread_data>>;
+
+// unique index of each external_correlation instance, used to find the thread-local data
+size_t
+get_next_index();
 
 struct external_correlation
 {
@@ -83,6 +97,9 @@ struct external_correlation
 private:
     rocprofiler_user_data_t get(rocprofiler_thread_id_t thr_id) const;
 
+    external_correlation_thread_data* get_thread_data(rocprofiler_thread_id_t thr_id,
+                                                      bool                    create) const;
+
     std::optional<rocprofiler_user_data_t> invoke_callback(
         rocprofiler_thread_id_t                            thr_id,
         const context::context*                            ctx,
@@ -90,10 +107,11 @@ private:
         uint32_t                                           op,
         uint64_t                                           internal_corr_id) const;
 
-    request_cb_t                                     callback      = nullptr;
-    void*                                            callback_data = nullptr;
-    std::bitset<request_kind_size>                   request       = 0;
-    common::Synchronized<external_correlation_map_t> data          = {};
+    request_cb_t                                             callback      = nullptr;
+    void*                                                    callback_data = nullptr;
+    std::bitset<request_kind_size>                           request       = 0;
+    size_t                                                   index         = get_next_index();
+    mutable common::Synchronized<external_correlation_map_t> data          = {};
 };
 }  // namespace external_correlation
 }  // namespace rocprofiler
@@ -30,6 +30,7 @@
 #include "lib/rocprofiler-sdk/agent.hpp"
 #include "lib/rocprofiler-sdk/context/context.hpp"
 #include "lib/rocprofiler-sdk/hsa/hsa.hpp"
+#include "lib/rocprofiler-sdk/internal_threading.hpp"
 #include "lib/rocprofiler-sdk/registration.hpp"
 #include "lib/rocprofiler-sdk/tracing/fwd.hpp"
 #include "lib/rocprofiler-sdk/tracing/profiling_time.hpp"
@@ -45,9 +46,15 @@
 #include <hsa/amd_hsa_signal.h>
 #include <hsa/hsa.h>
 
+#include <algorithm>
 #include <chrono>
 #include <cstdlib>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <type_traits>
+#include <vector>
 
 #define ROCPROFILER_LIB_ROCPROFILER_HSA_ASYNC_COPY_CPP_IMPL 1
 
@@ -168,6 +175,9 @@ struct async_copy_data
                                         timestamp_t      _beg = 0,
                                         timestamp_t      _end = 0) const;
 
+    // prepares a pooled record for another copy. The replacement signal is kept
+    void reset();
+
     auto get_lock() { return std::make_unique<std::unique_lock<std::mutex>>(m_mtx); }
 
 private:
@@ -214,6 +224,22 @@ async_copy_data::get_buffered_record(const context_t* _ctx,
                                           src_address);
 }
 
+void
+async_copy_data::reset()
+{
+    orig_signal    = {};
+    tid            = common::get_tid();
+    dst_agent      = null_rocp_agent_id;
+    src_agent      = null_rocp_agent_id;
+    dst_address    = {.value = 0};
+    src_address    = {.value = 0};
+    direction      = ROCPROFILER_MEMORY_COPY_NONE;
+    bytes_copied   = 0;
+    start_ts       = 0;
+    correlation_id = nullptr;
+    tracing_data   = {};
+}
+
 struct active_signals
 {
     active_signals();
@@ -338,31 +364,24 @@ convert_hsa_handle(Up _hsa_object)
     return reinterpret_cast<Tp*>(_hsa_object.handle);
 }
 
-bool
-async_copy_handler(hsa_signal_value_t signal_value, void* arg)
+void
+async_copy_complete(hsa_signal_value_t signal_value, async_copy_data* _data)
 {
-    // if we have fully finalized, delete the data and return
-    if(registration::get_fini_status() > 0)
-    {
-        auto* _data = static_cast<async_copy_data*>(arg);
-        delete _data;
-        return false;
-    }
+    // if we have fully finalized, only recycle the data
+    if(registration::get_fini_status() > 0) return;
 
-    auto  ts               = common::timestamp_ns();
-    auto* _data            = static_cast<async_copy_data*>(arg);
-    auto  _lk              = _data->get_lock();
-    auto  copy_time        = hsa_amd_profiling_async_copy_time_t{};
-    auto  copy_time_status = get_amd_ext_table()->hsa_amd_profiling_get_async_copy_time_fn(
+    auto ts               = common::timestamp_ns();
+    auto _lk              = _data->get_lock();
+    auto copy_time        = hsa_amd_profiling_async_copy_time_t{};
+    auto copy_time_status = get_amd_ext_table()->hsa_amd_profiling_get_async_copy_time_fn(
         _data->rocp_signal, &copy_time);
 
     auto _profile_time = tracing::profiling_time{copy_time_status, copy_time.start, copy_time.end};
 
     // we need to decrement this reference count at the end of the functions
     auto* _corr_id = _data->correlation_id;
-    auto  _dtor    = common::scope_destructor{[&_lk, &_data, &_corr_id]() {
+    auto  _dtor    = common::scope_destructor{[&_lk, &_corr_id]() {
         _lk.reset();  // reset the unique_ptr so the lock is released
-        delete _data;
 
         if(_corr_id) _corr_id->sub_ref_count();
     }};
@@ -441,10 +460,207 @@ async_copy_handler(hsa_signal_value_t signal_value, void* arg)
         ROCP_INFO << "Decrementing Signal: " << std::hex << _data->orig_signal.handle << std::dec;
         get_core_table()->hsa_signal_store_screlease_fn(_data->orig_signal, signal_value);
     }
+}
+
+/**
+ * Pool of the copy records and replacement completion signals of traced memory copies. Records
+ * and their signals are reused instead of creating a signal and registering an HSA async handler
+ * for every copy: a single completion thread waits on the signals of all in-flight copies with
+ * hsa_amd_signal_wait_any and handles every copy that completed. Submitting a copy rings a
+ * doorbell signal so that the thread adds it to the set it waits on.
+ */
+struct copy_completion_service
+{
+    copy_completion_service() = default;
+    ~copy_completion_service() { stop(); }
+
+    copy_completion_service(const copy_completion_service&)     = delete;
+    copy_completion_service(copy_completion_service&&) noexcept = delete;
+    copy_completion_service& operator=(const copy_completion_service&) = delete;
+    copy_completion_service& operator=(copy_completion_service&&) noexcept = delete;
+
+    async_copy_data* acquire();                      // nullptr if a record cannot be provided
+    void             submit(async_copy_data* _data);  // copy was enqueued with the record signal
+    void             release(async_copy_data* _data);
+    void             stop();
+
+private:
+    bool start();
+    void run();
+
+    std::mutex                                    m_mutex    = {};
+    bool                                          m_running  = false;
+    bool                                          m_stopped  = false;
+    hsa_signal_t                                  m_doorbell = {.handle = 0};
+    std::thread                                   m_thread   = {};
+    std::vector<std::unique_ptr<async_copy_data>> m_records  = {};
+    std::vector<async_copy_data*>                 m_free     = {};
+    std::vector<async_copy_data*>                 m_pending  = {};
+};
+
+async_copy_data*
+copy_completion_service::acquire()
+{
+    auto _lk = std::unique_lock<std::mutex>{m_mutex};
+
+    if(!m_running && !start()) return nullptr;
+
+    if(m_free.empty())
+    {
+        auto               _data         = std::make_unique<async_copy_data>();
+        const uint32_t     num_consumers = 0;
+        const hsa_agent_t* consumers     = nullptr;
+        auto               _status       = get_core_table()->hsa_signal_create_fn(
+            1, num_consumers, consumers, &_data->rocp_signal);
+
+        if(_status != HSA_STATUS_SUCCESS)
+        {
+            ROCP_ERROR << "hsa_signal_create returned non-zero error code " << _status;
+            return nullptr;
+        }
+
+        m_free.emplace_back(m_records.emplace_back(std::move(_data)).get());
+    }
+
+    auto* _data = m_free.back();
+    m_free.pop_back();
+    _lk.unlock();
+
+    _data->reset();
+    get_core_table()->hsa_signal_store_relaxed_fn(_data->rocp_signal, 1);
+
+    return _data;
+}
+
+void
+copy_completion_service::submit(async_copy_data* _data)
+{
+    {
+        auto _lk = std::unique_lock<std::mutex>{m_mutex};
+        m_pending.emplace_back(_data);
+    }
+
+    get_core_table()->hsa_signal_store_screlease_fn(m_doorbell, 0);
+}
+
+void
+copy_completion_service::release(async_copy_data* _data)
+{
+    auto _lk = std::unique_lock<std::mutex>{m_mutex};
+    m_free.emplace_back(_data);
+}
+
+bool
+copy_completion_service::start()
+{
+    if(m_stopped || registration::get_fini_status() != 0) return false;
+
+    ROCP_HSA_TABLE_CALL(ERROR, get_core_table()->hsa_signal_create_fn(1, 0, nullptr, &m_doorbell));
+    if(m_doorbell.handle == 0) return false;
+
+    m_running = true;
+
+    internal_threading::notify_pre_internal_thread_create(ROCPROFILER_LIBRARY);
+    m_thread = std::thread{&copy_completion_service::run, this};
+    internal_threading::notify_post_internal_thread_create(ROCPROFILER_LIBRARY);
+
+    return true;
+}
+
+void
+copy_completion_service::stop()
+{
+    {
+        auto _lk  = std::unique_lock<std::mutex>{m_mutex};
+        m_stopped = true;
+        if(!m_running) return;
+        m_running = false;
+    }
 
-    ROCP_HSA_TABLE_CALL(ERROR, get_core_table()->hsa_signal_destroy_fn(_data->rocp_signal));
+    get_core_table()->hsa_signal_store_screlease_fn(m_doorbell, 0);
+    if(m_thread.joinable()) m_thread.join();
 
-    return false;
+    // copies which never completed are left in m_pending with their signals intact
+    if(hsa::get_hsa_ref_count() > 0 && get_core_table()->hsa_signal_destroy_fn)
+    {
+        for(auto* itr : m_free)
+            ROCP_HSA_TABLE_CALL(ERROR, get_core_table()->hsa_signal_destroy_fn(itr->rocp_signal));
+        ROCP_HSA_TABLE_CALL(ERROR, get_core_table()->hsa_signal_destroy_fn(m_doorbell));
+    }
+    m_free.clear();
+}
+
+void
+copy_completion_service::run()
+{
+    // the arrays passed to hsa_amd_signal_wait_any are kept between wake-ups. The doorbell is
+    // the first entry, entry i + 1 holds the signal of _active[i]
+    auto _active  = std::vector<async_copy_data*>{};
+    auto _signals = std::vector<hsa_signal_t>{m_doorbell};
+    auto _conds   = std::vector<hsa_signal_condition_t>{HSA_SIGNAL_CONDITION_LT};
+    auto _values  = std::vector<hsa_signal_value_t>{1};
+
+    while(true)
+    {
+        // re-arm the doorbell before collecting the submitted copies so no wake-up is lost
+        get_core_table()->hsa_signal_store_relaxed_fn(m_doorbell, 1);
+        {
+            auto _lk = std::unique_lock<std::mutex>{m_mutex};
+            if(!m_running)
+            {
+                m_pending.insert(m_pending.end(), _active.begin(), _active.end());
+                return;
+            }
+
+            for(auto* itr : m_pending)
+            {
+                _active.emplace_back(itr);
+                _signals.emplace_back(itr->rocp_signal);
+                _conds.emplace_back(HSA_SIGNAL_CONDITION_LT);
+                _values.emplace_back(1);
+            }
+            m_pending.clear();
+        }
+
+        // handle every copy that completed since the last wake-up and swap the last entry
+        // into its place
+        for(size_t i = 0; i < _active.size();)
+        {
+            auto* _data  = _active[i];
+            auto  _value = get_core_table()->hsa_signal_load_scacquire_fn(_data->rocp_signal);
+            if(_value >= 1)
+            {
+                ++i;
+                continue;
+            }
+
+            async_copy_complete(_value, _data);
+            release(_data);
+
+            _active[i]      = _active.back();
+            _signals[i + 1] = _signals.back();
+            _active.pop_back();
+            _signals.pop_back();
+            _conds.pop_back();
+            _values.pop_back();
+        }
+
+        auto _satisfying_value = hsa_signal_value_t{0};
+        get_amd_ext_table()->hsa_amd_signal_wait_any_fn(static_cast<uint32_t>(_signals.size()),
+                                                        _signals.data(),
+                                                        _conds.data(),
+                                                        _values.data(),
+                                                        std::numeric_limits<uint64_t>::max(),
+                                                        HSA_WAIT_STATE_BLOCKED,
+                                                        &_satisfying_value);
+    }
+}
+
+copy_completion_service*
+get_copy_completion_service()
+{
+    static auto*& _v = common::static_object<copy_completion_service>::construct();
+    return _v;
 }
 
 enum async_copy_id
@@ -624,7 +840,17 @@ async_copy_impl(Args... args)
                           std::make_index_sequence<N>{});
         }
 
-        _data               = new async_copy_data{};
+        auto* _service = get_copy_completion_service();
+        _data          = (_service) ? _service->acquire() : nullptr;
+
+        // no replacement signal available (e.g. finalizing): execute without tracing
+        if(!_data)
+        {
+            return invoke(get_next_dispatch<TableIdx, OpIdx>(),
+                          std::move(_tied_args),
+                          std::make_index_sequence<N>{});
+        }
+
         _data->tracing_data = std::move(tracing_data);
     }
 
@@ -640,50 +866,11 @@ async_copy_impl(Args... args)
     _data->dst_address  = compute_address(std::get<dst_addr_idx>(_tied_args));
     _data->src_address  = compute_address(std::get<src_addr_idx>(_tied_args));
 
-    constexpr auto           completion_signal_idx  = arg_indices<OpIdx>::completion_signal_idx;
-    auto&                    _completion_signal     = std::get<completion_signal_idx>(_tied_args);
-    const hsa_signal_value_t _completion_signal_val = 1;
+    constexpr auto completion_signal_idx = arg_indices<OpIdx>::completion_signal_idx;
+    auto&          _completion_signal    = std::get<completion_signal_idx>(_tied_args);
 
     auto original_value = get_core_table()->hsa_signal_load_scacquire_fn(_completion_signal);
 
-    {
-        const uint32_t     num_consumers = 0;
-        const hsa_agent_t* consumers     = nullptr;
-        auto               _status       = get_core_table()->hsa_signal_create_fn(
-            _completion_signal_val, num_consumers, consumers, &_data->rocp_signal);
-
-        if(_status != HSA_STATUS_SUCCESS)
-        {
-            ROCP_ERROR << "hsa_signal_create returned non-zero error code " << _status;
-
-            delete _data;
-            return invoke(get_next_dispatch<TableIdx, OpIdx>(),
-                          std::move(_tied_args),
-                          std::make_index_sequence<N>{});
-        }
-    }
-
-    {
-        auto _status = get_amd_ext_table()->hsa_amd_signal_async_handler_fn(_data->rocp_signal,
-                                                                            HSA_SIGNAL_CONDITION_LT,
-                                                                            _completion_signal_val,
-                                                                            async_copy_handler,
-                                                                            _data);
-
-        if(_status != HSA_STATUS_SUCCESS)
-        {
-            ROCP_ERROR << "hsa_amd_signal_async_handler returned non-zero error code " << _status;
-
-            ROCP_HSA_TABLE_CALL(ERROR, get_core_table()->hsa_signal_destroy_fn(_data->rocp_signal))
-                << ":: failed to destroy signal after async handler failed";
-
-            delete _data;
-            return invoke(get_next_dispatch<TableIdx, OpIdx>(),
-                          std::move(_tied_args),
-                          std::make_index_sequence<N>{});
-        }
-    }
-
     _data->correlation_id                 = context::get_latest_correlation_id();
     context::correlation_id* _corr_id_pop = nullptr;
 
@@ -697,17 +884,6 @@ async_copy_impl(Args... args)
     // increase the reference count to denote that this correlation id is being used in a kernel
     _data->correlation_id->add_ref_count();
 
-    // if we constructed a correlation id, this decrements the reference count after the underlying
-    // function returns
-    auto _corr_id_dtor = common::scope_destructor{[_corr_id_pop, _data]() {
-        if(_corr_id_pop)
-        {
-            context::pop_latest_correlation_id(_corr_id_pop);
-            _corr_id_pop->sub_ref_count();
-        }
-        _data->start_ts = common::timestamp_ns();
-    }};
-
     auto thr_id = _data->correlation_id->thread_idx;
     tracing::populate_external_correlation_ids(tracing_data.external_correlation_ids,
                                                thr_id,
@@ -738,8 +914,44 @@ async_copy_impl(Args... args)
 
     CHECK_NOTNULL(get_active_signals())->fetch_add(1);
 
-    return invoke(
+    auto _status = invoke(
         get_next_dispatch<TableIdx, OpIdx>(), std::move(_tied_args), std::make_index_sequence<N>{});
+
+    // if we constructed a correlation id, decrement the reference count now that the underlying
+    // function returned
+    if(_corr_id_pop)
+    {
+        context::pop_latest_correlation_id(_corr_id_pop);
+        _corr_id_pop->sub_ref_count();
+    }
+    _data->start_ts = common::timestamp_ns();
+
+    if(_status == HSA_STATUS_SUCCESS)
+    {
+        get_copy_completion_service()->submit(_data);
+    }
+    else
+    {
+        // the copy was not enqueued so the replacement signal will never be decremented. The
+        // enter callbacks were already delivered so complete them with an empty copy
+        if(!tracing_data.callback_contexts.empty())
+        {
+            auto _tracer_data = _data->get_callback_data(_data->start_ts, _data->start_ts);
+
+            tracing::execute_phase_exit_callbacks(tracing_data.callback_contexts,
+                                                  tracing_data.external_correlation_ids,
+                                                  ROCPROFILER_CALLBACK_TRACING_MEMORY_COPY,
+                                                  _direction,
+                                                  _tracer_data);
+        }
+
+        get_active_signals()->fetch_sub(1);
+        _data->correlation_id->sub_ref_count();
+        _lk.reset();
+        get_copy_completion_service()->release(_data);
+    }
+
+    return _status;
 }
 
 template <size_t TableIdx, size_t OpIdx, typename RetT, typename... Args>
@@ -888,6 +1100,8 @@ async_copy_fini()
     if(!async_copy::get_active_signals()) return;
 
     async_copy_sync();
+    if(async_copy::get_copy_completion_service())
+        async_copy::get_copy_completion_service()->stop();
     async_copy::get_active_signals()->destroy();
 }
 }  // namespace hsa
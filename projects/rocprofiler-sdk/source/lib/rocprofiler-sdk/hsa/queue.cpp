@@ -168,6 +168,9 @@ AsyncSignalHandler(hsa_signal_value_t /*signal_v*/, void* data)
     auto* _corr_id = queue_info_session.correlation_id;
     if(_corr_id)
     {
+        ROCP_FATAL_IF(_corr_id->get_generation() != queue_info_session.correlation_gen)
+            << "correlation id " << _corr_id->internal
+            << " was retired before the kernel completed";
         ROCP_FATAL_IF(_corr_id->get_ref_count() == 0)
             << "reference counter for correlation id " << _corr_id->internal << " from thread "
             << _corr_id->thread_idx << " has no reference count";
@@ -489,6 +492,7 @@ WriteInterceptor(const void* packets,
                                                      .enqueue_ts       = common::timestamp_ns(),
                                                      .user_data        = user_data,
                                                      .correlation_id   = corr_id,
+                                                     .correlation_gen  = corr_id->get_generation(),
                                                      .kernel_pkt       = kernel_pkt,
                                                      .callback_record  = callback_record,
                                                      .tracing_data     = tracing_data_v,
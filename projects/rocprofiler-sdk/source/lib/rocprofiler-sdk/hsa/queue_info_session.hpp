@@ -61,6 +61,7 @@ struct queue_info_session
     rocprofiler_timestamp_t  enqueue_ts       = 0;
     rocprofiler_user_data_t  user_data        = {.value = 0};
     context::correlation_id* correlation_id   = nullptr;
+    uint32_t                 correlation_gen  = 0;
     rocprofiler_packet       kernel_pkt       = {};
     callback_record_t        callback_record  = {};
     tracing::tracing_data    tracing_data     = {};
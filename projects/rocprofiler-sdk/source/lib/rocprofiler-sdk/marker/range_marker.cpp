@@ -38,10 +38,13 @@
 
 #include <rocprofiler-sdk-roctx/roctx.h>
 
+#include <array>
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <mutex>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 
 namespace rocprofiler
@@ -107,12 +110,51 @@ get_range_thread_stack()
     return push_op_stack;
 }
 
+// process ranges are sharded by range id. roctx issues range ids sequentially so the ranges
+// which are concurrently active land in different shards and starting/stopping different
+// ranges rarely contends on the same lock
+struct range_process_registry
+{
+    static constexpr size_t num_shards = 64;
+
+    void emplace(roctx_range_id_t _id, range_data_t&& _data)
+    {
+        auto& _shard = get_shard(_id);
+        auto  _lk    = std::unique_lock<std::mutex>{_shard.mutex};
+        _shard.ranges.emplace(_id, std::move(_data));
+    }
+
+    // moves the data of the range out of the registry. Returns false if the range is unknown
+    bool extract(roctx_range_id_t _id, range_data_t& _dst)
+    {
+        auto& _shard = get_shard(_id);
+        auto  _lk    = std::unique_lock<std::mutex>{_shard.mutex};
+        auto  itr    = _shard.ranges.find(_id);
+        if(itr == _shard.ranges.end()) return false;
+
+        _dst = std::move(itr->second);
+        _shard.ranges.erase(itr);
+        return true;
+    }
+
+private:
+    // each shard occupies its own cache lines so that the locks do not falsely share
+    struct alignas(64) shard
+    {
+        std::mutex                                         mutex  = {};
+        std::unordered_map<roctx_range_id_t, range_data_t> ranges = {};
+    };
+
+    shard& get_shard(roctx_range_id_t _id) { return m_shards[_id % num_shards]; }
+
+    std::array<shard, num_shards> m_shards = {};
+};
+
 auto&
-get_range_process_stack()
+get_range_process_registry()
 {
-    static auto push_op_stack =
-        common::Synchronized<std::unordered_map<roctx_range_id_t, range_data_t>>{};
-    return push_op_stack;
+    static auto registry = range_process_registry{};
+    return registry;
 }
 }  // namespace
 
@@ -358,13 +400,8 @@ roctx_api_impl<TableIdx, OpIdx>::push_functor(Args... args)
     }
     else if constexpr(OpIdx == ROCPROFILER_MARKER_CORE_RANGE_API_ID_roctxProcessRangeA)
     {
-        // push the range data to the process stack
-        get_range_process_stack().wlock(
-            [](auto& _stack, auto _key, auto&& _range_data) {
-                _stack.emplace(_key, std::move(_range_data));
-            },
-            _ret,
-            std::move(range_data));
+        // register the range data for the range stop on any thread
+        get_range_process_registry().emplace(_ret, std::move(range_data));
     }
 
     if constexpr(!std::is_void<RetT>::value) return _ret;
@@ -395,18 +432,8 @@ roctx_api_impl<TableIdx, OpIdx>::pop_functor(Args... args)
         static_assert(sizeof...(Args) == 1,
                       "roctxRangeStopA requires a single argument of type roctx_range_id_t");
 
-        // push the range data to the process stack
-        get_range_process_stack().wlock(
-            [](auto& _range_stack, auto _key, auto& _dst) {
-                // find the data for the range id if it exists, copy it and delete it
-                if(auto itr = _range_stack.find(_key); itr != _range_stack.end())
-                {
-                    _dst = _range_stack.at(_key);
-                    _range_stack.erase(itr);
-                }
-            },
-            range_id,
-            range_data);
+        // move the data for the range id out of the process registry if it exists
+        get_range_process_registry().extract(range_id, range_data);
     }
 
     auto _ret = exec(info_type::get_pop_table_func(), std::forward<Args>(args)...);
@@ -0,0 +1,323 @@
+// MIT License
+//
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <rocprofiler-sdk/buffer.h>
+#include <rocprofiler-sdk/buffer_tracing.h>
+#include <rocprofiler-sdk/callback_tracing.h>
+#include <rocprofiler-sdk/fwd.h>
+#include <rocprofiler-sdk/registration.h>
+#include <rocprofiler-sdk/rocprofiler.h>
+
+#include <gtest/gtest.h>
+#include <hsa/hsa.h>
+#include <hsa/hsa_ext_amd.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#define ROCPROFILER_CALL(ARG, MSG)                                                                 \
+    {                                                                                              \
+        auto _status = (ARG);                                                                      \
+        EXPECT_EQ(_status, ROCPROFILER_STATUS_SUCCESS) << MSG << " :: " << #ARG;                   \
+    }
+
+namespace
+{
+struct copy_data
+{
+    struct phases
+    {
+        uint64_t enter = 0;
+        uint64_t exit  = 0;
+    };
+
+    std::mutex                             mutex     = {};
+    std::unordered_map<uint64_t, phases>   callbacks = {};
+    std::unordered_map<uint64_t, uint64_t> records   = {};
+    uint64_t                               dropped   = 0;
+    rocprofiler_context_id_t               context   = {0};
+    rocprofiler_buffer_id_t                buffer    = {};
+    rocprofiler_client_id_t*               client_id = nullptr;
+    rocprofiler_client_finalize_t          fini_func = nullptr;
+};
+
+void
+copy_traced(rocprofiler_callback_tracing_record_t record,
+            rocprofiler_user_data_t*,
+            void* client_data)
+{
+    auto* data = static_cast<copy_data*>(client_data);
+    auto  _lk  = std::unique_lock<std::mutex>{data->mutex};
+    auto& itr  = data->callbacks[record.correlation_id.internal];
+    if(record.phase == ROCPROFILER_CALLBACK_PHASE_ENTER)
+        ++itr.enter;
+    else if(record.phase == ROCPROFILER_CALLBACK_PHASE_EXIT)
+        ++itr.exit;
+}
+
+void
+copy_buffered(rocprofiler_context_id_t,
+              rocprofiler_buffer_id_t,
+              rocprofiler_record_header_t** headers,
+              size_t                        num_headers,
+              void*                         buffer_data,
+              uint64_t                      drop_count)
+{
+    auto* data = static_cast<copy_data*>(buffer_data);
+    auto  _lk  = std::unique_lock<std::mutex>{data->mutex};
+
+    data->dropped += drop_count;
+    for(size_t i = 0; i < num_headers; ++i)
+    {
+        ASSERT_EQ(headers[i]->kind, ROCPROFILER_BUFFER_TRACING_MEMORY_COPY);
+        const auto* record =
+            static_cast<rocprofiler_buffer_tracing_memory_copy_record_t*>(headers[i]->payload);
+        EXPECT_LE(record->start_timestamp, record->end_timestamp);
+        ++data->records[record->correlation_id.internal];
+    }
+}
+
+struct copy_agents
+{
+    hsa_agent_t           cpu      = {.handle = 0};
+    hsa_agent_t           gpu      = {.handle = 0};
+    hsa_amd_memory_pool_t cpu_pool = {.handle = 0};
+    hsa_amd_memory_pool_t gpu_pool = {.handle = 0};
+};
+
+hsa_status_t
+find_pool(hsa_amd_memory_pool_t pool, void* data)
+{
+    auto segment = hsa_amd_segment_t{};
+    auto allowed = false;
+    if(hsa_amd_memory_pool_get_info(pool, HSA_AMD_MEMORY_POOL_INFO_SEGMENT, &segment) !=
+           HSA_STATUS_SUCCESS ||
+       hsa_amd_memory_pool_get_info(
+           pool, HSA_AMD_MEMORY_POOL_INFO_RUNTIME_ALLOC_ALLOWED, &allowed) != HSA_STATUS_SUCCESS)
+        return HSA_STATUS_ERROR;
+
+    if(segment == HSA_AMD_SEGMENT_GLOBAL && allowed)
+    {
+        *static_cast<hsa_amd_memory_pool_t*>(data) = pool;
+        return HSA_STATUS_INFO_BREAK;
+    }
+    return HSA_STATUS_SUCCESS;
+}
+
+hsa_status_t
+find_agents(hsa_agent_t agent, void* data)
+{
+    auto* agents = static_cast<copy_agents*>(data);
+    auto  type   = hsa_device_type_t{};
+    if(hsa_agent_get_info(agent, HSA_AGENT_INFO_DEVICE, &type) != HSA_STATUS_SUCCESS)
+        return HSA_STATUS_ERROR;
+
+    if(type == HSA_DEVICE_TYPE_CPU && agents->cpu.handle == 0)
+    {
+        agents->cpu = agent;
+        hsa_amd_agent_iterate_memory_pools(agent, find_pool, &agents->cpu_pool);
+    }
+    else if(type == HSA_DEVICE_TYPE_GPU && agents->gpu.handle == 0)
+    {
+        agents->gpu = agent;
+        hsa_amd_agent_iterate_memory_pools(agent, find_pool, &agents->gpu_pool);
+    }
+    return HSA_STATUS_SUCCESS;
+}
+}  // namespace
+
+TEST(rocprofiler_lib, async_copy_tracing)
+{
+    using init_func_t = int (*)(rocprofiler_client_finalize_t, void*);
+    using fini_func_t = void (*)(void*);
+
+    static init_func_t tool_init = [](rocprofiler_client_finalize_t fini_func,
+                                      void*                         client_data) -> int {
+        auto* data      = static_cast<copy_data*>(client_data);
+        data->fini_func = fini_func;
+
+        ROCPROFILER_CALL(rocprofiler_create_context(&data->context), "failed to create context");
+
+        ROCPROFILER_CALL(rocprofiler_configure_callback_tracing_service(
+                             data->context,
+                             ROCPROFILER_CALLBACK_TRACING_MEMORY_COPY,
+                             nullptr,
+                             0,
+                             copy_traced,
+                             client_data),
+                         "callback tracing service failed to configure");
+
+        ROCPROFILER_CALL(rocprofiler_create_buffer(data->context,
+                                                   4096,
+                                                   2048,
+                                                   ROCPROFILER_BUFFER_POLICY_LOSSLESS,
+                                                   copy_buffered,
+                                                   client_data,
+                                                   &data->buffer),
+                         "buffer creation failed");
+
+        ROCPROFILER_CALL(
+            rocprofiler_configure_buffer_tracing_service(
+                data->context, ROCPROFILER_BUFFER_TRACING_MEMORY_COPY, nullptr, 0, data->buffer),
+            "buffer tracing service failed to configure");
+
+        ROCPROFILER_CALL(rocprofiler_start_context(data->context),
+                         "rocprofiler context start failed");
+        return 0;
+    };
+
+    static fini_func_t tool_fini = [](void* client_data) -> void {
+        auto* data = static_cast<copy_data*>(client_data);
+        ROCPROFILER_CALL(rocprofiler_flush_buffer(data->buffer), "buffer flush failed");
+    };
+
+    static auto data = copy_data{};
+
+    static auto cfg_result =
+        rocprofiler_tool_configure_result_t{sizeof(rocprofiler_tool_configure_result_t),
+                                            tool_init,
+                                            tool_fini,
+                                            static_cast<void*>(&data)};
+
+    static rocprofiler_configure_func_t rocp_init =
+        [](uint32_t,
+           const char*,
+           uint32_t,
+           rocprofiler_client_id_t* client_id) -> rocprofiler_tool_configure_result_t* {
+        data.client_id       = client_id;
+        data.client_id->name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        return &cfg_result;
+    };
+
+    EXPECT_EQ(rocprofiler_force_configure(rocp_init), ROCPROFILER_STATUS_SUCCESS);
+
+    ASSERT_EQ(hsa_init(), HSA_STATUS_SUCCESS);
+
+    auto agents = copy_agents{};
+    ASSERT_EQ(hsa_iterate_agents(find_agents, &agents), HSA_STATUS_SUCCESS);
+    if(agents.gpu.handle == 0 || agents.gpu_pool.handle == 0 || agents.cpu_pool.handle == 0)
+    {
+        hsa_shut_down();
+        GTEST_SKIP() << "no GPU agent (the HSA model backend provides one)";
+    }
+
+    // every thread keeps several copies in flight at once so that the completion service
+    // waits on many signals and recycles them between rounds
+    constexpr size_t num_threads  = 4;
+    constexpr size_t num_inflight = 16;
+    constexpr size_t num_rounds   = 64;
+    constexpr size_t copy_size    = 4096;
+
+    auto run = [&agents]() {
+        void* host = nullptr;
+        void* dev  = nullptr;
+        ASSERT_EQ(hsa_amd_memory_pool_allocate(agents.cpu_pool, copy_size, 0, &host),
+                  HSA_STATUS_SUCCESS);
+        ASSERT_EQ(hsa_amd_memory_pool_allocate(
+                      agents.gpu_pool, num_inflight * copy_size, 0, &dev),
+                  HSA_STATUS_SUCCESS);
+        ASSERT_EQ(hsa_amd_agents_allow_access(1, &agents.gpu, nullptr, host),
+                  HSA_STATUS_SUCCESS);
+
+        auto signals = std::vector<hsa_signal_t>(num_inflight);
+        for(auto& itr : signals)
+            ASSERT_EQ(hsa_signal_create(1, 0, nullptr, &itr), HSA_STATUS_SUCCESS);
+
+        for(size_t r = 0; r < num_rounds; ++r)
+        {
+            for(size_t i = 0; i < num_inflight; ++i)
+            {
+                hsa_signal_store_relaxed(signals.at(i), 1);
+                auto* dst = static_cast<char*>(dev) + (i * copy_size);
+                EXPECT_EQ(hsa_amd_memory_async_copy(
+                              dst, agents.gpu, host, agents.cpu, copy_size, 0, nullptr,
+                              signals.at(i)),
+                          HSA_STATUS_SUCCESS);
+            }
+
+            for(auto itr : signals)
+                hsa_signal_wait_scacquire(itr,
+                                          HSA_SIGNAL_CONDITION_LT,
+                                          1,
+                                          std::numeric_limits<uint64_t>::max(),
+                                          HSA_WAIT_STATE_BLOCKED);
+        }
+
+        for(auto itr : signals)
+            hsa_signal_destroy(itr);
+        hsa_amd_memory_pool_free(dev);
+        hsa_amd_memory_pool_free(host);
+    };
+
+    auto threads = std::vector<std::thread>{};
+    for(size_t i = 0; i < num_threads; ++i)
+        threads.emplace_back(run);
+    for(auto& itr : threads)
+        itr.join();
+
+    // a copy which is not enqueued still completes its enter callback with an exit callback
+    {
+        void* host = nullptr;
+        ASSERT_EQ(hsa_amd_memory_pool_allocate(agents.cpu_pool, copy_size, 0, &host),
+                  HSA_STATUS_SUCCESS);
+        auto signal = hsa_signal_t{};
+        ASSERT_EQ(hsa_signal_create(1, 0, nullptr, &signal), HSA_STATUS_SUCCESS);
+        EXPECT_NE(hsa_amd_memory_async_copy(
+                      nullptr, agents.gpu, host, agents.cpu, copy_size, 0, nullptr, signal),
+                  HSA_STATUS_SUCCESS);
+        EXPECT_EQ(hsa_signal_load_relaxed(signal), 1);
+        hsa_signal_destroy(signal);
+        hsa_amd_memory_pool_free(host);
+    }
+
+    ASSERT_NE(data.client_id, nullptr);
+    ASSERT_NE(data.fini_func, nullptr);
+
+    data.fini_func(*data.client_id);
+
+    constexpr size_t expected_count = num_threads * num_rounds * num_inflight;
+
+    auto _lk = std::unique_lock<std::mutex>{data.mutex};
+    EXPECT_EQ(data.dropped, 0);
+    EXPECT_EQ(data.callbacks.size(), expected_count + 1);
+    for(const auto& [corr_id, phases] : data.callbacks)
+    {
+        EXPECT_EQ(phases.enter, 1) << "correlation id " << corr_id;
+        EXPECT_EQ(phases.exit, 1) << "correlation id " << corr_id;
+    }
+
+    // only the copies which were enqueued have a buffer record
+    EXPECT_EQ(data.records.size(), expected_count);
+    for(const auto& [corr_id, count] : data.records)
+    {
+        EXPECT_EQ(count, 1) << "correlation id " << corr_id;
+        EXPECT_EQ(data.callbacks.count(corr_id), 1) << "correlation id " << corr_id;
+    }
+
+    _lk.unlock();
+    hsa_shut_down();
+}
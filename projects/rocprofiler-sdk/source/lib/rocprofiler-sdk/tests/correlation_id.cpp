@@ -0,0 +1,104 @@
+// MIT License
+//
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "lib/rocprofiler-sdk/context/correlation_id.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+namespace context = ::rocprofiler::context;
+
+context::correlation_id*
+construct_correlation_id()
+{
+    auto* _corr_id = context::correlation_tracing_service::construct(1);
+    context::pop_latest_correlation_id(_corr_id);
+    return _corr_id;
+}
+}  // namespace
+
+TEST(rocprofiler_lib, correlation_id_recycling)
+{
+    // every thread keeps more correlation ids alive than fit in one slab. Half of them are
+    // retired by the thread which constructed them, the other half by the main thread after
+    // the constructing thread exited. Threads are replaced every round so the pools of exited
+    // threads are adopted by new threads
+    constexpr size_t num_rounds  = 16;
+    constexpr size_t num_threads = 4;
+    constexpr size_t num_live    = 1000;
+
+    auto   mutex       = std::mutex{};
+    auto   internal    = std::unordered_set<uint64_t>{};
+    size_t num_slabs   = 0;
+    size_t num_retired = 0;
+    for(size_t r = 0; r < num_rounds; ++r)
+    {
+        auto handed_off = std::vector<context::correlation_id*>{};
+        auto threads    = std::vector<std::thread>{};
+        for(size_t t = 0; t < num_threads; ++t)
+        {
+            threads.emplace_back([&]() {
+                auto _live = std::vector<context::correlation_id*>{};
+                for(size_t i = 0; i < num_live; ++i)
+                    _live.emplace_back(construct_correlation_id());
+
+                auto _lk = std::unique_lock<std::mutex>{mutex};
+                for(size_t i = 0; i < _live.size(); ++i)
+                {
+                    ASSERT_NE(_live.at(i), nullptr);
+                    EXPECT_TRUE(internal.emplace(_live.at(i)->internal).second)
+                        << "correlation id " << _live.at(i)->internal << " constructed twice";
+                    if(i % 2 == 0)
+                        handed_off.emplace_back(_live.at(i));
+                    else
+                        EXPECT_EQ(_live.at(i)->sub_ref_count(), 1);
+                }
+            });
+        }
+        for(auto& itr : threads)
+            itr.join();
+
+        for(auto* itr : handed_off)
+        {
+            auto _generation = itr->get_generation();
+            EXPECT_EQ(itr->sub_ref_count(), 1);
+            EXPECT_EQ(itr->get_generation(), _generation + 1);
+        }
+        num_retired += num_threads * num_live;
+
+        // the first round allocates the slabs, later rounds only reuse them
+        if(r == 0)
+            num_slabs = context::get_correlation_id_slab_count();
+        else
+            EXPECT_EQ(context::get_correlation_id_slab_count(), num_slabs) << "round " << r;
+    }
+
+    EXPECT_GT(num_slabs, 0);
+    EXPECT_EQ(internal.size(), num_retired);
+}
@@ -20,6 +20,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <rocprofiler-sdk-roctx/roctx.h>
+#include <rocprofiler-sdk/callback_tracing.h>
 #include <rocprofiler-sdk/external_correlation.h>
 #include <rocprofiler-sdk/fwd.h>
 #include <rocprofiler-sdk/registration.h>
@@ -35,6 +37,8 @@
 
 #include <dlfcn.h>
 #include <pthread.h>
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <cstdlib>
 #include <iostream>
@@ -43,6 +47,7 @@
 #include <random>
 #include <sstream>
 #include <string_view>
+#include <thread>
 #include <typeinfo>
 #include <unordered_map>
 #include <unordered_set>
@@ -517,3 +522,137 @@ TEST(rocprofiler_lib, buffered_external_correlation)
     EXPECT_EQ(cb_data.current_depth, 0);
     EXPECT_EQ(cb_data.max_depth, 0);
 }
+
+namespace
+{
+struct marker_data
+{
+    std::atomic<uint64_t>         traced     = {0};
+    std::atomic<uint64_t>         mismatched = {0};
+    rocprofiler_context_id_t      context    = {0};
+    rocprofiler_client_id_t*      client_id  = nullptr;
+    rocprofiler_client_finalize_t fini_func  = nullptr;
+};
+
+// external correlation id on top of the stack of the calling thread
+thread_local uint64_t expected_external = 0;
+
+void
+marker_traced(rocprofiler_callback_tracing_record_t record,
+              rocprofiler_user_data_t*,
+              void* client_data)
+{
+    auto* data = static_cast<marker_data*>(client_data);
+    ++data->traced;
+    if(record.correlation_id.external.value != expected_external) ++data->mismatched;
+}
+}  // namespace
+
+TEST(rocprofiler_lib, marker_external_correlation)
+{
+    using init_func_t = int (*)(rocprofiler_client_finalize_t, void*);
+
+    static init_func_t tool_init = [](rocprofiler_client_finalize_t fini_func,
+                                      void*                         client_data) -> int {
+        auto* data      = static_cast<marker_data*>(client_data);
+        data->fini_func = fini_func;
+
+        ROCPROFILER_CALL(rocprofiler_create_context(&data->context), "failed to create context");
+
+        ROCPROFILER_CALL(rocprofiler_configure_callback_tracing_service(
+                             data->context,
+                             ROCPROFILER_CALLBACK_TRACING_MARKER_CORE_API,
+                             nullptr,
+                             0,
+                             marker_traced,
+                             client_data),
+                         "callback tracing service failed to configure");
+
+        ROCPROFILER_CALL(rocprofiler_start_context(data->context),
+                         "rocprofiler context start failed");
+        return 0;
+    };
+
+    static auto data = marker_data{};
+
+    static auto cfg_result = rocprofiler_tool_configure_result_t{
+        sizeof(rocprofiler_tool_configure_result_t), tool_init, nullptr, &data};
+
+    static rocprofiler_configure_func_t rocp_init =
+        [](uint32_t,
+           const char*,
+           uint32_t,
+           rocprofiler_client_id_t* client_id) -> rocprofiler_tool_configure_result_t* {
+        data.client_id       = client_id;
+        data.client_id->name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        return &cfg_result;
+    };
+
+    EXPECT_EQ(rocprofiler_force_configure(rocp_init), ROCPROFILER_STATUS_SUCCESS);
+
+    // CPU-only workload: every marker reads the external correlation id of its thread while
+    // the threads push and pop their own ids
+    constexpr uint64_t num_threads = 8;
+    constexpr uint64_t num_marks   = 20000;
+    constexpr uint64_t block_size  = 100;
+
+    auto run = [](uint64_t idx) {
+        uint64_t tid = 0;
+        ROCPROFILER_CALL(rocprofiler_get_thread_id(&tid), "failed to get thread id");
+
+        auto base = rocprofiler_user_data_t{.value = (idx + 1) << 32};
+        ROCPROFILER_CALL(rocprofiler_push_external_correlation_id(data.context, tid, base),
+                         "failed to push correlation id");
+        expected_external = base.value;
+
+        for(uint64_t i = 0; i < num_marks; ++i)
+        {
+            if(i % block_size == 0)
+            {
+                auto block = rocprofiler_user_data_t{.value = base.value + i + 1};
+                ROCPROFILER_CALL(rocprofiler_push_external_correlation_id(data.context, tid, block),
+                                 "failed to push correlation id");
+                expected_external = block.value;
+            }
+
+            roctxMark("external_correlation");
+
+            if(i % block_size == block_size - 1)
+            {
+                auto popped = rocprofiler_user_data_t{};
+                ROCPROFILER_CALL(
+                    rocprofiler_pop_external_correlation_id(data.context, tid, &popped),
+                    "failed to pop correlation id");
+                EXPECT_EQ(popped.value, expected_external);
+                expected_external = base.value;
+            }
+        }
+
+        auto popped = rocprofiler_user_data_t{};
+        ROCPROFILER_CALL(rocprofiler_pop_external_correlation_id(data.context, tid, &popped),
+                         "failed to pop correlation id");
+        EXPECT_EQ(popped.value, base.value);
+    };
+
+    auto beg     = std::chrono::steady_clock::now();
+    auto threads = std::vector<std::thread>{};
+    for(uint64_t i = 0; i < num_threads; ++i)
+        threads.emplace_back(run, i);
+    for(auto& itr : threads)
+        itr.join();
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - beg);
+
+    std::cout << "traced " << (num_threads * num_marks) << " markers on " << num_threads
+              << " threads: " << (elapsed.count() / (num_threads * num_marks))
+              << " nsec per marker\n"
+              << std::flush;
+
+    ASSERT_NE(data.client_id, nullptr);
+    ASSERT_NE(data.fini_func, nullptr);
+
+    data.fini_func(*data.client_id);
+
+    // one enter and one exit callback per marker
+    EXPECT_EQ(data.traced.load(), 2 * num_threads * num_marks);
+    EXPECT_EQ(data.mismatched.load(), 0);
+}
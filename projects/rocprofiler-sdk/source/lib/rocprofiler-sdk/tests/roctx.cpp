@@ -48,12 +48,15 @@
 #include <cstdint>
 #include <cstdlib>
 #include <iostream>
+#include <mutex>
 #include <random>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <typeinfo>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace
@@ -547,3 +550,466 @@ TEST(rocprofiler_lib, roctx_buffered_tracing)
     EXPECT_EQ(cb_data.current_depth, 0);
     EXPECT_EQ(cb_data.max_depth, 0);
 }
+
+namespace
+{
+struct correlation_id_data
+{
+    std::mutex                    mutex     = {};
+    std::vector<uint64_t>         traced    = {};
+    std::unordered_set<uint64_t>  retired   = {};
+    uint64_t                      dropped   = 0;
+    rocprofiler_context_id_t      context   = {0};
+    rocprofiler_buffer_id_t       buffer    = {};
+    rocprofiler_client_id_t*      client_id = nullptr;
+    rocprofiler_client_finalize_t fini_func = nullptr;
+};
+
+void
+correlation_id_traced(rocprofiler_callback_tracing_record_t record,
+                      rocprofiler_user_data_t*,
+                      void* client_data)
+{
+    if(record.phase != ROCPROFILER_CALLBACK_PHASE_ENTER) return;
+
+    auto* data = static_cast<correlation_id_data*>(client_data);
+    auto  _lk  = std::unique_lock<std::mutex>{data->mutex};
+    data->traced.emplace_back(record.correlation_id.internal);
+}
+
+void
+correlation_id_retired(rocprofiler_context_id_t,
+                       rocprofiler_buffer_id_t,
+                       rocprofiler_record_header_t** headers,
+                       size_t                        num_headers,
+                       void*                         buffer_data,
+                       uint64_t                      drop_count)
+{
+    auto* data = static_cast<correlation_id_data*>(buffer_data);
+    auto  _lk  = std::unique_lock<std::mutex>{data->mutex};
+
+    data->dropped += drop_count;
+    for(size_t i = 0; i < num_headers; ++i)
+    {
+        ASSERT_EQ(headers[i]->kind, ROCPROFILER_BUFFER_TRACING_CORRELATION_ID_RETIREMENT);
+        const auto* record =
+            static_cast<rocprofiler_buffer_tracing_correlation_id_retirement_record_t*>(
+                headers[i]->payload);
+        EXPECT_TRUE(data->retired.emplace(record->internal_correlation_id).second)
+            << "correlation id " << record->internal_correlation_id << " retired twice";
+    }
+}
+}  // namespace
+
+TEST(rocprofiler_lib, roctx_correlation_id_recycling)
+{
+    using init_func_t = int (*)(rocprofiler_client_finalize_t, void*);
+    using fini_func_t = void (*)(void*);
+
+    static init_func_t tool_init = [](rocprofiler_client_finalize_t fini_func,
+                                      void*                         client_data) -> int {
+        auto* data      = static_cast<correlation_id_data*>(client_data);
+        data->fini_func = fini_func;
+
+        ROCPROFILER_CALL(rocprofiler_create_context(&data->context), "failed to create context");
+
+        ROCPROFILER_CALL(rocprofiler_configure_callback_tracing_service(
+                             data->context,
+                             ROCPROFILER_CALLBACK_TRACING_MARKER_CORE_API,
+                             nullptr,
+                             0,
+                             correlation_id_traced,
+                             client_data),
+                         "callback tracing service failed to configure");
+
+        ROCPROFILER_CALL(rocprofiler_create_buffer(data->context,
+                                                   4096,
+                                                   2048,
+                                                   ROCPROFILER_BUFFER_POLICY_LOSSLESS,
+                                                   correlation_id_retired,
+                                                   client_data,
+                                                   &data->buffer),
+                         "buffer creation failed");
+
+        ROCPROFILER_CALL(rocprofiler_configure_buffer_tracing_service(
+                             data->context,
+                             ROCPROFILER_BUFFER_TRACING_CORRELATION_ID_RETIREMENT,
+                             nullptr,
+                             0,
+                             data->buffer),
+                         "buffer tracing service failed to configure");
+
+        ROCPROFILER_CALL(rocprofiler_start_context(data->context),
+                         "rocprofiler context start failed");
+        return 0;
+    };
+
+    static fini_func_t tool_fini = [](void* client_data) -> void {
+        auto* data = static_cast<correlation_id_data*>(client_data);
+        ROCPROFILER_CALL(rocprofiler_flush_buffer(data->buffer), "buffer flush failed");
+    };
+
+    static auto data = correlation_id_data{};
+
+    static auto cfg_result =
+        rocprofiler_tool_configure_result_t{sizeof(rocprofiler_tool_configure_result_t),
+                                            tool_init,
+                                            tool_fini,
+                                            static_cast<void*>(&data)};
+
+    static rocprofiler_configure_func_t rocp_init =
+        [](uint32_t,
+           const char*,
+           uint32_t,
+           rocprofiler_client_id_t* client_id) -> rocprofiler_tool_configure_result_t* {
+        data.client_id       = client_id;
+        data.client_id->name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        return &cfg_result;
+    };
+
+    EXPECT_EQ(rocprofiler_force_configure(rocp_init), ROCPROFILER_STATUS_SUCCESS);
+
+    // marker-only workload: every call constructs and retires a correlation id. Threads are
+    // joined and replaced so correlation ids are also recycled through the pools of exited
+    // threads
+    constexpr size_t num_rounds  = 4;
+    constexpr size_t num_threads = 4;
+    constexpr size_t num_marks   = 5000;
+    for(size_t r = 0; r < num_rounds; ++r)
+    {
+        auto threads = std::vector<std::thread>{};
+        for(size_t t = 0; t < num_threads; ++t)
+        {
+            threads.emplace_back([]() {
+                for(size_t i = 0; i < num_marks; ++i)
+                    roctxMark("correlation_id_recycling");
+            });
+        }
+        for(auto& itr : threads)
+            itr.join();
+    }
+
+    ASSERT_NE(data.client_id, nullptr);
+    ASSERT_NE(data.fini_func, nullptr);
+
+    data.fini_func(*data.client_id);
+
+    constexpr size_t expected_count = num_rounds * num_threads * num_marks;
+
+    auto _lk = std::unique_lock<std::mutex>{data.mutex};
+    EXPECT_EQ(data.dropped, 0);
+    ASSERT_EQ(data.traced.size(), expected_count);
+    EXPECT_EQ(data.retired.size(), expected_count);
+
+    // recycled correlation id objects must still produce unique correlation ids
+    auto unique_ids = std::unordered_set<uint64_t>{data.traced.begin(), data.traced.end()};
+    EXPECT_EQ(unique_ids.size(), expected_count);
+    for(auto itr : unique_ids)
+        EXPECT_EQ(data.retired.count(itr), 1) << "correlation id " << itr << " was not retired";
+}
+
+namespace
+{
+struct process_range_data
+{
+    struct range_info
+    {
+        const char*      enter_message = nullptr;
+        const char*      exit_message  = nullptr;
+        roctx_range_id_t range_id      = 0;
+        uint64_t         exit_count    = 0;
+        uint64_t         stop_count    = 0;
+    };
+
+    std::mutex                               mutex     = {};
+    std::unordered_map<uint64_t, range_info> ranges    = {};
+    rocprofiler_context_id_t                 context   = {0};
+    rocprofiler_client_id_t*                 client_id = nullptr;
+    rocprofiler_client_finalize_t            fini_func = nullptr;
+};
+
+// range the calling thread is stopping: set before roctxRangeStop so that the callbacks which
+// it triggers on this thread can check that they belong to that range
+struct stopping_range
+{
+    roctx_range_id_t range_id       = 0;
+    uint64_t         correlation_id = 0;
+    const char*      message        = nullptr;
+};
+
+thread_local uint64_t       started_correlation_id = 0;
+thread_local stopping_range stopping               = {};
+
+void
+process_range_traced(rocprofiler_callback_tracing_record_t record,
+                     rocprofiler_user_data_t*,
+                     void* client_data)
+{
+    if(record.operation != ROCPROFILER_MARKER_CORE_RANGE_API_ID_roctxProcessRangeA) return;
+
+    auto* data = static_cast<process_range_data*>(client_data);
+    const auto* payload =
+        static_cast<rocprofiler_callback_tracing_marker_api_data_t*>(record.payload);
+    auto  _lk   = std::unique_lock<std::mutex>{data->mutex};
+    auto& _info = data->ranges[record.correlation_id.internal];
+
+    if(record.phase == ROCPROFILER_CALLBACK_PHASE_ENTER)
+    {
+        _info.enter_message    = payload->args.roctxProcessRangeA.message;
+        started_correlation_id = record.correlation_id.internal;
+    }
+    else if(record.phase == ROCPROFILER_CALLBACK_PHASE_EXIT)
+    {
+        _info.exit_message = payload->args.roctxProcessRangeA.message;
+        _info.range_id     = payload->retval.roctx_range_id_t_retval;
+        ++_info.exit_count;
+
+        // the range ends while its stop runs, with the correlation id and data of its start
+        EXPECT_EQ(_info.range_id, stopping.range_id);
+        EXPECT_EQ(record.correlation_id.internal, stopping.correlation_id)
+            << "range " << stopping.range_id;
+        EXPECT_EQ(_info.exit_message, stopping.message) << "range " << stopping.range_id;
+    }
+}
+
+void
+range_stop_traced(rocprofiler_callback_tracing_record_t record,
+                  rocprofiler_user_data_t*,
+                  void* client_data)
+{
+    if(record.operation != ROCPROFILER_MARKER_CORE_API_ID_roctxRangeStop ||
+       record.phase != ROCPROFILER_CALLBACK_PHASE_ENTER)
+        return;
+
+    auto* data = static_cast<process_range_data*>(client_data);
+    const auto* payload =
+        static_cast<rocprofiler_callback_tracing_marker_api_data_t*>(record.payload);
+    auto _lk = std::unique_lock<std::mutex>{data->mutex};
+
+    EXPECT_EQ(payload->args.roctxRangeStop.id, stopping.range_id);
+    ++data->ranges[stopping.correlation_id].stop_count;
+}
+}  // namespace
+
+TEST(rocprofiler_lib, roctx_concurrent_process_ranges)
+{
+    using init_func_t = int (*)(rocprofiler_client_finalize_t, void*);
+    using fini_func_t = void (*)(void*);
+
+    static init_func_t tool_init = [](rocprofiler_client_finalize_t fini_func,
+                                      void*                         client_data) -> int {
+        auto* data      = static_cast<process_range_data*>(client_data);
+        data->fini_func = fini_func;
+
+        ROCPROFILER_CALL(rocprofiler_create_context(&data->context), "failed to create context");
+
+        ROCPROFILER_CALL(rocprofiler_configure_callback_tracing_service(
+                             data->context,
+                             ROCPROFILER_CALLBACK_TRACING_MARKER_CORE_RANGE_API,
+                             nullptr,
+                             0,
+                             process_range_traced,
+                             client_data),
+                         "callback tracing service failed to configure");
+
+        ROCPROFILER_CALL(rocprofiler_configure_callback_tracing_service(
+                             data->context,
+                             ROCPROFILER_CALLBACK_TRACING_MARKER_CORE_API,
+                             nullptr,
+                             0,
+                             range_stop_traced,
+                             client_data),
+                         "callback tracing service failed to configure");
+
+        ROCPROFILER_CALL(rocprofiler_start_context(data->context),
+                         "rocprofiler context start failed");
+        return 0;
+    };
+
+    static fini_func_t tool_fini = [](void*) -> void {};
+
+    static auto data = process_range_data{};
+
+    static auto cfg_result =
+        rocprofiler_tool_configure_result_t{sizeof(rocprofiler_tool_configure_result_t),
+                                            tool_init,
+                                            tool_fini,
+                                            static_cast<void*>(&data)};
+
+    static rocprofiler_configure_func_t rocp_init =
+        [](uint32_t,
+           const char*,
+           uint32_t,
+           rocprofiler_client_id_t* client_id) -> rocprofiler_tool_configure_result_t* {
+        data.client_id       = client_id;
+        data.client_id->name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        return &cfg_result;
+    };
+
+    EXPECT_EQ(rocprofiler_force_configure(rocp_init), ROCPROFILER_STATUS_SUCCESS);
+
+    // every thread keeps several process ranges open at once so that the ranges of all the
+    // threads are started and stopped concurrently. Each thread uses its own messages to detect
+    // range data being mixed up between ranges
+    constexpr size_t num_threads = 8;
+    constexpr size_t num_iters   = 500;
+    constexpr size_t num_open    = 8;
+
+    auto messages = std::vector<std::string>{};
+    for(size_t t = 0; t < num_threads; ++t)
+        for(size_t i = 0; i < num_open; ++i)
+            messages.emplace_back("process_range_" + std::to_string(t) + "_" + std::to_string(i));
+
+    auto threads = std::vector<std::thread>{};
+    for(size_t t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([t, &messages]() {
+            auto ranges = std::vector<stopping_range>{};
+            for(size_t n = 0; n < num_iters; ++n)
+            {
+                for(size_t i = 0; i < num_open; ++i)
+                {
+                    const auto* message = messages.at((t * num_open) + i).c_str();
+                    auto        id      = roctxRangeStart(message);
+                    ranges.emplace_back(stopping_range{id, started_correlation_id, message});
+                }
+
+                // stop in reverse order: the correlation ids are kept on the thread stack
+                while(!ranges.empty())
+                {
+                    stopping = ranges.back();
+                    roctxRangeStop(stopping.range_id);
+                    ranges.pop_back();
+                }
+            }
+        });
+    }
+    for(auto& itr : threads)
+        itr.join();
+
+    ASSERT_NE(data.client_id, nullptr);
+    ASSERT_NE(data.fini_func, nullptr);
+
+    data.fini_func(*data.client_id);
+
+    auto _lk = std::unique_lock<std::mutex>{data.mutex};
+    EXPECT_EQ(data.ranges.size(), num_threads * num_iters * num_open);
+
+    auto range_ids = std::unordered_set<roctx_range_id_t>{};
+    for(const auto& [corr_id, info] : data.ranges)
+    {
+        EXPECT_EQ(info.stop_count, 1) << "correlation id " << corr_id;
+        EXPECT_EQ(info.exit_count, 1) << "correlation id " << corr_id;
+        EXPECT_NE(info.enter_message, nullptr) << "correlation id " << corr_id;
+        EXPECT_EQ(info.enter_message, info.exit_message) << "correlation id " << corr_id;
+        EXPECT_TRUE(range_ids.emplace(info.range_id).second)
+            << "range id " << info.range_id << " was returned for more than one range";
+    }
+}
+
+TEST(rocprofiler_lib, roctx_cross_thread_process_ranges)
+{
+    using init_func_t = int (*)(rocprofiler_client_finalize_t, void*);
+    using fini_func_t = void (*)(void*);
+
+    static init_func_t tool_init = [](rocprofiler_client_finalize_t fini_func,
+                                      void*                         client_data) -> int {
+        auto* data      = static_cast<process_range_data*>(client_data);
+        data->fini_func = fini_func;
+
+        ROCPROFILER_CALL(rocprofiler_create_context(&data->context), "failed to create context");
+
+        ROCPROFILER_CALL(rocprofiler_configure_callback_tracing_service(
+                             data->context,
+                             ROCPROFILER_CALLBACK_TRACING_MARKER_CORE_RANGE_API,
+                             nullptr,
+                             0,
+                             process_range_traced,
+                             client_data),
+                         "callback tracing service failed to configure");
+
+        ROCPROFILER_CALL(rocprofiler_configure_callback_tracing_service(
+                             data->context,
+                             ROCPROFILER_CALLBACK_TRACING_MARKER_CORE_API,
+                             nullptr,
+                             0,
+                             range_stop_traced,
+                             client_data),
+                         "callback tracing service failed to configure");
+
+        ROCPROFILER_CALL(rocprofiler_start_context(data->context),
+                         "rocprofiler context start failed");
+        return 0;
+    };
+
+    static fini_func_t tool_fini = [](void*) -> void {};
+
+    static auto data = process_range_data{};
+
+    static auto cfg_result =
+        rocprofiler_tool_configure_result_t{sizeof(rocprofiler_tool_configure_result_t),
+                                            tool_init,
+                                            tool_fini,
+                                            static_cast<void*>(&data)};
+
+    static rocprofiler_configure_func_t rocp_init =
+        [](uint32_t,
+           const char*,
+           uint32_t,
+           rocprofiler_client_id_t* client_id) -> rocprofiler_tool_configure_result_t* {
+        data.client_id       = client_id;
+        data.client_id->name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        return &cfg_result;
+    };
+
+    EXPECT_EQ(rocprofiler_force_configure(rocp_init), ROCPROFILER_STATUS_SUCCESS);
+
+    // one thread starts the process ranges and another thread stops them, in the order they
+    // were started. The range exit runs on the stopping thread and must still carry the
+    // correlation id and message of the start on the other thread
+    constexpr size_t num_ranges = 16;
+
+    auto messages = std::vector<std::string>{};
+    for(size_t i = 0; i < num_ranges; ++i)
+        messages.emplace_back("cross_thread_process_range_" + std::to_string(i));
+
+    auto ranges = std::vector<stopping_range>{};
+    auto starter = std::thread{[&messages, &ranges]() {
+        for(const auto& itr : messages)
+        {
+            auto id = roctxRangeStart(itr.c_str());
+            ranges.emplace_back(stopping_range{id, started_correlation_id, itr.c_str()});
+        }
+    }};
+    starter.join();
+
+    ASSERT_EQ(ranges.size(), num_ranges);
+
+    auto stopper = std::thread{[&ranges]() {
+        for(const auto& itr : ranges)
+        {
+            stopping = itr;
+            roctxRangeStop(stopping.range_id);
+        }
+    }};
+    stopper.join();
+
+    ASSERT_NE(data.client_id, nullptr);
+    ASSERT_NE(data.fini_func, nullptr);
+
+    data.fini_func(*data.client_id);
+
+    auto _lk = std::unique_lock<std::mutex>{data.mutex};
+    EXPECT_EQ(data.ranges.size(), num_ranges);
+
+    for(const auto& itr : ranges)
+    {
+        auto info = data.ranges.find(itr.correlation_id);
+        ASSERT_TRUE(info != data.ranges.end()) << "range " << itr.range_id;
+        EXPECT_EQ(info->second.range_id, itr.range_id);
+        EXPECT_EQ(info->second.enter_message, itr.message) << "range " << itr.range_id;
+        EXPECT_EQ(info->second.exit_message, itr.message) << "range " << itr.range_id;
+        EXPECT_EQ(info->second.stop_count, 1) << "range " << itr.range_id;
+        EXPECT_EQ(info->second.exit_count, 1) << "range " << itr.range_id;
+    }
+}
@@ -0,0 +1,139 @@
+// MIT License
+//
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "lib/common/container/rcu_flat_map.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using kernel_object_map_t = ::rocprofiler::common::container::rcu_flat_map<uint64_t, uint64_t>;
+
+// kernel objects are 64-byte aligned addresses: the worst case for an identity hash
+constexpr uint64_t
+kernel_object(uint64_t _code_object, uint64_t _kernel)
+{
+    return 0x7f0000000000ULL + (_code_object << 20) + (_kernel * 64);
+}
+
+constexpr uint64_t
+kernel_id(uint64_t _code_object, uint64_t _kernel)
+{
+    return (_code_object * 1000) + _kernel + 1;
+}
+
+void
+load(kernel_object_map_t& _map, uint64_t _code_object, uint64_t _nkernels)
+{
+    _map.update([_code_object, _nkernels](kernel_object_map_t::map_type& _data) {
+        for(uint64_t i = 0; i < _nkernels; ++i)
+            _data[kernel_object(_code_object, i)] = kernel_id(_code_object, i);
+    });
+}
+
+void
+unload(kernel_object_map_t& _map, uint64_t _code_object, uint64_t _nkernels)
+{
+    _map.update([_code_object, _nkernels](kernel_object_map_t::map_type& _data) {
+        for(uint64_t i = 0; i < _nkernels; ++i)
+            _data.erase(kernel_object(_code_object, i));
+    });
+}
+}  // namespace
+
+TEST(rcu_flat_map, load_unload)
+{
+    constexpr uint64_t nkernels = 500;
+
+    auto _map = kernel_object_map_t{};
+    EXPECT_EQ(_map.size(), 0);
+    EXPECT_EQ(_map.find(kernel_object(0, 0)), 0);
+
+    load(_map, 0, nkernels);
+    load(_map, 1, nkernels);
+    EXPECT_EQ(_map.size(), 2 * nkernels);
+
+    unload(_map, 0, nkernels);
+    EXPECT_EQ(_map.size(), nkernels);
+
+    for(uint64_t i = 0; i < nkernels; ++i)
+    {
+        EXPECT_EQ(_map.find(kernel_object(0, i)), 0) << "kernel " << i;
+        EXPECT_EQ(_map.find(kernel_object(1, i)), kernel_id(1, i)) << "kernel " << i;
+    }
+
+    EXPECT_EQ(_map.find(kernel_object(2, 0), 42), 42);
+}
+
+TEST(rcu_flat_map, concurrent_dispatch)
+{
+    constexpr uint64_t nkernels     = 64;
+    constexpr uint64_t ncode_objs   = 100;
+    constexpr uint64_t nthreads     = 4;
+    constexpr uint64_t resident_obj = ncode_objs;
+
+    auto _map = kernel_object_map_t{};
+    load(_map, resident_obj, nkernels);
+
+    auto _done    = std::atomic<bool>{false};
+    auto _errors  = std::atomic<uint64_t>{0};
+    auto _threads = std::vector<std::thread>{};
+
+    // dispatching threads: the resident code object must always be found and a transient code
+    // object must either be found with the correct id or not found at all
+    for(uint64_t t = 0; t < nthreads; ++t)
+    {
+        _threads.emplace_back([&_map, &_done, &_errors]() {
+            uint64_t _co = 0;
+            while(!_done.load(std::memory_order_relaxed))
+            {
+                for(uint64_t i = 0; i < nkernels; ++i)
+                {
+                    if(_map.find(kernel_object(resident_obj, i)) != kernel_id(resident_obj, i))
+                        ++_errors;
+
+                    auto _id = _map.find(kernel_object(_co, i));
+                    if(_id != 0 && _id != kernel_id(_co, i)) ++_errors;
+                }
+                _co = (_co + 1) % ncode_objs;
+            }
+        });
+    }
+
+    for(uint64_t i = 0; i < ncode_objs; ++i)
+    {
+        load(_map, i, nkernels);
+        if(i % 2 == 1) unload(_map, i - 1, nkernels);
+    }
+
+    _done.store(true);
+    for(auto& itr : _threads)
+        itr.join();
+
+    EXPECT_EQ(_errors.load(), 0);
+    EXPECT_EQ(_map.size(), ((ncode_objs / 2) + 1) * nkernels);
+}
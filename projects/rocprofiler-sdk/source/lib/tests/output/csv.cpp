@@ -0,0 +1,145 @@
+// MIT License
+//
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "lib/output/csv.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+namespace
+{
+namespace csv = ::rocprofiler::tool::csv;
+
+enum unscoped_enum
+{
+    unscoped_negative = -7,
+    unscoped_zero     = 0,
+    unscoped_large    = 1 << 30,
+};
+
+enum byte_enum : uint8_t
+{
+    byte_enum_value = 65,
+};
+
+// writes the row with write_csv_entry and with a buffered_writer which flushes after every
+// few bytes and expects identical output
+template <typename... Args>
+void
+expect_same_row(Args&&... args)
+{
+    constexpr auto columns = sizeof...(Args);
+
+    auto _expected = std::ostringstream{};
+    csv::csv_encoder<columns>::write_row(_expected, args...);
+
+    auto _actual = std::ostringstream{};
+    {
+        auto _writer = csv::buffered_writer{_actual, 8};
+        csv::csv_encoder<columns>::write_row(_writer, args...);
+    }
+
+    EXPECT_EQ(_actual.str(), _expected.str());
+}
+}  // namespace
+
+TEST(csv, buffered_writer_integers)
+{
+    expect_same_row(int8_t{65},
+                    std::numeric_limits<int8_t>::min(),
+                    std::numeric_limits<uint8_t>::max(),
+                    std::numeric_limits<int16_t>::min(),
+                    std::numeric_limits<uint16_t>::max(),
+                    std::numeric_limits<int32_t>::min(),
+                    std::numeric_limits<int32_t>::max(),
+                    std::numeric_limits<uint32_t>::max(),
+                    std::numeric_limits<int64_t>::min(),
+                    std::numeric_limits<int64_t>::max(),
+                    std::numeric_limits<uint64_t>::max(),
+                    size_t{0});
+}
+
+TEST(csv, buffered_writer_floating_point)
+{
+    constexpr auto dlimits = std::numeric_limits<double>{};
+    constexpr auto flimits = std::numeric_limits<float>{};
+
+    expect_same_row(dlimits.quiet_NaN(),
+                    -dlimits.quiet_NaN(),
+                    dlimits.infinity(),
+                    -dlimits.infinity(),
+                    0.0,
+                    -0.0,
+                    dlimits.denorm_min(),
+                    dlimits.min(),
+                    dlimits.max(),
+                    dlimits.lowest(),
+                    dlimits.epsilon());
+    expect_same_row(1.0, 0.5, -3.25, 1e-12, 1e20, 123456.789, 0.99999999999, 1.0000005);
+    expect_same_row(flimits.quiet_NaN(),
+                    flimits.infinity(),
+                    -0.0f,
+                    flimits.max(),
+                    flimits.min(),
+                    2.5f,
+                    0.1f);
+}
+
+TEST(csv, buffered_writer_bools_and_enums)
+{
+    expect_same_row(true, false, unscoped_negative, unscoped_zero, unscoped_large, byte_enum_value);
+}
+
+TEST(csv, buffered_writer_strings)
+{
+    expect_same_row(std::string{"abc"},
+                    std::string{},
+                    std::string_view{"x,y"},
+                    std::string_view{},
+                    "literal",
+                    static_cast<const char*>("pointer"),
+                    std::string{"quote\"d"});
+}
+
+TEST(csv, buffered_writer_mixed_rows)
+{
+    // rows of the shape written by the tool, many times over the flush threshold
+    auto _expected = std::ostringstream{};
+    auto _actual   = std::ostringstream{};
+    {
+        auto _writer = csv::buffered_writer{_actual, 64};
+        for(uint64_t i = 0; i < 1000; ++i)
+        {
+            auto _name = "kernel_" + std::to_string(i);
+            auto _dur  = static_cast<double>(i) / 7.0;
+            csv::csv_encoder<6>::write_row(_expected, i, _name, _dur, i % 2 == 0, -int64_t(i), "x");
+            csv::csv_encoder<6>::write_row(_writer, i, _name, _dur, i % 2 == 0, -int64_t(i), "x");
+        }
+    }
+
+    EXPECT_EQ(_actual.str(), _expected.str());
+}
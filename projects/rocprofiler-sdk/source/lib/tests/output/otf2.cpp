@@ -0,0 +1,560 @@
+// MIT License
+//
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "lib/common/filesystem.hpp"
+#include "lib/output/generateOTF2.hpp"
+#include "lib/output/generator.hpp"
+#include "lib/output/metadata.hpp"
+#include "lib/output/output_config.hpp"
+
+#include <rocprofiler-sdk/buffer_tracing.h>
+#include <rocprofiler-sdk/fwd.h>
+#include <rocprofiler-sdk/hsa/api_id.h>
+#include <rocprofiler-sdk/marker/api_id.h>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+#include <otf2/otf2.h>
+
+#include <unistd.h>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace
+{
+namespace fs   = ::rocprofiler::common::filesystem;
+namespace tool = ::rocprofiler::tool;
+
+// serves records which are already in memory as a single chunk
+template <typename Tp>
+struct vector_generator : public tool::generator<Tp>
+{
+    explicit vector_generator(std::vector<Tp> _data = {})
+    : tool::generator<Tp>{(_data.empty()) ? size_t{0} : size_t{1}}
+    , m_data{std::move(_data)}
+    {}
+
+    ~vector_generator() override = default;
+
+    std::vector<Tp> get(size_t) const override { return m_data; }
+
+private:
+    std::vector<Tp> m_data = {};
+};
+
+struct event
+{
+    bool        enter     = false;
+    uint64_t    timestamp = 0;
+    std::string name      = {};
+};
+
+bool
+operator==(const event& lhs, const event& rhs)
+{
+    return std::tie(lhs.enter, lhs.timestamp, lhs.name) ==
+           std::tie(rhs.enter, rhs.timestamp, rhs.name);
+}
+
+std::ostream&
+operator<<(std::ostream& os, const event& _evt)
+{
+    return os << fmt::format(
+               "{} {} @ {}", (_evt.enter) ? "enter" : "leave", _evt.name, _evt.timestamp);
+}
+
+struct location
+{
+    std::string        name   = {};
+    OTF2_LocationType  type   = OTF2_LOCATION_TYPE_UNKNOWN;
+    uint64_t           group  = 0;
+    uint64_t           count  = 0;  // number of events in the definition
+    std::vector<event> events = {};
+};
+
+struct region
+{
+    OTF2_StringRef  name = 0;
+    OTF2_RegionRole role = OTF2_REGION_ROLE_UNKNOWN;
+};
+
+struct raw_event
+{
+    bool           enter     = false;
+    uint64_t       timestamp = 0;
+    OTF2_RegionRef region    = 0;
+    OTF2_StringRef category  = 0;
+};
+
+struct raw_location
+{
+    OTF2_StringRef         name   = 0;
+    OTF2_LocationType      type   = OTF2_LOCATION_TYPE_UNKNOWN;
+    OTF2_LocationGroupRef  group  = 0;
+    uint64_t               count  = 0;
+    std::vector<raw_event> events = {};
+};
+
+// everything read back from the archive, before the string references are resolved
+struct archive_data
+{
+    using group_t = std::pair<OTF2_StringRef, OTF2_LocationGroupType>;
+
+    std::map<OTF2_StringRef, std::string>    strings   = {};
+    std::map<OTF2_RegionRef, region>         regions   = {};
+    std::map<OTF2_LocationGroupRef, group_t> groups    = {};
+    std::map<OTF2_LocationRef, raw_location> locations = {};
+};
+
+OTF2_CallbackCode
+read_string(void* _data, OTF2_StringRef _self, const char* _string)
+{
+    static_cast<archive_data*>(_data)->strings.emplace(_self, _string);
+    return OTF2_CALLBACK_SUCCESS;
+}
+
+OTF2_CallbackCode
+read_region(void*           _data,
+            OTF2_RegionRef  _self,
+            OTF2_StringRef  _name,
+            OTF2_StringRef  /*canonical_name*/,
+            OTF2_StringRef  /*description*/,
+            OTF2_RegionRole _role,
+            OTF2_Paradigm   /*paradigm*/,
+            OTF2_RegionFlag /*flags*/,
+            OTF2_StringRef  /*source_file*/,
+            uint32_t        /*begin_line*/,
+            uint32_t        /*end_line*/)
+{
+    static_cast<archive_data*>(_data)->regions.emplace(_self, region{_name, _role});
+    return OTF2_CALLBACK_SUCCESS;
+}
+
+OTF2_CallbackCode
+read_location_group(void*                  _data,
+                    OTF2_LocationGroupRef  _self,
+                    OTF2_StringRef         _name,
+                    OTF2_LocationGroupType _type,
+                    OTF2_SystemTreeNodeRef /*parent*/,
+                    OTF2_LocationGroupRef  /*creating_group*/)
+{
+    static_cast<archive_data*>(_data)->groups.emplace(_self, std::make_pair(_name, _type));
+    return OTF2_CALLBACK_SUCCESS;
+}
+
+OTF2_CallbackCode
+read_location(void*                 _data,
+              OTF2_LocationRef      _self,
+              OTF2_StringRef        _name,
+              OTF2_LocationType     _type,
+              uint64_t              _count,
+              OTF2_LocationGroupRef _group)
+{
+    static_cast<archive_data*>(_data)->locations.emplace(
+        _self, raw_location{_name, _type, _group, _count, {}});
+    return OTF2_CALLBACK_SUCCESS;
+}
+
+OTF2_CallbackCode
+read_enter(OTF2_LocationRef    /*location*/,
+           OTF2_TimeStamp      _time,
+           void*               _data,
+           OTF2_AttributeList* _attributes,
+           OTF2_RegionRef      _region)
+{
+    auto _category = OTF2_StringRef{0};
+    if(OTF2_AttributeList_GetStringRef(_attributes, 0, &_category) != OTF2_SUCCESS) _category = 0;
+    static_cast<raw_location*>(_data)->events.emplace_back(
+        raw_event{true, _time, _region, _category});
+    return OTF2_CALLBACK_SUCCESS;
+}
+
+OTF2_CallbackCode
+read_leave(OTF2_LocationRef    /*location*/,
+           OTF2_TimeStamp      _time,
+           void*               _data,
+           OTF2_AttributeList* /*attributes*/,
+           OTF2_RegionRef      _region)
+{
+    static_cast<raw_location*>(_data)->events.emplace_back(raw_event{false, _time, _region, 0});
+    return OTF2_CALLBACK_SUCCESS;
+}
+
+// reads the global definitions, then the local definitions and the events of every location
+// with its own event reader so the per-location order is what the writer produced
+archive_data
+read_archive(const std::string& _anchor)
+{
+    auto  _data   = archive_data{};
+    auto* _reader = OTF2_Reader_Open(_anchor.c_str());
+    EXPECT_NE(_reader, nullptr) << _anchor;
+    if(!_reader) return _data;
+
+    EXPECT_EQ(OTF2_Reader_SetSerialCollectiveCallbacks(_reader), OTF2_SUCCESS);
+
+    {
+        auto* _def_reader = OTF2_Reader_GetGlobalDefReader(_reader);
+        auto* _callbacks  = OTF2_GlobalDefReaderCallbacks_New();
+        OTF2_GlobalDefReaderCallbacks_SetStringCallback(_callbacks, read_string);
+        OTF2_GlobalDefReaderCallbacks_SetRegionCallback(_callbacks, read_region);
+        OTF2_GlobalDefReaderCallbacks_SetLocationGroupCallback(_callbacks, read_location_group);
+        OTF2_GlobalDefReaderCallbacks_SetLocationCallback(_callbacks, read_location);
+        EXPECT_EQ(OTF2_Reader_RegisterGlobalDefCallbacks(_reader, _def_reader, _callbacks, &_data),
+                  OTF2_SUCCESS);
+        OTF2_GlobalDefReaderCallbacks_Delete(_callbacks);
+
+        uint64_t _ndefs = 0;
+        EXPECT_EQ(OTF2_Reader_ReadAllGlobalDefinitions(_reader, _def_reader, &_ndefs),
+                  OTF2_SUCCESS);
+        EXPECT_EQ(OTF2_Reader_CloseGlobalDefReader(_reader, _def_reader), OTF2_SUCCESS);
+    }
+
+    uint64_t _nlocations = 0;
+    EXPECT_EQ(OTF2_Reader_GetNumberOfLocations(_reader, &_nlocations), OTF2_SUCCESS);
+    EXPECT_EQ(_nlocations, _data.locations.size());
+
+    for(const auto& itr : _data.locations)
+        EXPECT_EQ(OTF2_Reader_SelectLocation(_reader, itr.first), OTF2_SUCCESS);
+
+    EXPECT_EQ(OTF2_Reader_OpenDefFiles(_reader), OTF2_SUCCESS);
+    EXPECT_EQ(OTF2_Reader_OpenEvtFiles(_reader), OTF2_SUCCESS);
+    for(const auto& itr : _data.locations)
+    {
+        auto* _def_reader = OTF2_Reader_GetDefReader(_reader, itr.first);
+        EXPECT_NE(_def_reader, nullptr) << "location " << itr.first;
+        if(_def_reader)
+        {
+            uint64_t _ndefs = 0;
+            EXPECT_EQ(OTF2_Reader_ReadAllLocalDefinitions(_reader, _def_reader, &_ndefs),
+                      OTF2_SUCCESS);
+            EXPECT_EQ(_ndefs, uint64_t{0}) << "location " << itr.first;
+            EXPECT_EQ(OTF2_Reader_CloseDefReader(_reader, _def_reader), OTF2_SUCCESS);
+        }
+    }
+    EXPECT_EQ(OTF2_Reader_CloseDefFiles(_reader), OTF2_SUCCESS);
+
+    auto* _callbacks = OTF2_EvtReaderCallbacks_New();
+    OTF2_EvtReaderCallbacks_SetEnterCallback(_callbacks, read_enter);
+    OTF2_EvtReaderCallbacks_SetLeaveCallback(_callbacks, read_leave);
+    for(auto& itr : _data.locations)
+    {
+        auto* _evt_reader = OTF2_Reader_GetEvtReader(_reader, itr.first);
+        EXPECT_NE(_evt_reader, nullptr) << "location " << itr.first;
+        if(!_evt_reader) continue;
+
+        EXPECT_EQ(OTF2_Reader_RegisterEvtCallbacks(_reader, _evt_reader, _callbacks, &itr.second),
+                  OTF2_SUCCESS);
+        uint64_t _nevents = 0;
+        EXPECT_EQ(OTF2_Reader_ReadAllLocalEvents(_reader, _evt_reader, &_nevents), OTF2_SUCCESS);
+        EXPECT_EQ(_nevents, itr.second.events.size()) << "location " << itr.first;
+        EXPECT_EQ(OTF2_Reader_CloseEvtReader(_reader, _evt_reader), OTF2_SUCCESS);
+    }
+    OTF2_EvtReaderCallbacks_Delete(_callbacks);
+
+    EXPECT_EQ(OTF2_Reader_CloseEvtFiles(_reader), OTF2_SUCCESS);
+    EXPECT_EQ(OTF2_Reader_Close(_reader), OTF2_SUCCESS);
+
+    return _data;
+}
+
+template <typename Tp>
+Tp
+make_record(rocprofiler_buffer_tracing_kind_t _kind,
+            int32_t                           _operation,
+            rocprofiler_thread_id_t           _tid,
+            uint64_t                          _start,
+            uint64_t                          _end)
+{
+    auto _record            = Tp{};
+    _record.size            = sizeof(Tp);
+    _record.kind            = _kind;
+    _record.operation       = static_cast<decltype(_record.operation)>(_operation);
+    _record.thread_id       = _tid;
+    _record.start_timestamp = _start;
+    _record.end_timestamp   = _end;
+    return _record;
+}
+}  // namespace
+
+TEST(otf2, round_trip)
+{
+    using hsa_api_record_t    = rocprofiler_buffer_tracing_hsa_api_record_t;
+    using marker_api_record_t = rocprofiler_buffer_tracing_marker_api_record_t;
+    using memory_copy_base_t  = rocprofiler_buffer_tracing_memory_copy_record_t;
+    using memory_alloc_base_t = rocprofiler_buffer_tracing_memory_allocation_record_t;
+    using dispatch_base_t     = rocprofiler_buffer_tracing_kernel_dispatch_record_t;
+
+    constexpr auto null_stream   = rocprofiler_stream_id_t{.handle = 0};
+    constexpr auto cpu_agent     = rocprofiler_agent_id_t{.handle = 0x100};
+    constexpr auto gpu_agent     = rocprofiler_agent_id_t{.handle = 0x200};
+    constexpr auto marker_corrid = uint64_t{5};
+
+    auto _output_dir = fs::temp_directory_path() / fmt::format("rocprofiler-otf2-{}", getpid());
+
+    auto cfg        = tool::output_config{};
+    cfg.output_path = _output_dir.string();
+    cfg.output_file = "trace";
+
+    auto tool_metadata             = tool::metadata{};
+    tool_metadata.process_start_ns = 1000;
+    tool_metadata.process_end_ns   = 10000;
+
+    {
+        auto _cpu                 = rocprofiler_agent_v0_t{};
+        _cpu.size                 = sizeof(rocprofiler_agent_v0_t);
+        _cpu.id                   = cpu_agent;
+        _cpu.type                 = ROCPROFILER_AGENT_TYPE_CPU;
+        _cpu.name                 = "cpu";
+        _cpu.node_id              = 0;
+        _cpu.logical_node_id      = 0;
+        _cpu.logical_node_type_id = 0;
+
+        auto _gpu                 = rocprofiler_agent_v0_t{};
+        _gpu.size                 = sizeof(rocprofiler_agent_v0_t);
+        _gpu.id                   = gpu_agent;
+        _gpu.type                 = ROCPROFILER_AGENT_TYPE_GPU;
+        _gpu.name                 = "gfx942";
+        _gpu.node_id              = 1;
+        _gpu.logical_node_id      = 1;
+        _gpu.logical_node_type_id = 0;
+
+        tool_metadata.agents.emplace_back(_cpu);
+        tool_metadata.agents.emplace_back(_gpu);
+    }
+
+    // name_info resizes to the emplaced index so the kinds and operations are added in order
+    auto& _names = tool_metadata.buffer_names;
+    _names.emplace(ROCPROFILER_BUFFER_TRACING_HSA_CORE_API,
+                   ROCPROFILER_HSA_CORE_API_ID_hsa_queue_create,
+                   "hsa_queue_create");
+    _names.emplace(ROCPROFILER_BUFFER_TRACING_HSA_CORE_API,
+                   ROCPROFILER_HSA_CORE_API_ID_hsa_signal_create,
+                   "hsa_signal_create");
+    _names.emplace(ROCPROFILER_BUFFER_TRACING_MEMORY_COPY,
+                   ROCPROFILER_MEMORY_COPY_HOST_TO_DEVICE,
+                   "MEMORY_COPY_HOST_TO_DEVICE");
+    _names.emplace(ROCPROFILER_BUFFER_TRACING_MEMORY_ALLOCATION,
+                   ROCPROFILER_MEMORY_ALLOCATION_FREE,
+                   "MEMORY_ALLOCATION_FREE");
+    _names.emplace(ROCPROFILER_BUFFER_TRACING_MARKER_CORE_RANGE_API,
+                   ROCPROFILER_MARKER_CORE_RANGE_API_ID_roctxThreadRangeA,
+                   "roctxThreadRangeA");
+
+    tool_metadata.add_marker_message(marker_corrid, "outer range");
+
+    for(uint64_t i = 1; i <= 2; ++i)
+    {
+        auto _sym                  = tool::kernel_symbol_info{};
+        _sym.kernel_id             = i;
+        _sym.formatted_kernel_name = fmt::format("kernel_{}", i);
+        tool_metadata.add_kernel_symbol(std::move(_sym));
+    }
+
+    // thread 11: the calls are nested in a range and the second call starts when the first one
+    // ends. The records are out of order, the writer sorts them per location
+    auto hsa_api_gen = vector_generator<hsa_api_record_t>{{
+        make_record<hsa_api_record_t>(ROCPROFILER_BUFFER_TRACING_HSA_CORE_API,
+                                      ROCPROFILER_HSA_CORE_API_ID_hsa_signal_create,
+                                      12,
+                                      2000,
+                                      2100),
+        make_record<hsa_api_record_t>(ROCPROFILER_BUFFER_TRACING_HSA_CORE_API,
+                                      ROCPROFILER_HSA_CORE_API_ID_hsa_queue_create,
+                                      11,
+                                      1300,
+                                      1400),
+        make_record<hsa_api_record_t>(ROCPROFILER_BUFFER_TRACING_HSA_CORE_API,
+                                      ROCPROFILER_HSA_CORE_API_ID_hsa_signal_create,
+                                      11,
+                                      1200,
+                                      1300),
+    }};
+
+    auto _range = make_record<marker_api_record_t>(
+        ROCPROFILER_BUFFER_TRACING_MARKER_CORE_RANGE_API,
+        ROCPROFILER_MARKER_CORE_RANGE_API_ID_roctxThreadRangeA,
+        11,
+        1100,
+        1600);
+    _range.correlation_id.internal = marker_corrid;
+    auto marker_api_gen            = vector_generator<marker_api_record_t>{{_range}};
+
+    // thread 12 copies to the GPU and dispatches on two queues, thread 13 only frees memory
+    auto _copy = make_record<memory_copy_base_t>(ROCPROFILER_BUFFER_TRACING_MEMORY_COPY,
+                                                 ROCPROFILER_MEMORY_COPY_HOST_TO_DEVICE,
+                                                 12,
+                                                 2200,
+                                                 2300);
+    _copy.src_agent_id   = cpu_agent;
+    _copy.dst_agent_id   = gpu_agent;
+    auto memory_copy_gen = vector_generator<tool::tool_buffer_tracing_memory_copy_ext_record_t>{
+        {{_copy, null_stream}}};
+
+    auto _free = make_record<memory_alloc_base_t>(ROCPROFILER_BUFFER_TRACING_MEMORY_ALLOCATION,
+                                                  ROCPROFILER_MEMORY_ALLOCATION_FREE,
+                                                  13,
+                                                  3000,
+                                                  3050);
+    auto memory_allocation_gen =
+        vector_generator<tool::tool_buffer_tracing_memory_allocation_ext_record_t>{
+            {{_free, null_stream}}};
+
+    auto _dispatch = [&](uint64_t _queue, uint64_t _kernel, uint64_t _start, uint64_t _end) {
+        auto _record = make_record<dispatch_base_t>(ROCPROFILER_BUFFER_TRACING_KERNEL_DISPATCH,
+                                                    ROCPROFILER_KERNEL_DISPATCH_COMPLETE,
+                                                    12,
+                                                    _start,
+                                                    _end);
+        _record.dispatch_info.agent_id  = gpu_agent;
+        _record.dispatch_info.queue_id  = rocprofiler_queue_id_t{.handle = _queue};
+        _record.dispatch_info.kernel_id = _kernel;
+        return tool::tool_buffer_tracing_kernel_dispatch_ext_record_t{_record, null_stream};
+    };
+    auto kernel_dispatch_gen =
+        vector_generator<tool::tool_buffer_tracing_kernel_dispatch_ext_record_t>{{
+            _dispatch(0x20, 2, 2500, 2600),
+            _dispatch(0x10, 1, 2700, 2800),
+            _dispatch(0x10, 1, 2400, 2500),
+        }};
+
+    tool::write_otf2(cfg,
+                     tool_metadata,
+                     getpid(),
+                     tool_metadata.agents,
+                     vector_generator<tool::tool_buffer_tracing_hip_api_ext_record_t>{},
+                     hsa_api_gen,
+                     kernel_dispatch_gen,
+                     memory_copy_gen,
+                     marker_api_gen,
+                     vector_generator<rocprofiler_buffer_tracing_scratch_memory_record_t>{},
+                     vector_generator<rocprofiler_buffer_tracing_rccl_api_record_t>{},
+                     memory_allocation_gen,
+                     vector_generator<rocprofiler_buffer_tracing_rocdecode_api_ext_record_t>{},
+                     vector_generator<rocprofiler_buffer_tracing_rocjpeg_api_record_t>{});
+
+    auto _data = read_archive((_output_dir / "trace_results.otf2").string());
+
+    auto _string = [&_data](OTF2_StringRef _ref) -> std::string {
+        auto itr = _data.strings.find(_ref);
+        EXPECT_TRUE(itr != _data.strings.end()) << "undefined string " << _ref;
+        return (itr != _data.strings.end()) ? itr->second : std::string{};
+    };
+
+    // every event must refer to a defined region and every enter carries its category
+    auto _roles     = std::map<std::string, OTF2_RegionRole>{};
+    auto _locations = std::vector<location>{};
+    for(const auto& [_ref, _raw] : _data.locations)
+    {
+        auto& _loc = _locations.emplace_back(
+            location{_string(_raw.name), _raw.type, _raw.group, _raw.count, {}});
+        for(const auto& itr : _raw.events)
+        {
+            auto ritr = _data.regions.find(itr.region);
+            EXPECT_TRUE(ritr != _data.regions.end()) << "undefined region " << itr.region;
+            if(ritr == _data.regions.end()) continue;
+
+            auto _name = _string(ritr->second.name);
+            _roles.emplace(_name, ritr->second.role);
+            _loc.events.emplace_back(event{itr.enter, itr.timestamp, _name});
+            if(itr.enter)
+            {
+                EXPECT_NE(itr.category, OTF2_StringRef{0}) << _loc.name << " :: " << _name;
+                EXPECT_FALSE(_string(itr.category).empty()) << _loc.name << " :: " << _name;
+            }
+        }
+    }
+
+    // threads first, then memory copies, memory allocations and kernel dispatches. Queues are
+    // numbered by their handle
+    auto _expected = std::vector<location>{
+        {"Thread 11",
+         OTF2_LOCATION_TYPE_CPU_THREAD,
+         0,
+         6,
+         {{true, 1100, "outer range"},
+          {true, 1200, "hsa_signal_create"},
+          {false, 1300, "hsa_signal_create"},
+          {true, 1300, "hsa_queue_create"},
+          {false, 1400, "hsa_queue_create"},
+          {false, 1600, "outer range"}}},
+        {"Thread 12",
+         OTF2_LOCATION_TYPE_CPU_THREAD,
+         0,
+         2,
+         {{true, 2000, "hsa_signal_create"}, {false, 2100, "hsa_signal_create"}}},
+        {"Thread 13", OTF2_LOCATION_TYPE_CPU_THREAD, 0, 0, {}},
+        {"Thread 12, Copy to GPU Agent-1",
+         OTF2_LOCATION_TYPE_ACCELERATOR_STREAM,
+         gpu_agent.handle,
+         2,
+         {{true, 2200, "MEMORY_COPY_HOST_TO_DEVICE"}, {false, 2300, "MEMORY_COPY_HOST_TO_DEVICE"}}},
+        {"Thread 13, Memory Operation at UNK 0",
+         OTF2_LOCATION_TYPE_ACCELERATOR_STREAM,
+         0,
+         2,
+         {{true, 3000, "MEMORY_ALLOCATION_FREE"}, {false, 3050, "MEMORY_ALLOCATION_FREE"}}},
+        {"Thread 12, Compute on GPU Agent-1, Queue 0",
+         OTF2_LOCATION_TYPE_ACCELERATOR_STREAM,
+         gpu_agent.handle,
+         4,
+         {{true, 2400, "kernel_1"},
+          {false, 2500, "kernel_1"},
+          {true, 2700, "kernel_1"},
+          {false, 2800, "kernel_1"}}},
+        {"Thread 12, Compute on GPU Agent-1, Queue 1",
+         OTF2_LOCATION_TYPE_ACCELERATOR_STREAM,
+         gpu_agent.handle,
+         2,
+         {{true, 2500, "kernel_2"}, {false, 2600, "kernel_2"}}},
+    };
+
+    ASSERT_EQ(_locations.size(), _expected.size());
+    for(size_t i = 0; i < _expected.size(); ++i)
+    {
+        const auto& _loc = _locations.at(i);
+        const auto& _exp = _expected.at(i);
+        EXPECT_EQ(_loc.name, _exp.name) << "location " << i;
+        EXPECT_EQ(_loc.type, _exp.type) << _exp.name;
+        EXPECT_EQ(_loc.group, _exp.group) << _exp.name;
+        EXPECT_EQ(_loc.count, _exp.count) << _exp.name;
+        EXPECT_EQ(_loc.events, _exp.events) << _exp.name;
+    }
+
+    EXPECT_EQ(_roles.at("hsa_signal_create"), OTF2_REGION_ROLE_FUNCTION);
+    EXPECT_EQ(_roles.at("MEMORY_COPY_HOST_TO_DEVICE"), OTF2_REGION_ROLE_DATA_TRANSFER);
+    EXPECT_EQ(_roles.at("MEMORY_ALLOCATION_FREE"), OTF2_REGION_ROLE_ALLOCATE);
+    EXPECT_EQ(_roles.at("kernel_1"), OTF2_REGION_ROLE_FUNCTION);
+
+    // the process and one accelerator group per agent
+    ASSERT_EQ(_data.groups.size(), size_t{3});
+    EXPECT_EQ(_data.groups.at(0).second, OTF2_LOCATION_GROUP_TYPE_PROCESS);
+    EXPECT_EQ(_data.groups.at(gpu_agent.handle).second, OTF2_LOCATION_GROUP_TYPE_ACCELERATOR);
+    EXPECT_EQ(_string(_data.groups.at(gpu_agent.handle).first), "gfx942");
+    EXPECT_EQ(_string(_data.groups.at(cpu_agent.handle).first), "cpu");
+
+    fs::remove_all(_output_dir);
+}
@@ -0,0 +1,759 @@
+// MIT License
+//
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "lib/common/filesystem.hpp"
+#include "lib/output/generatePerfetto.hpp"
+#include "lib/output/generator.hpp"
+#include "lib/output/metadata.hpp"
+#include "lib/output/output_config.hpp"
+#include "lib/output/stream_info.hpp"
+
+#include <rocprofiler-sdk/buffer_tracing.h>
+#include <rocprofiler-sdk/fwd.h>
+#include <rocprofiler-sdk/hip/api_id.h>
+#include <rocprofiler-sdk/hsa/api_id.h>
+#include <rocprofiler-sdk/marker/api_id.h>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <ostream>
+#include <set>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+namespace fs   = ::rocprofiler::common::filesystem;
+namespace tool = ::rocprofiler::tool;
+
+// serves records which are already in memory as a single chunk
+template <typename Tp>
+struct vector_generator : public tool::generator<Tp>
+{
+    explicit vector_generator(std::vector<Tp> _data = {})
+    : tool::generator<Tp>{(_data.empty()) ? size_t{0} : size_t{1}}
+    , m_data{std::move(_data)}
+    {}
+
+    ~vector_generator() override = default;
+
+    std::vector<Tp> get(size_t) const override { return m_data; }
+
+private:
+    std::vector<Tp> m_data = {};
+};
+
+// one field of a protobuf message. varint and fixed values are stored in `value`,
+// length-delimited values in `bytes`
+struct field
+{
+    uint32_t         number = 0;
+    uint64_t         value  = 0;
+    std::string_view bytes  = {};
+};
+
+uint64_t
+read_varint(std::string_view& _data)
+{
+    uint64_t _val   = 0;
+    uint32_t _shift = 0;
+    while(!_data.empty())
+    {
+        auto _byte = static_cast<uint8_t>(_data.front());
+        _data.remove_prefix(1);
+        _val |= static_cast<uint64_t>(_byte & 0x7f) << _shift;
+        if((_byte & 0x80) == 0) break;
+        _shift += 7;
+    }
+    return _val;
+}
+
+std::vector<field>
+decode(std::string_view _data)
+{
+    auto _fields = std::vector<field>{};
+    while(!_data.empty())
+    {
+        auto _tag  = read_varint(_data);
+        auto _fld  = field{static_cast<uint32_t>(_tag >> 3), 0, {}};
+        auto _size = size_t{0};
+        switch(_tag & 0x7)
+        {
+            case 0: _fld.value = read_varint(_data); break;
+            case 1: _size = sizeof(uint64_t); break;
+            case 5: _size = sizeof(uint32_t); break;
+            case 2:
+            {
+                auto _len = read_varint(_data);
+                if(_len > _data.size())
+                {
+                    ADD_FAILURE() << "truncated field " << _fld.number;
+                    return _fields;
+                }
+                _fld.bytes = _data.substr(0, _len);
+                _data.remove_prefix(_len);
+                break;
+            }
+            default:
+                ADD_FAILURE() << "unexpected wire type in field " << _fld.number;
+                return _fields;
+        }
+        if(_size > 0)
+        {
+            if(_size > _data.size())
+            {
+                ADD_FAILURE() << "truncated field " << _fld.number;
+                return _fields;
+            }
+            std::memcpy(&_fld.value, _data.data(), _size);
+            _data.remove_prefix(_size);
+        }
+        _fields.emplace_back(_fld);
+    }
+    return _fields;
+}
+
+double
+to_double(uint64_t _bits)
+{
+    auto _val = 0.0;
+    std::memcpy(&_val, &_bits, sizeof(_val));
+    return _val;
+}
+
+struct track
+{
+    std::string name        = {};
+    std::string parent      = {};  // "process", "thread" or the name of the parent
+    bool        counter     = false;
+    uint64_t    unit        = 0;
+    int64_t     multiplier  = 0;
+    bool        incremental = false;
+};
+
+bool
+operator==(const track& lhs, const track& rhs)
+{
+    return std::tie(
+               lhs.name, lhs.parent, lhs.counter, lhs.unit, lhs.multiplier, lhs.incremental) ==
+           std::tie(rhs.name, rhs.parent, rhs.counter, rhs.unit, rhs.multiplier, rhs.incremental);
+}
+
+std::ostream&
+operator<<(std::ostream& os, const track& _trk)
+{
+    return os << fmt::format("{} (parent: {}, counter: {}, unit: {}, multiplier: {}, "
+                             "incremental: {})",
+                             _trk.name,
+                             _trk.parent,
+                             _trk.counter,
+                             _trk.unit,
+                             _trk.multiplier,
+                             _trk.incremental);
+}
+
+struct slice
+{
+    std::string                        track       = {};
+    std::string                        category    = {};
+    std::string                        name        = {};
+    uint64_t                           begin       = 0;
+    uint64_t                           end         = 0;
+    std::map<std::string, std::string> annotations = {};
+
+    std::string key() const { return fmt::format("{} @ {} on {}", name, begin, track); }
+};
+
+bool
+operator==(const slice& lhs, const slice& rhs)
+{
+    return std::tie(lhs.track, lhs.category, lhs.name, lhs.begin, lhs.end, lhs.annotations) ==
+           std::tie(rhs.track, rhs.category, rhs.name, rhs.begin, rhs.end, rhs.annotations);
+}
+
+std::ostream&
+operator<<(std::ostream& os, const slice& _slice)
+{
+    os << fmt::format("[{}] {} [{}, {}] on {}",
+                      _slice.category,
+                      _slice.name,
+                      _slice.begin,
+                      _slice.end,
+                      _slice.track);
+    for(const auto& itr : _slice.annotations)
+        os << fmt::format(", {}={}", itr.first, itr.second);
+    return os;
+}
+
+// everything read back from a trace, resolved to names. The backends pick different track
+// uuids, flow ids and interning ids, so the traces are compared by what they show: the named
+// tracks, the slices with their annotations, which slices each flow connects and the values
+// of each counter track
+struct trace_data
+{
+    std::map<std::string, track>                           tracks   = {};
+    std::vector<slice>                                     slices   = {};
+    std::set<std::vector<std::string>>                     flows    = {};
+    std::map<std::string, std::map<uint64_t, std::string>> counters = {};
+};
+
+struct descriptor
+{
+    std::string name        = {};
+    uint64_t    parent      = 0;
+    bool        process     = false;
+    bool        thread      = false;
+    bool        counter     = false;
+    uint64_t    unit        = 0;
+    int64_t     multiplier  = 0;
+    bool        incremental = false;
+};
+
+// the interned strings and timestamp state of one trusted packet sequence
+struct sequence_state
+{
+    std::map<uint64_t, std::string> categories        = {};
+    std::map<uint64_t, std::string> event_names       = {};
+    std::map<uint64_t, std::string> annotation_names  = {};
+    std::map<uint64_t, uint64_t>    incremental_clock = {};  // clock id -> last timestamp
+    uint64_t                        clock_id          = 0;
+    uint64_t                        track_uuid        = 0;
+};
+
+std::string
+lookup(const std::map<uint64_t, std::string>& _interned, uint64_t _iid)
+{
+    auto itr = _interned.find(_iid);
+    EXPECT_TRUE(itr != _interned.end()) << "undefined interned id " << _iid;
+    return (itr != _interned.end()) ? itr->second : std::string{};
+}
+
+// signed and unsigned integers are compared by value since the backends may pick either
+std::pair<std::string, std::string>
+read_annotation(std::string_view _data, const sequence_state& _state)
+{
+    auto _ret = std::pair<std::string, std::string>{};
+    for(const auto& itr : decode(_data))
+    {
+        switch(itr.number)
+        {
+            case 1: _ret.first = lookup(_state.annotation_names, itr.value); break;
+            case 10: _ret.first = std::string{itr.bytes}; break;
+            case 2: _ret.second = (itr.value != 0) ? "true" : "false"; break;
+            case 3: _ret.second = std::to_string(itr.value); break;
+            case 4: _ret.second = std::to_string(static_cast<int64_t>(itr.value)); break;
+            case 5: _ret.second = fmt::format("{}", to_double(itr.value)); break;
+            case 6: _ret.second = std::string{itr.bytes}; break;
+            default: ADD_FAILURE() << "unexpected debug annotation field " << itr.number;
+        }
+    }
+    return _ret;
+}
+
+trace_data
+read_trace(const std::string& _filename)
+{
+    auto _ifs = std::ifstream{_filename, std::ios::binary};
+    EXPECT_TRUE(_ifs) << _filename;
+    const auto _buffer =
+        std::string{std::istreambuf_iterator<char>{_ifs}, std::istreambuf_iterator<char>{}};
+
+    auto _packets = std::vector<std::vector<field>>{};
+    for(const auto& itr : decode(_buffer))
+    {
+        EXPECT_EQ(itr.number, 1) << _filename;
+        _packets.emplace_back(decode(itr.bytes));
+    }
+
+    // descriptors may be emitted more than once and after the events which use them
+    auto _descriptors = std::map<uint64_t, descriptor>{};
+    for(const auto& pitr : _packets)
+        for(const auto& itr : pitr)
+        {
+            if(itr.number != 60) continue;
+
+            auto _uuid = uint64_t{0};
+            auto _desc = descriptor{};
+            for(const auto& ditr : decode(itr.bytes))
+            {
+                if(ditr.number == 1)
+                    _uuid = ditr.value;
+                else if(ditr.number == 2 || ditr.number == 10 || ditr.number == 13)
+                    _desc.name = std::string{ditr.bytes};  // name, static_name or atrace_name
+                else if(ditr.number == 3)
+                    _desc.process = true;
+                else if(ditr.number == 4)
+                    _desc.thread = true;
+                else if(ditr.number == 5)
+                    _desc.parent = ditr.value;
+                else if(ditr.number == 8)
+                {
+                    _desc.counter = true;
+                    for(const auto& citr : decode(ditr.bytes))
+                    {
+                        if(citr.number == 3)
+                            _desc.unit = citr.value;
+                        else if(citr.number == 4)
+                            _desc.multiplier = static_cast<int64_t>(citr.value);
+                        else if(citr.number == 5)
+                            _desc.incremental = (citr.value != 0);
+                    }
+                }
+            }
+            _descriptors[_uuid] = _desc;
+        }
+
+    auto _data = trace_data{};
+    for(const auto& [_uuid, _desc] : _descriptors)
+    {
+        // the process and thread tracks come from the tracing session, not from the records
+        if(_desc.name.empty() || _desc.process || _desc.thread) continue;
+
+        auto _trk = track{_desc.name,
+                          "none",
+                          _desc.counter,
+                          _desc.unit,
+                          _desc.multiplier,
+                          _desc.incremental};
+        if(auto pitr = _descriptors.find(_desc.parent); pitr != _descriptors.end())
+        {
+            const auto& _parent = pitr->second;
+            _trk.parent =
+                (_parent.process) ? "process" : (_parent.thread) ? "thread" : _parent.name;
+        }
+        auto itr = _data.tracks.emplace(_trk.name, _trk).first;
+        EXPECT_EQ(itr->second, _trk) << "conflicting descriptors named " << _trk.name;
+    }
+
+    auto _track_name = [&_descriptors](uint64_t _uuid) {
+        auto itr = _descriptors.find(_uuid);
+        EXPECT_TRUE(itr != _descriptors.end()) << "undefined track " << _uuid;
+        if(itr == _descriptors.end()) return std::string{};
+        EXPECT_FALSE(itr->second.name.empty()) << "event on unnamed track " << _uuid;
+        return itr->second.name;
+    };
+
+    struct open_slice
+    {
+        slice                 data  = {};
+        std::vector<uint64_t> flows = {};
+    };
+
+    auto _states = std::map<uint64_t, sequence_state>{};
+    auto _open   = std::map<uint64_t, std::vector<open_slice>>{};
+    auto _flows  = std::map<uint64_t, std::vector<std::string>>{};
+    for(const auto& pitr : _packets)
+    {
+        auto _sequence  = uint64_t{0};
+        auto _flags     = uint64_t{0};
+        auto _timestamp = uint64_t{0};
+        auto _clock_id  = uint64_t{0};
+        auto _event     = std::string_view{};
+        auto _interned  = std::vector<std::string_view>{};
+        auto _snapshots = std::vector<std::string_view>{};
+        auto _defaults  = std::vector<std::string_view>{};
+        for(const auto& itr : pitr)
+        {
+            switch(itr.number)
+            {
+                case 6: _snapshots.emplace_back(itr.bytes); break;
+                case 8: _timestamp = itr.value; break;
+                case 10: _sequence = itr.value; break;
+                case 11: _event = itr.bytes; break;
+                case 12: _interned.emplace_back(itr.bytes); break;
+                case 13: _flags = itr.value; break;
+                case 58: _clock_id = itr.value; break;
+                case 59: _defaults.emplace_back(itr.bytes); break;
+                default: break;
+            }
+        }
+
+        // SEQ_INCREMENTAL_STATE_CLEARED
+        auto& _state = _states[_sequence];
+        if((_flags & 1) != 0) _state = sequence_state{};
+
+        for(auto itr : _defaults)
+            for(const auto& ditr : decode(itr))
+            {
+                if(ditr.number == 58) _state.clock_id = ditr.value;
+                if(ditr.number != 11) continue;
+                for(const auto& eitr : decode(ditr.bytes))
+                    if(eitr.number == 11) _state.track_uuid = eitr.value;
+            }
+
+        for(auto itr : _snapshots)
+            for(const auto& citr : decode(itr))
+            {
+                if(citr.number != 1) continue;
+                auto _id          = uint64_t{0};
+                auto _value       = uint64_t{0};
+                auto _incremental = false;
+                for(const auto& vitr : decode(citr.bytes))
+                {
+                    if(vitr.number == 1)
+                        _id = vitr.value;
+                    else if(vitr.number == 2)
+                        _value = vitr.value;
+                    else if(vitr.number == 3)
+                        _incremental = (vitr.value != 0);
+                }
+                if(_incremental) _state.incremental_clock[_id] = _value;
+            }
+
+        for(auto itr : _interned)
+            for(const auto& iitr : decode(itr))
+            {
+                auto* _map = (iitr.number == 1)   ? &_state.categories
+                             : (iitr.number == 2) ? &_state.event_names
+                             : (iitr.number == 3) ? &_state.annotation_names
+                                                  : nullptr;
+                if(!_map) continue;
+
+                auto _iid  = uint64_t{0};
+                auto _name = std::string{};
+                for(const auto& sitr : decode(iitr.bytes))
+                {
+                    if(sitr.number == 1) _iid = sitr.value;
+                    if(sitr.number == 2) _name = std::string{sitr.bytes};
+                }
+                (*_map)[_iid] = _name;
+            }
+
+        if(_event.empty()) continue;
+
+        // timestamps on an incremental clock are deltas to the previous one on the sequence
+        if(_clock_id == 0) _clock_id = _state.clock_id;
+        if(auto citr = _state.incremental_clock.find(_clock_id);
+           citr != _state.incremental_clock.end())
+        {
+            citr->second += _timestamp;
+            _timestamp = citr->second;
+        }
+
+        auto _type    = uint64_t{0};
+        auto _track   = _state.track_uuid;
+        auto _current = open_slice{};
+        auto _value   = std::string{};
+        for(const auto& itr : decode(_event))
+        {
+            switch(itr.number)
+            {
+                case 3: _current.data.category = lookup(_state.categories, itr.value); break;
+                case 22: _current.data.category = std::string{itr.bytes}; break;
+                case 4:
+                    _current.data.annotations.emplace(read_annotation(itr.bytes, _state));
+                    break;
+                case 9: _type = itr.value; break;
+                case 10: _current.data.name = lookup(_state.event_names, itr.value); break;
+                case 23: _current.data.name = std::string{itr.bytes}; break;
+                case 11: _track = itr.value; break;
+                case 30: _value = std::to_string(static_cast<int64_t>(itr.value)); break;
+                case 44: _value = fmt::format("{}", to_double(itr.value)); break;
+                case 36:
+                case 47: _current.flows.emplace_back(itr.value); break;
+                default: break;
+            }
+        }
+
+        if(_type == 1)
+        {
+            _current.data.track = _track_name(_track);
+            _current.data.begin = _timestamp;
+            _open[_track].emplace_back(std::move(_current));
+        }
+        else if(_type == 2)
+        {
+            auto& _stack = _open[_track];
+            EXPECT_FALSE(_stack.empty()) << "slice end without begin on " << _track_name(_track);
+            if(_stack.empty()) continue;
+
+            auto _slice = std::move(_stack.back());
+            _stack.pop_back();
+            _slice.data.end = _timestamp;
+            for(auto itr : _slice.flows)
+                _flows[itr].emplace_back(_slice.data.key());
+            _data.slices.emplace_back(std::move(_slice.data));
+        }
+        else if(_type == 4)
+        {
+            auto& _values = _data.counters[_track_name(_track)];
+            auto  itr     = _values.emplace(_timestamp, _value).first;
+            EXPECT_EQ(itr->second, _value) << "conflicting values at " << _timestamp;
+        }
+        else
+        {
+            ADD_FAILURE() << "unexpected track event type " << _type;
+        }
+    }
+
+    for(const auto& itr : _open)
+        EXPECT_TRUE(itr.second.empty()) << "unterminated slice on " << _track_name(itr.first);
+
+    for(auto& itr : _flows)
+    {
+        std::sort(itr.second.begin(), itr.second.end());
+        _data.flows.emplace(itr.second);
+    }
+
+    std::sort(_data.slices.begin(), _data.slices.end(), [](const slice& lhs, const slice& rhs) {
+        return std::tie(lhs.track, lhs.begin, lhs.name) < std::tie(rhs.track, rhs.begin, rhs.name);
+    });
+
+    return _data;
+}
+
+template <typename Tp>
+Tp
+make_record(rocprofiler_buffer_tracing_kind_t _kind,
+            int32_t                           _operation,
+            rocprofiler_thread_id_t           _tid,
+            uint64_t                          _corr_id,
+            uint64_t                          _start,
+            uint64_t                          _end)
+{
+    auto _record                    = Tp{};
+    _record.size                    = sizeof(Tp);
+    _record.kind                    = _kind;
+    _record.operation               = static_cast<decltype(_record.operation)>(_operation);
+    _record.thread_id               = _tid;
+    _record.correlation_id.internal = _corr_id;
+    _record.start_timestamp         = _start;
+    _record.end_timestamp           = _end;
+    return _record;
+}
+}  // namespace
+
+// writes the same records through the tracing session and the direct protobuf writer
+TEST(perfetto, direct_backend_matches_inprocess)
+{
+    using hip_api_base_t      = rocprofiler_buffer_tracing_hip_api_ext_record_t;
+    using hsa_api_record_t    = rocprofiler_buffer_tracing_hsa_api_record_t;
+    using marker_api_record_t = rocprofiler_buffer_tracing_marker_api_record_t;
+    using memory_copy_base_t  = rocprofiler_buffer_tracing_memory_copy_record_t;
+    using memory_alloc_base_t = rocprofiler_buffer_tracing_memory_allocation_record_t;
+    using dispatch_base_t     = rocprofiler_buffer_tracing_kernel_dispatch_record_t;
+
+    constexpr auto null_stream = rocprofiler_stream_id_t{.handle = 0};
+    constexpr auto cpu_agent   = rocprofiler_agent_id_t{.handle = 0x100};
+    constexpr auto gpu_agent   = rocprofiler_agent_id_t{.handle = 0x200};
+
+    auto _output_dir =
+        fs::temp_directory_path() / fmt::format("rocprofiler-perfetto-{}", getpid());
+
+    auto tool_metadata             = tool::metadata{};
+    tool_metadata.process_start_ns = 1000;
+    tool_metadata.process_end_ns   = 100000;
+
+    {
+        auto _cpu                 = rocprofiler_agent_v0_t{};
+        _cpu.size                 = sizeof(rocprofiler_agent_v0_t);
+        _cpu.id                   = cpu_agent;
+        _cpu.type                 = ROCPROFILER_AGENT_TYPE_CPU;
+        _cpu.name                 = "cpu";
+        _cpu.node_id              = 0;
+        _cpu.logical_node_id      = 0;
+        _cpu.logical_node_type_id = 0;
+
+        auto _gpu                 = rocprofiler_agent_v0_t{};
+        _gpu.size                 = sizeof(rocprofiler_agent_v0_t);
+        _gpu.id                   = gpu_agent;
+        _gpu.type                 = ROCPROFILER_AGENT_TYPE_GPU;
+        _gpu.name                 = "gfx942";
+        _gpu.node_id              = 1;
+        _gpu.logical_node_id      = 1;
+        _gpu.logical_node_type_id = 0;
+
+        tool_metadata.agents.emplace_back(_cpu);
+        tool_metadata.agents.emplace_back(_gpu);
+    }
+
+    tool_metadata.add_marker_message(1, "outer range");
+
+    for(uint64_t i = 1; i <= 2; ++i)
+    {
+        auto _sym                  = tool::kernel_symbol_info{};
+        _sym.kernel_id             = i;
+        _sym.kernel_name           = (i == 1) ? "kernel_1" : "kernel_2";
+        _sym.formatted_kernel_name = _sym.kernel_name;
+        tool_metadata.add_kernel_symbol(std::move(_sym));
+    }
+
+    // thread 11 launches the kernels and the copy inside a range, so the launch, copy and
+    // dispatch records share correlation ids and are connected by flows
+    auto marker_api_gen = vector_generator<marker_api_record_t>{{
+        make_record<marker_api_record_t>(ROCPROFILER_BUFFER_TRACING_MARKER_CORE_RANGE_API,
+                                         ROCPROFILER_MARKER_CORE_RANGE_API_ID_roctxThreadRangeA,
+                                         11,
+                                         1,
+                                         10000,
+                                         19000),
+    }};
+
+    auto _hip_api = [&](int32_t _operation, uint64_t _corr_id, uint64_t _start, uint64_t _end) {
+        return tool::tool_buffer_tracing_hip_api_ext_record_t{
+            make_record<hip_api_base_t>(ROCPROFILER_BUFFER_TRACING_HIP_RUNTIME_API,
+                                        _operation,
+                                        11,
+                                        _corr_id,
+                                        _start,
+                                        _end),
+            rocprofiler_stream_id_t{.handle = 7}};
+    };
+    auto hip_api_gen = vector_generator<tool::tool_buffer_tracing_hip_api_ext_record_t>{{
+        _hip_api(ROCPROFILER_HIP_RUNTIME_API_ID_hipLaunchKernel, 2, 11000, 11500),
+        _hip_api(ROCPROFILER_HIP_RUNTIME_API_ID_hipLaunchKernel, 3, 12000, 12500),
+        _hip_api(ROCPROFILER_HIP_RUNTIME_API_ID_hipMemcpyAsync, 4, 13000, 13500),
+    }};
+
+    auto hsa_api_gen = vector_generator<hsa_api_record_t>{{
+        make_record<hsa_api_record_t>(ROCPROFILER_BUFFER_TRACING_HSA_CORE_API,
+                                      ROCPROFILER_HSA_CORE_API_ID_hsa_signal_create,
+                                      12,
+                                      5,
+                                      20000,
+                                      20100),
+        make_record<hsa_api_record_t>(ROCPROFILER_BUFFER_TRACING_HSA_CORE_API,
+                                      ROCPROFILER_HSA_CORE_API_ID_hsa_queue_create,
+                                      11,
+                                      6,
+                                      18000,
+                                      18500),
+    }};
+
+    auto _copy = make_record<memory_copy_base_t>(ROCPROFILER_BUFFER_TRACING_MEMORY_COPY,
+                                                 ROCPROFILER_MEMORY_COPY_HOST_TO_DEVICE,
+                                                 11,
+                                                 4,
+                                                 13200,
+                                                 14200);
+    _copy.src_agent_id   = cpu_agent;
+    _copy.dst_agent_id   = gpu_agent;
+    _copy.bytes          = 8192;
+    auto memory_copy_gen = vector_generator<tool::tool_buffer_tracing_memory_copy_ext_record_t>{
+        {{_copy, null_stream}}};
+
+    // thread 13 allocates and frees memory on the GPU
+    auto _alloc = make_record<memory_alloc_base_t>(ROCPROFILER_BUFFER_TRACING_MEMORY_ALLOCATION,
+                                                   ROCPROFILER_MEMORY_ALLOCATION_ALLOCATE,
+                                                   13,
+                                                   7,
+                                                   15000,
+                                                   15100);
+    _alloc.agent_id        = gpu_agent;
+    _alloc.address         = rocprofiler_address_t{.handle = 0x1000};
+    _alloc.allocation_size = 4096;
+    auto _free = make_record<memory_alloc_base_t>(ROCPROFILER_BUFFER_TRACING_MEMORY_ALLOCATION,
+                                                  ROCPROFILER_MEMORY_ALLOCATION_FREE,
+                                                  13,
+                                                  8,
+                                                  21000,
+                                                  21100);
+    _free.address = _alloc.address;
+    auto memory_allocation_gen =
+        vector_generator<tool::tool_buffer_tracing_memory_allocation_ext_record_t>{
+            {{_alloc, null_stream}, {_free, null_stream}}};
+
+    // the dispatches on queue 0x10 overlap so both backends split them at the midpoint
+    auto _dispatch = [&](uint64_t _queue,
+                         uint64_t _kernel,
+                         uint64_t _corr_id,
+                         uint64_t _start,
+                         uint64_t _end) {
+        auto _record = make_record<dispatch_base_t>(ROCPROFILER_BUFFER_TRACING_KERNEL_DISPATCH,
+                                                    ROCPROFILER_KERNEL_DISPATCH_COMPLETE,
+                                                    11,
+                                                    _corr_id,
+                                                    _start,
+                                                    _end);
+        _record.dispatch_info.agent_id       = gpu_agent;
+        _record.dispatch_info.queue_id       = rocprofiler_queue_id_t{.handle = _queue};
+        _record.dispatch_info.kernel_id      = _kernel;
+        _record.dispatch_info.workgroup_size = {64, 1, 1};
+        _record.dispatch_info.grid_size      = {1024, 2, 1};
+        return tool::tool_buffer_tracing_kernel_dispatch_ext_record_t{_record, null_stream};
+    };
+    auto kernel_dispatch_gen =
+        vector_generator<tool::tool_buffer_tracing_kernel_dispatch_ext_record_t>{{
+            _dispatch(0x10, 1, 2, 11600, 12800),
+            _dispatch(0x10, 2, 3, 12600, 13000),
+            _dispatch(0x20, 1, 9, 16000, 17000),
+        }};
+
+    auto _write = [&](const std::string& _backend) {
+        auto cfg             = tool::output_config{};
+        cfg.output_path      = (_output_dir / _backend).string();
+        cfg.output_file      = "trace";
+        cfg.perfetto_backend = _backend;
+
+        tool::write_perfetto(
+            cfg,
+            tool_metadata,
+            tool_metadata.agents,
+            hip_api_gen,
+            hsa_api_gen,
+            kernel_dispatch_gen,
+            memory_copy_gen,
+            vector_generator<tool::tool_counter_record_t>{},
+            marker_api_gen,
+            vector_generator<rocprofiler_buffer_tracing_scratch_memory_record_t>{},
+            vector_generator<rocprofiler_buffer_tracing_rccl_api_record_t>{},
+            memory_allocation_gen,
+            vector_generator<rocprofiler_buffer_tracing_rocdecode_api_ext_record_t>{},
+            vector_generator<rocprofiler_buffer_tracing_rocjpeg_api_record_t>{});
+
+        return read_trace((_output_dir / _backend / "trace_results.pftrace").string());
+    };
+
+    auto _inprocess = _write("inprocess");
+    auto _direct    = _write("direct");
+
+    // guard against both traces being empty or both failing to parse the same way: one slice
+    // per API, copy and dispatch record, the launches and the copy are linked to their
+    // dispatch and copy, and the copy and allocation counters are written
+    EXPECT_EQ(_inprocess.slices.size(), size_t{10});
+    EXPECT_EQ(std::count_if(_inprocess.flows.begin(),
+                            _inprocess.flows.end(),
+                            [](const auto& itr) { return itr.size() == 2; }),
+              3);
+    EXPECT_EQ(_inprocess.counters.size(), size_t{2});
+
+    EXPECT_EQ(_direct.tracks, _inprocess.tracks);
+
+    ASSERT_EQ(_direct.slices.size(), _inprocess.slices.size());
+    for(size_t i = 0; i < _inprocess.slices.size(); ++i)
+        EXPECT_EQ(_direct.slices.at(i), _inprocess.slices.at(i)) << "slice " << i;
+
+    EXPECT_EQ(_direct.flows, _inprocess.flows);
+    EXPECT_EQ(_direct.counters, _inprocess.counters);
+
+    fs::remove_all(_output_dir);
+}
@@ -0,0 +1,289 @@
+// MIT License
+//
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "lib/output/pftrace_writer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace
+{
+namespace pftrace = ::rocprofiler::tool::pftrace;
+
+// a decoded protobuf message: field number -> values in the order they were encoded.
+// varint and fixed64 values are stored in `ints`, length-delimited values in `bytes`
+struct message
+{
+    std::multimap<uint32_t, uint64_t>         ints  = {};
+    std::multimap<uint32_t, std::string_view> bytes = {};
+
+    uint64_t int_at(uint32_t field) const { return ints.find(field)->second; }
+    message  msg_at(uint32_t field) const;
+    bool     has(uint32_t field) const { return ints.count(field) + bytes.count(field) > 0; }
+};
+
+uint64_t
+read_varint(std::string_view& _data)
+{
+    uint64_t _val   = 0;
+    uint32_t _shift = 0;
+    while(!_data.empty())
+    {
+        auto _byte = static_cast<uint8_t>(_data.front());
+        _data.remove_prefix(1);
+        _val |= static_cast<uint64_t>(_byte & 0x7f) << _shift;
+        if((_byte & 0x80) == 0) break;
+        _shift += 7;
+    }
+    return _val;
+}
+
+message
+decode(std::string_view _data)
+{
+    auto _msg = message{};
+    while(!_data.empty())
+    {
+        auto _tag   = read_varint(_data);
+        auto _field = static_cast<uint32_t>(_tag >> 3);
+        switch(_tag & 0x7)
+        {
+            case 0: _msg.ints.emplace(_field, read_varint(_data)); break;
+            case 1:
+            {
+                auto _val = uint64_t{0};
+                std::memcpy(&_val, _data.data(), sizeof(_val));
+                _data.remove_prefix(sizeof(_val));
+                _msg.ints.emplace(_field, _val);
+                break;
+            }
+            case 2:
+            {
+                auto _len = read_varint(_data);
+                _msg.bytes.emplace(_field, _data.substr(0, _len));
+                _data.remove_prefix(_len);
+                break;
+            }
+            default: ADD_FAILURE() << "unexpected wire type in field " << _field; return _msg;
+        }
+    }
+    return _msg;
+}
+
+message
+message::msg_at(uint32_t field) const
+{
+    return decode(bytes.find(field)->second);
+}
+
+// the decoded messages reference the trace data so it must outlive them
+std::vector<message>
+get_packets(const std::string& _trace)
+{
+    auto _packets = std::vector<message>{};
+    auto _trc     = decode(_trace);
+    EXPECT_TRUE(_trc.ints.empty());
+    for(const auto& itr : _trc.bytes)
+    {
+        EXPECT_EQ(itr.first, 1);
+        _packets.emplace_back(decode(itr.second));
+    }
+    return _packets;
+}
+
+// TracePacket field numbers
+constexpr uint32_t timestamp           = 8;
+constexpr uint32_t sequence_id         = 10;
+constexpr uint32_t track_event         = 11;
+constexpr uint32_t interned_data       = 12;
+constexpr uint32_t sequence_flags      = 13;
+constexpr uint32_t track_descriptor    = 60;
+constexpr uint32_t first_packet_on_seq = 87;
+}  // namespace
+
+TEST(pftrace_writer, track_descriptors)
+{
+    auto _ss = std::stringstream{};
+    {
+        auto _out = pftrace::output{_ss};
+        auto _seq = pftrace::sequence_writer{_out, 1};
+        _seq.process_track(100, 42, "app --arg");
+        _seq.thread_track(101, 100, 42, 43);
+        _seq.track(102, 100, "STREAM 0");
+        _seq.counter_track(103, 100, "COPY BYTES", pftrace::counter_unit::size_bytes, 1024, false);
+    }
+
+    auto _trace   = _ss.str();
+    auto _packets = get_packets(_trace);
+    ASSERT_EQ(_packets.size(), 4);
+    for(const auto& itr : _packets)
+    {
+        EXPECT_EQ(itr.int_at(sequence_id), 1);
+        EXPECT_FALSE(itr.has(timestamp));
+        EXPECT_TRUE(itr.has(track_descriptor));
+    }
+
+    auto _process = _packets.at(0).msg_at(track_descriptor);
+    EXPECT_EQ(_process.int_at(1), 100);
+    EXPECT_EQ(_process.msg_at(3).int_at(1), 42);
+    EXPECT_EQ(_process.msg_at(3).bytes.find(6)->second, "app --arg");
+
+    auto _thread = _packets.at(1).msg_at(track_descriptor);
+    EXPECT_EQ(_thread.int_at(1), 101);
+    EXPECT_EQ(_thread.int_at(5), 100);
+    EXPECT_EQ(_thread.msg_at(4).int_at(1), 42);
+    EXPECT_EQ(_thread.msg_at(4).int_at(2), 43);
+
+    auto _track = _packets.at(2).msg_at(track_descriptor);
+    EXPECT_EQ(_track.int_at(1), 102);
+    EXPECT_EQ(_track.bytes.find(2)->second, "STREAM 0");
+
+    auto _counter = _packets.at(3).msg_at(track_descriptor);
+    EXPECT_EQ(_counter.int_at(1), 103);
+    EXPECT_EQ(_counter.msg_at(8).int_at(3), 3);
+    EXPECT_EQ(_counter.msg_at(8).int_at(4), 1024);
+    EXPECT_FALSE(_counter.msg_at(8).has(5));
+}
+
+TEST(pftrace_writer, interned_slices)
+{
+    auto _ss = std::stringstream{};
+    {
+        auto _out   = pftrace::output{_ss};
+        auto _seq   = pftrace::sequence_writer{_out, 7};
+        auto _extra = std::vector<pftrace::annotation>{};
+        _extra.emplace_back("SQ_WAVES", 2.5);
+
+        // the second slice reuses every interned string of the first one
+        for(uint64_t i = 0; i < 2; ++i)
+        {
+            _seq.slice_begin(101,
+                             1000 * (i + 1),
+                             "hip_api",
+                             "hipLaunchKernel",
+                             55,
+                             {{"begin_ns", uint64_t{1000}},
+                              {"operation", int32_t{-3}},
+                              {"agent", std::string{"GPU-0"}},
+                              {"is_async", true}},
+                             _extra);
+            _seq.slice_end(101, 1000 * (i + 1) + 500, "hip_api");
+        }
+        _seq.counter(103, 5000, -12);
+    }
+
+    auto _trace   = _ss.str();
+    auto _packets = get_packets(_trace);
+    ASSERT_EQ(_packets.size(), 5);
+
+    const auto& _first = _packets.at(0);
+    EXPECT_EQ(_first.int_at(timestamp), 1000);
+    EXPECT_EQ(_first.int_at(sequence_id), 7);
+    EXPECT_EQ(_first.int_at(sequence_flags), 1);
+    EXPECT_EQ(_first.int_at(first_packet_on_seq), 1);
+
+    auto _interned = _first.msg_at(interned_data);
+    EXPECT_EQ(_interned.bytes.count(1), 1);  // categories
+    EXPECT_EQ(_interned.bytes.count(2), 1);  // event names
+    EXPECT_EQ(_interned.bytes.count(3), 5);  // debug annotation names
+    EXPECT_EQ(decode(_interned.bytes.find(2)->second).bytes.find(2)->second, "hipLaunchKernel");
+
+    auto _begin = _first.msg_at(track_event);
+    EXPECT_EQ(_begin.int_at(9), 1);
+    EXPECT_EQ(_begin.int_at(11), 101);
+    EXPECT_EQ(_begin.int_at(47), 55);
+    ASSERT_EQ(_begin.bytes.count(4), 5);
+
+    auto _annotations = std::vector<message>{};
+    for(auto itr = _begin.bytes.lower_bound(4); itr != _begin.bytes.upper_bound(4); ++itr)
+        _annotations.emplace_back(decode(itr->second));
+    EXPECT_EQ(_annotations.at(0).int_at(3), 1000);
+    EXPECT_EQ(static_cast<int64_t>(_annotations.at(1).int_at(4)), -3);
+    EXPECT_EQ(_annotations.at(2).bytes.find(6)->second, "GPU-0");
+    EXPECT_EQ(_annotations.at(3).int_at(2), 1);
+    auto _dbl = 0.0;
+    auto _raw = _annotations.at(4).int_at(5);
+    std::memcpy(&_dbl, &_raw, sizeof(_dbl));
+    EXPECT_EQ(_dbl, 2.5);
+
+    for(size_t i = 1; i < _packets.size(); ++i)
+    {
+        EXPECT_EQ(_packets.at(i).int_at(sequence_flags), 2);
+        EXPECT_FALSE(_packets.at(i).has(interned_data)) << "packet " << i;
+    }
+
+    auto _end = _packets.at(1).msg_at(track_event);
+    EXPECT_EQ(_packets.at(1).int_at(timestamp), 1500);
+    EXPECT_EQ(_end.int_at(9), 2);
+    EXPECT_EQ(_end.int_at(11), 101);
+
+    auto _counter = _packets.at(4).msg_at(track_event);
+    EXPECT_EQ(_counter.int_at(9), 4);
+    EXPECT_EQ(static_cast<int64_t>(_counter.int_at(30)), -12);
+}
+
+TEST(pftrace_writer, concurrent_sequences)
+{
+    constexpr uint32_t nsequences = 4;
+    constexpr uint64_t nevents    = 2000;
+
+    auto _ss = std::stringstream{};
+    {
+        auto _out     = pftrace::output{_ss};
+        auto _threads = std::vector<std::thread>{};
+        for(uint32_t i = 0; i < nsequences; ++i)
+        {
+            _threads.emplace_back([&_out, i]() {
+                // a small threshold so that the sequences interleave in the output
+                auto _seq = pftrace::sequence_writer{_out, i + 1, 256};
+                for(uint64_t j = 0; j < nevents; ++j)
+                    _seq.counter(i + 1, j, static_cast<int64_t>(j));
+            });
+        }
+        for(auto& itr : _threads)
+            itr.join();
+    }
+
+    auto _trace   = _ss.str();
+    auto _packets = get_packets(_trace);
+    ASSERT_EQ(_packets.size(), nsequences * nevents);
+
+    // packets of each sequence must stay complete and in order
+    auto _next = std::map<uint64_t, uint64_t>{};
+    for(const auto& itr : _packets)
+    {
+        auto  _seq_id = itr.int_at(sequence_id);
+        auto& _ts     = _next[_seq_id];
+        EXPECT_EQ(itr.int_at(timestamp), _ts);
+        EXPECT_EQ(itr.int_at(sequence_flags), (_ts == 0) ? 1 : 2);
+        ++_ts;
+    }
+    EXPECT_EQ(_next.size(), nsequences);
+}
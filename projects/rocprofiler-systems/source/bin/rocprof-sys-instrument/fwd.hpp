@@ -122,6 +122,8 @@ using object_t               = BPatch_object;
 using local_var_t            = BPatch_localVar;
 using sequence_t             = BPatch_sequence;
 using const_expr_t           = BPatch_constExpr;
+using arith_expr_t           = BPatch_arithExpr;
+using variable_expr_t        = BPatch_variableExpr;
 using error_level_t          = BPatchErrorLevel;
 using snippet_handle_t       = BPatchSnippetHandle;
 using patch_pointer_t        = std::shared_ptr<patch_t>;
@@ -210,6 +212,7 @@ extern int  num_log_entries;
 extern bool simulate;
 extern bool include_uninstr;
 extern bool include_internal_linked_libs;
+extern bool use_trace_handles;
 //
 //  string settings
 //
@@ -223,6 +226,7 @@ extern string_t prefer_library;
 //
 extern patch_pointer_t  bpatch;
 extern call_expr_t*     terminate_expr;
+extern variable_expr_t* trace_handle_base;
 extern snippet_vec_t    init_names;
 extern snippet_vec_t    fini_names;
 extern fmodset_t        available_module_functions;
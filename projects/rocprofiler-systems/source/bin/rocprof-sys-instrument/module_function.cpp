@@ -30,6 +30,7 @@
 #include <timemory/utility/join.hpp>
 
 #include <stdexcept>
+#include <unordered_map>
 
 module_function::width_t&
 module_function::get_width()
@@ -859,6 +860,38 @@ module_function::is_exit_trap_constrained() const
     return false;
 }
 
+namespace
+{
+// number of handles in the range the runtime reserves for each module, must match
+// trace_handle_module_size in the rocprof-sys library
+constexpr uint32_t trace_handle_module_size = (1U << 20);
+
+// each region name gets one index so the runtime can cache the lookup of the
+// name. Re-instrumenting a function (e.g. after a failed batch) reuses it.
+uint32_t
+get_trace_handle_index(const std::string& _name)
+{
+    static auto _handles = std::unordered_map<std::string, uint32_t>{};
+    return _handles.emplace(_name, static_cast<uint32_t>(_handles.size())).first->second;
+}
+
+// the handle is the base of the range of this module plus the index of the name.
+// Names beyond the range pass handle 0, which the runtime never hands out, so they
+// are looked up by name.
+rocprofsys_call_expr
+get_trace_call_expr(const std::string& _name)
+{
+    if(!use_trace_handles) return rocprofsys_call_expr(_name.c_str());
+
+    auto _index = get_trace_handle_index(_name);
+    if(_index >= trace_handle_module_size) return rocprofsys_call_expr(0U, _name.c_str());
+
+    auto _handle = std::make_shared<snippet_t>(
+        arith_expr_t{ BPatch_plus, *trace_handle_base, const_expr_t{ _index } });
+    return rocprofsys_call_expr(_handle, _name.c_str());
+}
+}  // namespace
+
 std::pair<size_t, size_t>
 module_function::operator()(address_space_t* _addr_space, procedure_t* _entr_trace,
                             procedure_t* _exit_trace) const
@@ -868,8 +901,8 @@ module_function::operator()(address_space_t* _addr_space, procedure_t* _entr_tra
     if(!function || !module) return _count;
 
     auto _name       = signature.get();
-    auto _trace_entr = rocprofsys_call_expr(_name.c_str());
-    auto _trace_exit = rocprofsys_call_expr(_name.c_str());
+    auto _trace_entr = get_trace_call_expr(_name);
+    auto _trace_exit = get_trace_call_expr(_name);
     auto _entr       = _trace_entr.get(_entr_trace);
     auto _exit       = _trace_exit.get(_exit_trace);
 
@@ -919,8 +952,8 @@ module_function::operator()(address_space_t* _addr_space, procedure_t* _entr_tra
                            "loop-exit-point-trap-instrumentation", _lname))
             continue;
 
-        auto _ltrace_entr = rocprofsys_call_expr(_lname.c_str());
-        auto _ltrace_exit = rocprofsys_call_expr(_lname.c_str());
+        auto _ltrace_entr = get_trace_call_expr(_lname);
+        auto _ltrace_exit = get_trace_call_expr(_lname);
         auto _lentr       = _ltrace_entr.get(_entr_trace);
         auto _lexit       = _ltrace_exit.get(_exit_trace);
 
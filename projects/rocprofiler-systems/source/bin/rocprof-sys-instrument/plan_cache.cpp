@@ -0,0 +1,271 @@
+// MIT License
+//
+// Copyright (c) 2022-2025 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "plan_cache.hpp"
+#include "fwd.hpp"
+#include "log.hpp"
+#include "module_function.hpp"
+
+#include <timemory/environment/types.hpp>
+#include <timemory/utility/filepath.hpp>
+#include <timemory/utility/join.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <elf.h>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <unistd.h>
+#include <vector>
+
+namespace plan_cache
+{
+namespace
+{
+namespace filepath = ::tim::filepath;
+
+// bump when the layout of the cache file changes
+constexpr auto plan_version = "rocprofsys-instrument-plan 1";
+
+template <typename EhdrT, typename ShdrT, typename NhdrT>
+std::optional<std::string>
+read_build_id(std::ifstream& _ifs)
+{
+    auto _ehdr = EhdrT{};
+    _ifs.seekg(0);
+    if(!_ifs.read(reinterpret_cast<char*>(&_ehdr), sizeof(_ehdr))) return std::nullopt;
+    if(_ehdr.e_shoff == 0 || _ehdr.e_shentsize != sizeof(ShdrT)) return std::nullopt;
+
+    auto _shdrs = std::vector<ShdrT>(_ehdr.e_shnum);
+    _ifs.seekg(_ehdr.e_shoff);
+    if(!_ifs.read(reinterpret_cast<char*>(_shdrs.data()), _shdrs.size() * sizeof(ShdrT)))
+        return std::nullopt;
+
+    auto _align = [](size_t _v) { return (_v + 3) & ~size_t{ 3 }; };
+    for(const auto& itr : _shdrs)
+    {
+        if(itr.sh_type != SHT_NOTE) continue;
+
+        auto _data = std::vector<char>(itr.sh_size);
+        _ifs.seekg(itr.sh_offset);
+        if(!_ifs.read(_data.data(), _data.size())) continue;
+
+        size_t _off = 0;
+        while(_off + sizeof(NhdrT) <= _data.size())
+        {
+            auto _nhdr = NhdrT{};
+            std::memcpy(&_nhdr, _data.data() + _off, sizeof(_nhdr));
+            auto _name = _off + sizeof(NhdrT);
+            auto _desc = _name + _align(_nhdr.n_namesz);
+            if(_desc + _nhdr.n_descsz > _data.size()) break;
+            if(_nhdr.n_type == NT_GNU_BUILD_ID && _nhdr.n_namesz == 4 &&
+               std::string_view{ _data.data() + _name, 3 } == "GNU" &&
+               _nhdr.n_descsz > 0)
+            {
+                std::stringstream _ss{};
+                for(size_t i = 0; i < _nhdr.n_descsz; ++i)
+                    _ss << std::hex << std::setw(2) << std::setfill('0')
+                        << static_cast<int>(
+                               static_cast<unsigned char>(_data.at(_desc + i)));
+                return _ss.str();
+            }
+            _off = _desc + _align(_nhdr.n_descsz);
+        }
+    }
+    return std::nullopt;
+}
+
+// 64-bit FNV-1a: stable across builds, unlike std::hash
+uint64_t
+get_hash(std::string_view _v)
+{
+    uint64_t _hash = 0xcbf29ce484222325ULL;
+    for(auto itr : _v)
+    {
+        _hash ^= static_cast<unsigned char>(itr);
+        _hash *= 0x100000001b3ULL;
+    }
+    return _hash;
+}
+
+void
+insert_entries(entry_set_t& _entries, const fmodset_t& _data)
+{
+    for(const auto& itr : _data)
+        _entries.emplace(itr.start_address, itr.function_name);
+}
+}  // namespace
+
+size_t
+plan::size() const
+{
+    auto _entries = instrumented;
+    _entries.insert(coverage.begin(), coverage.end());
+    return _entries.size();
+}
+
+bool
+plan::contains(uint64_t _addr, std::string_view _name) const
+{
+    auto _entry = entry_t{ _addr, std::string{ _name } };
+    return instrumented.count(_entry) > 0 || coverage.count(_entry) > 0;
+}
+
+bool
+plan::is_instrumented(const module_function& _v) const
+{
+    return instrumented.count(entry_t{ _v.start_address, _v.function_name }) > 0;
+}
+
+bool
+plan::is_coverage(const module_function& _v) const
+{
+    return coverage.count(entry_t{ _v.start_address, _v.function_name }) > 0;
+}
+
+std::string
+get_default_directory()
+{
+    auto _base = tim::get_env<std::string>("XDG_CACHE_HOME", "");
+    if(_base.empty())
+        _base = JOIN('/', tim::get_env<std::string>("HOME", "/tmp"), ".cache");
+    return JOIN('/', _base, "rocprofsys", "instrument");
+}
+
+std::optional<std::string>
+get_build_id(const std::string& _filename)
+{
+    std::ifstream _ifs{ _filename, std::ios::binary };
+    if(!_ifs) return std::nullopt;
+
+    unsigned char _ident[EI_NIDENT] = {};
+    if(!_ifs.read(reinterpret_cast<char*>(_ident), EI_NIDENT)) return std::nullopt;
+    if(std::string_view{ reinterpret_cast<char*>(_ident), SELFMAG } != ELFMAG)
+        return std::nullopt;
+
+    if(_ident[EI_CLASS] == ELFCLASS64)
+        return read_build_id<Elf64_Ehdr, Elf64_Shdr, Elf64_Nhdr>(_ifs);
+    else if(_ident[EI_CLASS] == ELFCLASS32)
+        return read_build_id<Elf32_Ehdr, Elf32_Shdr, Elf32_Nhdr>(_ifs);
+    return std::nullopt;
+}
+
+std::string
+get_filename(const std::string& _dir, const std::string& _build_id,
+             const std::string& _options)
+{
+    std::stringstream _ss{};
+    _ss << _dir << "/" << _build_id << "-" << std::hex << std::setw(16)
+        << std::setfill('0') << get_hash(_options) << ".plan";
+    return _ss.str();
+}
+
+std::optional<plan>
+load(const std::string& _filename, const std::string& _options)
+{
+    std::ifstream _ifs{ _filename };
+    if(!_ifs) return std::nullopt;
+
+    auto _line = std::string{};
+    if(!std::getline(_ifs, _line) || _line != plan_version) return std::nullopt;
+    // guard against hash collisions and options containing newlines
+    if(!std::getline(_ifs, _line) || _line != JOIN(' ', "options", _options))
+        return std::nullopt;
+
+    auto _plan = plan{};
+    while(std::getline(_ifs, _line))
+    {
+        // <category> 0x<address> <name>
+        auto _first   = _line.find(' ');
+        auto _second  = std::string::npos;
+        auto _address = uint64_t{ 0 };
+        auto _pos     = size_t{ 0 };
+        if(_first != std::string::npos) _second = _line.find(' ', _first + 1);
+        if(_second != std::string::npos)
+        {
+            auto _token = _line.substr(_first + 1, _second - _first - 1);
+            try
+            {
+                _address = std::stoull(_token, &_pos, 16);
+            } catch(const std::exception&)
+            {
+                _pos = 0;
+            }
+            if(_pos != _token.size()) _pos = 0;
+        }
+        auto _category = (_pos == 0) ? std::string{} : _line.substr(0, _first);
+        if(_category != "instrumented" && _category != "coverage")
+        {
+            // a partial plan would silently drop functions, rebuild the whole plan
+            verbprintf(0, "Warning! Malformed entry in instrumentation plan '%s': %s. "
+                          "Ignoring the plan...\n",
+                       _filename.c_str(), _line.c_str());
+            return std::nullopt;
+        }
+
+        auto _entry = entry_t{ _address, _line.substr(_second + 1) };
+        if(_category == "instrumented")
+            _plan.instrumented.emplace(std::move(_entry));
+        else
+            _plan.coverage.emplace(std::move(_entry));
+    }
+
+    return _plan;
+}
+
+bool
+save(const std::string& _filename, const std::string& _options,
+     const fmodset_t& _instrumented, const fmodset_t& _coverage)
+{
+    auto _plan = plan{};
+    insert_entries(_plan.instrumented, _instrumented);
+    insert_entries(_plan.coverage, _coverage);
+
+    // write to a temporary file and rename it so that concurrent instances
+    // targeting the same binary never observe a partially written plan
+    auto _tmpname = JOIN('.', _filename, getpid(), "tmp");
+    {
+        std::ofstream _ofs{};
+        if(!filepath::open(_ofs, _tmpname)) return false;
+
+        _ofs << plan_version << '\n' << JOIN(' ', "options", _options) << '\n';
+        for(const auto& [_category, _entries] :
+            { std::make_pair("instrumented", &_plan.instrumented),
+              std::make_pair("coverage", &_plan.coverage) })
+        {
+            for(const auto& itr : *_entries)
+                _ofs << _category << " 0x" << std::hex << itr.first << std::dec << ' '
+                     << itr.second << '\n';
+        }
+        if(!_ofs) return false;
+    }
+
+    if(std::rename(_tmpname.c_str(), _filename.c_str()) != 0)
+    {
+        std::remove(_tmpname.c_str());
+        return false;
+    }
+    return true;
+}
+}  // namespace plan_cache
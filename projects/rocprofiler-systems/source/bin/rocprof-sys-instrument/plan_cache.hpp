@@ -0,0 +1,74 @@
+// MIT License
+//
+// Copyright (c) 2022-2025 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "fwd.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <utility>
+
+//  The instrumentation plan is the outcome of the function selection heuristics for a
+//  given binary and set of selection options. It is persisted in a cache directory so
+//  that repeated runs on the same binary (e.g. in a job array) only need to analyze the
+//  functions which end up being instrumented.
+namespace plan_cache
+{
+// functions are identified by their start address and name
+using entry_t     = std::pair<uint64_t, std::string>;
+using entry_set_t = std::set<entry_t>;
+
+struct plan
+{
+    entry_set_t instrumented = {};
+    entry_set_t coverage     = {};
+
+    size_t size() const;
+    bool   contains(uint64_t _addr, std::string_view _name) const;
+    bool   is_instrumented(const module_function&) const;
+    bool   is_coverage(const module_function&) const;
+};
+
+// $XDG_CACHE_HOME/rocprofsys/instrument or $HOME/.cache/rocprofsys/instrument
+std::string
+get_default_directory();
+
+// hex-encoded NT_GNU_BUILD_ID note of an ELF file, if it has one
+std::optional<std::string>
+get_build_id(const std::string& _filename);
+
+// name of the cache file for the build-id and the (serialized) selection options
+std::string
+get_filename(const std::string& _dir, const std::string& _build_id,
+             const std::string& _options);
+
+std::optional<plan>
+load(const std::string& _filename, const std::string& _options);
+
+bool
+save(const std::string& _filename, const std::string& _options,
+     const fmodset_t& _instrumented, const fmodset_t& _coverage);
+}  // namespace plan_cache
@@ -27,6 +27,7 @@
 #include "fwd.hpp"
 #include "internal_libs.hpp"
 #include "log.hpp"
+#include "plan_cache.hpp"
 
 #include <timemory/backends/process.hpp>
 #include <timemory/config.hpp>
@@ -53,6 +54,7 @@
 #include <iomanip>
 #include <iterator>
 #include <map>
+#include <optional>
 #include <regex>
 #include <stdexcept>
 #include <string>
@@ -111,6 +113,7 @@ bool   instr_print                  = false;
 bool   simulate                     = false;
 bool   include_uninstr              = false;
 bool   include_internal_linked_libs = false;
+bool   use_trace_handles            = false;
 int    verbose_level   = tim::get_env<int>("ROCPROFSYS_VERBOSE_INSTRUMENT", 0);
 int    num_log_entries = tim::get_env<int>(
     "ROCPROFSYS_LOG_COUNT", tim::get_env<bool>("ROCPROFSYS_CI", false) ? 20 : 50);
@@ -123,6 +126,7 @@ string_t prefer_library = {};
 //
 patch_pointer_t  bpatch                        = {};
 call_expr_t*     terminate_expr                = nullptr;
+variable_expr_t* trace_handle_base             = nullptr;
 snippet_vec_t    init_names                    = {};
 snippet_vec_t    fini_names                    = {};
 fmodset_t        available_module_functions    = {};
@@ -190,6 +194,7 @@ string_t                                   print_available      = {};
 string_t                                   print_overlapping    = {};
 strset_t                                   print_formats        = { "txt", "json" };
 std::string                                modfunc_dump_dir     = {};
+std::string                                plan_cache_dir       = {};
 auto regex_opts = std::regex_constants::egrep | std::regex_constants::optimize;
 
 std::string
@@ -733,6 +738,22 @@ main(int argc, char** argv)
                 fixed_module_functions.at(itr.second) = !_empty;
             }
         });
+    parser
+        .add_argument(
+            { "--plan-cache" },
+            "Cache the instrumentation plan (the functions selected for instrumentation) "
+            "in the given directory, keyed by the ELF build-id of the target and the "
+            "function selection options. Subsequent runs on the same binary with the "
+            "same options only analyze the functions in the cached plan. If a directory "
+            "is not provided, $XDG_CACHE_HOME/rocprofsys/instrument is used")
+        .min_count(0)
+        .max_count(1)
+        .dtype("filepath")
+        .action([](parser_t& p) {
+            plan_cache_dir = p.get<string_t>("plan-cache");
+            if(plan_cache_dir.empty())
+                plan_cache_dir = plan_cache::get_default_directory();
+        });
     parser
         .add_argument({ "--init-functions" },
                       "Initialization function(s) for supplemental instrumentation "
@@ -1287,14 +1308,34 @@ main(int argc, char** argv)
     //
     //----------------------------------------------------------------------------------//
     //
-    {
+    // the function selection options which key the instrumentation plan cache
+    auto _plan_options = strvec_t{};
+    {
+        const auto _regex_labels = std::map<const regexvec_t*, const char*>{
+            { &func_include, "function-include" },
+            { &func_exclude, "function-exclude" },
+            { &func_restrict, "function-restrict" },
+            { &caller_include, "caller-include" },
+            { &func_internal_include, "internal-function-include" },
+            { &file_include, "module-include" },
+            { &file_exclude, "module-exclude" },
+            { &file_restrict, "module-restrict" },
+            { &file_internal_include, "internal-module-include" },
+            { &instruction_exclude, "instruction-exclude" },
+        };
+
         //  Helper function for adding regex expressions
-        auto add_regex = [](auto& regex_array, const string_t& regex_expr) {
+        auto add_regex = [&_plan_options, &_regex_labels](auto&           regex_array,
+                                                          const string_t& regex_expr) {
             ROCPROFSYS_ADD_DETAILED_LOG_ENTRY("", "Adding regular expression \"",
                                               regex_expr, "\" to regex_array@",
                                               &regex_array);
             if(!regex_expr.empty())
+            {
                 regex_array.emplace_back(std::regex(regex_expr, regex_opts));
+                _plan_options.emplace_back(
+                    JOIN('=', _regex_labels.at(&regex_array), regex_expr));
+            }
         };
 
         add_regex(func_include, tim::get_env<string_t>("ROCPROFSYS_REGEX_INCLUDE", ""));
@@ -1486,6 +1527,76 @@ main(int argc, char** argv)
 
     if(app_modules) process_modules(*app_modules);
 
+    //----------------------------------------------------------------------------------//
+    //
+    //  Load the cached instrumentation plan for the binary and selection options
+    //
+    //----------------------------------------------------------------------------------//
+    auto _plan      = std::optional<plan_cache::plan>{};
+    auto _plan_file = std::string{};
+    auto _plan_spec = std::string{};
+
+    if(!plan_cache_dir.empty())
+    {
+        auto _is_fixed = std::any_of(fixed_module_functions.begin(),
+                                     fixed_module_functions.end(),
+                                     [](const auto& itr) { return itr.second; });
+        auto _build_id = plan_cache::get_build_id(mutname);
+        if(instr_mode == "sampling" || _is_fixed)
+        {
+            verbprintf(1, "Instrumentation plan cache is not used in sampling mode or "
+                          "with '--load-instr'...\n");
+        }
+        else if(!_build_id)
+        {
+            verbprintf(0,
+                       "Warning! No build-id found in '%s'. Instrumentation plan "
+                       "cache is disabled...\n",
+                       mutname.c_str());
+        }
+        else
+        {
+            auto _ss = std::stringstream{};
+            // plans from another build of the instrumenter may select differently
+            _ss << "version=" << ROCPROFSYS_VERSION_STRING
+                << ";revision=" << ROCPROFSYS_GIT_REVISION << ";mode=" << instr_mode
+                << ";main=" << main_fname
+                << ";coverage=" << static_cast<int>(coverage_mode)
+                << ";loops=" << loop_level_instr
+                << ";min-instructions=" << min_instructions
+                << ";min-address-range=" << min_address_range
+                << ";min-instructions-loop=" << min_loop_instructions
+                << ";min-address-range-loop=" << min_loop_address_range
+                << ";dynamic-callsites=" << instr_dynamic_callsites
+                << ";traps=" << instr_traps << ";loop-traps=" << instr_loop_traps
+                << ";allow-overlapping=" << allow_overlapping
+                << ";parse-all-modules=" << parse_all_modules
+                << ";all-functions=" << include_uninstr
+                << ";internal-library-deps=" << include_internal_linked_libs;
+            for(const auto& itr : enabled_linkage)
+                _ss << ";linkage=" << static_cast<int>(itr);
+            for(const auto& itr : enabled_visibility)
+                _ss << ";visibility=" << static_cast<int>(itr);
+            for(const auto& itr : _plan_options)
+                _ss << ";" << itr;
+
+            filepath::makedir(plan_cache_dir);
+            _plan_spec = _ss.str();
+            _plan_file = plan_cache::get_filename(plan_cache_dir, *_build_id, _plan_spec);
+            _plan      = plan_cache::load(_plan_file, _plan_spec);
+            if(_plan)
+            {
+                verbprintf(0, "Using instrumentation plan '%s' (%zu functions)...\n",
+                           _plan_file.c_str(), _plan->size());
+            }
+            else
+            {
+                verbprintf(1, "No instrumentation plan found in '%s'...\n",
+                           _plan_file.c_str());
+            }
+        }
+    }
+
     //----------------------------------------------------------------------------------//
     //
     //  Generate a log of all the available procedures and modules
@@ -1517,68 +1628,109 @@ main(int argc, char** argv)
         }
     };
 
-    if(app_functions && !app_functions->empty())
-    {
-        for(auto* itr : *app_functions)
+    // with a cached instrumentation plan, only the functions in the plan are analyzed
+    auto _in_plan = [&_plan](procedure_t* _func) {
+        if(!_plan) return true;
+        auto _range = std::pair<module_function::address_t, module_function::address_t>{};
+        if(!_func->getAddressRange(_range.first, _range.second)) _range.first = 0;
+        return _plan->contains(_range.first, get_name(_func));
+    };
+
+    auto _parse_procedures = [&]() {
+        if(app_functions && !app_functions->empty())
         {
-            if(itr->getModule())
+            for(auto* itr : *app_functions)
             {
-                functions.emplace(itr);
-                modules.emplace(itr->getModule());
+                if(itr->getModule())
+                {
+                    functions.emplace(itr);
+                    modules.emplace(itr->getModule());
+                }
             }
-        }
-        verbprintf(2, "Adding %zu procedures found in the app image...\n",
-                   functions.size());
-        for(auto* itr : functions)
-        {
-            if(itr->isInstrumentable() || (simulate && include_uninstr))
+            verbprintf(2, "Adding %zu procedures found in the app image...\n",
+                       functions.size());
+            for(auto* itr : functions)
             {
-                module_t* mod    = itr->getModule();
-                auto      _modfn = module_function{ mod, itr };
-                module_names.insert(_modfn.module_name);
-                _insert_module_function(available_module_functions, _modfn);
-                _add_overlapping(mod, itr);
+                if(!_in_plan(itr)) continue;
+                if(itr->isInstrumentable() || (simulate && include_uninstr))
+                {
+                    module_t* mod    = itr->getModule();
+                    auto      _modfn = module_function{ mod, itr };
+                    module_names.insert(_modfn.module_name);
+                    _insert_module_function(available_module_functions, _modfn);
+                    _add_overlapping(mod, itr);
+                }
             }
         }
-    }
-    else
-    {
-        verbprintf(
-            0, "Warning! No functions in application. Enabling parsing all modules...\n");
-        parse_all_modules = true;
-    }
-
-    if(parse_all_modules && app_modules && !app_modules->empty())
-    {
-        for(auto* itr : *app_modules)
-            modules.emplace(itr);
+        else
+        {
+            verbprintf(0, "Warning! No functions in application. Enabling parsing all "
+                          "modules...\n");
+            parse_all_modules = true;
+        }
 
-        verbprintf(2,
-                   "Adding the procedures from %zu modules found in the app image...\n",
-                   modules.size());
-        for(auto* itr : modules)
+        if(parse_all_modules && app_modules && !app_modules->empty())
         {
-            auto* procedures = itr->getProcedures(include_uninstr);
-            if(procedures)
+            for(auto* itr : *app_modules)
+                modules.emplace(itr);
+
+            verbprintf(
+                2, "Adding the procedures from %zu modules found in the app image...\n",
+                modules.size());
+            for(auto* itr : modules)
             {
-                verbprintf(2, "Processing %zu procedures found in the %s module...\n",
-                           procedures->size(), get_name(itr).data());
-                for(auto* pitr : *procedures)
+                auto* procedures = itr->getProcedures(include_uninstr);
+                if(procedures)
                 {
-                    if(!pitr->isInstrumentable() && !simulate && !include_uninstr)
-                        continue;
-                    functions.emplace(pitr);
-                    auto _modfn = module_function{ itr, pitr };
-                    module_names.insert(_modfn.module_name);
-                    _insert_module_function(available_module_functions, _modfn);
-                    _add_overlapping(itr, pitr);
+                    verbprintf(2, "Processing %zu procedures found in the %s module...\n",
+                               procedures->size(), get_name(itr).data());
+                    for(auto* pitr : *procedures)
+                    {
+                        if(!pitr->isInstrumentable() && !simulate && !include_uninstr)
+                            continue;
+                        if(!_in_plan(pitr)) continue;
+                        functions.emplace(pitr);
+                        auto _modfn = module_function{ itr, pitr };
+                        module_names.insert(_modfn.module_name);
+                        _insert_module_function(available_module_functions, _modfn);
+                        _add_overlapping(itr, pitr);
+                    }
                 }
             }
         }
-    }
-    else if(parse_all_modules)
+        else if(parse_all_modules)
+        {
+            verbprintf(0, "Warning! No modules in application...\n");
+        }
+    };
+
+    _parse_procedures();
+
+    if(_plan)
     {
-        verbprintf(0, "Warning! No modules in application...\n");
+        // if the plan references functions which were not found, e.g. a shared library
+        // in the address space changed, fall back to the full analysis
+        auto _found = plan_cache::entry_set_t{};
+        for(const auto& itr : available_module_functions)
+        {
+            if(_plan->contains(itr.start_address, itr.function_name))
+                _found.emplace(itr.start_address, itr.function_name);
+        }
+
+        if(_found.size() < _plan->size())
+        {
+            verbprintf(0,
+                       "Warning! Only %zu of %zu functions in the instrumentation plan "
+                       "'%s' were found. Ignoring the cached plan...\n",
+                       _found.size(), _plan->size(), _plan_file.c_str());
+            _plan.reset();
+            functions.clear();
+            modules.clear();
+            module_names.clear();
+            available_module_functions.clear();
+            overlapping_module_functions.clear();
+            _parse_procedures();
+        }
     }
 
     verbprintf(1, "\n");
@@ -1757,6 +1909,9 @@ main(int argc, char** argv)
     auto* mpi_func       = find_function(app_image, "rocprofsys_set_mpi");
     auto* entr_trace     = find_function(app_image, "rocprofsys_push_trace");
     auto* exit_trace     = find_function(app_image, "rocprofsys_pop_trace");
+    auto* reg_handles    = find_function(app_image, "rocprofsys_register_trace_handles");
+    auto* entr_handle    = find_function(app_image, "rocprofsys_push_trace_handle");
+    auto* exit_handle    = find_function(app_image, "rocprofsys_pop_trace_handle");
     auto* reg_src_func   = find_function(app_image, "rocprofsys_register_source");
     auto* reg_cov_func   = find_function(app_image, "rocprofsys_register_coverage");
     auto* set_instr_func = find_function(app_image, "rocprofsys_set_instrumented");
@@ -1892,6 +2047,27 @@ main(int argc, char** argv)
         }
     }
 
+    // the handle based trace functions let the runtime skip hashing the region name.
+    // The handles of this module are offset by a base which the init snippets obtain
+    // from the runtime, so separately instrumented modules never share handles.
+    use_trace_handles =
+        (reg_handles != nullptr && entr_handle != nullptr && exit_handle != nullptr);
+    if(use_trace_handles)
+    {
+        auto* _type = app_image->findType("int");
+        if(_type) trace_handle_base = addr_space->malloc(*_type, "rocprofsys_trace_handle_base");
+        int _base = 0;
+        if(!trace_handle_base || !trace_handle_base->writeValue(&_base, sizeof(_base), false))
+        {
+            verbprintf(0, "Warning! Failed to allocate the trace handle base. Regions are "
+                          "identified by name...\n");
+            trace_handle_base = nullptr;
+            use_trace_handles = false;
+        }
+    }
+    auto* func_entr_trace = (use_trace_handles) ? entr_handle : entr_trace;
+    auto* func_exit_trace = (use_trace_handles) ? exit_handle : exit_trace;
+
     //----------------------------------------------------------------------------------//
     //
     //  Find the entry/exit point of either the main (if executable) or the _init
@@ -1952,6 +2128,11 @@ main(int argc, char** argv)
     auto umpi_call      = umpi_call_args.get(mpi_func);
     auto set_instr_call = set_instr_args.get(set_instr_func);
     auto main_beg_call  = main_call_args.get(entr_trace);
+    auto reg_hdls_call  = none_call_args.get(reg_handles);
+    auto reg_hdls_expr  = std::shared_ptr<arith_expr_t>{};
+    if(use_trace_handles && reg_hdls_call)
+        reg_hdls_expr = std::make_shared<arith_expr_t>(BPatch_assign, *trace_handle_base,
+                                                       *reg_hdls_call);
 
     verbprintf(2, "Done\n");
 
@@ -2014,6 +2195,9 @@ main(int argc, char** argv)
         init_names.emplace(init_names.begin(), set_instr_call.get());
     }
 
+    // reserve the trace handles of this module before any instrumented region runs
+    if(reg_hdls_expr) init_names.emplace_back(reg_hdls_expr.get());
+
     for(const auto& itr : env_variables)
     {
         if(itr) init_names.emplace_back(itr.get());
@@ -2051,7 +2235,7 @@ main(int argc, char** argv)
     {
         for(const auto& itr : available_module_functions)
         {
-            if(itr.should_instrument())
+            if((_plan) ? _plan->is_instrumented(itr) : itr.should_instrument())
             {
                 _insert_module_function(instrumented_module_functions, itr);
             }
@@ -2061,7 +2245,7 @@ main(int argc, char** argv)
             }
             if(coverage_mode != CODECOV_NONE)
             {
-                if(itr.should_coverage_instrument())
+                if((_plan) ? _plan->is_coverage(itr) : itr.should_coverage_instrument())
                     _insert_module_function(coverage_module_functions, itr);
             }
             if(itr.is_overlapping())
@@ -2088,6 +2272,20 @@ main(int argc, char** argv)
         }
     }
 
+    if(!_plan_file.empty() && !_plan)
+    {
+        if(plan_cache::save(_plan_file, _plan_spec, instrumented_module_functions,
+                            coverage_module_functions))
+        {
+            verbprintf(1, "Saved instrumentation plan to '%s'...\n", _plan_file.c_str());
+        }
+        else
+        {
+            verbprintf(0, "Warning! Failed to save instrumentation plan to '%s'\n",
+                       _plan_file.c_str());
+        }
+    }
+
     //----------------------------------------------------------------------------------//
     //
     //  Insert the initialization and finalization routines into the main entry and
@@ -2207,7 +2405,7 @@ main(int argc, char** argv)
         for(const auto& itr : instrumented_module_functions)
         {
             if(itr.function == main_func) continue;
-            auto _count = itr(addr_space, entr_trace, exit_trace);
+            auto _count = itr(addr_space, func_entr_trace, func_exit_trace);
             _pass_info[itr.module_name].first += _count.first;
             _pass_info[itr.module_name].second += _count.second;
 
@@ -2290,22 +2488,22 @@ main(int argc, char** argv)
             verbprintf(
                 1,
                 "Using insertion set failed. Restarting with individual insertion...\n");
-            auto _execute_batch = [&addr_space, &entr_trace, &exit_trace](size_t _beg,
-                                                                          size_t _end) {
+            auto _execute_batch = [&addr_space, &func_entr_trace,
+                                   &func_exit_trace](size_t _beg, size_t _end) {
                 verbprintf(1, "Instrumenting batch of functions [%lu, %lu)\n",
                            (unsigned long) _beg, (unsigned long) _end);
                 addr_space->beginInsertionSet();
                 auto itr = instrumented_module_functions.begin();
                 std::advance(itr, _beg);
                 for(size_t i = _beg; i < _end; ++i, ++itr)
-                    (*itr)(addr_space, entr_trace, exit_trace);
+                    (*itr)(addr_space, func_entr_trace, func_exit_trace);
                 bool _modified = true;
                 bool _success  = addr_space->finalizeInsertionSet(true, &_modified);
                 return _success;
             };
 
-            auto execute_batch = [&_execute_batch, &addr_space, &entr_trace,
-                                  &exit_trace](size_t _beg) {
+            auto execute_batch = [&_execute_batch, &addr_space, &func_entr_trace,
+                                  &func_exit_trace](size_t _beg) {
                 if(!_execute_batch(_beg, _beg + batch_size))
                 {
                     verbprintf(1,
@@ -2317,7 +2515,7 @@ main(int argc, char** argv)
                     std::advance(itr, _beg);
                     for(size_t i = _beg; i < _beg + batch_size && itr != _end; ++i, ++itr)
                     {
-                        (*itr)(addr_space, entr_trace, exit_trace);
+                        (*itr)(addr_space, func_entr_trace, func_exit_trace);
                     }
                 }
                 return _beg + batch_size;
@@ -72,6 +72,14 @@ get_snippet(const Tp& arg)
 //
 //======================================================================================//
 //
+inline snippet_pointer_t
+get_snippet(snippet_pointer_t arg)
+{
+    return arg;
+}
+//
+//======================================================================================//
+//
 template <typename... Args>
 snippet_pointer_vec_t
 get_snippets(Args&&... args)
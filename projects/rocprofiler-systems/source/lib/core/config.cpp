@@ -2555,20 +2555,25 @@ get_tmp_file(std::string _basename, std::string _ext)
     static auto _existing_files =
         std::unordered_map<std::string, std::shared_ptr<tmp_file>>{};
     static std::mutex            _mutex{};
+    static bool                  _fini_registered = false;
     std::unique_lock<std::mutex> _lk{ _mutex };
 
-    cfg_fini_callbacks.emplace_back([]() {
-        for(auto itr : _existing_files)
-        {
-            if(itr.second)
+    if(!_fini_registered)
+    {
+        _fini_registered = true;
+        cfg_fini_callbacks.emplace_back([]() {
+            for(auto itr : _existing_files)
             {
-                itr.second->close();
-                itr.second->remove();
-                itr.second.reset();
+                if(itr.second)
+                {
+                    itr.second->close();
+                    itr.second->remove();
+                    itr.second.reset();
+                }
             }
-        }
-        _existing_files.clear();
-    });
+            _existing_files.clear();
+        });
+    }
 
     auto _cfg          = settings::compose_filename_config{};
     _cfg.use_suffix    = true;
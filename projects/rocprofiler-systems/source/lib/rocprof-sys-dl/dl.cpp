@@ -307,6 +307,12 @@ struct ROCPROFSYS_INTERNAL_API indirect
         ROCPROFSYS_DLSYM(rocprofsys_set_mpi_f, m_omnihandle, "rocprofsys_set_mpi");
         ROCPROFSYS_DLSYM(rocprofsys_push_trace_f, m_omnihandle, "rocprofsys_push_trace");
         ROCPROFSYS_DLSYM(rocprofsys_pop_trace_f, m_omnihandle, "rocprofsys_pop_trace");
+        ROCPROFSYS_DLSYM(rocprofsys_register_trace_handles_f, m_omnihandle,
+                         "rocprofsys_register_trace_handles");
+        ROCPROFSYS_DLSYM(rocprofsys_push_trace_handle_f, m_omnihandle,
+                         "rocprofsys_push_trace_handle");
+        ROCPROFSYS_DLSYM(rocprofsys_pop_trace_handle_f, m_omnihandle,
+                         "rocprofsys_pop_trace_handle");
         ROCPROFSYS_DLSYM(rocprofsys_push_region_f, m_omnihandle,
                          "rocprofsys_push_region");
         ROCPROFSYS_DLSYM(rocprofsys_pop_region_f, m_omnihandle, "rocprofsys_pop_region");
@@ -416,6 +422,9 @@ public:
     void (*rocprofsys_register_coverage_f)(const char*, const char*, size_t)   = nullptr;
     void (*rocprofsys_push_trace_f)(const char*)                               = nullptr;
     void (*rocprofsys_pop_trace_f)(const char*)                                = nullptr;
+    uint32_t (*rocprofsys_register_trace_handles_f)(void)                      = nullptr;
+    void (*rocprofsys_push_trace_handle_f)(uint32_t, const char*)              = nullptr;
+    void (*rocprofsys_pop_trace_handle_f)(uint32_t, const char*)               = nullptr;
     int (*rocprofsys_push_region_f)(const char*)                               = nullptr;
     int (*rocprofsys_pop_region_f)(const char*)                                = nullptr;
     int (*rocprofsys_push_category_region_f)(rocprofsys_category_t, const char*,
@@ -705,6 +714,41 @@ extern "C"
         }
     }
 
+    uint32_t rocprofsys_register_trace_handles(void)
+    {
+        // called by the init snippets of an instrumented module before any of its
+        // regions, so it is forwarded even when the library is not active yet
+        return ROCPROFSYS_DL_INVOKE(get_indirect().rocprofsys_register_trace_handles_f);
+    }
+
+    void rocprofsys_push_trace_handle(uint32_t handle, const char* name)
+    {
+        if(!dl::get_active()) return;
+        if(dl::get_thread_enabled())
+        {
+            ROCPROFSYS_DL_INVOKE(get_indirect().rocprofsys_push_trace_handle_f, handle,
+                                 name);
+        }
+        else
+        {
+            ++dl::get_thread_count();
+        }
+    }
+
+    void rocprofsys_pop_trace_handle(uint32_t handle, const char* name)
+    {
+        if(!dl::get_active()) return;
+        if(dl::get_thread_enabled())
+        {
+            ROCPROFSYS_DL_INVOKE(get_indirect().rocprofsys_pop_trace_handle_f, handle,
+                                 name);
+        }
+        else
+        {
+            if(dl::get_thread_count()-- == 0) rocprofsys_user_start_thread_trace_dl();
+        }
+    }
+
     int rocprofsys_push_region(const char* name)
     {
         if(!dl::get_active()) return 0;
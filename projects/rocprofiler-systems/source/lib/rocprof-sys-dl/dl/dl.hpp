@@ -75,6 +75,11 @@ extern "C"
     void rocprofsys_set_instrumented(int) ROCPROFSYS_PUBLIC_API;
     void rocprofsys_push_trace(const char* name) ROCPROFSYS_PUBLIC_API;
     void rocprofsys_pop_trace(const char* name) ROCPROFSYS_PUBLIC_API;
+    uint32_t rocprofsys_register_trace_handles(void) ROCPROFSYS_PUBLIC_API;
+    void rocprofsys_push_trace_handle(uint32_t handle,
+                                      const char* name) ROCPROFSYS_PUBLIC_API;
+    void rocprofsys_pop_trace_handle(uint32_t handle,
+                                     const char* name) ROCPROFSYS_PUBLIC_API;
     int  rocprofsys_push_region(const char*) ROCPROFSYS_PUBLIC_API;
     int  rocprofsys_pop_region(const char*) ROCPROFSYS_PUBLIC_API;
     int  rocprofsys_push_category_region(rocprofsys_category_t, const char*,
@@ -38,6 +38,24 @@ rocprofsys_pop_trace(const char* _name)
     rocprofsys_pop_trace_hidden(_name);
 }
 
+extern "C" uint32_t
+rocprofsys_register_trace_handles(void)
+{
+    return rocprofsys_register_trace_handles_hidden();
+}
+
+extern "C" void
+rocprofsys_push_trace_handle(uint32_t _handle, const char* _name)
+{
+    rocprofsys_push_trace_handle_hidden(_handle, _name);
+}
+
+extern "C" void
+rocprofsys_pop_trace_handle(uint32_t _handle, const char* _name)
+{
+    rocprofsys_pop_trace_handle_hidden(_handle, _name);
+}
+
 extern "C" int
 rocprofsys_push_region(const char* _name)
 {
@@ -28,6 +28,7 @@
 #include <timemory/compat/macros.h>
 
 #include <cstddef>
+#include <cstdint>
 
 // forward decl of the API
 extern "C"
@@ -59,6 +60,15 @@ extern "C"
     /// stops an instrumentation region
     void rocprofsys_pop_trace(const char*) ROCPROFSYS_PUBLIC_API;
 
+    /// reserves the range of trace handles of an instrumented module and returns its base
+    uint32_t rocprofsys_register_trace_handles(void) ROCPROFSYS_PUBLIC_API;
+
+    /// starts an instrumentation region using a handle assigned by rocprof-sys-instrument
+    void rocprofsys_push_trace_handle(uint32_t, const char*) ROCPROFSYS_PUBLIC_API;
+
+    /// stops an instrumentation region using a handle assigned by rocprof-sys-instrument
+    void rocprofsys_pop_trace_handle(uint32_t, const char*) ROCPROFSYS_PUBLIC_API;
+
     /// starts an instrumentation region (user-defined)
     int rocprofsys_push_region(const char*) ROCPROFSYS_PUBLIC_API;
 
@@ -103,6 +113,10 @@ extern "C"
     void rocprofsys_set_mpi_hidden(bool, bool) ROCPROFSYS_HIDDEN_API;
     void rocprofsys_push_trace_hidden(const char*) ROCPROFSYS_HIDDEN_API;
     void rocprofsys_pop_trace_hidden(const char*) ROCPROFSYS_HIDDEN_API;
+    uint32_t rocprofsys_register_trace_handles_hidden(void) ROCPROFSYS_HIDDEN_API;
+    void rocprofsys_push_trace_handle_hidden(uint32_t,
+                                             const char*) ROCPROFSYS_HIDDEN_API;
+    void rocprofsys_pop_trace_handle_hidden(uint32_t, const char*) ROCPROFSYS_HIDDEN_API;
     void rocprofsys_push_region_hidden(const char*) ROCPROFSYS_HIDDEN_API;
     void rocprofsys_pop_region_hidden(const char*) ROCPROFSYS_HIDDEN_API;
     void rocprofsys_push_category_region_hidden(rocprofsys_category_t, const char*,
@@ -100,6 +100,11 @@ struct category_region : comp::base<category_region<CategoryT>, void>
     template <typename... OptsT, typename... Args>
     static void start(std::string_view name, Args&&...);
 
+    // start a region whose name was already added to the hash registry, i.e.
+    // name is the identifier returned by tim::get_hash_identifier_fast(hash)
+    template <typename... OptsT, typename... Args>
+    static void start(tim::hash_value_t hash, std::string_view name, Args&&...);
+
     template <typename... OptsT, typename... Args>
     static void stop(std::string_view name, Args&&...);
 
@@ -120,12 +125,34 @@ struct category_region : comp::base<category_region<CategoryT>, void>
 
     template <typename... OptsT, typename... Args>
     static void audit(quirk::config<OptsT...>, Args&&...);
+
+private:
+    template <bool HashedV, typename... OptsT, typename... Args>
+    static void start_region(tim::hash_value_t, std::string_view, Args&&...);
 };
 
 template <typename CategoryT>
 template <typename... OptsT, typename... Args>
 void
 category_region<CategoryT>::start(std::string_view name, Args&&... args)
+{
+    start_region<false, OptsT...>(0, name, std::forward<Args>(args)...);
+}
+
+template <typename CategoryT>
+template <typename... OptsT, typename... Args>
+void
+category_region<CategoryT>::start(tim::hash_value_t hash, std::string_view name,
+                                  Args&&... args)
+{
+    start_region<true, OptsT...>(hash, name, std::forward<Args>(args)...);
+}
+
+template <typename CategoryT>
+template <bool HashedV, typename... OptsT, typename... Args>
+void
+category_region<CategoryT>::start_region(tim::hash_value_t _hash, std::string_view name,
+                                         Args&&... args)
 {
     // skip if category is disabled
     if(tracing::category_push_disabled<CategoryT>()) return;
@@ -165,8 +192,11 @@ category_region<CategoryT>::start(std::string_view name, Args&&... args)
         ++tracing::push_count();
     }
 
-    auto _hash = tim::add_hash_id(name);
-    name       = tim::get_hash_identifier_fast(_hash);
+    if constexpr(!HashedV)
+    {
+        _hash = tim::add_hash_id(name);
+        name  = tim::get_hash_identifier_fast(_hash);
+    }
 
     if constexpr(_ct_use_causal)
     {
@@ -180,7 +210,7 @@ category_region<CategoryT>::start(std::string_view name, Args&&... args)
     {
         if(get_use_timemory())
         {
-            tracing::push_timemory(CategoryT{}, name, std::forward<Args>(args)...);
+            tracing::push_timemory(CategoryT{}, _hash, std::forward<Args>(args)...);
         }
     }
 
@@ -523,35 +523,44 @@ start_duration_thread()
     }
 }
 
-auto&
-get_offload_file()
+using sampler_bundle_t = typename sampler_t::bundle_type;
+using sampler_buffer_t = tim::data_storage::ring_buffer<sampler_bundle_t>;
+
+// Offloaded sample buffers are appended to a segment file owned by the sampled
+// thread. A sampler is only ever serviced by one allocator so appending to a
+// segment needs no lock, and each segment is replayed sequentially. The file is
+// created on the first offload of the thread and is only open while a buffer is
+// appended, so threads that never offload hold no file descriptor.
+struct offload_segment
 {
-    static auto _v = []() {
-        auto _tmp_v = config::get_tmp_file("sampling");
-        if(get_use_tmp_files())
-        {
-            auto _success = _tmp_v->open();
-            ROCPROFSYS_CI_FAIL(!_success,
-                               "Error opening sampling offload temporary file '%s'\n",
-                               _tmp_v->filename.c_str());
-        }
-        return _tmp_v;
-    }();
-    return _v;
-}
+    std::shared_ptr<tmp_file> file  = {};
+    size_t                    count = 0;
+};
+
+using offload_segment_instances = thread_data<offload_segment, category::sampling>;
 
-locking::atomic_mutex&
-get_offload_mutex()
+unique_ptr_t<offload_segment>&
+get_offload_segment(int64_t _tid)
 {
-    static auto _v = locking::atomic_mutex{};
-    return _v;
+    return offload_segment_instances::instance(construct_on_thread{ _tid });
 }
 
-using sampler_bundle_t = typename sampler_t::bundle_type;
-using sampler_buffer_t = tim::data_storage::ring_buffer<sampler_bundle_t>;
-using pos_type         = typename std::fstream::pos_type;
+void
+remove_offload_segments()
+{
+    auto* _segments = offload_segment_instances::get();
+    if(!_segments) return;
 
-auto offload_seq_data = std::unordered_map<int64_t, std::set<pos_type>>{};
+    for(auto& itr : *_segments)
+    {
+        if(itr && itr->file)
+        {
+            itr->file->remove();
+            itr->file.reset();
+            itr->count = 0;
+        }
+    }
+}
 
 void
 offload_buffer(int64_t _seq, sampler_buffer_t&& _buf)
@@ -560,29 +569,35 @@ offload_buffer(int64_t _seq, sampler_buffer_t&& _buf)
         << "Error! sampling allocator tries to offload buffer of samples but "
            "rocprof-sys was configured to not use temporary files\n";
 
-    // use homemade atomic_mutex/atomic_lock since contention will be low
-    // and using pthread_lock might trigger our wrappers
-    auto  _lk   = locking::atomic_lock{ get_offload_mutex() };
-    auto& _file = get_offload_file();
+    auto& _segment = get_offload_segment(_seq);
+    if(!_segment->file) _segment->file = config::get_tmp_file(JOIN('-', "sampling", _seq));
 
-    ROCPROFSYS_REQUIRE(_file)
+    ROCPROFSYS_REQUIRE(_segment->file)
         << "Error! sampling allocator tried to offload buffer of samples for thread "
-        << _seq << " but the offload file does not exist\n";
+        << _seq << " but the offload file could not be created\n";
 
     ROCPROFSYS_VERBOSE_F(2, "Offloading %zu samples for thread %li to %s...\n",
-                         _buf.count(), _seq, _file->filename.c_str());
-    auto& _fs = _file->stream;
+                         _buf.count(), _seq, _segment->file->filename.c_str());
 
-    ROCPROFSYS_REQUIRE(_fs.good()) << "Error! temporary file for offloading buffer is in "
-                                      "an invalid state during offload for thread "
-                                   << _seq << "\n";
+    auto _mode = std::ios::binary | std::ios::out |
+                 ((_segment->count == 0) ? std::ios::trunc : std::ios::app);
+    auto _success = _segment->file->open(_mode);
+    ROCPROFSYS_REQUIRE(_success) << "Error! temporary file '" << _segment->file->filename
+                                 << "' for offloading buffer could not be opened for thread "
+                                 << _seq << "\n";
 
-    offload_seq_data[_seq].emplace(_fs.tellg());
-    _fs.write(reinterpret_cast<char*>(&_seq), sizeof(_seq));
-    auto _data = std::move(_buf);
+    auto& _fs   = _segment->file->stream;
+    auto  _data = std::move(_buf);
     _data.save(_fs);
     _data.destroy();
     _buf.destroy();
+
+    ROCPROFSYS_REQUIRE(_fs.good()) << "Error! temporary file for offloading buffer is in "
+                                      "an invalid state during offload for thread "
+                                   << _seq << "\n";
+
+    _segment->file->close();
+    ++_segment->count;
 }
 
 auto
@@ -596,17 +611,17 @@ load_offload_buffer(int64_t _thread_idx)
         return _data;
     }
 
-    // use homemade atomic_mutex/atomic_lock since contention will be low
-    // and using pthread_lock might trigger our wrappers
-    auto  _lk   = locking::atomic_lock{ get_offload_mutex() };
-    auto& _file = get_offload_file();
+    auto& _segment = get_offload_segment(_thread_idx);
+    auto& _file    = _segment->file;
     if(!_file)
     {
         ROCPROFSYS_WARNING_F(
-            0, "[sampling] returning no data because the offload file no longer exists");
+            2, "[sampling] returning no data because the offload file does not exist");
         return _data;
     }
 
+    if(_segment->count == 0) return _data;
+
     auto& _fs = _file->stream;
 
     if(_fs.is_open()) _fs.close();
@@ -617,27 +632,21 @@ load_offload_buffer(int64_t _thread_idx)
         return _data;
     }
 
-    if(offload_seq_data.count(_thread_idx) == 0) return _data;
-
     size_t _count = 0;
-    for(auto itr : offload_seq_data.at(_thread_idx))
+    _data.reserve(_segment->count);
+    for(size_t i = 0; i < _segment->count; ++i)
     {
-        _fs.seekg(itr);  // set to the absolute position
-
-        int64_t _seq = 0;
-        _fs.read(reinterpret_cast<char*>(&_seq), sizeof(_seq));
-        if(_fs.eof()) break;
-
         sampler_buffer_t _buffer{};
         _buffer.load(_fs);
-
-        if(_seq != _thread_idx)
+        if(!_fs)
         {
-            ROCPROFSYS_WARNING_F(
-                0,
-                "[sampling] file position %zu returned %zi instead of (expected) %zi\n",
-                static_cast<uintptr_t>(itr), _seq, _thread_idx);
-            continue;
+            ROCPROFSYS_WARNING_F(0,
+                                 "[sampling] %s is truncated: read %zu of %zu buffers "
+                                 "for thread %li\n",
+                                 _file->filename.c_str(), i, _segment->count,
+                                 _thread_idx);
+            _buffer.destroy();
+            break;
         }
         _count += _buffer.count();
         _data.emplace_back(std::move(_buffer));
@@ -797,11 +806,7 @@ configure(bool _setup, int64_t _tid)
                 _tid, threading::get_sys_tid() });
         }
 
-        if(get_use_tmp_files())
-        {
-            auto _file = get_offload_file();
-            if(_file && *_file) _sampler->set_offload(&offload_buffer);
-        }
+        if(get_use_tmp_files()) _sampler->set_offload(&offload_buffer);
 
         static_assert(tim::trait::buffer_size<sampling::sampler_t>::value > 0,
                       "Error! Zero buffer size");
@@ -1140,7 +1145,7 @@ post_process()
     ROCPROFSYS_VERBOSE(3 || get_debug_sampling(),
                        "Destroying samplers and allocators...\n");
 
-    get_offload_file().reset();  // remove the temporary file
+    remove_offload_segments();  // remove the temporary files
 
     for(size_t i = 0; i < thread_info::get_peak_num_threads(); ++i)
         get_sampler(i).reset();
@@ -1150,12 +1155,6 @@ post_process()
         if(itr) itr.reset();
     }
 
-    if(get_use_tmp_files() && get_offload_file())
-    {
-        get_offload_file()->remove();
-        get_offload_file().reset();
-    }
-
     ROCPROFSYS_VERBOSE(1 || get_debug_sampling(),
                        "Collected %zu samples from %zu threads... %zu samples out of %zu "
                        "were taken while within instrumented routines\n",
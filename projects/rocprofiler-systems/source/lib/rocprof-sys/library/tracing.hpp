@@ -311,6 +311,23 @@ push_timemory(CategoryT, std::string_view name, Args&&... args)
     }
 }
 
+// same as above for a name that was already added to the hash registry
+template <typename CategoryT, typename... Args>
+inline void
+push_timemory(CategoryT, hash_value_t _hash, Args&&... args)
+{
+    // skip if category is disabled
+    if(category_push_disabled<CategoryT>()) return;
+
+    auto& _data = tracing::get_instrumentation_bundles();
+    if(ROCPROFSYS_LIKELY(_data != nullptr))
+    {
+        _data->construct(_hash)->start(std::forward<Args>(args)...);
+        // increment the profile stack
+        ++get_profile_stack<CategoryT>();
+    }
+}
+
 template <typename CategoryT>
 inline std::pair<instrumentation_bundle_t*, size_t>
 get_timemory(CategoryT, std::string_view name)
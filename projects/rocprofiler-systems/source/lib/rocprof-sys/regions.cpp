@@ -23,9 +23,18 @@
 #include "api.hpp"
 #include "core/categories.hpp"
 #include "core/config.hpp"
+#include "core/debug.hpp"
 #include "library/components/category_region.hpp"
 #include "library/tracing.hpp"
 
+#include <timemory/hash/types.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+
 #if defined(__GNUC__) && (__GNUC__ == 7)
 #    pragma GCC diagnostic push
 #    pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
@@ -106,6 +115,114 @@ invoke_category_region_stop(rocprofsys_category_t _category, const char* name,
                                         std::index_sequence<Tail...>{});
     }
 }
+
+// Regions instrumented by rocprof-sys-instrument carry a handle assigned at
+// instrumentation time. Each instrumented module registers itself when it is
+// loaded and receives its own range of handles, the handle passed by a region is
+// the base of that range plus the index assigned by the instrumenter. The first
+// call with a handle adds the name to the hash registry and caches the result in
+// the slot for that handle, so later calls index the table instead of hashing
+// the name. Base 0 is never handed out: regions which run before their module
+// registered pass a handle below trace_handle_module_size and take the string path.
+struct trace_handle_entry
+{
+    std::atomic<bool> ready = { false };
+    tim::hash_value_t hash  = 0;
+    std::string_view  name  = {};
+};
+
+// must match the range size used by rocprof-sys-instrument
+constexpr size_t trace_handle_module_bits = 20;
+constexpr size_t trace_handle_module_size = (1UL << trace_handle_module_bits);
+constexpr size_t trace_handle_max_modules = (1UL << (32 - trace_handle_module_bits));
+constexpr size_t trace_handle_chunk_size  = 4096;
+
+struct trace_handle_module
+{
+    std::array<std::atomic<trace_handle_entry*>,
+               trace_handle_module_size / trace_handle_chunk_size>
+        chunks = {};
+};
+
+auto&
+get_trace_handle_modules()
+{
+    static auto _v =
+        std::array<std::atomic<trace_handle_module*>, trace_handle_max_modules>{};
+    return _v;
+}
+
+auto&
+get_trace_handle_mutex()
+{
+    static auto _v = std::mutex{};
+    return _v;
+}
+
+uint32_t
+register_trace_handle_module()
+{
+    static size_t _count = 0;
+
+    auto& _modules = get_trace_handle_modules();
+    auto  _lk      = std::unique_lock<std::mutex>{ get_trace_handle_mutex() };
+
+    if(_count + 1 >= trace_handle_max_modules)
+    {
+        ROCPROFSYS_WARNING_F(1, "Maximum number of instrumented modules with trace "
+                                "handles reached, regions use their name instead\n");
+        return 0;
+    }
+
+    // modules are never released since handles may be used until exit
+    auto _idx = ++_count;
+    _modules.at(_idx).store(new trace_handle_module{}, std::memory_order_release);
+    return static_cast<uint32_t>(_idx << trace_handle_module_bits);
+}
+
+trace_handle_entry*
+register_trace_handle(trace_handle_module* _module, uint32_t _index, const char* _name)
+{
+    auto _lk = std::unique_lock<std::mutex>{ get_trace_handle_mutex() };
+
+    auto& _chunk_v = _module->chunks.at(_index / trace_handle_chunk_size);
+    auto* _chunk   = _chunk_v.load(std::memory_order_acquire);
+    if(!_chunk)
+    {
+        _chunk = new trace_handle_entry[trace_handle_chunk_size];
+        _chunk_v.store(_chunk, std::memory_order_release);
+    }
+
+    auto& _entry = _chunk[_index % trace_handle_chunk_size];
+    if(!_entry.ready.load(std::memory_order_relaxed))
+    {
+        _entry.hash = tim::add_hash_id(std::string_view{ _name });
+        _entry.name = tim::get_hash_identifier_fast(_entry.hash);
+        _entry.ready.store(true, std::memory_order_release);
+    }
+    return &_entry;
+}
+
+// returns nullptr when the handle does not belong to a registered module
+const trace_handle_entry*
+find_trace_handle(uint32_t _handle, const char* _name)
+{
+    if(!_name) return nullptr;
+
+    auto* _module = get_trace_handle_modules()[_handle >> trace_handle_module_bits].load(
+        std::memory_order_acquire);
+    if(!_module) return nullptr;
+
+    auto  _index = _handle & (trace_handle_module_size - 1);
+    auto* _chunk =
+        _module->chunks[_index / trace_handle_chunk_size].load(std::memory_order_acquire);
+    auto* _entry = (_chunk) ? &_chunk[_index % trace_handle_chunk_size] : nullptr;
+
+    if(!_entry || !_entry->ready.load(std::memory_order_acquire))
+        _entry = register_trace_handle(_module, _index, _name);
+
+    return _entry;
+}
 }  // namespace
 }  // namespace impl
 }  // namespace rocprofsys
@@ -124,6 +241,34 @@ rocprofsys_pop_trace_hidden(const char* name)
     rocprofsys::component::category_region<rocprofsys::category::host>::stop(name);
 }
 
+extern "C" uint32_t
+rocprofsys_register_trace_handles_hidden(void)
+{
+    return rocprofsys::impl::register_trace_handle_module();
+}
+
+extern "C" void
+rocprofsys_push_trace_handle_hidden(uint32_t handle, const char* name)
+{
+    const auto* _entry = rocprofsys::impl::find_trace_handle(handle, name);
+    if(_entry)
+        rocprofsys::component::category_region<rocprofsys::category::host>::start(
+            _entry->hash, _entry->name);
+    else
+        rocprofsys_push_trace_hidden(name);
+}
+
+extern "C" void
+rocprofsys_pop_trace_handle_hidden(uint32_t handle, const char* name)
+{
+    const auto* _entry = rocprofsys::impl::find_trace_handle(handle, name);
+    if(_entry)
+        rocprofsys::component::category_region<rocprofsys::category::host>::stop(
+            _entry->name);
+    else
+        rocprofsys_pop_trace_hidden(name);
+}
+
 //======================================================================================//
 ///
 ///
@@ -54,3 +54,15 @@ rocprofiler_systems_add_test(
     REWRITE_RUN_PASS_REGEX
         "start_thread (.*) 4 (.*) pthread_mutex_lock (.*) 4000 (.*) pthread_mutex_unlock (.*) 4000"
 )
+
+rocprofiler_systems_add_test(
+    SKIP_BASELINE SKIP_RUNTIME SKIP_REWRITE
+    NAME parallel-overhead-locks-sampling-offload
+    TARGET parallel-overhead-locks
+    LABELS "locks;sampling-offload"
+    RUN_ARGS 35 16 1000
+    ENVIRONMENT
+        "${_lock_environment};ROCPROFSYS_VERBOSE=2;ROCPROFSYS_USE_SAMPLING=ON;ROCPROFSYS_USE_PROCESS_SAMPLING=OFF;ROCPROFSYS_USE_TEMPORARY_FILES=ON;ROCPROFSYS_SAMPLING_CPUTIME=ON;ROCPROFSYS_SAMPLING_CPUTIME_FREQ=2000;ROCPROFSYS_SAMPLING_REALTIME=OFF;ROCPROFSYS_SAMPLING_ALLOCATOR_SIZE=4"
+    SAMPLING_PASS_REGEX
+        "Offloading [0-9]+ samples for thread (.*)Loaded [0-9]+ samples for thread"
+)
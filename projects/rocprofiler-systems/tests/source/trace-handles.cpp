@@ -0,0 +1,109 @@
+// MIT License
+//
+// Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Registers two modules the way the init snippets of two separately instrumented
+// binaries do, uses the same local handle with a different region name in each and
+// compares the cost of the handle path with the name path. If the handles of the
+// modules collided, the regions of the second module would be recorded under the
+// name of the first one.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <dlfcn.h>
+
+namespace
+{
+using register_func_t = uint32_t (*)(void);
+using trace_func_t    = void (*)(const char*);
+using handle_func_t   = void (*)(uint32_t, const char*);
+
+template <typename Tp>
+Tp
+get_symbol(const char* _name)
+{
+    auto* _sym = dlsym(RTLD_DEFAULT, _name);
+    if(!_sym)
+    {
+        fprintf(stderr, "[trace-handles] %s not found\n", _name);
+        exit(EXIT_FAILURE);
+    }
+    return reinterpret_cast<Tp>(_sym);
+}
+
+template <typename FuncT>
+double
+time_pairs(long _n, FuncT&& _func)
+{
+    auto _beg = std::chrono::steady_clock::now();
+    for(long i = 0; i < _n; ++i)
+        _func();
+    auto _end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(_end - _beg).count() / _n;
+}
+}  // namespace
+
+int
+main(int argc, char** argv)
+{
+    long nitr = 1000;
+    if(argc > 1) nitr = atol(argv[1]);
+
+    auto register_handles = get_symbol<register_func_t>("rocprofsys_register_trace_handles");
+    auto push_trace       = get_symbol<trace_func_t>("rocprofsys_push_trace");
+    auto pop_trace        = get_symbol<trace_func_t>("rocprofsys_pop_trace");
+    auto push_handle      = get_symbol<handle_func_t>("rocprofsys_push_trace_handle");
+    auto pop_handle       = get_symbol<handle_func_t>("rocprofsys_pop_trace_handle");
+
+    auto base_a = register_handles();
+    auto base_b = register_handles();
+    printf("[trace-handles] module bases: %u, %u\n", base_a, base_b);
+    if(base_a == 0 || base_b == 0 || base_a == base_b)
+    {
+        fprintf(stderr, "[trace-handles] modules did not receive distinct bases\n");
+        return EXIT_FAILURE;
+    }
+
+    // both instrumenters assigned local index 0 to their first region
+    for(long i = 0; i < nitr; ++i)
+    {
+        push_handle(base_a + 0, "module_a_region");
+        pop_handle(base_a + 0, "module_a_region");
+        push_handle(base_b + 0, "module_b_region");
+        pop_handle(base_b + 0, "module_b_region");
+    }
+
+    auto name_ns = time_pairs(nitr, [&]() {
+        push_trace("name_path_region");
+        pop_trace("name_path_region");
+    });
+    auto handle_ns = time_pairs(nitr, [&]() {
+        push_handle(base_a + 1, "handle_path_region");
+        pop_handle(base_a + 1, "handle_path_region");
+    });
+
+    printf("[trace-handles] name path   :: %10.1f ns per push/pop\n", name_ns);
+    printf("[trace-handles] handle path :: %10.1f ns per push/pop\n", handle_ns);
+
+    return EXIT_SUCCESS;
+}
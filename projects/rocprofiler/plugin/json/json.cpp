@@ -30,7 +30,7 @@
 #include <mutex>
 #include <string_view>
 #include <utility>
-#include <thread>
+#include <unordered_map>
 #include <unordered_set>
 
 #include <cxxabi.h>
@@ -57,17 +57,6 @@ struct TraceCategoryArgs {
   std::string name;
 };
 
-struct TraceActivity {
-  std::string phase;
-  uint64_t category;
-  std::string name;
-  std::string category_str;
-  std::string timestamp;
-  std::string duration;
-  uint64_t thread_id;
-  uint64_t correlation_id;
-};
-
 struct TraceCategory {
   TraceCategoryArgs args;
   std::string phase;
@@ -118,6 +107,17 @@ void TraceFlow::setID(uint64_t id) { id_ = id; }
 
 std::mutex writing_lock{};
 
+// Serialized trace events are staged here and appended to the output file when
+// a record buffer has been consumed or the staging buffer grows past this size.
+constexpr size_t kJsonFlushThreshold = 1 << 20;
+
+// A flame graph output is written while the trace is collected, one line per
+// sample of each event duration.
+struct FlameGraphFile {
+  std::ofstream file;
+  uint64_t sample_rate;
+};
+
 std::string process_name;
 
 std::string get_kernel_name(rocprofiler_record_profiler_t& profiler_record) {
@@ -142,8 +142,6 @@ std::string get_kernel_name(rocprofiler_record_profiler_t& profiler_record) {
 class json_plugin_t {
  public:
   json_plugin_t() {
-    is_valid_ = true;
-
     const char* rocprofiler_trace_period = getenv("ROCPROFILER_TRACE_PERIOD");
     if (rocprofiler_trace_period) trace_period_enabled_ = true;
 
@@ -178,282 +176,132 @@ class json_plugin_t {
     txt_output_prefix_ = output_prefix_;
     output_prefix_.append(output_file_name + std::to_string(GetPid()) + "_output.json");
     txt_output_prefix_.append(output_file_name + std::to_string(GetPid()) + "_output");
-    // file.open(output_prefix_.string());
-
-    // This flush technique won't work we need to join JSON files
-    // flush_thread_check_.exchange(true, std::memory_order_acquire);
-
-    // char* flush_interval = getenv("ROCPROFILER_FLUSH_INTERVAL");
-    // uint64_t rocprofiler_flush_interval = 10;
-    // char* end;
-    // if (flush_interval) rocprofiler_flush_interval = std::stoi(flush_interval);
-
-    // flush_thread_ = std::thread(
-    //     [&](uint64_t rocprofiler_flush_interval) {
-    //       while (flush_thread_check_.load(std::memory_order_acquire)) {
-    //         writing_lock.lock();
-    //         ExportTraceEventsToJSON();
-    //         writing_lock.unlock();
-    //         usleep(rocprofiler_flush_interval);
-    //       }
-    //     },
-    //     rocprofiler_flush_interval);
-  }
-
-  void delete_json_plugin() {
-    if (is_valid_) {
-      // flush_thread_check_.exchange(false, std::memory_order_acquire);
-      // flush_thread_.join();
-      ExportTraceEventsToJSON(output_prefix_.string());
-      const char* flame_graph_env = getenv("ROCPROFILER_ENABLE_FLAME_GRAPH");
-      if (flame_graph_env &&
-          (std::string_view(flame_graph_env).find("1") != std::string::npos ||
-           std::string_view(flame_graph_env).find("ON") != std::string::npos))
-        ExportTraceEventsForFlameGraph(txt_output_prefix_.string());
-      // if (file.is_open()) {
-      //   file.close();
-      // }
-    }
-  }
-
-  void ExportTraceEventsToJSON(const std::string& path) {
-    nlohmann::json j;
-    j["traceEvents"] = nlohmann::json::array();
-
-    if (!trace_categories_check.load(std::memory_order_acquire)) {
-      for (const auto& event : trace_categories) {
-        nlohmann::json args;
-        args["name"] = event.args.name;
-        j["traceEvents"].push_back({{"args", args},
-                                    {"ph", event.phase},
-                                    {"pid", event.category},
-                                    {"name", "process_name"},
-                                    {"sort_index", event.sort_index}});
-      }
-      trace_categories_check.exchange(true, std::memory_order_acquire);
-    }
 
-    std::sort(trace_copy_activities_.begin(), trace_copy_activities_.end(),
-              [](auto& a, auto& b) { return (a.timestamp < b.timestamp); });
-
-    std::sort(trace_events_.begin(), trace_events_.end(),
-              [](auto& a, auto& b) { return (a.timestamp < b.timestamp); });
-
-    std::sort(trace_gpu_activities_.begin(), trace_gpu_activities_.end(),
-              [](auto& a, auto& b) { return (a.timestamp < b.timestamp); });
-
-    std::sort(trace_unknown_activities_.begin(), trace_unknown_activities_.end(),
-              [](auto& a, auto& b) { return (a.timestamp < b.timestamp); });
-
-    for (const auto& event : trace_copy_activities_) {
-      nlohmann::json args;
-      args["cid"] = event.correlation_id;
-      j["traceEvents"].push_back({{"name", event.name},
-                                  {"ph", event.phase},
-                                  {"ts", event.timestamp},
-                                  {"tid", event.thread_id},
-                                  {"pid", event.category},
-                                  {"dur", event.duration},
-                                  {"cat", event.category_str},
-                                  {"args", args}});
+    // Events are streamed to the file as the record buffers are flushed, so
+    // only the process metadata is known when the document is opened.
+    stream_.open(output_prefix_.string());
+    if (!stream_.is_open()) {
+      rocprofiler::warning("Cannot open output file '%s'", output_prefix_.c_str());
+      return;
     }
-
-    for (const auto& event : trace_unknown_activities_) {
+    is_valid_ = true;
+    stream_ << "{\n  \"traceEvents\": [";
+    for (const auto& event : trace_categories) {
       nlohmann::json args;
-      args["cid"] = event.correlation_id;
-      j["traceEvents"].push_back({{"name", event.name},
-                                  {"ph", event.phase},
-                                  {"ts", event.timestamp},
-                                  {"tid", event.thread_id},
-                                  {"pid", event.category},
-                                  {"dur", event.duration},
-                                  {"cat", event.category_str},
-                                  {"args", args}});
+      args["name"] = event.args.name;
+      WriteEvent({{"args", args},
+                  {"ph", event.phase},
+                  {"pid", event.category},
+                  {"name", "process_name"},
+                  {"sort_index", event.sort_index}});
     }
 
-    for (const auto& event : trace_events_) {
-      nlohmann::json args;
-      args["cid"] = event.correlation_id;
-      j["traceEvents"].push_back({{"name", event.name},
-                                  {"ph", event.phase},
-                                  {"ts", event.timestamp},
-                                  {"tid", event.thread_id},
-                                  {"pid", event.category},
-                                  {"dur", event.duration},
-                                  {"cat", event.category_str},
-                                  {"args", args}});
+    const char* flame_graph_env = getenv("ROCPROFILER_ENABLE_FLAME_GRAPH");
+    if (flame_graph_env &&
+        (std::string_view(flame_graph_env).find("1") != std::string::npos ||
+         std::string_view(flame_graph_env).find("ON") != std::string::npos)) {
+      uint64_t sample_rate = 10;
+      const char* flame_graph_sample_rate_env = getenv("ROCPROFILER_FLAME_GRAPH_SAMPLE_RATE");
+      if (flame_graph_sample_rate_env) sample_rate = std::stoull(flame_graph_sample_rate_env);
+      OpenFlameGraphFile(kernels_graph_, txt_output_prefix_.string() + "_kernels.txt",
+                         "ROCPROFILER_FLAME_GRAPH_ENABLE_KERNELS",
+                         "ROCPROFILER_FLAME_GRAPH_KERNELS_SAMPLE_RATE", sample_rate);
+      OpenFlameGraphFile(copy_graph_, txt_output_prefix_.string() + "_mem_copies.txt",
+                         "ROCPROFILER_FLAME_GRAPH_ENABLE_MEM_COPY",
+                         "ROCPROFILER_FLAME_GRAPH_MEM_COPY_SAMPLE_RATE", sample_rate);
+      OpenFlameGraphFile(api_graph_, txt_output_prefix_.string() + "_api.txt",
+                         "ROCPROFILER_FLAME_GRAPH_ENABLE_API",
+                         "ROCPROFILER_FLAME_GRAPH_API_SAMPLE_RATE", sample_rate);
     }
+  }
 
-    for (const auto& event : trace_gpu_activities_) {
-      nlohmann::json args;
-      args["cid"] = event.correlation_id;
-      j["traceEvents"].push_back({{"name", event.name},
-                                  {"ph", event.phase},
-                                  {"ts", event.timestamp},
-                                  {"tid", event.thread_id},
-                                  {"pid", event.category},
-                                  {"dur", event.duration},
-                                  {"cat", event.category_str},
-                                  {"args", args}});
+  void delete_json_plugin() {
+    if (is_valid_ && stream_.is_open()) {
+      // Data flows that never saw their second half are dropped, as a single
+      // endpoint cannot be drawn.
+      pending_data_flows_.clear();
+      FlushBuffer();
+      stream_ << "\n  ]\n}" << std::endl;
+      stream_.close();
     }
+    kernels_graph_.file.close();
+    copy_graph_.file.close();
+    api_graph_.file.close();
+  }
 
-    if (enable_data_flow_) {
-      for (auto data_flow : trace_data_flows_) {
-        if (data_flow.second.size() > 1) {
-          uint64_t id = trace_flow_counter.fetch_add(1, std::memory_order_acquire);
-          // The following workaround to overcome the timestamp clock issues in Mi300X
-          std::string df0 = "s";
-          std::string df1 = "t";
-          if (data_flow.second[0].getTimestamp() > data_flow.second[1].getTimestamp()) {
-            df1 = "s";
-            df0 = "t";
-          }
-          j["traceEvents"].push_back({{"id", id},
-                                      {"ph", df0},
-                                      {"ts", data_flow.second[0].getTimestamp()},
-                                      {"cat", "DataFlow"},
-                                      {"pid", data_flow.second[0].getCategory()},
-                                      {"tid", data_flow.second[0].getThreadID()},
-                                      {"name", "dep"}});
-          j["traceEvents"].push_back({{"id", id},
-                                      {"ph", df1},
-                                      {"ts", data_flow.second[1].getTimestamp()},
-                                      {"cat", "DataFlow"},
-                                      {"pid", data_flow.second[1].getCategory()},
-                                      {"tid", data_flow.second[1].getThreadID()},
-                                      {"name", "dep"}});
-        }
-      }
-    }
+  void OpenFlameGraphFile(FlameGraphFile& graph, const std::string& file_path,
+                          const char* enable_env, const char* sample_rate_env,
+                          uint64_t sample_rate) {
+    const char* flame_graph_enable = getenv(enable_env);
+    if (flame_graph_enable &&
+        (std::string_view(flame_graph_enable).find("0") != std::string::npos ||
+         std::string_view(flame_graph_enable).find("OFF") != std::string::npos))
+      return;
+    graph.sample_rate = sample_rate;
+    const char* flame_graph_sample_rate = getenv(sample_rate_env);
+    if (flame_graph_sample_rate) graph.sample_rate = std::stoull(flame_graph_sample_rate);
+    graph.file.open(file_path);
+    if (!graph.file.is_open())
+      std::cerr << "Failed to open file for writing: " << file_path << std::endl;
+  }
 
-    std::ofstream file(path);
-    if (file.is_open()) {
-      file << j.dump(2) << std::endl;  // Pretty print with 4 spaces
-      file.close();
+  void LogFlameGraph(FlameGraphFile& graph, const std::string& name, uint64_t duration) {
+    if (!graph.file.is_open()) return;
+    // Convert duration to sample count (for simplicity, assume 1 sample per microsecond)
+    for (uint64_t i = 0; i < duration; i += graph.sample_rate) {
+      graph.file << name << ";" << name << i << " " << graph.sample_rate << "\n";
     }
-    // trace_gpu_activities_.clear();
-    // trace_copy_activities_.clear();
-    // trace_events_.clear();
-    // trace_data_flows_.clear();
   }
 
-  void ExportTraceEventsForFlameGraph(const std::string& file_path) {
-    uint64_t sample_rate = 10;
-    const char* flame_graph_sample_rate_env = getenv("ROCPROFILER_FLAME_GRAPH_SAMPLE_RATE");
-    if (flame_graph_sample_rate_env) sample_rate = std::stoull(flame_graph_sample_rate_env);
-    std::thread kernels_graph = std::thread([&]() {
-      const char* flame_graph_enable_kernels = getenv("ROCPROFILER_FLAME_GRAPH_ENABLE_KERNELS");
-      if (flame_graph_enable_kernels &&
-          (std::string_view(flame_graph_enable_kernels).find("0") != std::string::npos ||
-           std::string_view(flame_graph_enable_kernels).find("OFF") != std::string::npos))
-        return;
-      uint64_t kernels_sample_rate = sample_rate;
-      const char* flame_graph_sample_rate_kernels_env =
-          getenv("ROCPROFILER_FLAME_GRAPH_KERNELS_SAMPLE_RATE");
-      if (flame_graph_sample_rate_kernels_env)
-        kernels_sample_rate = std::stoull(flame_graph_sample_rate_kernels_env);
-      std::ofstream kernels_file(file_path + "_kernels.txt");
-      if (!kernels_file.is_open()) {
-        std::cerr << "Failed to open file for writing: " << file_path << std::endl;
-        return;
-      }
-
-      for (const auto& event : trace_gpu_activities_) {
-        // Convert duration to sample count (for simplicity, assume 1 sample per microsecond)
-        uint64_t duration = std::stoul(event.duration);
-        for (uint64_t i = 0; i < duration; i += kernels_sample_rate) {
-          kernels_file << event.name << ";" << event.name << i << " " << kernels_sample_rate
-                       << "\n";  // Simple example
-        }
-      }
-
-      kernels_file.close();
-    });
-
-    std::thread copy_graph = std::thread([&]() {
-      const char* flame_graph_enable_copy = getenv("ROCPROFILER_FLAME_GRAPH_ENABLE_MEM_COPY");
-      if (flame_graph_enable_copy &&
-          (std::string_view(flame_graph_enable_copy).find("0") != std::string::npos ||
-           std::string_view(flame_graph_enable_copy).find("OFF") != std::string::npos))
-        return;
-      uint64_t copy_sample_rate = sample_rate;
-      const char* flame_graph_sample_rate_copy_env =
-          getenv("ROCPROFILER_FLAME_GRAPH_MEM_COPY_SAMPLE_RATE");
-      if (flame_graph_sample_rate_copy_env)
-        copy_sample_rate = std::stoull(flame_graph_sample_rate_copy_env);
-      std::ofstream copy_file(file_path + "_mem_copies.txt");
-      if (!copy_file.is_open()) {
-        std::cerr << "Failed to open file for writing: " << file_path << std::endl;
-        return;
-      }
-
-      for (const auto& event : trace_copy_activities_) {
-        uint64_t duration = std::stoul(event.duration);
-        for (uint64_t i = 0; i < duration; i += copy_sample_rate) {
-          copy_file << event.name << ";" << event.name << i << " " << copy_sample_rate << "\n";
-        }
-      }
-
-      copy_file.close();
-    });
-
-    std::thread api_graph = std::thread([&]() {
-      const char* flame_graph_enable_api = getenv("ROCPROFILER_FLAME_GRAPH_ENABLE_API");
-      if (flame_graph_enable_api &&
-          (std::string_view(flame_graph_enable_api).find("0") != std::string::npos ||
-           std::string_view(flame_graph_enable_api).find("OFF") != std::string::npos))
-        return;
-      uint64_t api_sample_rate = sample_rate;
-      const char* flame_graph_sample_rate_api_env =
-          getenv("ROCPROFILER_FLAME_GRAPH_API_SAMPLE_RATE");
-      if (flame_graph_sample_rate_api_env)
-        api_sample_rate = std::stoull(flame_graph_sample_rate_api_env);
-      std::ofstream api_file(file_path + "_api.txt");
-      if (!api_file.is_open()) {
-        std::cerr << "Failed to open file for writing: " << file_path << std::endl;
-        return;
-      }
-
-      for (const auto& event : trace_events_) {
-        // Convert duration to sample count (for simplicity, assume 1 sample per microsecond)
-        uint64_t duration = std::stoul(event.duration);
-        for (uint64_t i = 0; i < duration; i += api_sample_rate) {
-          api_file << event.name << ";" << event.name << i << " " << api_sample_rate
-                   << "\n";  // Simple example
-        }
-      }
+  void WriteEvent(const nlohmann::json& event) {
+    buffer_ += first_event_ ? "\n    " : ",\n    ";
+    buffer_ += event.dump();
+    first_event_ = false;
+    if (buffer_.size() >= kJsonFlushThreshold) FlushBuffer();
+  }
 
-      api_file.close();
-    });
+  void FlushBuffer() {
+    if (buffer_.empty()) return;
+    stream_.write(buffer_.data(), buffer_.size());
+    buffer_.clear();
+  }
 
-    kernels_graph.join();
-    copy_graph.join();
-    api_graph.join();
+  void LogTraceEvent(const std::string& name, const std::string& category_str,
+                     uint64_t timestamp, uint64_t thread_id, uint64_t category,
+                     uint64_t duration, uint64_t correlation_id) {
+    nlohmann::json args;
+    args["cid"] = correlation_id;
+    WriteEvent({{"name", name},
+                {"ph", "X"},
+                {"ts", std::to_string(timestamp)},
+                {"tid", thread_id},
+                {"pid", category},
+                {"dur", std::to_string(duration)},
+                {"cat", category_str},
+                {"args", args}});
   }
 
   void LogGpuActivityTrace(const std::string& name, const std::string& category_str,
                            uint64_t timestamp, uint64_t thread_id, uint64_t category,
                            uint64_t duration, uint64_t correlation_id) {
     if (duration == 0) duration = 1;
-    trace_gpu_activities_.push_back({"X", category, name, category_str, std::to_string(timestamp),
-                                     std::to_string(duration), thread_id, correlation_id});
+    LogTraceEvent(name, category_str, timestamp, thread_id, category, duration, correlation_id);
+    LogFlameGraph(kernels_graph_, name, duration);
   }
 
   void LogCopyActivityTrace(const std::string& name, const std::string& category_str,
                             uint64_t timestamp, uint64_t thread_id, uint64_t category,
                             uint64_t duration, uint64_t correlation_id) {
     if (duration == 0) duration = 1;
-    trace_copy_activities_.push_back({"X", category, name, category_str, std::to_string(timestamp),
-                                      std::to_string(duration), thread_id, correlation_id});
+    LogTraceEvent(name, category_str, timestamp, thread_id, category, duration, correlation_id);
+    LogFlameGraph(copy_graph_, name, duration);
   }
 
   void LogCopyUnknownTrace(const std::string& name, const std::string& category_str,
                            uint64_t timestamp, uint64_t thread_id, uint64_t category,
                            uint64_t duration, uint64_t correlation_id) {
     if (duration == 0) duration = 1;
-    trace_unknown_activities_.push_back({"X", category, name, category_str,
-                                         std::to_string(timestamp), std::to_string(duration),
-                                         thread_id, correlation_id});
+    LogTraceEvent(name, category_str, timestamp, thread_id, category, duration, correlation_id);
   }
 
   void LogAPITrace(const std::string& name, const std::string& category_str,
@@ -461,21 +309,76 @@ class json_plugin_t {
                    uint64_t category, uint64_t correlation_id) {
     uint64_t duration = (end_timestamp - start_timestamp);
     if (duration == 0) duration = 1;
-    trace_events_.push_back({"X", category, name, category_str, std::to_string(start_timestamp),
-                             std::to_string(duration), thread_id, correlation_id});
+    LogTraceEvent(name, category_str, start_timestamp, thread_id, category, duration,
+                  correlation_id);
+    LogFlameGraph(api_graph_, name, duration);
   }
 
+  void LogDataFlow(TraceFlow& first, TraceFlow& second) {
+    uint64_t id = trace_flow_counter.fetch_add(1, std::memory_order_acquire);
+    // The following workaround to overcome the timestamp clock issues in Mi300X
+    std::string df0 = "s";
+    std::string df1 = "t";
+    if (first.getTimestamp() > second.getTimestamp()) {
+      df1 = "s";
+      df0 = "t";
+    }
+    WriteEvent({{"id", id},
+                {"ph", df0},
+                {"ts", first.getTimestamp()},
+                {"cat", "DataFlow"},
+                {"pid", first.getCategory()},
+                {"tid", first.getThreadID()},
+                {"name", "dep"}});
+    WriteEvent({{"id", id},
+                {"ph", df1},
+                {"ts", second.getTimestamp()},
+                {"cat", "DataFlow"},
+                {"pid", second.getCategory()},
+                {"tid", second.getThreadID()},
+                {"name", "dep"}});
+  }
+
+  // A data flow is held until its other endpoint arrives and is then written
+  // out.
   void AddDataFlowEvent(uint64_t timestamp, TraceFlowCategory type, uint64_t category,
                         uint64_t thread_id, uint64_t correlation_id) {
-    if (enable_data_flow_) {
-      if (type == ROCPROFILER_DATA_FLOW_START) {
-        trace_data_flows_[correlation_id].emplace_back(
-            TraceFlow(timestamp, "s", category, thread_id, correlation_id));
-      } else {
-        trace_data_flows_[correlation_id].emplace_back(
-            TraceFlow(timestamp, "t", category, thread_id, correlation_id));
-      }
+    if (!enable_data_flow_) return;
+    TraceFlow flow(timestamp, type == ROCPROFILER_DATA_FLOW_START ? "s" : "t", category,
+                   thread_id, correlation_id);
+    auto it = pending_data_flows_.find(correlation_id);
+    if (it == pending_data_flows_.end()) {
+      pending_data_flows_.emplace(correlation_id, std::move(flow));
+      return;
     }
+    LogDataFlow(it->second, flow);
+    pending_data_flows_.erase(it);
+  }
+
+  // An API call which cannot create an op does not start a flow. An op
+  // endpoint held for its correlation id is dropped.
+  void AddApiDataFlowEvent(rocprofiler_tracer_activity_domain_t domain, const char* name,
+                           uint64_t timestamp, uint64_t thread_id, uint64_t correlation_id) {
+    if (!enable_data_flow_) return;
+    if (CanCreateOp(domain, name)) {
+      AddDataFlowEvent(timestamp, ROCPROFILER_DATA_FLOW_START, 1, thread_id, correlation_id);
+      return;
+    }
+    pending_data_flows_.erase(correlation_id);
+  }
+
+  // HSA API calls create ops for async copies only, HIP API calls for kernel
+  // launches, copies, fills and the markers of stream and event operations.
+  static bool CanCreateOp(rocprofiler_tracer_activity_domain_t domain, const char* name) {
+    if (!name) return false;
+    std::string_view api(name);
+    if (domain == ACTIVITY_DOMAIN_HSA_API)
+      return api.find("memory_async_copy") != std::string_view::npos;
+    for (std::string_view pattern : {"Launch", "Memcpy", "Memset", "MemPrefetch", "Synchronize",
+                                     "EventRecord", "StreamWaitEvent", "StreamAddCallback"}) {
+      if (api.find(pattern) != std::string_view::npos) return true;
+    }
+    return false;
   }
 
   // We may need to use this in the Args of the trace
@@ -588,15 +491,15 @@ class json_plugin_t {
       case ACTIVITY_DOMAIN_HSA_API: {
         LogAPITrace(operation_name_c, "CPU", start_timestamp, end_timestamp, thread_id, 1,
                     correlation_id);
-        AddDataFlowEvent(start_timestamp, ROCPROFILER_DATA_FLOW_START, 1, thread_id,
-                         correlation_id);
+        AddApiDataFlowEvent(tracer_record.domain, operation_name_c, start_timestamp, thread_id,
+                            correlation_id);
         break;
       }
       case ACTIVITY_DOMAIN_HIP_API: {
         LogAPITrace(operation_name_c, "CPU", start_timestamp, end_timestamp, thread_id, 1,
                     correlation_id);
-        AddDataFlowEvent(start_timestamp, ROCPROFILER_DATA_FLOW_START, 1, thread_id,
-                         correlation_id);
+        AddApiDataFlowEvent(tracer_record.domain, operation_name_c, start_timestamp, thread_id,
+                            correlation_id);
         if (trace_period_enabled_) found_correlation_ids_.insert(correlation_id);
         break;
       }
@@ -663,7 +566,7 @@ class json_plugin_t {
                          const rocprofiler_record_header_t* end,
                          rocprofiler_session_id_t session_id, rocprofiler_buffer_id_t buffer_id) {
     while (begin < end) {
-      if (!begin) return 0;
+      if (!begin) break;
       switch (begin->kind) {
         case ROCPROFILER_PROFILER_RECORD: {
           rocprofiler_record_profiler_t* profiler_record =
@@ -683,6 +586,8 @@ class json_plugin_t {
       }
       rocprofiler_next_record(begin, &begin, session_id, buffer_id);
     }
+    std::lock_guard<std::mutex> lock(writing_lock);
+    FlushBuffer();
     return 0;
   }
 
@@ -693,25 +598,22 @@ class json_plugin_t {
   fs::path output_prefix_;
   fs::path txt_output_prefix_;
 
-  std::atomic<bool> flush_thread_check_{false};
-  std::thread flush_thread_;
-
   std::ofstream stream_;
+  std::string buffer_;
+  bool first_event_ = true;
   std::unordered_map<std::string, std::string> kernel_names_map;
 
   std::atomic<uint64_t> trace_flow_counter{0};
-  std::vector<TraceActivity> trace_events_;
-  std::vector<TraceActivity> trace_gpu_activities_;
-  std::vector<TraceActivity> trace_copy_activities_;
-  std::vector<TraceActivity> trace_unknown_activities_;
+  std::unordered_map<uint64_t, TraceFlow> pending_data_flows_;
 
-  std::map<uint64_t, std::vector<TraceFlow>> trace_data_flows_;
+  FlameGraphFile kernels_graph_;
+  FlameGraphFile copy_graph_;
+  FlameGraphFile api_graph_;
 
   TraceCategory trace_categories[4] = {{{"CPU"}, "M", 1, 0},
                                        {{"GPU"}, "M", 2, 1},
                                        {{"COPY"}, "M", 3, 2},
                                        {{"HIPBLITKERNELS"}, "M", 4, 3}};
-  std::atomic<bool> trace_categories_check{false};
   bool enable_data_flow_ = true;
 
   std::unordered_set<uint64_t> found_correlation_ids_;
@@ -732,10 +634,7 @@ int rocprofiler_plugin_initialize(uint32_t rocprofiler_major_version,
   if (json_plugin != nullptr) return -1;
 
   json_plugin = new json_plugin_t();
-  if (json_plugin->IsValid()) {
-    writing_lock.unlock();
-    return 0;
-  }
+  if (json_plugin->IsValid()) return 0;
 
   delete json_plugin;
   json_plugin = nullptr;
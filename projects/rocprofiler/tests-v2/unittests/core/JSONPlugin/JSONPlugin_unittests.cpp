@@ -0,0 +1,210 @@
+/* Copyright (c) 2025 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include <gtest/gtest.h>
+
+#include <dlfcn.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "rocprofiler.h"
+#include "rocprofiler_plugin.h"
+#include "plugin/json/json/include/nlohmann/json.hpp"
+#include "src/utils/filesystem.hpp"
+
+namespace fs = rocprofiler::common::filesystem;
+
+extern std::string running_path;
+std::string GetRunningPath(std::string string_to_erase);
+
+namespace {
+
+// Operation ids of the HSA API and HSA OPS domains used by the records below.
+// Operation 0 of the HSA API cannot create an op.
+constexpr uint64_t kHsaApiNoOp = 0;
+constexpr uint64_t kHsaOpsCopy = 1;
+
+// Enough ROCTx ranges to pass the 1 MiB staging threshold of the plugin
+constexpr uint64_t kRangeCount = 20000;
+constexpr uint64_t kFlowCount = 100;
+
+class JSONPluginTest : public ::testing::Test {
+ protected:
+  using initialize_t = decltype(rocprofiler_plugin_initialize);
+  using finalize_t = decltype(rocprofiler_plugin_finalize);
+  using write_record_t = decltype(rocprofiler_plugin_write_record);
+
+  void SetUp() override {
+    std::string plugin_path = GetRunningPath(running_path) + "lib/rocprofiler/libjson_plugin.so";
+    handle_ = dlopen(plugin_path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    ASSERT_NE(handle_, nullptr) << dlerror();
+    initialize_ = reinterpret_cast<initialize_t*>(dlsym(handle_, "rocprofiler_plugin_initialize"));
+    finalize_ = reinterpret_cast<finalize_t*>(dlsym(handle_, "rocprofiler_plugin_finalize"));
+    write_record_ =
+        reinterpret_cast<write_record_t*>(dlsym(handle_, "rocprofiler_plugin_write_record"));
+    ASSERT_TRUE(initialize_ && finalize_ && write_record_);
+
+    char dir_template[] = "/tmp/rocprofiler-json-plugin-XXXXXX";
+    ASSERT_NE(mkdtemp(dir_template), nullptr);
+    output_dir_ = dir_template;
+
+    unsetenv("OUT_FILE_NAME");
+    unsetenv("ROCPROFILER_TRACE_PERIOD");
+    unsetenv("ROCPROFILER_DISABLE_JSON_DATA_FLOWS");
+    unsetenv("ROCPROFILER_ENABLE_FLAME_GRAPH");
+  }
+
+  void TearDown() override {
+    if (!output_dir_.empty()) fs::remove_all(output_dir_);
+    if (handle_) dlclose(handle_);
+  }
+
+  // The HSA API operation which starts async copies
+  static uint64_t AsyncCopyOperation() {
+    for (uint32_t id = 0; id < 1024; ++id) {
+      const char* name = nullptr;
+      rocprofiler_query_tracer_operation_name(ACTIVITY_DOMAIN_HSA_API, {id}, &name);
+      if (name && std::string(name) == "hsa_amd_memory_async_copy") return id;
+    }
+    ADD_FAILURE() << "hsa_amd_memory_async_copy has no operation id";
+    return 0;
+  }
+
+  static rocprofiler_record_tracer_t MakeRecord(rocprofiler_tracer_activity_domain_t domain,
+                                                uint64_t operation_id, uint64_t correlation_id,
+                                                uint64_t begin_ns, uint64_t end_ns,
+                                                const char* name) {
+    rocprofiler_record_tracer_t record{};
+    record.header.kind = ROCPROFILER_TRACER_RECORD;
+    record.header.id.handle = correlation_id;
+    record.domain = domain;
+    record.operation_id.id = operation_id;
+    record.correlation_id.value = correlation_id;
+    record.timestamps.begin.value = begin_ns;
+    record.timestamps.end.value = end_ns;
+    record.thread_id.value = 7;
+    record.name = name;
+    return record;
+  }
+
+  void* handle_ = nullptr;
+  initialize_t* initialize_ = nullptr;
+  finalize_t* finalize_ = nullptr;
+  write_record_t* write_record_ = nullptr;
+  std::string output_dir_;
+};
+
+}  // namespace
+
+TEST_F(JSONPluginTest, WhenOutputDirectoryIsMissingInitializationFails) {
+  setenv("OUTPUT_PATH", (output_dir_ + "/missing").c_str(), 1);
+  EXPECT_EQ(initialize_(ROCPROFILER_VERSION_MAJOR, ROCPROFILER_VERSION_MINOR, nullptr), -1);
+  EXPECT_EQ(write_record_(MakeRecord(ACTIVITY_DOMAIN_ROCTX, 0, 1, 1000, 2000, "range")), -1);
+  finalize_();
+}
+
+TEST_F(JSONPluginTest, WhenWritingSyntheticRecordsTheTraceIsComplete) {
+  setenv("OUTPUT_PATH", output_dir_.c_str(), 1);
+  ASSERT_EQ(initialize_(ROCPROFILER_VERSION_MAJOR, ROCPROFILER_VERSION_MINOR, nullptr), 0);
+
+  std::vector<std::string> range_names;
+  range_names.reserve(kRangeCount);
+  uint64_t correlation_id = 1;
+  for (uint64_t i = 0; i < kRangeCount; ++i) {
+    range_names.push_back("range_" + std::to_string(i));
+    ASSERT_EQ(write_record_(MakeRecord(ACTIVITY_DOMAIN_ROCTX, 0, correlation_id++, i * 1000,
+                                       i * 1000 + 500, range_names.back().c_str())),
+              0);
+  }
+
+  // Each API call is followed by the copy it started, which closes its data
+  // flow. The last call has no copy, so its flow is never written.
+  const uint64_t async_copy = AsyncCopyOperation();
+  for (uint64_t i = 0; i <= kFlowCount; ++i) {
+    uint64_t id = correlation_id++;
+    ASSERT_EQ(write_record_(MakeRecord(ACTIVITY_DOMAIN_HSA_API, async_copy, id, i * 1000,
+                                       i * 1000 + 100, nullptr)),
+              0);
+    if (i == kFlowCount) break;
+    ASSERT_EQ(write_record_(MakeRecord(ACTIVITY_DOMAIN_HSA_OPS, kHsaOpsCopy, id, i * 1000 + 200,
+                                       i * 1000 + 300, nullptr)),
+              0);
+  }
+
+  // An API call which cannot create an op does not start a flow, and drops
+  // an op which arrived before it with the same correlation id.
+  for (uint64_t i = 0; i < kFlowCount; ++i) {
+    uint64_t id = correlation_id++;
+    ASSERT_EQ(write_record_(MakeRecord(ACTIVITY_DOMAIN_HSA_OPS, kHsaOpsCopy, id, i * 1000 + 200,
+                                       i * 1000 + 300, nullptr)),
+              0);
+    ASSERT_EQ(write_record_(MakeRecord(ACTIVITY_DOMAIN_HSA_API, kHsaApiNoOp, id, i * 1000,
+                                       i * 1000 + 100, nullptr)),
+              0);
+  }
+  finalize_();
+
+  std::ifstream file(output_dir_ + "/" + std::to_string(getpid()) + "_output.json");
+  ASSERT_TRUE(file.is_open());
+  nlohmann::json trace = nlohmann::json::parse(file);
+  const auto& events = trace.at("traceEvents");
+
+  std::vector<std::string> category_names;
+  std::vector<std::string> roctx_names;
+  uint64_t api_count = 0, copy_count = 0;
+  std::map<uint64_t, std::vector<std::string>> flows;
+  for (const auto& event : events) {
+    const std::string phase = event.at("ph");
+    if (phase == "M") {
+      category_names.push_back(event.at("args").at("name"));
+    } else if (phase == "X" && event.at("pid") == 1 && event.at("cat") == "CPU") {
+      const std::string name = event.at("name");
+      if (name.rfind("range_", 0) == 0) {
+        uint64_t index = roctx_names.size();
+        EXPECT_EQ(event.at("ts"), std::to_string(index));
+        EXPECT_EQ(event.at("dur"), "1");
+        roctx_names.push_back(name);
+      } else {
+        ++api_count;
+      }
+    } else if (phase == "X" && event.at("pid") == 3) {
+      ++copy_count;
+    } else if (phase == "s" || phase == "t") {
+      EXPECT_EQ(event.at("cat"), "DataFlow");
+      flows[event.at("id").get<uint64_t>()].push_back(phase);
+    } else {
+      ADD_FAILURE() << "Unexpected event " << event.dump();
+    }
+  }
+
+  EXPECT_EQ(category_names, (std::vector<std::string>{"CPU", "GPU", "COPY", "HIPBLITKERNELS"}));
+  EXPECT_EQ(roctx_names, range_names);
+  EXPECT_EQ(api_count, 2 * kFlowCount + 1);
+  EXPECT_EQ(copy_count, 2 * kFlowCount);
+  EXPECT_EQ(flows.size(), kFlowCount);
+  for (const auto& [id, phases] : flows) {
+    EXPECT_EQ(phases, (std::vector<std::string>{"s", "t"})) << "flow " << id;
+  }
+}
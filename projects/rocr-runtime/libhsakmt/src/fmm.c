@@ -127,11 +127,20 @@ struct vm_object {
 };
 typedef struct vm_object vm_object_t;
 
+/* Used address ranges of a reserved aperture, kept in an AVL tree keyed by
+ * start address. Each node also tracks the span of its subtree and the
+ * largest free gap between areas inside it, so that searches for a hole can
+ * skip subtrees that cannot hold the request.
+ */
 struct vm_area {
 	void *start;
 	void *end;
-	struct vm_area *next;
-	struct vm_area *prev;
+	struct vm_area *left;
+	struct vm_area *right;
+	int height;
+	void *min_start;	/* start of the leftmost area in the subtree */
+	void *max_end;		/* end of the rightmost area in the subtree */
+	uint64_t max_gap;	/* largest gap between areas in the subtree */
 };
 typedef struct vm_area vm_area_t;
 
@@ -179,7 +188,7 @@ struct manageable_aperture {
 	void *limit;
 	uint64_t align;
 	uint32_t guard_pages;
-	vm_area_t *vm_ranges;
+	vm_area_t *vm_ranges; /* root of the used range tree */
 	rbtree_t tree;
 	rbtree_t user_tree;
 	pthread_mutex_t fmm_mutex;
@@ -333,14 +342,238 @@ static vm_area_t *vm_create_and_init_area(void *start, void *end)
 	vm_area_t *area = (vm_area_t *) malloc(sizeof(vm_area_t));
 
 	if (area) {
-		area->start = start;
-		area->end = end;
-		area->next = area->prev = NULL;
+		area->start = area->min_start = start;
+		area->end = area->max_end = end;
+		area->left = area->right = NULL;
+		area->height = 1;
+		area->max_gap = 0;
+	}
+
+	return area;
+}
+
+static inline int vm_area_height(vm_area_t *area)
+{
+	return area ? area->height : 0;
+}
+
+/* Free space between two areas, or 0 if they touch */
+static inline uint64_t vm_area_gap(void *prev_end, void *next_start)
+{
+	return next_start > prev_end ? VOID_PTRS_SUB(next_start, prev_end) - 1 : 0;
+}
+
+/* Recompute the cached subtree fields of area from its children */
+static void vm_area_update(vm_area_t *area)
+{
+	vm_area_t *l = area->left, *r = area->right;
+	uint64_t gap = 0;
+
+	area->height = 1 + MAX(vm_area_height(l), vm_area_height(r));
+	area->min_start = l ? l->min_start : area->start;
+	area->max_end = r ? r->max_end : area->end;
+
+	if (l) {
+		gap = MAX(l->max_gap, vm_area_gap(l->max_end, area->start));
+	}
+	if (r) {
+		gap = MAX(gap, r->max_gap);
+		gap = MAX(gap, vm_area_gap(area->end, r->min_start));
 	}
+	area->max_gap = gap;
+}
+
+static vm_area_t *vm_area_rotate_right(vm_area_t *area)
+{
+	vm_area_t *l = area->left;
+
+	area->left = l->right;
+	l->right = area;
+	vm_area_update(area);
+	vm_area_update(l);
+	return l;
+}
+
+static vm_area_t *vm_area_rotate_left(vm_area_t *area)
+{
+	vm_area_t *r = area->right;
 
+	area->right = r->left;
+	r->left = area;
+	vm_area_update(area);
+	vm_area_update(r);
+	return r;
+}
+
+static vm_area_t *vm_area_balance(vm_area_t *area)
+{
+	int balance;
+
+	vm_area_update(area);
+	balance = vm_area_height(area->left) - vm_area_height(area->right);
+
+	if (balance > 1) {
+		if (vm_area_height(area->left->left) < vm_area_height(area->left->right))
+			area->left = vm_area_rotate_left(area->left);
+		return vm_area_rotate_right(area);
+	}
+	if (balance < -1) {
+		if (vm_area_height(area->right->right) < vm_area_height(area->right->left))
+			area->right = vm_area_rotate_right(area->right);
+		return vm_area_rotate_left(area);
+	}
 	return area;
 }
 
+static vm_area_t *vm_area_insert(vm_area_t *root, vm_area_t *area)
+{
+	if (!root)
+		return area;
+
+	if (area->start < root->start)
+		root->left = vm_area_insert(root->left, area);
+	else
+		root->right = vm_area_insert(root->right, area);
+
+	return vm_area_balance(root);
+}
+
+/* Unlink the leftmost area of the subtree, returned in *min */
+static vm_area_t *vm_area_unlink_min(vm_area_t *root, vm_area_t **min)
+{
+	if (!root->left) {
+		*min = root;
+		return root->right;
+	}
+
+	root->left = vm_area_unlink_min(root->left, min);
+	return vm_area_balance(root);
+}
+
+/* Unlink area from the subtree. The area itself is not freed. */
+static vm_area_t *vm_area_unlink(vm_area_t *root, vm_area_t *area)
+{
+	vm_area_t *min;
+
+	if (!root)
+		return NULL;
+
+	if (area->start < root->start) {
+		root->left = vm_area_unlink(root->left, area);
+	} else if (area->start > root->start) {
+		root->right = vm_area_unlink(root->right, area);
+	} else {
+		if (!root->left || !root->right)
+			return root->left ? root->left : root->right;
+
+		root->right = vm_area_unlink_min(root->right, &min);
+		min->left = root->left;
+		min->right = root->right;
+		root = min;
+	}
+
+	return vm_area_balance(root);
+}
+
+/* Refresh the cached fields on the path to area after its start or end
+ * changed without changing its position in the tree.
+ */
+static void vm_area_refresh(vm_area_t *root, vm_area_t *area)
+{
+	if (!root)
+		return;
+
+	if (area->start < root->start)
+		vm_area_refresh(root->left, area);
+	else if (area->start > root->start)
+		vm_area_refresh(root->right, area);
+
+	vm_area_update(root);
+}
+
+/* Area with the largest start <= address, or NULL */
+static vm_area_t *vm_area_floor(vm_area_t *root, const void *address)
+{
+	vm_area_t *found = NULL;
+
+	while (root) {
+		if (root->start <= address) {
+			found = root;
+			root = root->right;
+		} else {
+			root = root->left;
+		}
+	}
+
+	return found;
+}
+
+/* Area with the smallest start > address, or NULL */
+static vm_area_t *vm_area_higher(vm_area_t *root, const void *address)
+{
+	vm_area_t *found = NULL;
+
+	while (root) {
+		if (root->start > address) {
+			found = root;
+			root = root->left;
+		} else {
+			root = root->right;
+		}
+	}
+
+	return found;
+}
+
+static void vm_area_free_all(vm_area_t *root)
+{
+	if (!root)
+		return;
+
+	vm_area_free_all(root->left);
+	vm_area_free_all(root->right);
+	free(root);
+}
+
+/* Lowest hole start for a request of size bytes, first fit by address.
+ * hole_base is the first free address before the subtree and is advanced
+ * past it. Returns the aligned start, or NULL if the subtree has no fitting
+ * hole.
+ *
+ * Subtrees are only pruned by hole size. A hole that is big enough before
+ * alignment but too small after it still makes the search descend to it, so
+ * the cost is O(log n) per such candidate hole rather than O(log n) overall.
+ */
+static void *vm_area_find_hole(vm_area_t *root, void **hole_base,
+			       uint64_t size, uint64_t align, uint64_t offset)
+{
+	void *start;
+
+	if (!root)
+		return NULL;
+
+	/* Neither the hole in front of the subtree nor any hole inside it
+	 * is big enough, regardless of alignment.
+	 */
+	if (root->max_gap < size &&
+	    (root->min_start <= *hole_base ||
+	     VOID_PTRS_SUB(root->min_start, *hole_base) < size)) {
+		*hole_base = VOID_PTR_ADD(root->max_end, 1);
+		return NULL;
+	}
+
+	start = vm_area_find_hole(root->left, hole_base, size, align, offset);
+	if (start)
+		return start;
+
+	start = (void *)(ALIGN_UP((uint64_t)*hole_base, align) + offset);
+	if (root->start > start && VOID_PTRS_SUB(root->start, start) >= size)
+		return start;
+	*hole_base = VOID_PTR_ADD(root->end, 1);
+
+	return vm_area_find_hole(root->right, hole_base, size, align, offset);
+}
+
 /* One huge page smaller than 512GB system buffer limit,
  * because 512GB allocation will cause TTM failure.
  */
@@ -388,20 +621,7 @@ static vm_object_t *vm_create_and_init_object(void *start, uint64_t size,
 
 static void vm_remove_area(manageable_aperture_t *app, vm_area_t *area)
 {
-	vm_area_t *next;
-	vm_area_t *prev;
-
-	next = area->next;
-	prev = area->prev;
-
-	if (!prev) /* The first element */
-		app->vm_ranges = next;
-	else
-		prev->next = next;
-
-	if (next) /* If not the last element */
-		next->prev = prev;
-
+	app->vm_ranges = vm_area_unlink(app->vm_ranges, area);
 	free(area);
 }
 
@@ -429,18 +649,6 @@ static void vm_remove_object(manageable_aperture_t *app, vm_object_t *object)
 	free(object);
 }
 
-static void vm_add_area_after(vm_area_t *after_this, vm_area_t *new_area)
-{
-	vm_area_t *next = after_this->next;
-
-	after_this->next = new_area;
-	new_area->next = next;
-
-	new_area->prev = after_this;
-	if (next)
-		next->prev = new_area;
-}
-
 static void vm_split_area(manageable_aperture_t *app, vm_area_t *area,
 				void *address, uint64_t MemorySizeInBytes)
 {
@@ -458,8 +666,9 @@ static void vm_split_area(manageable_aperture_t *app, vm_area_t *area,
 	}
 	/* Shrink the existing area */
 	area->end = VOID_PTR_SUB(address, 1);
+	vm_area_refresh(app->vm_ranges, area);
 
-	vm_add_area_after(area, new_area);
+	app->vm_ranges = vm_area_insert(app->vm_ranges, new_area);
 }
 
 static vm_object_t *vm_find_object_by_address_userptr(manageable_aperture_t *app,
@@ -591,16 +800,13 @@ static vm_object_t *vm_find_object_by_userptr_range(manageable_aperture_t *app,
 
 static vm_area_t *vm_find(manageable_aperture_t *app, void *address)
 {
-	vm_area_t *cur = app->vm_ranges;
-
 	/* Look up the appropriate address range containing the given address */
-	while (cur) {
-		if (cur->start <= address && cur->end >= address)
-			break;
-		cur = cur->next;
-	};
+	vm_area_t *cur = vm_area_floor(app->vm_ranges, address);
 
-	return cur; /* NULL if not found */
+	if (cur && cur->end >= address)
+		return cur;
+
+	return NULL;
 }
 
 static bool aperture_is_valid(void *app_base, void *app_limit)
@@ -643,13 +849,17 @@ static void reserved_aperture_release(manageable_aperture_t *app,
 		vm_remove_area(app, area);
 	} else if (SizeOfRegion > MemorySizeInBytes) {
 		/* shrink from the start */
-		if (area->start == address)
+		if (area->start == address) {
 			area->start =
 				VOID_PTR_ADD(area->start, MemorySizeInBytes);
+			vm_area_refresh(app->vm_ranges, area);
+		}
 		/* shrink from the end */
 		else if (VOID_PTRS_SUB(area->end, address) + 1 ==
-				MemorySizeInBytes)
+				MemorySizeInBytes) {
 			area->end = VOID_PTR_SUB(area->end, MemorySizeInBytes);
+			vm_area_refresh(app->vm_ranges, area);
+		}
 		/* split the area */
 		else
 			vm_split_area(app, area, address, MemorySizeInBytes);
@@ -722,31 +932,36 @@ static void *reserved_aperture_allocate_aligned(manageable_aperture_t *app,
 	MemorySizeInBytes = vm_align_area_size(app, MemorySizeInBytes);
 
 	/* Find a big enough "hole" in the address space */
-	cur = NULL;
-	next = app->vm_ranges;
-	start = address ? address :
-		(void *)(ALIGN_UP((uint64_t)app->base, align) + offset);
-	while (next) {
-		if (next->start > start &&
-		    VOID_PTRS_SUB(next->start, start) >= MemorySizeInBytes)
-			break;
+	if (address) {
+		start = address;
+		cur = vm_area_floor(app->vm_ranges, start);
+		next = vm_area_higher(app->vm_ranges, start);
 
-		cur = next;
-		next = next->next;
-		if (!address)
-			start = (void *)(ALIGN_UP((uint64_t)cur->end + 1, align) + offset);
-	}
-	if (!next && VOID_PTRS_SUB(app->limit, start) + 1 < MemorySizeInBytes)
+		if (cur && start < (void *)ALIGN_UP((uint64_t)cur->end + 1, align))
+			/* Required address is not free or overlaps */
+			return NULL;
+		if (next && VOID_PTRS_SUB(next->start, start) < MemorySizeInBytes)
+			return NULL;
+	} else {
+		void *hole_base = app->base;
+
+		start = vm_area_find_hole(app->vm_ranges, &hole_base,
+					  MemorySizeInBytes, align, offset);
+		if (!start)
+			/* No hole found, try the space after the last area */
+			start = (void *)(ALIGN_UP((uint64_t)hole_base, align) + offset);
+		cur = vm_area_floor(app->vm_ranges, VOID_PTR_SUB(start, 1));
+		next = vm_area_higher(app->vm_ranges, start);
+	}
+	if (!next && (start > app->limit ||
+		      VOID_PTRS_SUB(app->limit, start) + 1 < MemorySizeInBytes))
 		/* No hole found and not enough space after the last area */
 		return NULL;
 
-	if (cur && address && address < (void *)ALIGN_UP((uint64_t)cur->end + 1, align))
-		/* Required address is not free or overlaps */
-		return NULL;
-
 	if (cur && VOID_PTR_ADD(cur->end, 1) == start) {
 		/* extend existing area */
 		cur->end = VOID_PTR_ADD(start, MemorySizeInBytes-1);
+		vm_area_refresh(app->vm_ranges, cur);
 	} else {
 		vm_area_t *new_area;
 		/* create a new area between cur and next */
@@ -754,14 +969,7 @@ static void *reserved_aperture_allocate_aligned(manageable_aperture_t *app,
 				VOID_PTR_ADD(start, (MemorySizeInBytes - 1)));
 		if (!new_area)
 			return NULL;
-		new_area->next = next;
-		new_area->prev = cur;
-		if (cur)
-			cur->next = new_area;
-		else
-			app->vm_ranges = new_area;
-		if (next)
-			next->prev = new_area;
+		app->vm_ranges = vm_area_insert(app->vm_ranges, new_area);
 	}
 
 	return start;
@@ -1246,9 +1454,11 @@ static void manageable_aperture_print(manageable_aperture_t *app)
 	pr_info("\t Base: %p\n", app->base);
 	pr_info("\t Limit: %p\n", app->limit);
 	pr_info("\t Ranges:\n");
+	while (cur && cur->left)
+		cur = cur->left;
 	while (cur) {
 		pr_info("\t\t Range [%p - %p]\n", cur->start, cur->end);
-		cur = cur->next;
+		cur = vm_area_higher(app->vm_ranges, cur->start);
 	};
 	pr_info("\t Objects:\n");
 	while (n) {
@@ -4533,11 +4743,8 @@ static void fmm_clear_aperture(manageable_aperture_t *app)
 	while ((n = rbtree_node_any(&app->tree, MID)))
 		vm_remove_object(app, vm_object_entry(n, 0));
 
-	while (app->vm_ranges) {
-		void *next_range = app->vm_ranges->next;
-		vm_remove_area(app, app->vm_ranges);
-		app->vm_ranges = next_range;
-	}
+	vm_area_free_all(app->vm_ranges);
+	app->vm_ranges = NULL;
 }
 
 /* This is a special funcion that should be called only from the child process
@@ -75,6 +75,7 @@ struct model_queue
 {
 	hsakmt_model_queue_t *queue;
 	uint32_t node_id;
+	bool destroying;
 };
 
 #define MAX_MODEL_QUEUES 128
@@ -226,7 +227,7 @@ static uint64_t get_sysfs_mem_bank_size(unsigned node_id, unsigned mem_id)
 	abort();
 }
 
-static void model_set_event(void *data, unsigned event_id)
+static void model_set_event_locked(unsigned event_id)
 {
 	if (!event_id)
 		return;
@@ -262,6 +263,16 @@ static void model_set_event(void *data, unsigned event_id)
 	pthread_cond_broadcast(&model_event_condvar);
 }
 
+/* Called by the model from its own threads. Take the IOCTL mutex so that a
+ * concurrent AMDKFD_IOC_WAIT_EVENTS cannot miss the wakeup between checking
+ * the events and waiting on the condition variable. */
+static void model_set_event(void *data, unsigned event_id)
+{
+	pthread_mutex_lock(&model_ioctl_mutex);
+	model_set_event_locked(event_id);
+	pthread_mutex_unlock(&model_ioctl_mutex);
+}
+
 void model_init(void)
 {
 	if (!hsakmt_use_model)
@@ -702,7 +713,7 @@ static int model_kfd_ioctl_locked(unsigned long request, void *arg)
 	case AMDKFD_IOC_SET_EVENT:
 	{
 		struct kfd_ioctl_set_event_args *args = arg;
-		model_set_event(NULL, args->event_id);
+		model_set_event_locked(args->event_id);
 		return 0;
 	}
 	case AMDKFD_IOC_RESET_EVENT:
@@ -775,7 +786,8 @@ static int model_kfd_ioctl_locked(unsigned long request, void *arg)
 	case AMDKFD_IOC_DESTROY_QUEUE:
 	{
 		struct kfd_ioctl_destroy_queue_args *args = arg;
-		if (args->queue_id >= MAX_MODEL_QUEUES || !model_queues[args->queue_id].queue)
+		if (args->queue_id >= MAX_MODEL_QUEUES || !model_queues[args->queue_id].queue ||
+		    model_queues[args->queue_id].destroying)
 		{
 			fprintf(stderr, "model: trying to destroy a queue that doesn't exist\n");
 			abort();
@@ -783,7 +795,16 @@ static int model_kfd_ioctl_locked(unsigned long request, void *arg)
 		struct model_queue *queue = &model_queues[args->queue_id];
 		// Older model versions simply leak the queue.
 		if (model_functions->version_minor >= 3)
+		{
+			// The model may wait for its queue threads, which can be blocked
+			// in model_set_event() on this mutex. The slot stays allocated
+			// until destroy_queue returns so CREATE_QUEUE can't reuse it.
+			queue->destroying = true;
+			pthread_mutex_unlock(&model_ioctl_mutex);
 			model_functions->destroy_queue(model_nodes[queue->node_id].model, queue->queue);
+			pthread_mutex_lock(&model_ioctl_mutex);
+			queue->destroying = false;
+		}
 		queue->queue = NULL;
 		return 0;
 	}
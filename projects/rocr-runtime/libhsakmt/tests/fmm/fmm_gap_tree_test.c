@@ -0,0 +1,310 @@
+/*
+ * Copyright © 2025 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice (including
+ * the next paragraph) shall be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Replays random allocate/release sequences on a reserved aperture and
+ * checks the gap tree against a reference model. The reference keeps the
+ * used ranges in a sorted array and searches it with the linear first-fit
+ * walk that reserved_aperture_allocate_aligned used before the ranges were
+ * kept in a tree. Both must return the same addresses and end up with the
+ * same ranges, and the cached subtree fields of the tree must stay exact.
+ *
+ * fmm.c is included so that its static functions can be called directly.
+ */
+
+#include "../../src/fmm.c"
+
+#define CHECK(cond)								\
+	do									\
+	{									\
+		if (!(cond))							\
+		{								\
+			fprintf(stderr, "%s:%d: check failed: %s\n",		\
+				__FILE__, __LINE__, #cond);			\
+			exit(EXIT_FAILURE);					\
+		}								\
+	} while (0)
+
+struct ref_range {
+	uint64_t start;
+	uint64_t end;
+};
+
+struct ref_aperture {
+	uint64_t base;
+	uint64_t limit;
+	uint64_t align;
+	uint32_t guard_pages;
+	struct ref_range *ranges;
+	uint32_t count;
+};
+
+static void ref_insert(struct ref_aperture *ref, uint32_t index,
+		       uint64_t start, uint64_t end)
+{
+	memmove(&ref->ranges[index + 1], &ref->ranges[index],
+		(ref->count - index) * sizeof(*ref->ranges));
+	ref->ranges[index].start = start;
+	ref->ranges[index].end = end;
+	ref->count++;
+}
+
+static void ref_remove(struct ref_aperture *ref, uint32_t index)
+{
+	ref->count--;
+	memmove(&ref->ranges[index], &ref->ranges[index + 1],
+		(ref->count - index) * sizeof(*ref->ranges));
+}
+
+/* Linear first-fit search over the sorted ranges */
+static uint64_t ref_allocate(struct ref_aperture *ref, uint64_t address,
+			     uint64_t size, uint64_t align)
+{
+	uint64_t offset = 0, orig_align = align, start;
+	uint32_t next = 0;
+	int64_t cur = -1;
+
+	if (align < ref->align)
+		align = ref->align;
+	while (align < GPU_HUGE_PAGE_SIZE && size >= (align << 1))
+		align <<= 1;
+	if (orig_align <= (uint64_t)PAGE_SIZE)
+		offset = align - (size & (align - 1));
+
+	size += (uint64_t)ref->guard_pages * PAGE_SIZE;
+
+	start = address ? address : ALIGN_UP(ref->base, align) + offset;
+	while (next < ref->count) {
+		if (ref->ranges[next].start > start &&
+		    ref->ranges[next].start - start >= size)
+			break;
+
+		cur = next++;
+		if (!address)
+			start = ALIGN_UP(ref->ranges[cur].end + 1, align) + offset;
+	}
+	if (next == ref->count &&
+	    (start > ref->limit || ref->limit - start + 1 < size))
+		return 0;
+
+	if (cur >= 0 && address &&
+	    address < ALIGN_UP(ref->ranges[cur].end + 1, align))
+		return 0;
+
+	if (cur >= 0 && ref->ranges[cur].end + 1 == start)
+		ref->ranges[cur].end = start + size - 1;
+	else
+		ref_insert(ref, next, start, start + size - 1);
+
+	return start;
+}
+
+static void ref_release(struct ref_aperture *ref, uint64_t address,
+			uint64_t size)
+{
+	struct ref_range *range = NULL;
+	uint32_t i;
+
+	size += (uint64_t)ref->guard_pages * PAGE_SIZE;
+
+	for (i = 0; i < ref->count; i++) {
+		if (ref->ranges[i].start <= address && ref->ranges[i].end >= address) {
+			range = &ref->ranges[i];
+			break;
+		}
+	}
+	if (!range)
+		return;
+
+	if (range->end - range->start + 1 == size) {
+		ref_remove(ref, i);
+	} else if (range->end - range->start + 1 > size) {
+		if (range->start == address)
+			range->start += size;
+		else if (range->end - address + 1 == size)
+			range->end -= size;
+		else {
+			uint64_t end = range->end;
+
+			range->end = address - 1;
+			ref_insert(ref, i + 1, address + size, end);
+		}
+	}
+}
+
+/* Checks the cached fields of the subtree and returns its height */
+static int check_subtree(vm_area_t *area, vm_area_t **prev)
+{
+	int left, right;
+	uint64_t gap = 0;
+
+	if (!area)
+		return 0;
+
+	left = check_subtree(area->left, prev);
+	if (*prev)
+		CHECK((*prev)->end < area->start);
+	*prev = area;
+	right = check_subtree(area->right, prev);
+
+	CHECK(area->start <= area->end);
+	CHECK(abs(left - right) <= 1);
+	CHECK(area->height == 1 + MAX(left, right));
+	CHECK(area->min_start == (area->left ? area->left->min_start : area->start));
+	CHECK(area->max_end == (area->right ? area->right->max_end : area->end));
+
+	if (area->left) {
+		gap = MAX(area->left->max_gap,
+			  vm_area_gap(area->left->max_end, area->start));
+	}
+	if (area->right) {
+		gap = MAX(gap, area->right->max_gap);
+		gap = MAX(gap, vm_area_gap(area->end, area->right->min_start));
+	}
+	CHECK(area->max_gap == gap);
+
+	return area->height;
+}
+
+static void collect(vm_area_t *area, struct ref_range *ranges, uint32_t *count)
+{
+	if (!area)
+		return;
+
+	collect(area->left, ranges, count);
+	ranges[*count].start = (uint64_t)area->start;
+	ranges[*count].end = (uint64_t)area->end;
+	(*count)++;
+	collect(area->right, ranges, count);
+}
+
+static void compare(manageable_aperture_t *app, struct ref_aperture *ref,
+		    struct ref_range *scratch)
+{
+	vm_area_t *prev = NULL;
+	uint32_t count = 0;
+
+	check_subtree(app->vm_ranges, &prev);
+	collect(app->vm_ranges, scratch, &count);
+	CHECK(count == ref->count);
+	CHECK(!memcmp(scratch, ref->ranges, count * sizeof(*scratch)));
+}
+
+static uint64_t rnd_state = 88172645463325252ull;
+
+static uint64_t rnd(void)
+{
+	rnd_state ^= rnd_state << 13;
+	rnd_state ^= rnd_state >> 7;
+	rnd_state ^= rnd_state << 17;
+	return rnd_state;
+}
+
+struct live {
+	uint64_t address;
+	uint64_t size;
+};
+
+static void run(uint64_t base, uint64_t limit, uint64_t align,
+		uint32_t guard_pages, uint32_t max_live, uint32_t ops)
+{
+	manageable_aperture_t app = INIT_MANAGEABLE_APERTURE(base, limit);
+	struct ref_aperture ref = {
+		.base = base,
+		.limit = limit,
+		.align = align,
+		.guard_pages = guard_pages,
+	};
+	/* Each release can split one range in two */
+	struct ref_range *scratch = calloc(2 * max_live + 1, sizeof(*scratch));
+	struct live *live = calloc(max_live, sizeof(*live));
+	uint32_t num_live = 0, failed = 0;
+
+	ref.ranges = calloc(2 * max_live + 1, sizeof(*ref.ranges));
+	CHECK(scratch && live && ref.ranges);
+	app.align = align;
+	app.guard_pages = guard_pages;
+
+	for (uint32_t i = 0; i < ops; i++) {
+		if (num_live < max_live && (num_live == 0 || rnd() % 3)) {
+			uint64_t size = (rnd() % 4 == 0) ? ((rnd() % 64) + 1) << 20 :
+							    ((rnd() % 16) + 1) * PAGE_SIZE;
+			uint64_t request_align = (rnd() % 8 == 0) ?
+						 (uint64_t)PAGE_SIZE << (rnd() % 10) : 0;
+			uint64_t address = 0;
+			uint64_t expected;
+			void *actual;
+
+			/* Fixed addresses land anywhere, mostly on used ranges */
+			if (rnd() % 50 == 0)
+				address = base + (rnd() % ((limit - base) / PAGE_SIZE)) * PAGE_SIZE;
+
+			expected = ref_allocate(&ref, address, size, request_align);
+			actual = reserved_aperture_allocate_aligned(&app, (void *)address,
+								    size, request_align);
+			CHECK((uint64_t)actual == expected);
+			if (actual) {
+				live[num_live].address = expected;
+				live[num_live].size = size;
+				num_live++;
+			} else {
+				failed++;
+			}
+		} else {
+			uint32_t k = rnd() % num_live;
+
+			ref_release(&ref, live[k].address, live[k].size);
+			reserved_aperture_release(&app, (void *)live[k].address,
+						  live[k].size);
+			live[k] = live[--num_live];
+		}
+
+		if (i % 64 == 0)
+			compare(&app, &ref, scratch);
+	}
+	compare(&app, &ref, scratch);
+
+	printf("aperture %" PRIx64 "-%" PRIx64 " guard pages %u: %u ops, %u failed allocations\n",
+	       base, limit, guard_pages, ops, failed);
+
+	vm_area_free_all(app.vm_ranges);
+	free(ref.ranges);
+	free(live);
+	free(scratch);
+}
+
+int main(void)
+{
+	hsakmt_page_size = sysconf(_SC_PAGESIZE);
+
+	/* Large aperture, allocations never run out of space */
+	run(0x100000000ull, 0x7fffffffffull, PAGE_SIZE, 1, 2000, 40000);
+	run(0x100000000ull, 0x7fffffffffull, PAGE_SIZE, 0, 2000, 40000);
+	/* Small aperture, the search often has to give up */
+	run(0x100000000ull, 0x1ffffffffull, 64 * 1024, 1, 500, 40000);
+
+	printf("PASSED\n");
+	return EXIT_SUCCESS;
+}
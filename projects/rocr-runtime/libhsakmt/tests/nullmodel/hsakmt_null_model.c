@@ -0,0 +1,617 @@
+/*
+ * Copyright © 2025 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice (including
+ * the next paragraph) shall be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Reference "null device" implementation of hsakmtmodeliface.h.
+ *
+ * Every registered queue is consumed by a host thread. AQL barrier packets
+ * wait for their dependent signals, kernel and agent dispatch packets retire
+ * as no-ops after a configurable latency, and completion signals are
+ * decremented just like the command processor would. SDMA queues execute the
+ * copy, fill, fence, atomic, poll and trap packets that ROCr emits.
+ *
+ * Built with -DBUILD_HSAKMT_NULL_MODEL=ON, or standalone from this directory.
+ *
+ * Usage:
+ *   HSA_MODEL_TOPOLOGY=<topology dir> HSA_MODEL_LIB=libhsakmt_null_model.so
+ *
+ * Optional environment variables:
+ *   HSA_NULL_MODEL_DISPATCH_LATENCY_US  time a kernel dispatch takes (0)
+ *   HSA_NULL_MODEL_IDLE_SLEEP_US        sleep of an idle queue thread
+ *                                       between polls, 0 to only yield (20)
+ */
+
+#define _GNU_SOURCE
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "hsakmt/hsakmtmodeliface.h"
+
+/* AQL packet header, see hsa_packet_header_t and hsa_packet_type_t. */
+#define AQL_HEADER_TYPE_MASK 0xff
+#define AQL_PACKET_TYPE_VENDOR_SPECIFIC 0
+#define AQL_PACKET_TYPE_INVALID 1
+#define AQL_PACKET_TYPE_KERNEL_DISPATCH 2
+#define AQL_PACKET_TYPE_BARRIER_AND 3
+#define AQL_PACKET_TYPE_AGENT_DISPATCH 4
+#define AQL_PACKET_TYPE_BARRIER_OR 5
+#define AQL_PACKET_SIZE 64
+
+/* AMD vendor packet formats, see hsa_amd_packet_type_t. */
+#define AMD_AQL_FORMAT_BARRIER_VALUE 2
+
+/* Condition of a barrier-value packet, see hsa_signal_condition_t. */
+#define SIGNAL_CONDITION_EQ 0
+#define SIGNAL_CONDITION_NE 1
+#define SIGNAL_CONDITION_LT 2
+#define SIGNAL_CONDITION_GTE 3
+
+/* SDMA opcodes, see sdma_registers.h in ROCr. */
+#define SDMA_OP_NOP 0
+#define SDMA_OP_COPY 1
+#define SDMA_OP_FENCE 5
+#define SDMA_OP_TRAP 6
+#define SDMA_OP_POLL_REGMEM 8
+#define SDMA_OP_ATOMIC 10
+#define SDMA_OP_CONST_FILL 11
+#define SDMA_OP_TIMESTAMP 13
+#define SDMA_OP_GCR 17
+#define SDMA_SUBOP_COPY_LINEAR 0
+#define SDMA_ATOMIC_ADD64 47
+
+/* Queue types, as in kfd_ioctl.h. */
+#define NULL_MODEL_QUEUE_TYPE_SDMA 1
+#define NULL_MODEL_QUEUE_TYPE_COMPUTE_AQL 2
+
+/* Layout of amd_signal_t, only the fields the model uses. */
+struct null_model_signal
+{
+	int64_t kind;
+	int64_t value;
+	uint64_t event_mailbox_ptr;
+	uint32_t event_id;
+};
+
+/* The fields shared by all AQL packets that complete a signal. */
+struct null_model_aql_packet
+{
+	uint16_t header;
+	uint8_t amd_format; /* Only valid for vendor specific packets */
+	uint8_t reserved0;
+	uint32_t reserved1;
+	uint64_t body[6];
+	uint64_t completion_signal;
+};
+
+/* Barrier-AND and barrier-OR packet */
+struct null_model_barrier_packet
+{
+	uint16_t header;
+	uint16_t reserved0;
+	uint32_t reserved1;
+	uint64_t dep_signal[5];
+	uint64_t reserved2;
+	uint64_t completion_signal;
+};
+
+/* AMD barrier-value packet */
+struct null_model_barrier_value_packet
+{
+	uint16_t header;
+	uint8_t amd_format;
+	uint8_t reserved0;
+	uint32_t reserved1;
+	uint64_t signal;
+	int64_t value;
+	int64_t mask;
+	uint32_t cond;
+	uint32_t reserved2;
+	uint64_t reserved3;
+	uint64_t reserved4;
+	uint64_t completion_signal;
+};
+
+struct hsakmt_model
+{
+	void *aperture;
+	uint64_t aperture_size;
+
+	hsakmt_model_set_event_fn set_event;
+	void *set_event_data;
+	void (*notify_event)(void *data);
+	void *notify_event_data;
+	void (*wait_event)(void *data, uint64_t address, uint64_t age);
+	void *wait_event_data;
+
+	pthread_mutex_t lock;
+	uint64_t allocated_size;
+
+	uint64_t dispatch_latency_ns;
+	uint64_t idle_sleep_ns;
+};
+
+struct hsakmt_model_queue
+{
+	struct hsakmt_model *model;
+	struct hsakmt_model_queue_info info;
+	pthread_t thread;
+	bool stop;
+};
+
+static uint64_t env_to_u64(const char *name, uint64_t default_value)
+{
+	const char *str = getenv(name);
+	if (!str || !*str)
+		return default_value;
+	return strtoull(str, NULL, 0);
+}
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/* Translate a GPU virtual address to the CPU address in the aperture. */
+static void *gpu_to_cpu(struct hsakmt_model *model, uint64_t address)
+{
+	if (address >= model->aperture_size)
+	{
+		fprintf(stderr, "null model: address 0x%" PRIx64 " outside of the aperture\n",
+				address);
+		abort();
+	}
+	return (char *)model->aperture + address;
+}
+
+static void idle_wait(struct hsakmt_model *model)
+{
+	if (!model->idle_sleep_ns)
+	{
+		sched_yield();
+		return;
+	}
+	struct timespec ts = {
+		.tv_sec = model->idle_sleep_ns / 1000000000ull,
+		.tv_nsec = model->idle_sleep_ns % 1000000000ull,
+	};
+	nanosleep(&ts, NULL);
+}
+
+/* Spin rather than sleep so that short latencies are accurate. */
+static void dispatch_delay(struct hsakmt_model *model)
+{
+	if (!model->dispatch_latency_ns)
+		return;
+	uint64_t end = now_ns() + model->dispatch_latency_ns;
+	while (now_ns() < end)
+		;
+}
+
+static void raise_event(struct hsakmt_model *model, uint32_t event_id)
+{
+	if (model->set_event)
+		model->set_event(model->set_event_data, event_id);
+	else if (model->notify_event)
+		model->notify_event(model->notify_event_data);
+}
+
+static int64_t signal_load(struct hsakmt_model *model, uint64_t handle)
+{
+	struct null_model_signal *signal = gpu_to_cpu(model, handle);
+	return __atomic_load_n(&signal->value, __ATOMIC_ACQUIRE);
+}
+
+/* Do what the command processor does at the end of a packet: decrement the
+ * completion signal and raise its event if it is an interrupt signal. */
+static void complete_signal(struct hsakmt_model *model, uint64_t handle)
+{
+	if (!handle)
+		return;
+	struct null_model_signal *signal = gpu_to_cpu(model, handle);
+	__atomic_fetch_sub(&signal->value, 1, __ATOMIC_ACQ_REL);
+	if (signal->event_mailbox_ptr && signal->event_id)
+		raise_event(model, signal->event_id);
+}
+
+static bool barrier_ready(struct hsakmt_model *model,
+						  const struct null_model_barrier_packet *packet, bool is_or)
+{
+	bool any_deps = false;
+	for (unsigned i = 0; i < 5; ++i)
+	{
+		if (!packet->dep_signal[i])
+			continue;
+		any_deps = true;
+		bool done = signal_load(model, packet->dep_signal[i]) == 0;
+		if (is_or && done)
+			return true;
+		if (!is_or && !done)
+			return false;
+	}
+	return !is_or || !any_deps;
+}
+
+static bool barrier_value_ready(struct hsakmt_model *model,
+								const struct null_model_barrier_value_packet *packet)
+{
+	int64_t value = signal_load(model, packet->signal) & packet->mask;
+	switch (packet->cond)
+	{
+	case SIGNAL_CONDITION_EQ:
+		return value == packet->value;
+	case SIGNAL_CONDITION_NE:
+		return value != packet->value;
+	case SIGNAL_CONDITION_LT:
+		return value < packet->value;
+	case SIGNAL_CONDITION_GTE:
+		return value >= packet->value;
+	default:
+		fprintf(stderr, "null model: invalid barrier-value condition %u\n", packet->cond);
+		abort();
+	}
+}
+
+/* Process the AQL packet in the slot. Returns false if the packet is not
+ * ready yet, either because it hasn't been written or because it waits on
+ * a signal. */
+static bool process_aql_packet(struct hsakmt_model *model, struct null_model_aql_packet *packet)
+{
+	uint16_t header = __atomic_load_n(&packet->header, __ATOMIC_ACQUIRE);
+	switch (header & AQL_HEADER_TYPE_MASK)
+	{
+	case AQL_PACKET_TYPE_INVALID:
+		return false;
+	case AQL_PACKET_TYPE_KERNEL_DISPATCH:
+		dispatch_delay(model);
+		break;
+	case AQL_PACKET_TYPE_AGENT_DISPATCH:
+		break;
+	case AQL_PACKET_TYPE_BARRIER_AND:
+	case AQL_PACKET_TYPE_BARRIER_OR:
+		if (!barrier_ready(model, (const struct null_model_barrier_packet *)packet,
+						   (header & AQL_HEADER_TYPE_MASK) == AQL_PACKET_TYPE_BARRIER_OR))
+			return false;
+		break;
+	case AQL_PACKET_TYPE_VENDOR_SPECIFIC:
+		if (packet->amd_format != AMD_AQL_FORMAT_BARRIER_VALUE)
+		{
+			fprintf(stderr, "null model: unsupported vendor packet format %u\n",
+					packet->amd_format);
+			abort();
+		}
+		if (!barrier_value_ready(model, (const struct null_model_barrier_value_packet *)packet))
+			return false;
+		break;
+	default:
+		fprintf(stderr, "null model: unsupported AQL packet type %u\n",
+				header & AQL_HEADER_TYPE_MASK);
+		abort();
+	}
+
+	/* Release the memory effects of the packet before the signal. */
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	uint64_t completion_signal = packet->completion_signal;
+
+	/* Hand the slot back to the producer. */
+	__atomic_store_n(&packet->header, AQL_PACKET_TYPE_INVALID, __ATOMIC_RELEASE);
+	complete_signal(model, completion_signal);
+	return true;
+}
+
+static bool sdma_poll_ready(uint32_t func, uint32_t value, uint32_t reference)
+{
+	switch (func)
+	{
+	case 0:
+		return true;
+	case 1:
+		return value < reference;
+	case 2:
+		return value <= reference;
+	case 3:
+		return value == reference;
+	case 4:
+		return value != reference;
+	case 5:
+		return value >= reference;
+	case 6:
+		return value > reference;
+	default:
+		fprintf(stderr, "null model: invalid SDMA poll function %u\n", func);
+		abort();
+	}
+}
+
+static uint64_t sdma_address(const uint32_t *dw)
+{
+	return (uint64_t)dw[0] | ((uint64_t)dw[1] << 32);
+}
+
+/* Execute the SDMA packet at dw. Returns the size of the packet in dwords,
+ * or 0 if the packet cannot make progress yet. */
+static uint32_t process_sdma_packet(struct hsakmt_model *model, const uint32_t *dw)
+{
+	uint32_t op = dw[0] & 0xff;
+	uint32_t sub_op = (dw[0] >> 8) & 0xff;
+
+	switch (op)
+	{
+	case SDMA_OP_NOP:
+		/* The count of padding dwords that follow is in bits 16-29. */
+		return 1 + ((dw[0] >> 16) & 0x3fff);
+	case SDMA_OP_COPY:
+	{
+		if (sub_op != SDMA_SUBOP_COPY_LINEAR)
+		{
+			fprintf(stderr, "null model: unsupported SDMA copy sub-op %u\n", sub_op);
+			abort();
+		}
+		/* The count is size - 1 in bytes; use the wider encoding, the
+		 * upper bits are reserved in the narrow one. */
+		uint64_t size = (uint64_t)(dw[1] & 0x3fffffff) + 1;
+		memmove(gpu_to_cpu(model, sdma_address(&dw[5])),
+				gpu_to_cpu(model, sdma_address(&dw[3])), size);
+		return 7;
+	}
+	case SDMA_OP_CONST_FILL:
+	{
+		/* ROCr only emits dword fills; the count is the offset of the last
+		 * dword in bytes. */
+		uint64_t num_dwords = (dw[4] & 0x3fffff) / 4 + 1;
+		uint32_t *dst = gpu_to_cpu(model, sdma_address(&dw[1]));
+		for (uint64_t i = 0; i < num_dwords; ++i)
+			dst[i] = dw[3];
+		return 5;
+	}
+	case SDMA_OP_FENCE:
+	{
+		uint32_t *dst = gpu_to_cpu(model, sdma_address(&dw[1]));
+		__atomic_store_n(dst, dw[3], __ATOMIC_RELEASE);
+		return 4;
+	}
+	case SDMA_OP_TRAP:
+		raise_event(model, dw[1] & 0xfffffff);
+		return 2;
+	case SDMA_OP_POLL_REGMEM:
+	{
+		bool mem_poll = (dw[0] >> 31) & 1;
+		/* Register polls (e.g. HDP flush) have nothing to wait on here. */
+		if (mem_poll)
+		{
+			uint32_t *src = gpu_to_cpu(model, sdma_address(&dw[1]));
+			uint32_t value = __atomic_load_n(src, __ATOMIC_ACQUIRE) & dw[4];
+			if (!sdma_poll_ready((dw[0] >> 28) & 7, value, dw[3]))
+				return 0;
+		}
+		return 6;
+	}
+	case SDMA_OP_ATOMIC:
+	{
+		uint32_t operation = (dw[0] >> 25) & 0x7f;
+		if (operation != SDMA_ATOMIC_ADD64)
+		{
+			fprintf(stderr, "null model: unsupported SDMA atomic %u\n", operation);
+			abort();
+		}
+		int64_t *dst = gpu_to_cpu(model, sdma_address(&dw[1]));
+		__atomic_fetch_add(dst, (int64_t)sdma_address(&dw[3]), __ATOMIC_ACQ_REL);
+		return 8;
+	}
+	case SDMA_OP_TIMESTAMP:
+	{
+		uint64_t *dst = gpu_to_cpu(model, sdma_address(&dw[1]));
+		*dst = now_ns();
+		return 3;
+	}
+	case SDMA_OP_GCR:
+		/* No caches to maintain */
+		return 5;
+	default:
+		fprintf(stderr, "null model: unsupported SDMA opcode %u\n", op);
+		abort();
+	}
+}
+
+static void *aql_queue_thread(void *arg)
+{
+	struct hsakmt_model_queue *queue = arg;
+	struct hsakmt_model *model = queue->model;
+	struct null_model_aql_packet *ring = gpu_to_cpu(model, queue->info.ring_base_address);
+	uint64_t *write_ptr = gpu_to_cpu(model, queue->info.write_pointer_address);
+	uint64_t *read_ptr = gpu_to_cpu(model, queue->info.read_pointer_address);
+	uint64_t num_packets = queue->info.ring_size / AQL_PACKET_SIZE;
+
+	while (!__atomic_load_n(&queue->stop, __ATOMIC_ACQUIRE))
+	{
+		/* The AQL read and write pointers count packets. */
+		uint64_t read_index = __atomic_load_n(read_ptr, __ATOMIC_RELAXED);
+		if (read_index == __atomic_load_n(write_ptr, __ATOMIC_ACQUIRE) ||
+			!process_aql_packet(model, &ring[read_index % num_packets]))
+		{
+			idle_wait(model);
+			continue;
+		}
+		__atomic_store_n(read_ptr, read_index + 1, __ATOMIC_RELEASE);
+	}
+	return NULL;
+}
+
+static void *sdma_queue_thread(void *arg)
+{
+	struct hsakmt_model_queue *queue = arg;
+	struct hsakmt_model *model = queue->model;
+	const char *ring = gpu_to_cpu(model, queue->info.ring_base_address);
+	uint64_t *write_ptr = gpu_to_cpu(model, queue->info.write_pointer_address);
+	uint64_t *read_ptr = gpu_to_cpu(model, queue->info.read_pointer_address);
+
+	while (!__atomic_load_n(&queue->stop, __ATOMIC_ACQUIRE))
+	{
+		/* The SDMA read and write pointers count bytes. ROCr pads the end of
+		 * the ring with NOPs, so a packet never wraps. */
+		uint64_t read_offset = __atomic_load_n(read_ptr, __ATOMIC_RELAXED);
+		uint32_t size = 0;
+		if (read_offset != __atomic_load_n(write_ptr, __ATOMIC_ACQUIRE))
+			size = process_sdma_packet(
+				model, (const uint32_t *)(ring + read_offset % queue->info.ring_size));
+		if (!size)
+		{
+			idle_wait(model);
+			continue;
+		}
+		__atomic_store_n(read_ptr, read_offset + size * 4, __ATOMIC_RELEASE);
+	}
+	return NULL;
+}
+
+static hsakmt_model_t *null_model_create(void)
+{
+	struct hsakmt_model *model = calloc(1, sizeof(*model));
+	if (!model)
+		return NULL;
+	pthread_mutex_init(&model->lock, NULL);
+	model->dispatch_latency_ns = env_to_u64("HSA_NULL_MODEL_DISPATCH_LATENCY_US", 0) * 1000;
+	model->idle_sleep_ns = env_to_u64("HSA_NULL_MODEL_IDLE_SLEEP_US", 20) * 1000;
+	return model;
+}
+
+static void null_model_destroy(hsakmt_model_t *model)
+{
+	pthread_mutex_destroy(&model->lock);
+	free(model);
+}
+
+static void null_model_set_global_aperture(hsakmt_model_t *model, void *base, uint64_t size)
+{
+	model->aperture = base;
+	model->aperture_size = size;
+}
+
+static void null_model_alloced_memory(hsakmt_model_t *model, void *base, uint64_t size,
+									  uint32_t flags)
+{
+	(void)base;
+	(void)flags;
+	pthread_mutex_lock(&model->lock);
+	model->allocated_size += size;
+	pthread_mutex_unlock(&model->lock);
+}
+
+static void null_model_freed_memory(hsakmt_model_t *model, void *base, uint64_t size)
+{
+	(void)base;
+	pthread_mutex_lock(&model->lock);
+	assert(model->allocated_size >= size);
+	model->allocated_size -= size;
+	pthread_mutex_unlock(&model->lock);
+}
+
+static void null_model_set_notify_event(hsakmt_model_t *model, void (*callback)(void *data),
+										void *data)
+{
+	model->notify_event = callback;
+	model->notify_event_data = data;
+}
+
+static void null_model_set_wait_event(hsakmt_model_t *model,
+									  void (*callback)(void *data, uint64_t address,
+													   uint64_t age),
+									  void *data)
+{
+	/* The null device never waits on host events. */
+	model->wait_event = callback;
+	model->wait_event_data = data;
+}
+
+static void null_model_set_set_event(hsakmt_model_t *model, hsakmt_model_set_event_fn fn,
+									 void *data)
+{
+	model->set_event = fn;
+	model->set_event_data = data;
+}
+
+static hsakmt_model_queue_t *null_model_register_queue(hsakmt_model_t *model,
+													   struct hsakmt_model_queue_info *info)
+{
+	void *(*thread_fn)(void *);
+	if (info->queue_type == NULL_MODEL_QUEUE_TYPE_COMPUTE_AQL)
+		thread_fn = aql_queue_thread;
+	else if (info->queue_type == NULL_MODEL_QUEUE_TYPE_SDMA)
+		thread_fn = sdma_queue_thread;
+	else
+	{
+		fprintf(stderr, "null model: unsupported queue type %u\n", info->queue_type);
+		abort();
+	}
+
+	struct hsakmt_model_queue *queue = calloc(1, sizeof(*queue));
+	if (!queue)
+		abort();
+	queue->model = model;
+	queue->info = *info;
+	if (pthread_create(&queue->thread, NULL, thread_fn, queue))
+	{
+		fprintf(stderr, "null model: failed to create queue thread\n");
+		abort();
+	}
+	return queue;
+}
+
+static void null_model_destroy_queue(hsakmt_model_t *model, hsakmt_model_queue_t *queue)
+{
+	(void)model;
+	__atomic_store_n(&queue->stop, true, __ATOMIC_RELEASE);
+	pthread_join(queue->thread, NULL);
+	free(queue);
+}
+
+static const struct hsakmt_model_functions null_model_functions = {
+	.version_major = HSAKMT_MODEL_INTERFACE_VERSION_MAJOR,
+	.version_minor = HSAKMT_MODEL_INTERFACE_VERSION_MINOR,
+	.create = null_model_create,
+	.destroy = null_model_destroy,
+	.set_global_aperture = null_model_set_global_aperture,
+	.alloced_memory = null_model_alloced_memory,
+	.freed_memory = null_model_freed_memory,
+	.set_notify_event = null_model_set_notify_event,
+	.set_wait_event = null_model_set_wait_event,
+	.register_queue = null_model_register_queue,
+	.set_set_event = null_model_set_set_event,
+	.destroy_queue = null_model_destroy_queue,
+};
+
+__attribute__((visibility("default"))) const struct hsakmt_model_functions *
+get_hsakmt_model_functions(void)
+{
+	return &null_model_functions;
+}
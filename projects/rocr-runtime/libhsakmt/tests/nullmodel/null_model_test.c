@@ -0,0 +1,196 @@
+/*
+ * Copyright © 2025 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice (including
+ * the next paragraph) shall be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Drives the null model through the model interface the way libhsakmt
+ * does: create a queue, dispatch AQL packets and destroy the queue. The
+ * set-event callback takes a lock like model_set_event() takes the ioctl
+ * mutex, and the queue is destroyed while its thread is blocked on that
+ * lock, with the lock released around destroy_queue as AMDKFD_IOC_DESTROY_QUEUE
+ * does.
+ */
+
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hsakmt/hsakmtmodeliface.h"
+
+const struct hsakmt_model_functions *get_hsakmt_model_functions(void);
+
+#define APERTURE_SIZE (1u << 20)
+#define RING_ADDRESS 0x1000
+#define RING_PACKETS 4
+#define WRITE_PTR_ADDRESS 0x2000
+#define READ_PTR_ADDRESS 0x2008
+#define SIGNAL_ADDRESS 0x3000
+#define DEP_SIGNAL_ADDRESS 0x3100
+#define MAILBOX_ADDRESS 0x3200
+#define EVENT_ID 7
+
+#define PACKET_TYPE_INVALID 1
+#define PACKET_TYPE_KERNEL_DISPATCH 2
+#define PACKET_TYPE_BARRIER_AND 3
+
+#define QUEUE_TYPE_COMPUTE_AQL 2
+
+#define CHECK(cond)                                                              \
+	do                                                                           \
+	{                                                                            \
+		if (!(cond))                                                             \
+		{                                                                        \
+			fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+			exit(EXIT_FAILURE);                                                  \
+		}                                                                        \
+	} while (0)
+
+struct signal
+{
+	int64_t kind;
+	int64_t value;
+	uint64_t event_mailbox_ptr;
+	uint32_t event_id;
+};
+
+static pthread_mutex_t ioctl_mutex = PTHREAD_MUTEX_INITIALIZER;
+static unsigned events_raised;
+static unsigned events_waiting;
+
+static void set_event(void *data, unsigned event_id)
+{
+	(void)data;
+	CHECK(event_id == EVENT_ID);
+	__atomic_add_fetch(&events_waiting, 1, __ATOMIC_SEQ_CST);
+	pthread_mutex_lock(&ioctl_mutex);
+	__atomic_add_fetch(&events_raised, 1, __ATOMIC_SEQ_CST);
+	pthread_mutex_unlock(&ioctl_mutex);
+	__atomic_sub_fetch(&events_waiting, 1, __ATOMIC_SEQ_CST);
+}
+
+static char *aperture;
+static uint64_t packets_written;
+
+static void *at(uint64_t address)
+{
+	return aperture + address;
+}
+
+static void write_packet(uint16_t type, uint64_t dep_signal, uint64_t completion_signal)
+{
+	uint64_t *packet = at(RING_ADDRESS + 64 * (packets_written % RING_PACKETS));
+
+	/* Wait for the model to hand the slot back. */
+	while (__atomic_load_n((uint16_t *)packet, __ATOMIC_ACQUIRE) != PACKET_TYPE_INVALID)
+		;
+	memset(packet + 1, 0, 56);
+	packet[1] = dep_signal;
+	packet[7] = completion_signal;
+	__atomic_store_n((uint64_t *)at(WRITE_PTR_ADDRESS), ++packets_written, __ATOMIC_SEQ_CST);
+	__atomic_store_n((uint16_t *)packet, type, __ATOMIC_RELEASE);
+}
+
+static void wait_signal(struct signal *signal, int64_t value)
+{
+	while (__atomic_load_n(&signal->value, __ATOMIC_ACQUIRE) != value)
+		;
+}
+
+/* The event is raised after the signal is decremented. */
+static void wait_events(unsigned count)
+{
+	while (__atomic_load_n(&events_raised, __ATOMIC_SEQ_CST) != count)
+		;
+}
+
+int main(void)
+{
+	const struct hsakmt_model_functions *fn = get_hsakmt_model_functions();
+	CHECK(fn->version_major == HSAKMT_MODEL_INTERFACE_VERSION_MAJOR);
+	CHECK(fn->version_minor >= 3);
+
+	hsakmt_model_t *model = fn->create();
+	CHECK(model);
+	aperture = aligned_alloc(4096, APERTURE_SIZE);
+	CHECK(aperture);
+	memset(aperture, 0, APERTURE_SIZE);
+	fn->set_global_aperture(model, aperture, APERTURE_SIZE);
+	fn->set_set_event(model, set_event, NULL);
+
+	for (unsigned i = 0; i < RING_PACKETS; ++i)
+		*(uint16_t *)at(RING_ADDRESS + 64 * i) = PACKET_TYPE_INVALID;
+
+	struct hsakmt_model_queue_info info = {
+		.ring_base_address = RING_ADDRESS,
+		.write_pointer_address = WRITE_PTR_ADDRESS,
+		.read_pointer_address = READ_PTR_ADDRESS,
+		.ring_size = RING_PACKETS * 64,
+		.queue_type = QUEUE_TYPE_COMPUTE_AQL,
+	};
+	hsakmt_model_queue_t *queue = fn->register_queue(model, &info);
+	CHECK(queue);
+
+	struct signal *signal = at(SIGNAL_ADDRESS);
+	struct signal *dep_signal = at(DEP_SIGNAL_ADDRESS);
+	signal->event_mailbox_ptr = MAILBOX_ADDRESS;
+	signal->event_id = EVENT_ID;
+
+	/* Kernel dispatches retire in order and wrap around the ring. */
+	__atomic_store_n(&signal->value, 2 * RING_PACKETS, __ATOMIC_RELEASE);
+	for (unsigned i = 0; i < 2 * RING_PACKETS; ++i)
+		write_packet(PACKET_TYPE_KERNEL_DISPATCH, 0, SIGNAL_ADDRESS);
+	wait_signal(signal, 0);
+	wait_events(2 * RING_PACKETS);
+	CHECK(__atomic_load_n((uint64_t *)at(READ_PTR_ADDRESS), __ATOMIC_SEQ_CST) ==
+		  packets_written);
+
+	/* A barrier holds back the queue until its dependency is done. */
+	__atomic_store_n(&dep_signal->value, 1, __ATOMIC_RELEASE);
+	__atomic_store_n(&signal->value, 2, __ATOMIC_RELEASE);
+	write_packet(PACKET_TYPE_BARRIER_AND, DEP_SIGNAL_ADDRESS, SIGNAL_ADDRESS);
+	write_packet(PACKET_TYPE_KERNEL_DISPATCH, 0, SIGNAL_ADDRESS);
+	for (unsigned i = 0; i < 1000; ++i)
+		CHECK(__atomic_load_n(&signal->value, __ATOMIC_ACQUIRE) == 2);
+	__atomic_store_n(&dep_signal->value, 0, __ATOMIC_RELEASE);
+	wait_signal(signal, 0);
+	wait_events(2 * RING_PACKETS + 2);
+
+	/* Destroy the queue while its thread waits for the ioctl lock. */
+	pthread_mutex_lock(&ioctl_mutex);
+	__atomic_store_n(&signal->value, 1, __ATOMIC_RELEASE);
+	write_packet(PACKET_TYPE_KERNEL_DISPATCH, 0, SIGNAL_ADDRESS);
+	while (!__atomic_load_n(&events_waiting, __ATOMIC_SEQ_CST))
+		;
+	pthread_mutex_unlock(&ioctl_mutex);
+	fn->destroy_queue(model, queue);
+	CHECK(__atomic_load_n(&events_raised, __ATOMIC_SEQ_CST) == 2 * RING_PACKETS + 3);
+
+	fn->destroy(model);
+	free(aperture);
+	printf("PASSED\n");
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,244 @@
+/*
+ * =============================================================================
+ *   ROC Runtime Conformance Release License
+ * =============================================================================
+ * The University of Illinois/NCSA
+ * Open Source License (NCSA)
+ *
+ * Copyright (c) 2026, Advanced Micro Devices, Inc.
+ * All rights reserved.
+ *
+ * Developed by:
+ *
+ *                 AMD Research and AMD ROC Software Development
+ *
+ *                 Advanced Micro Devices, Inc.
+ *
+ *                 www.amd.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal with the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimers.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimers in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the names of <Name of Development Group, Name of Institution>,
+ *    nor the names of its contributors may be used to endorse or promote
+ *    products derived from this Software without specific prior written
+ *    permission.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS WITH THE SOFTWARE.
+ *
+ */
+
+#include <stdlib.h>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include "suites/functional/async_handler.h"
+#include "common/base_rocr_utils.h"
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "hsa/hsa.h"
+#include "hsa/hsa_ext_amd.h"
+
+static const char* kWorkersEnv = "HSA_ASYNCEVENTS_WORKERS";
+static const char* kWorkers = "4";
+static const int kFastSignals = 3;
+static const hsa_signal_value_t kLastValue = 64;
+
+// Waits up to 10 seconds for cond, so that a broken runtime fails the test
+// instead of hanging it
+template <typename Cond> static bool WaitFor(Cond cond) {
+  auto end = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (!cond()) {
+    if (std::chrono::steady_clock::now() > end) return false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+struct SlowState {
+  std::atomic<bool> started{false};
+  std::atomic<bool> release{false};
+  std::atomic<bool> done{false};
+};
+
+static bool SlowCallback(hsa_signal_value_t value, void* arg) {
+  SlowState* state = reinterpret_cast<SlowState*>(arg);
+  state->started.store(true);
+  WaitFor([state]() { return state->release.load(); });
+  state->done.store(true);
+  return false;
+}
+
+static bool FastCallback(hsa_signal_value_t value, void* arg) {
+  reinterpret_cast<std::atomic<int>*>(arg)->fetch_add(1);
+  return false;
+}
+
+// Shared by the handlers of two signals, like the handlers of an AqlQueue
+struct OrderState {
+  std::atomic<int> running{0};
+  std::atomic<bool> overlapped{false};
+  std::atomic<bool> out_of_order{false};
+  std::atomic<hsa_signal_value_t> last[2];
+  std::atomic<int> done{0};
+};
+
+template <int I> static bool OrderCallback(hsa_signal_value_t value, void* arg) {
+  OrderState* state = reinterpret_cast<OrderState*>(arg);
+  if (state->running.fetch_add(1) != 0) state->overlapped.store(true);
+  if (value < state->last[I].load()) state->out_of_order.store(true);
+  state->last[I].store(value);
+  std::this_thread::sleep_for(std::chrono::microseconds(50));
+  state->running.fetch_sub(1);
+
+  if (value < kLastValue) return true;
+  state->done.fetch_add(1);
+  return false;
+}
+
+AsyncHandlerTest::AsyncHandlerTest(void) : TestBase(), had_workers_env_(false) {
+  set_title("RocR Async Signal Handler Test");
+  set_description("This test checks that async signal handlers run on the worker pool without"
+                  " delaying each other, and that the handlers of a signal run in order.");
+}
+
+AsyncHandlerTest::~AsyncHandlerTest(void) {}
+
+void AsyncHandlerTest::SetUp(void) {
+  hsa_status_t err;
+
+  // The pool size is read when the runtime is initialized
+  const char* env = getenv(kWorkersEnv);
+  had_workers_env_ = (env != nullptr);
+  if (had_workers_env_) workers_env_ = env;
+  setenv(kWorkersEnv, kWorkers, 1);
+
+  TestBase::SetUp();
+
+  err = rocrtst::SetDefaultAgents(this);
+  ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+}
+
+void AsyncHandlerTest::Run(void) {
+  if (!rocrtst::CheckProfile(this)) {
+    return;
+  }
+  TestBase::Run();
+}
+
+void AsyncHandlerTest::DisplayTestInfo(void) { TestBase::DisplayTestInfo(); }
+
+void AsyncHandlerTest::DisplayResults(void) const {
+  if (!rocrtst::CheckProfile(this)) {
+    return;
+  }
+  TestBase::DisplayResults();
+}
+
+void AsyncHandlerTest::Close() {
+  // This will close handles opened within rocrtst utility calls and call
+  // hsa_shut_down(), so it should be done after other hsa cleanup
+  TestBase::Close();
+
+  if (had_workers_env_)
+    setenv(kWorkersEnv, workers_env_.c_str(), 1);
+  else
+    unsetenv(kWorkersEnv);
+}
+
+void AsyncHandlerTest::SlowHandler(void) {
+  hsa_status_t err;
+  SlowState slow;
+  std::atomic<int> fast_done[kFastSignals];
+  hsa_signal_t slow_signal;
+  hsa_signal_t fast_signals[kFastSignals];
+
+  err = hsa_signal_create(0, 0, NULL, &slow_signal);
+  ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+  err = hsa_amd_signal_async_handler(slow_signal, HSA_SIGNAL_CONDITION_NE, 0, SlowCallback, &slow);
+  ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+
+  for (int i = 0; i < kFastSignals; ++i) {
+    fast_done[i].store(0);
+    err = hsa_signal_create(0, 0, NULL, &fast_signals[i]);
+    ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+    err = hsa_amd_signal_async_handler(fast_signals[i], HSA_SIGNAL_CONDITION_NE, 0, FastCallback,
+                                       &fast_done[i]);
+    ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+  }
+
+  hsa_signal_store_screlease(slow_signal, 1);
+  EXPECT_TRUE(WaitFor([&slow]() { return slow.started.load(); }));
+
+  // The slow handler is still blocked while the others run
+  for (int i = 0; i < kFastSignals; ++i) hsa_signal_store_screlease(fast_signals[i], 1);
+  for (int i = 0; i < kFastSignals; ++i)
+    EXPECT_TRUE(WaitFor([&fast_done, i]() { return fast_done[i].load() == 1; }))
+        << "handler of signal " << i << " waited for the slow handler";
+  EXPECT_FALSE(slow.done.load());
+
+  slow.release.store(true);
+  EXPECT_TRUE(WaitFor([&slow]() { return slow.done.load(); }));
+
+  for (int i = 0; i < kFastSignals; ++i) {
+    err = hsa_signal_destroy(fast_signals[i]);
+    ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+  }
+  err = hsa_signal_destroy(slow_signal);
+  ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+}
+
+void AsyncHandlerTest::HandlerOrder(void) {
+  hsa_status_t err;
+  OrderState state;
+  hsa_signal_t signals[2];
+
+  state.last[0].store(0);
+  state.last[1].store(0);
+  for (int i = 0; i < 2; ++i) {
+    err = hsa_signal_create(0, 0, NULL, &signals[i]);
+    ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+  }
+  err = hsa_amd_signal_async_handler(signals[0], HSA_SIGNAL_CONDITION_NE, 0, OrderCallback<0>,
+                                     &state);
+  ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+  err = hsa_amd_signal_async_handler(signals[1], HSA_SIGNAL_CONDITION_NE, 0, OrderCallback<1>,
+                                     &state);
+  ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+
+  // The handlers keep their signals until they see the last value
+  for (hsa_signal_value_t value = 1; value <= kLastValue; ++value) {
+    hsa_signal_store_screlease(signals[0], value);
+    hsa_signal_store_screlease(signals[1], value);
+    std::this_thread::sleep_for(std::chrono::microseconds(20));
+  }
+  EXPECT_TRUE(WaitFor([&state]() { return state.done.load() == 2; }));
+
+  EXPECT_FALSE(state.overlapped.load()) << "handlers sharing an argument ran concurrently";
+  EXPECT_FALSE(state.out_of_order.load()) << "a handler saw its signal go backwards";
+  EXPECT_EQ(kLastValue, state.last[0].load());
+  EXPECT_EQ(kLastValue, state.last[1].load());
+
+  for (int i = 0; i < 2; ++i) {
+    err = hsa_signal_destroy(signals[i]);
+    ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+  }
+}
@@ -0,0 +1,95 @@
+/*
+ * =============================================================================
+ *   ROC Runtime Conformance Release License
+ * =============================================================================
+ * The University of Illinois/NCSA
+ * Open Source License (NCSA)
+ *
+ * Copyright (c) 2026, Advanced Micro Devices, Inc.
+ * All rights reserved.
+ *
+ * Developed by:
+ *
+ *                 AMD Research and AMD ROC Software Development
+ *
+ *                 Advanced Micro Devices, Inc.
+ *
+ *                 www.amd.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal with the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimers.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimers in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the names of <Name of Development Group, Name of Institution>,
+ *    nor the names of its contributors may be used to endorse or promote
+ *    products derived from this Software without specific prior written
+ *    permission.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS WITH THE SOFTWARE.
+ *
+ */
+
+#ifndef ROCRTST_SUITES_FUNCTIONAL_ASYNC_HANDLER_H_
+#define ROCRTST_SUITES_FUNCTIONAL_ASYNC_HANDLER_H_
+
+#include <string>
+
+#include "common/base_rocr.h"
+#include "hsa/hsa.h"
+#include "suites/test_common/test_base.h"
+
+// @Brief: Checks async signal handlers run on the HSA_ASYNCEVENTS_WORKERS
+//  pool: a slow handler doesn't hold back the handlers of other signals and
+//  handlers which keep their signal, or share their argument, run in order.
+
+class AsyncHandlerTest : public TestBase {
+ public:
+  AsyncHandlerTest(void);
+
+  // @Brief: Destructor for the AsyncHandlerTest class
+  virtual ~AsyncHandlerTest(void);
+
+  // @Brief: Setup the environment for measurement
+  virtual void SetUp(void);
+
+  // @Brief: Core measurement execution
+  virtual void Run(void);
+
+  // @Brief: Clean up and retrive the resource
+  virtual void Close(void);
+
+  // @Brief: Display  results
+  virtual void DisplayResults(void) const;
+
+  // @Brief: Display information about what this test does
+  virtual void DisplayTestInfo(void);
+
+  // @Brief: Handlers of other signals complete while one handler is
+  //  blocked
+  void SlowHandler(void);
+
+  // @Brief: A handler which keeps its signal sees the signal values in
+  //  order, and handlers sharing an argument never run concurrently
+  void HandlerOrder(void);
+
+ private:
+  // @Brief: Value of HSA_ASYNCEVENTS_WORKERS before SetUp
+  bool had_workers_env_;
+  std::string workers_env_;
+};
+
+#endif  // ROCRTST_SUITES_FUNCTIONAL_ASYNC_HANDLER_H_
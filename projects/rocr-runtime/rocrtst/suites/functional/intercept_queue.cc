@@ -0,0 +1,249 @@
+/*
+ * =============================================================================
+ *   ROC Runtime Conformance Release License
+ * =============================================================================
+ * The University of Illinois/NCSA
+ * Open Source License (NCSA)
+ *
+ * Copyright (c) 2026, Advanced Micro Devices, Inc.
+ * All rights reserved.
+ *
+ * Developed by:
+ *
+ *                 AMD Research and AMD ROC Software Development
+ *
+ *                 Advanced Micro Devices, Inc.
+ *
+ *                 www.amd.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal with the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimers.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimers in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the names of <Name of Development Group, Name of Institution>,
+ *    nor the names of its contributors may be used to endorse or promote
+ *    products derived from this Software without specific prior written
+ *    permission.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS WITH THE SOFTWARE.
+ *
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "suites/functional/intercept_queue.h"
+#include "suites/test_common/tool/rocrtst_tool.h"
+#include "common/base_rocr_utils.h"
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "hsa/hsa.h"
+#include "hsa/hsa_ext_amd.h"
+
+static const uint32_t kQueueSize = 64;
+
+static inline void AtomicSetPacketHeader(uint16_t header, hsa_barrier_and_packet_t* packet) {
+  __atomic_store_n(reinterpret_cast<uint16_t*>(packet), header, __ATOMIC_RELEASE);
+}
+
+InterceptQueueTest::InterceptQueueTest(void) : TestBase(), amd_ext_(nullptr), duplicate_(false) {
+  set_title("RocR Intercept Queue Test");
+  set_description("This test checks that intercept queues pass runs of packets to the"
+                  " interceptors and that rewritten packets are all submitted.");
+}
+
+InterceptQueueTest::~InterceptQueueTest(void) {}
+
+void InterceptQueueTest::SetUp(void) {
+  hsa_status_t err;
+
+  TestBase::SetUp();
+
+  err = rocrtst::SetDefaultAgents(this);
+  ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+
+  const HsaApiTable* table = rocrtst_tool_api_table();
+  ASSERT_NE(nullptr, table) << "rocrtst tool library was not loaded by the runtime";
+  amd_ext_ = table->amd_ext_;
+}
+
+void InterceptQueueTest::Run(void) {
+  if (!rocrtst::CheckProfile(this)) {
+    return;
+  }
+  TestBase::Run();
+}
+
+void InterceptQueueTest::DisplayTestInfo(void) { TestBase::DisplayTestInfo(); }
+
+void InterceptQueueTest::DisplayResults(void) const {
+  if (!rocrtst::CheckProfile(this)) {
+    return;
+  }
+  TestBase::DisplayResults();
+}
+
+void InterceptQueueTest::Close() {
+  // This will close handles opened within rocrtst utility calls and call
+  // hsa_shut_down(), so it should be done after other hsa cleanup
+  TestBase::Close();
+}
+
+void InterceptQueueTest::Interceptor(const void* pkts, uint64_t pkt_count,
+                                     uint64_t user_pkt_index, void* data,
+                                     hsa_amd_queue_intercept_packet_writer writer) {
+  InterceptQueueTest* test = reinterpret_cast<InterceptQueueTest*>(data);
+  {
+    std::lock_guard<std::mutex> lock(test->runs_lock_);
+    test->runs_.push_back(pkt_count);
+  }
+
+  if (!test->duplicate_) {
+    writer(pkts, pkt_count);
+    return;
+  }
+
+  const hsa_barrier_and_packet_t* packets = reinterpret_cast<const hsa_barrier_and_packet_t*>(pkts);
+  std::vector<hsa_barrier_and_packet_t> rewrite;
+  rewrite.reserve(2 * pkt_count);
+  for (uint64_t i = 0; i < pkt_count; ++i) {
+    rewrite.push_back(packets[i]);
+    rewrite.push_back(packets[i]);
+  }
+  writer(rewrite.data(), rewrite.size());
+}
+
+hsa_queue_t* InterceptQueueTest::CreateInterceptQueue(void) {
+  hsa_queue_t* queue = nullptr;
+  hsa_status_t err = amd_ext_->hsa_amd_queue_intercept_create_fn(
+      *gpu_device1(), kQueueSize, HSA_QUEUE_TYPE_MULTI, nullptr, nullptr, UINT32_MAX, UINT32_MAX,
+      &queue);
+  EXPECT_EQ(HSA_STATUS_SUCCESS, err);
+  if (err != HSA_STATUS_SUCCESS) return nullptr;
+
+  err = amd_ext_->hsa_amd_queue_intercept_register_fn(queue, Interceptor, this);
+  EXPECT_EQ(HSA_STATUS_SUCCESS, err);
+  return queue;
+}
+
+void InterceptQueueTest::SubmitBarriers(hsa_queue_t* queue, uint64_t count, hsa_signal_t signal) {
+  hsa_barrier_and_packet_t* ring = reinterpret_cast<hsa_barrier_and_packet_t*>(queue->base_address);
+  const uint32_t mask = queue->size - 1;
+  uint64_t index = hsa_queue_add_write_index_relaxed(queue, count);
+
+  uint16_t header = HSA_PACKET_TYPE_BARRIER_AND << HSA_PACKET_HEADER_TYPE;
+  header |= HSA_FENCE_SCOPE_SYSTEM << HSA_PACKET_HEADER_SCACQUIRE_FENCE_SCOPE;
+  header |= HSA_FENCE_SCOPE_SYSTEM << HSA_PACKET_HEADER_SCRELEASE_FENCE_SCOPE;
+
+  for (uint64_t i = index; i < index + count; ++i) {
+    hsa_barrier_and_packet_t* packet = &ring[i & mask];
+    memset(reinterpret_cast<uint8_t*>(packet) + sizeof(packet->header), 0,
+           sizeof(*packet) - sizeof(packet->header));
+    packet->completion_signal = signal;
+    AtomicSetPacketHeader(header, packet);
+  }
+
+  // Publish all packets before the only doorbell ring.
+  hsa_signal_store_screlease(queue->doorbell_signal, index + count - 1);
+}
+
+void InterceptQueueTest::WaitForZero(hsa_signal_t signal) {
+  uint64_t freq = 0;
+  hsa_status_t err = hsa_system_get_info(HSA_SYSTEM_INFO_TIMESTAMP_FREQUENCY, &freq);
+  ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+
+  // Time out after 10 seconds
+  hsa_signal_value_t value = hsa_signal_wait_scacquire(signal, HSA_SIGNAL_CONDITION_EQ, 0,
+                                                       10 * freq, HSA_WAIT_STATE_BLOCKED);
+  ASSERT_EQ(0, value);
+}
+
+void InterceptQueueTest::BatchedIntercept(void) {
+  hsa_status_t err;
+  duplicate_ = false;
+
+  hsa_queue_t* queue = CreateInterceptQueue();
+  ASSERT_NE(nullptr, queue);
+
+  hsa_signal_t signal;
+  err = hsa_signal_create(1, 0, nullptr, &signal);
+  ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+
+  // All packets of one doorbell ring reach the interceptor in one call.
+  const uint64_t first = kQueueSize / 4;
+  hsa_signal_store_relaxed(signal, first);
+  SubmitBarriers(queue, first, signal);
+  WaitForZero(signal);
+  {
+    std::lock_guard<std::mutex> lock(runs_lock_);
+    ASSERT_EQ(std::vector<uint64_t>({first}), runs_);
+    runs_.clear();
+  }
+
+  // A full queue of packets wraps around the end of the ring buffer, which
+  // splits it in two runs.
+  hsa_signal_store_relaxed(signal, kQueueSize);
+  SubmitBarriers(queue, kQueueSize, signal);
+  WaitForZero(signal);
+  {
+    std::lock_guard<std::mutex> lock(runs_lock_);
+    ASSERT_EQ(std::vector<uint64_t>({kQueueSize - first, first}), runs_);
+    runs_.clear();
+  }
+
+  if (verbosity() > 0) {
+    std::cout << "Intercepted " << first + kQueueSize << " packets in 3 runs." << std::endl;
+  }
+
+  err = hsa_signal_destroy(signal);
+  ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+  err = hsa_queue_destroy(queue);
+  ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+}
+
+void InterceptQueueTest::OverflowIntercept(void) {
+  hsa_status_t err;
+  duplicate_ = true;
+
+  hsa_queue_t* queue = CreateInterceptQueue();
+  ASSERT_NE(nullptr, queue);
+
+  hsa_signal_t signal;
+  err = hsa_signal_create(1, 0, nullptr, &signal);
+  ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+
+  // Each rewrite is twice the size of the hardware queue, so most of it goes
+  // to the overflow buffer and is submitted as the queue drains.
+  for (int iter = 0; iter < 4; ++iter) {
+    hsa_signal_store_relaxed(signal, 2 * kQueueSize);
+    SubmitBarriers(queue, kQueueSize, signal);
+    WaitForZero(signal);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(runs_lock_);
+    uint64_t intercepted = 0;
+    for (uint64_t run : runs_) intercepted += run;
+    ASSERT_EQ(4 * kQueueSize, intercepted);
+  }
+
+  err = hsa_signal_destroy(signal);
+  ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+  err = hsa_queue_destroy(queue);
+  ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+}
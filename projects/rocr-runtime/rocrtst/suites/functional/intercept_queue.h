@@ -0,0 +1,116 @@
+/*
+ * =============================================================================
+ *   ROC Runtime Conformance Release License
+ * =============================================================================
+ * The University of Illinois/NCSA
+ * Open Source License (NCSA)
+ *
+ * Copyright (c) 2026, Advanced Micro Devices, Inc.
+ * All rights reserved.
+ *
+ * Developed by:
+ *
+ *                 AMD Research and AMD ROC Software Development
+ *
+ *                 Advanced Micro Devices, Inc.
+ *
+ *                 www.amd.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal with the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimers.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimers in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the names of <Name of Development Group, Name of Institution>,
+ *    nor the names of its contributors may be used to endorse or promote
+ *    products derived from this Software without specific prior written
+ *    permission.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS WITH THE SOFTWARE.
+ *
+ */
+
+#ifndef ROCRTST_SUITES_FUNCTIONAL_INTERCEPT_QUEUE_H_
+#define ROCRTST_SUITES_FUNCTIONAL_INTERCEPT_QUEUE_H_
+
+#include <mutex>
+#include <vector>
+
+#include "common/base_rocr.h"
+#include "hsa/hsa.h"
+#include "hsa/hsa_api_trace.h"
+#include "suites/test_common/test_base.h"
+
+// @Brief: Checks that intercept queues hand contiguous runs of packets to
+//  the interceptors and that rewrites which overflow the hardware queue are
+//  submitted in full.
+
+class InterceptQueueTest : public TestBase {
+ public:
+  InterceptQueueTest(void);
+
+  // @Brief: Destructor for the InterceptQueueTest class
+  virtual ~InterceptQueueTest(void);
+
+  // @Brief: Setup the environment for measurement
+  virtual void SetUp(void);
+
+  // @Brief: Core measurement execution
+  virtual void Run(void);
+
+  // @Brief: Clean up and retrive the resource
+  virtual void Close(void);
+
+  // @Brief: Display  results
+  virtual void DisplayResults(void) const;
+
+  // @Brief: Display information about what this test does
+  virtual void DisplayTestInfo(void);
+
+  // @Brief: Packets published with a single doorbell ring are intercepted
+  //  together, split only where the ring buffer wraps
+  void BatchedIntercept(void);
+
+  // @Brief: A rewrite which doubles every packet overflows the hardware
+  //  queue, all packets must still be executed
+  void OverflowIntercept(void);
+
+ private:
+  static void Interceptor(const void* pkts, uint64_t pkt_count, uint64_t user_pkt_index,
+                          void* data, hsa_amd_queue_intercept_packet_writer writer);
+
+  // @Brief: Create an intercept queue of kQueueSize packets on the GPU
+  //  agent, with Interceptor registered on it
+  hsa_queue_t* CreateInterceptQueue(void);
+
+  // @Brief: Write count barrier-AND packets which decrement signal, then
+  //  ring the doorbell once
+  void SubmitBarriers(hsa_queue_t* queue, uint64_t count, hsa_signal_t signal);
+
+  // @Brief: Wait for signal to reach 0 with a timeout
+  void WaitForZero(hsa_signal_t signal);
+
+  const AmdExtTable* amd_ext_;
+
+  // @Brief: Whether Interceptor writes every packet twice
+  bool duplicate_;
+
+  // @Brief: Number of packets of each interceptor invocation
+  std::mutex runs_lock_;
+  std::vector<uint64_t> runs_;
+};
+
+#endif  // ROCRTST_SUITES_FUNCTIONAL_INTERCEPT_QUEUE_H_
@@ -0,0 +1,532 @@
+/*
+ * =============================================================================
+ *   ROC Runtime Conformance Release License
+ * =============================================================================
+ * The University of Illinois/NCSA
+ * Open Source License (NCSA)
+ *
+ * Copyright (c) 2026, Advanced Micro Devices, Inc.
+ * All rights reserved.
+ *
+ * Developed by:
+ *
+ *                 AMD Research and AMD ROC Software Development
+ *
+ *                 Advanced Micro Devices, Inc.
+ *
+ *                 www.amd.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal with the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimers.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimers in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the names of <Name of Development Group, Name of Institution>,
+ *    nor the names of its contributors may be used to endorse or promote
+ *    products derived from this Software without specific prior written
+ *    permission.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS WITH THE SOFTWARE.
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "suites/performance/host_overhead.h"
+#include "suites/test_common/tool/rocrtst_tool.h"
+#include "common/base_rocr_utils.h"
+#include "common/common.h"
+#include "common/helper_funcs.h"
+#include "common/hsatimer.h"
+#include "gtest/gtest.h"
+#include "hsa/hsa.h"
+#include "hsa/hsa_ext_amd.h"
+#include "hsa/hsa_ven_amd_loader.h"
+
+static const size_t kAllocationSize = 4096;
+static const uint32_t kInterceptQueueSize = 256;
+
+// Lengths of the interceptor chains, 0 is a queue without interception
+static const uint32_t kInterceptChains[] = {0, 1, 4};
+
+static void PassThroughInterceptor(const void* pkts, uint64_t pkt_count, uint64_t user_pkt_index,
+                                   void* data, hsa_amd_queue_intercept_packet_writer writer) {
+  writer(pkts, pkt_count);
+}
+
+// CPU time each async handler spends before it returns
+static const std::chrono::microseconds kHandlerWork(20);
+
+static bool AsyncHandlerWork(hsa_signal_value_t value, void* arg) {
+  auto start = std::chrono::steady_clock::now();
+  while (std::chrono::steady_clock::now() - start < kHandlerWork) {
+  }
+  static_cast<std::atomic<uint32_t>*>(arg)->fetch_add(1, std::memory_order_release);
+  return false;
+}
+
+HostOverhead::HostOverhead(Benchmark benchmark) : TestBase(), benchmark_(benchmark) {
+#if ROCRTST_EMULATOR_BUILD
+  batch_size_ = 10;
+  num_allocations_ = 16;
+  packet_batch_ = 8;
+  num_handlers_ = 4;
+  set_num_iteration(1);
+#else
+  batch_size_ = 1000;
+  num_allocations_ = 10000;
+  packet_batch_ = kInterceptQueueSize / 2;
+  num_handlers_ = 64;
+  set_num_iteration(100);
+#endif
+
+  std::string name = "Host Overhead";
+  std::string desc = "This test measures the CPU time spent in runtime bookkeeping paths that do"
+      " not wait for the GPU.";
+
+  switch (benchmark_) {
+    case kSignalOps:
+      name += ", Signal Operations";
+      desc += " It times signal creation, a wait on an already satisfied condition and signal"
+          " destruction.";
+      break;
+    case kPointerInfo:
+      name += ", Pointer Info";
+      desc += " It times hsa_amd_pointer_info on interior addresses of " +
+          std::to_string(num_allocations_) + " live allocations.";
+      break;
+    case kLoaderQueries:
+      name += ", Loader Queries";
+      desc += " It times loader lookups of a loaded kernel by device address and by symbol"
+          " name.";
+      set_kernel_file_name("dispatch_time_kernels.hsaco");
+      set_kernel_name("empty_kernel");
+      break;
+    case kInterceptChain:
+      name += ", Intercept Chain";
+      desc += " It times batches of " + std::to_string(packet_batch_) + " barrier packets from"
+          " the doorbell ring to completion on a plain queue and on intercept queues with"
+          " chains of pass-through interceptors.";
+      break;
+    case kAsyncHandlers:
+      name += ", Async Handlers";
+      desc += " It signals " + std::to_string(num_handlers_) + " signals at once, each with an"
+          " async handler that spins for " + std::to_string(kHandlerWork.count()) + " uS, and"
+          " times until all handlers have returned. Compare runs with different"
+          " HSA_ASYNCEVENTS_WORKERS values.";
+      break;
+  }
+
+  set_title(name);
+  set_description(desc);
+}
+
+HostOverhead::~HostOverhead() {}
+
+void HostOverhead::SetUp() {
+  hsa_status_t err;
+  TestBase::SetUp();
+
+  err = rocrtst::SetDefaultAgents(this);
+  ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+}
+
+void HostOverhead::Run() {
+  if (!rocrtst::CheckProfile(this)) {
+    return;
+  }
+  TestBase::Run();
+
+  switch (benchmark_) {
+    case kSignalOps:
+      RunSignalOps();
+      break;
+    case kPointerInfo:
+      RunPointerInfo();
+      break;
+    case kLoaderQueries:
+      RunLoaderQueries();
+      break;
+    case kInterceptChain:
+      RunInterceptChain();
+      break;
+    case kAsyncHandlers:
+      RunAsyncHandlers();
+      break;
+  }
+}
+
+size_t HostOverhead::RealIterationNum() { return num_iteration() * 1.2 + 1; }
+
+double HostOverhead::MeanPerOp(std::vector<double>* timer, size_t ops_per_sample) const {
+  // Abandon the first result and after sort, delete the slowest values
+  timer->erase(timer->begin());
+  std::sort(timer->begin(), timer->end());
+  timer->erase(timer->begin() + num_iteration(), timer->end());
+
+  return rocrtst::CalcMean(*timer) / ops_per_sample;
+}
+
+void HostOverhead::RunSignalOps() {
+  std::vector<double> create_timer;
+  std::vector<double> wait_timer;
+  std::vector<double> destroy_timer;
+  std::vector<hsa_signal_t> signals(batch_size_);
+  hsa_status_t err;
+
+  rocrtst::PerfTimer p_timer;
+  size_t it = RealIterationNum();
+  for (size_t i = 0; i < it; i++) {
+    int id = p_timer.CreateTimer();
+    p_timer.StartTimer(id);
+    for (uint32_t j = 0; j < batch_size_; j++) {
+      err = hsa_signal_create(0, 0, nullptr, &signals[j]);
+      ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+    }
+    p_timer.StopTimer(id);
+    create_timer.push_back(p_timer.ReadTimer(id));
+
+    // The condition is already satisfied so only the runtime's wait path is timed.
+    id = p_timer.CreateTimer();
+    p_timer.StartTimer(id);
+    for (uint32_t j = 0; j < batch_size_; j++) {
+      hsa_signal_value_t value = hsa_signal_wait_scacquire(signals[j], HSA_SIGNAL_CONDITION_EQ,
+                                                           0, UINT64_MAX, HSA_WAIT_STATE_BLOCKED);
+      ASSERT_EQ(0, value);
+    }
+    p_timer.StopTimer(id);
+    wait_timer.push_back(p_timer.ReadTimer(id));
+
+    id = p_timer.CreateTimer();
+    p_timer.StartTimer(id);
+    for (uint32_t j = 0; j < batch_size_; j++) {
+      err = hsa_signal_destroy(signals[j]);
+      ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+    }
+    p_timer.StopTimer(id);
+    destroy_timer.push_back(p_timer.ReadTimer(id));
+
+    if (verbosity() >= VERBOSE_PROGRESS) {
+      std::cout << ".";
+      fflush(stdout);
+    }
+  }
+
+  if (verbosity() >= VERBOSE_PROGRESS) {
+    std::cout << std::endl;
+  }
+
+  results_.push_back({"hsa_signal_create", MeanPerOp(&create_timer, batch_size_)});
+  results_.push_back({"hsa_signal_wait_scacquire (satisfied)",
+                      MeanPerOp(&wait_timer, batch_size_)});
+  results_.push_back({"hsa_signal_destroy", MeanPerOp(&destroy_timer, batch_size_)});
+}
+
+void HostOverhead::RunPointerInfo() {
+  hsa_status_t err;
+
+  err = hsa_amd_agent_iterate_memory_pools(*cpu_device(), rocrtst::GetGlobalMemoryPool,
+                                           &cpu_pool());
+  ASSERT_EQ(HSA_STATUS_INFO_BREAK, err);
+
+  std::vector<void*> allocations(num_allocations_, nullptr);
+  for (uint32_t i = 0; i < num_allocations_; i++) {
+    err = hsa_amd_memory_pool_allocate(cpu_pool(), kAllocationSize, 0, &allocations[i]);
+    ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+  }
+
+  // Look up interior addresses of random allocations so the lookup cannot
+  // be satisfied by matching the base address alone.
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<uint32_t> pick(0, num_allocations_ - 1);
+  std::vector<const void*> queries(batch_size_);
+  for (uint32_t j = 0; j < batch_size_; j++) {
+    queries[j] = static_cast<const char*>(allocations[pick(rng)]) + (j % kAllocationSize);
+  }
+
+  std::vector<double> timer;
+  rocrtst::PerfTimer p_timer;
+  size_t it = RealIterationNum();
+  for (size_t i = 0; i < it; i++) {
+    int id = p_timer.CreateTimer();
+    p_timer.StartTimer(id);
+    for (uint32_t j = 0; j < batch_size_; j++) {
+      hsa_amd_pointer_info_t info;
+      info.size = sizeof(info);
+      err = hsa_amd_pointer_info(queries[j], &info, nullptr, nullptr, nullptr);
+      ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+    }
+    p_timer.StopTimer(id);
+    timer.push_back(p_timer.ReadTimer(id));
+
+    if (verbosity() >= VERBOSE_PROGRESS) {
+      std::cout << ".";
+      fflush(stdout);
+    }
+  }
+
+  if (verbosity() >= VERBOSE_PROGRESS) {
+    std::cout << std::endl;
+  }
+
+  for (void* ptr : allocations) {
+    err = hsa_amd_memory_pool_free(ptr);
+    ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+  }
+
+  results_.push_back({"hsa_amd_pointer_info", MeanPerOp(&timer, batch_size_)});
+}
+
+void HostOverhead::RunLoaderQueries() {
+  hsa_status_t err;
+
+  hsa_ven_amd_loader_1_01_pfn_t loader;
+  err = hsa_system_get_major_extension_table(HSA_EXTENSION_AMD_LOADER, 1,
+                                             sizeof(loader), &loader);
+  ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+
+  err = rocrtst::LoadKernelFromObjFile(this, gpu_device1());
+  ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+
+  const void* kernel_address = reinterpret_cast<const void*>(kernel_object());
+  hsa_executable_t executable;
+  err = loader.hsa_ven_amd_loader_query_executable(kernel_address, &executable);
+  ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+
+  std::string symbol_name = kernel_name() + ".kd";
+
+  std::vector<double> executable_timer;
+  std::vector<double> host_address_timer;
+  std::vector<double> symbol_timer;
+  rocrtst::PerfTimer p_timer;
+  size_t it = RealIterationNum();
+  for (size_t i = 0; i < it; i++) {
+    int id = p_timer.CreateTimer();
+    p_timer.StartTimer(id);
+    for (uint32_t j = 0; j < batch_size_; j++) {
+      hsa_executable_t found;
+      err = loader.hsa_ven_amd_loader_query_executable(kernel_address, &found);
+      ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+    }
+    p_timer.StopTimer(id);
+    executable_timer.push_back(p_timer.ReadTimer(id));
+
+    id = p_timer.CreateTimer();
+    p_timer.StartTimer(id);
+    for (uint32_t j = 0; j < batch_size_; j++) {
+      const void* host_address;
+      err = loader.hsa_ven_amd_loader_query_host_address(kernel_address, &host_address);
+      ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+    }
+    p_timer.StopTimer(id);
+    host_address_timer.push_back(p_timer.ReadTimer(id));
+
+    id = p_timer.CreateTimer();
+    p_timer.StartTimer(id);
+    for (uint32_t j = 0; j < batch_size_; j++) {
+      hsa_executable_symbol_t symbol;
+      err = hsa_executable_get_symbol_by_name(executable, symbol_name.c_str(), gpu_device1(),
+                                              &symbol);
+      ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+    }
+    p_timer.StopTimer(id);
+    symbol_timer.push_back(p_timer.ReadTimer(id));
+
+    if (verbosity() >= VERBOSE_PROGRESS) {
+      std::cout << ".";
+      fflush(stdout);
+    }
+  }
+
+  if (verbosity() >= VERBOSE_PROGRESS) {
+    std::cout << std::endl;
+  }
+
+  results_.push_back({"hsa_ven_amd_loader_query_executable",
+                      MeanPerOp(&executable_timer, batch_size_)});
+  results_.push_back({"hsa_ven_amd_loader_query_host_address",
+                      MeanPerOp(&host_address_timer, batch_size_)});
+  results_.push_back({"hsa_executable_get_symbol_by_name", MeanPerOp(&symbol_timer, batch_size_)});
+}
+
+double HostOverhead::TimeBarriers(hsa_queue_t* queue, hsa_signal_t signal) {
+  hsa_barrier_and_packet_t* ring = reinterpret_cast<hsa_barrier_and_packet_t*>(queue->base_address);
+  const uint32_t mask = queue->size - 1;
+
+  uint16_t header = HSA_PACKET_TYPE_BARRIER_AND << HSA_PACKET_HEADER_TYPE;
+  header |= HSA_FENCE_SCOPE_SYSTEM << HSA_PACKET_HEADER_SCACQUIRE_FENCE_SCOPE;
+  header |= HSA_FENCE_SCOPE_SYSTEM << HSA_PACKET_HEADER_SCRELEASE_FENCE_SCOPE;
+
+  std::vector<double> timer;
+  rocrtst::PerfTimer p_timer;
+  size_t it = RealIterationNum();
+  for (size_t i = 0; i < it; i++) {
+    hsa_signal_store_relaxed(signal, packet_batch_);
+
+    int id = p_timer.CreateTimer();
+    p_timer.StartTimer(id);
+    uint64_t index = hsa_queue_add_write_index_relaxed(queue, packet_batch_);
+    for (uint64_t j = index; j < index + packet_batch_; j++) {
+      hsa_barrier_and_packet_t* packet = &ring[j & mask];
+      memset(reinterpret_cast<uint8_t*>(packet) + sizeof(packet->header), 0,
+             sizeof(*packet) - sizeof(packet->header));
+      packet->completion_signal = signal;
+      __atomic_store_n(reinterpret_cast<uint16_t*>(packet), header, __ATOMIC_RELEASE);
+    }
+    hsa_signal_store_screlease(queue->doorbell_signal, index + packet_batch_ - 1);
+    hsa_signal_wait_scacquire(signal, HSA_SIGNAL_CONDITION_EQ, 0, UINT64_MAX,
+                              HSA_WAIT_STATE_ACTIVE);
+    p_timer.StopTimer(id);
+    timer.push_back(p_timer.ReadTimer(id));
+
+    if (verbosity() >= VERBOSE_PROGRESS) {
+      std::cout << ".";
+      fflush(stdout);
+    }
+  }
+
+  if (verbosity() >= VERBOSE_PROGRESS) {
+    std::cout << std::endl;
+  }
+
+  return MeanPerOp(&timer, packet_batch_);
+}
+
+void HostOverhead::RunInterceptChain() {
+  hsa_status_t err;
+
+  const HsaApiTable* table = rocrtst_tool_api_table();
+  ASSERT_NE(nullptr, table) << "rocrtst tool library was not loaded by the runtime";
+  const AmdExtTable* amd_ext = table->amd_ext_;
+
+  hsa_signal_t signal;
+  err = hsa_signal_create(1, 0, nullptr, &signal);
+  ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+
+  for (uint32_t chain : kInterceptChains) {
+    hsa_queue_t* queue = nullptr;
+    if (chain == 0) {
+      err = hsa_queue_create(*gpu_device1(), kInterceptQueueSize, HSA_QUEUE_TYPE_MULTI, nullptr,
+                             nullptr, UINT32_MAX, UINT32_MAX, &queue);
+      ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+    } else {
+      err = amd_ext->hsa_amd_queue_intercept_create_fn(*gpu_device1(), kInterceptQueueSize,
+                                                       HSA_QUEUE_TYPE_MULTI, nullptr, nullptr,
+                                                       UINT32_MAX, UINT32_MAX, &queue);
+      ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+      for (uint32_t j = 0; j < chain; j++) {
+        err = amd_ext->hsa_amd_queue_intercept_register_fn(queue, PassThroughInterceptor,
+                                                           nullptr);
+        ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+      }
+    }
+
+    double mean = TimeBarriers(queue, signal);
+    results_.push_back({"barrier packet with " + std::to_string(chain) + " interceptors", mean});
+
+    err = hsa_queue_destroy(queue);
+    ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+  }
+
+  err = hsa_signal_destroy(signal);
+  ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+}
+
+void HostOverhead::RunAsyncHandlers() {
+  std::vector<hsa_signal_t> signals(num_handlers_);
+  std::vector<std::atomic<uint32_t>> done(num_handlers_);
+  hsa_status_t err;
+
+  for (uint32_t j = 0; j < num_handlers_; j++) {
+    err = hsa_signal_create(1, 0, nullptr, &signals[j]);
+    ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+  }
+
+  std::vector<double> timer;
+  rocrtst::PerfTimer p_timer;
+  size_t it = RealIterationNum();
+  for (size_t i = 0; i < it; i++) {
+    // Each handler gets its own argument so the runtime may run them on
+    // different workers.
+    for (uint32_t j = 0; j < num_handlers_; j++) {
+      done[j].store(0, std::memory_order_relaxed);
+      hsa_signal_store_screlease(signals[j], 1);
+      err = hsa_amd_signal_async_handler(signals[j], HSA_SIGNAL_CONDITION_EQ, 0,
+                                         AsyncHandlerWork, &done[j]);
+      ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+    }
+
+    int id = p_timer.CreateTimer();
+    p_timer.StartTimer(id);
+    for (uint32_t j = 0; j < num_handlers_; j++) {
+      hsa_signal_store_screlease(signals[j], 0);
+    }
+    for (uint32_t j = 0; j < num_handlers_; j++) {
+      while (done[j].load(std::memory_order_acquire) == 0) {
+        std::this_thread::yield();
+      }
+    }
+    p_timer.StopTimer(id);
+    timer.push_back(p_timer.ReadTimer(id));
+
+    if (verbosity() >= VERBOSE_PROGRESS) {
+      std::cout << ".";
+      fflush(stdout);
+    }
+  }
+
+  if (verbosity() >= VERBOSE_PROGRESS) {
+    std::cout << std::endl;
+  }
+
+  for (hsa_signal_t signal : signals) {
+    err = hsa_signal_destroy(signal);
+    ASSERT_EQ(HSA_STATUS_SUCCESS, err);
+  }
+
+  const char* workers = getenv("HSA_ASYNCEVENTS_WORKERS");
+  std::string label = "async handler (HSA_ASYNCEVENTS_WORKERS=" +
+      std::string(workers ? workers : "unset") + ")";
+  results_.push_back({label, MeanPerOp(&timer, num_handlers_)});
+}
+
+void HostOverhead::DisplayTestInfo(void) { TestBase::DisplayTestInfo(); }
+
+void HostOverhead::DisplayResults(void) const {
+  if (!rocrtst::CheckProfile(this)) {
+    return;
+  }
+
+  TestBase::DisplayResults();
+
+  for (const auto& result : results_) {
+    std::cout << "Average Time per " << result.first << ": " << result.second * 1e6 << " uS"
+              << std::endl;
+  }
+  return;
+}
+
+void HostOverhead::Close() {
+  TestBase::Close();
+  return;
+}
@@ -0,0 +1,138 @@
+/*
+ * =============================================================================
+ *   ROC Runtime Conformance Release License
+ * =============================================================================
+ * The University of Illinois/NCSA
+ * Open Source License (NCSA)
+ *
+ * Copyright (c) 2026, Advanced Micro Devices, Inc.
+ * All rights reserved.
+ *
+ * Developed by:
+ *
+ *                 AMD Research and AMD ROC Software Development
+ *
+ *                 Advanced Micro Devices, Inc.
+ *
+ *                 www.amd.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal with the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimers.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimers in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the names of <Name of Development Group, Name of Institution>,
+ *    nor the names of its contributors may be used to endorse or promote
+ *    products derived from this Software without specific prior written
+ *    permission.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS WITH THE SOFTWARE.
+ *
+ */
+
+#ifndef ROCRTST_SUITES_PERFORMANCE_HOST_OVERHEAD_H_
+#define ROCRTST_SUITES_PERFORMANCE_HOST_OVERHEAD_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "suites/test_common/test_base.h"
+#include "common/base_rocr.h"
+#include "hsa/hsa.h"
+
+// @Brief: This class measures the CPU side cost of runtime bookkeeping
+//  paths that do not depend on GPU execution, so it can run against the
+//  libhsakmt model backend as well as real hardware.
+
+class HostOverhead : public TestBase {
+ public:
+  enum Benchmark {
+    kSignalOps,      // Signal create, satisfied wait and destroy
+    kPointerInfo,    // hsa_amd_pointer_info with a large allocation map
+    kLoaderQueries,  // Loader address and symbol queries
+    kInterceptChain, // Packets through a chain of pass-through queue interceptors
+    kAsyncHandlers,  // Signal async handlers that do a little work each
+  };
+
+  // @Brief: Constructor
+  explicit HostOverhead(Benchmark benchmark);
+
+  // @Brief: Destructor
+  virtual ~HostOverhead(void);
+
+  // @Brief: Set up the environment for the test
+  virtual void SetUp(void);
+
+  // @Brief: Run the test case
+  virtual void Run(void);
+
+  // @Brief: Display  results we got
+  virtual void DisplayResults(void) const;
+
+  // @Brief: Display information about what this test does
+  virtual void DisplayTestInfo(void);
+
+  // @Brief: Clean up and close the runtime
+  virtual void Close(void);
+
+ private:
+  // @Brief: Get actual iteration number
+  size_t RealIterationNum(void);
+
+  // @Brief: Time signal create, wait and destroy
+  void RunSignalOps(void);
+
+  // @Brief: Time pointer info lookups
+  void RunPointerInfo(void);
+
+  // @Brief: Time loader queries on a loaded code object
+  void RunLoaderQueries(void);
+
+  // @Brief: Time packets through intercept queues with chains of interceptors
+  void RunInterceptChain(void);
+
+  // @Brief: Time batches of barrier packets from submission to completion on
+  //  the queue, return the mean time per packet
+  double TimeBarriers(hsa_queue_t* queue, hsa_signal_t signal);
+
+  // @Brief: Time a batch of async handlers from signaling to completion
+  void RunAsyncHandlers(void);
+
+  // @Brief: Drop the warm up sample and the slowest samples, return the
+  //  mean time per operation of the remaining ones
+  double MeanPerOp(std::vector<double>* timer, size_t ops_per_sample) const;
+
+  // @Brief: Selected benchmark
+  Benchmark benchmark_;
+
+  // @Brief: Number of operations timed together in one sample
+  uint32_t batch_size_;
+
+  // @Brief: Number of live allocations for pointer info lookups
+  uint32_t num_allocations_;
+
+  // @Brief: Number of packets submitted with one doorbell ring
+  uint32_t packet_batch_;
+
+  // @Brief: Number of signals with an async handler, one handler each
+  uint32_t num_handlers_;
+
+  // @Brief: Name and mean time per operation of each measured operation
+  std::vector<std::pair<std::string, double>> results_;
+};
+
+#endif  // ROCRTST_SUITES_PERFORMANCE_HOST_OVERHEAD_H_
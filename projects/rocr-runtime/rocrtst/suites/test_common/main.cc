@@ -62,6 +62,7 @@
 #include "suites/performance/memory_async_copy.h"
 #include "suites/performance/memory_async_copy_numa.h"
 #include "suites/performance/enqueueLatency.h"
+#include "suites/performance/host_overhead.h"
 #include "suites/negative/memory_allocate_negative_tests.h"
 #include "suites/negative/queue_validation.h"
 #include "suites/stress/memory_concurrent_tests.h"
@@ -77,6 +78,8 @@
 #include "suites/functional/aql_barrier_bit.h"
 #include "suites/functional/signal_kernel.h"
 #include "suites/functional/cu_masking.h"
+#include "suites/functional/intercept_queue.h"
+#include "suites/functional/async_handler.h"
 #include "amd_smi/amdsmi.h"
 
 static RocrTstGlobals *sRocrtstGlvalues = nullptr;
@@ -220,6 +223,20 @@ TEST(rocrtstFunc, DISABLED_CU_Masking) {
   RunGenericTest(&sd);
 }
 
+TEST(rocrtstFunc, Async_Handler_Slow) {
+  AsyncHandlerTest ah;
+  RunCustomTestProlog(&ah);
+  ah.SlowHandler();
+  RunCustomTestEpilog(&ah);
+}
+
+TEST(rocrtstFunc, Async_Handler_Order) {
+  AsyncHandlerTest ah;
+  RunCustomTestProlog(&ah);
+  ah.HandlerOrder();
+  RunCustomTestEpilog(&ah);
+}
+
 #ifndef ROCRTST_EMULATOR_BUILD
 TEST(rocrtstFunc, IPC) {
   IPCTest ipc;
@@ -268,6 +285,20 @@ TEST(rocrtstFunc, DISABLED_Aql_Barrier_Bit_Not_Set) {
   RunCustomTestEpilog(&ab);
 }
 
+TEST(rocrtstFunc, Intercept_Queue_Batched) {
+  InterceptQueueTest iq;
+  RunCustomTestProlog(&iq);
+  iq.BatchedIntercept();
+  RunCustomTestEpilog(&iq);
+}
+
+TEST(rocrtstFunc, Intercept_Queue_Overflow) {
+  InterceptQueueTest iq;
+  RunCustomTestProlog(&iq);
+  iq.OverflowIntercept();
+  RunCustomTestEpilog(&iq);
+}
+
 TEST(rocrtstFunc, Memory_Max_Mem) {
   MemoryTest mt;
 
@@ -518,6 +549,31 @@ TEST(rocrtstPerf, ENQUEUE_LATENCY) {
   RunGenericTest(&multiPacketequeue);
 }
 
+TEST(rocrtstPerf, Host_Overhead_Signal_Ops) {
+  HostOverhead ho(HostOverhead::kSignalOps);
+  RunGenericTest(&ho);
+}
+
+TEST(rocrtstPerf, Host_Overhead_Pointer_Info) {
+  HostOverhead ho(HostOverhead::kPointerInfo);
+  RunGenericTest(&ho);
+}
+
+TEST(rocrtstPerf, Host_Overhead_Loader_Queries) {
+  HostOverhead ho(HostOverhead::kLoaderQueries);
+  RunGenericTest(&ho);
+}
+
+TEST(rocrtstPerf, Host_Overhead_Intercept_Chain) {
+  HostOverhead ho(HostOverhead::kInterceptChain);
+  RunGenericTest(&ho);
+}
+
+TEST(rocrtstPerf, Host_Overhead_Async_Handlers) {
+  HostOverhead ho(HostOverhead::kAsyncHandlers);
+  RunGenericTest(&ho);
+}
+
 TEST(rocrtstPerf, DISABLED_Memory_Async_Copy_NUMA) {
   MemoryAsyncCopyNUMA numa;
   RunGenericTest(&numa);
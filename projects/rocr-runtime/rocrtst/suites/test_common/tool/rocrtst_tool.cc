@@ -0,0 +1,72 @@
+/*
+ * =============================================================================
+ *   ROC Runtime Conformance Release License
+ * =============================================================================
+ * The University of Illinois/NCSA
+ * Open Source License (NCSA)
+ *
+ * Copyright (c) 2026, Advanced Micro Devices, Inc.
+ * All rights reserved.
+ *
+ * Developed by:
+ *
+ *                 AMD Research and AMD ROC Software Development
+ *
+ *                 Advanced Micro Devices, Inc.
+ *
+ *                 www.amd.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal with the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimers.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimers in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the names of <Name of Development Group, Name of Institution>,
+ *    nor the names of its contributors may be used to endorse or promote
+ *    products derived from this Software without specific prior written
+ *    permission.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS WITH THE SOFTWARE.
+ *
+ */
+
+#include <atomic>
+
+#include "suites/test_common/tool/rocrtst_tool.h"
+
+#define ROCRTST_TOOL_EXPORT __attribute__((visibility("default")))
+
+static std::atomic<const HsaApiTable*> api_table{nullptr};
+
+extern "C" {
+
+// The runtime discovers loaded libraries which export this symbol and
+// loads them as tools, without HSA_TOOLS_LIB being set.
+ROCRTST_TOOL_EXPORT extern const uint32_t HSA_AMD_TOOL_PRIORITY = 50;
+
+ROCRTST_TOOL_EXPORT bool OnLoad(HsaApiTable* table, uint64_t runtime_version,
+                                uint64_t failed_tool_count, const char* const* failed_tool_names) {
+  api_table.store(table, std::memory_order_release);
+  return true;
+}
+
+ROCRTST_TOOL_EXPORT void OnUnload() { api_table.store(nullptr, std::memory_order_release); }
+
+ROCRTST_TOOL_EXPORT const HsaApiTable* rocrtst_tool_api_table(void) {
+  return api_table.load(std::memory_order_acquire);
+}
+
+}  // extern "C"
@@ -0,0 +1,202 @@
+/*
+ * =============================================================================
+ *   ROC Runtime Conformance Release License
+ * =============================================================================
+ * The University of Illinois/NCSA
+ * Open Source License (NCSA)
+ *
+ * Copyright (c) 2026, Advanced Micro Devices, Inc.
+ * All rights reserved.
+ *
+ * Developed by:
+ *
+ *                 AMD Research and AMD ROC Software Development
+ *
+ *                 Advanced Micro Devices, Inc.
+ *
+ *                 www.amd.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal with the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimers.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimers in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the names of <Name of Development Group, Name of Institution>,
+ *    nor the names of its contributors may be used to endorse or promote
+ *    products derived from this Software without specific prior written
+ *    permission.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS WITH THE SOFTWARE.
+ *
+ */
+
+// Unit tests of the fragment allocator used by the runtime's memory regions,
+// backed by malloc so they run without a GPU.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "core/util/slab_heap.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+const size_t kBlockSize = 2 * 1024 * 1024;
+
+size_t live_blocks = 0;
+std::map<uintptr_t, size_t> blocks;
+
+struct MallocBlockAllocator {
+  void* alloc(size_t request_size, size_t& allocated_size) const {
+    allocated_size = std::max(request_size, kBlockSize);
+    void* ptr = aligned_alloc(4096, allocated_size);
+    live_blocks++;
+    blocks[reinterpret_cast<uintptr_t>(ptr)] = allocated_size;
+    return ptr;
+  }
+  void free(void* ptr, size_t length) const {
+    live_blocks--;
+    blocks.erase(reinterpret_cast<uintptr_t>(ptr));
+    ::free(ptr);
+  }
+  size_t block_size() const { return kBlockSize; }
+};
+
+// Block of the backing allocator which contains ptr.
+std::pair<uintptr_t, size_t> BlockOf(const void* ptr) {
+  uintptr_t addr = reinterpret_cast<uintptr_t>(ptr);
+  auto it = blocks.upper_bound(addr);
+  if (it == blocks.begin()) return std::make_pair(uintptr_t(0), size_t(0));
+  --it;
+  return *it;
+}
+
+typedef rocr::SlabHeap<MallocBlockAllocator> Heap;
+
+}  // namespace
+
+TEST(rocrtstUnit, SlabHeap_Slab_Size) {
+  for (uint32_t class_index = 0; class_index < Heap::kNumClasses; ++class_index) {
+    const size_t object_size = (class_index + 1) * Heap::kClassGranule;
+    const uint32_t objects = Heap::slabObjects(class_index);
+    ASSERT_GE(objects, Heap::kMinSlabObjects);
+    ASSERT_LE(object_size * objects, std::max(Heap::kSlabSize, object_size * Heap::kMinSlabObjects));
+
+    // One live object of the class only keeps its own slab in use.
+    Heap heap;
+    void* ptr = heap.alloc(object_size);
+    ASSERT_NE(nullptr, ptr);
+    const size_t cached = heap.cache_size();
+    ASSERT_TRUE(heap.free(ptr));
+    ASSERT_EQ(cached + object_size * objects, heap.cache_size());
+
+    // A slab is filled before the next one is started.
+    std::vector<uintptr_t> addrs;
+    for (uint32_t i = 0; i < objects + 1; ++i) {
+      addrs.push_back(reinterpret_cast<uintptr_t>(heap.alloc(object_size)));
+    }
+    std::sort(addrs.begin(), addrs.end() - 1);
+    for (uint32_t i = 1; i < objects; ++i) ASSERT_EQ(addrs[i - 1] + object_size, addrs[i]);
+    ASSERT_TRUE(addrs.back() < addrs[0] || addrs.back() >= addrs[0] + object_size * objects);
+
+    for (uintptr_t addr : addrs) ASSERT_TRUE(heap.free(reinterpret_cast<void*>(addr)));
+  }
+  ASSERT_EQ(0u, live_blocks);
+}
+
+TEST(rocrtstUnit, SlabHeap_Random_Traffic) {
+  {
+    Heap heap;
+    std::mt19937 rng(7);
+    std::vector<std::pair<uint8_t*, size_t>> live;
+
+    for (int iter = 0; iter < 100000; ++iter) {
+      if (live.size() < 2000 && (live.empty() || rng() % 3 != 0)) {
+        // Mostly slab sized requests, some served by the backing heap.
+        size_t size = (rng() % 4 == 0) ? rng() % (256 * 1024) + 1 : rng() % (40 * 1024) + 1;
+        uint8_t* ptr = reinterpret_cast<uint8_t*>(heap.alloc(size));
+        ASSERT_NE(nullptr, ptr);
+        memset(ptr, int(size & 0xff), size);
+        live.push_back(std::make_pair(ptr, size));
+      } else {
+        size_t index = rng() % live.size();
+        uint8_t* ptr = live[index].first;
+        size_t size = live[index].second;
+        // Objects never overlap, so the pattern is intact.
+        for (size_t i = 0; i < size; i += 997) ASSERT_EQ(size & 0xff, ptr[i]);
+        ASSERT_EQ(size & 0xff, ptr[size - 1]);
+        ASSERT_TRUE(heap.free(ptr));
+        live[index] = live.back();
+        live.pop_back();
+      }
+    }
+
+    // Interior pointers and foreign pointers are rejected.
+    if (!live.empty() && live[0].second > 1) {
+      ASSERT_FALSE(heap.free(live[0].first + 1));
+    }
+    int foreign;
+    ASSERT_FALSE(heap.free(&foreign));
+
+    for (auto& object : live) ASSERT_TRUE(heap.free(object.first));
+    heap.trim();
+    ASSERT_EQ(0u, heap.cache_size());
+    ASSERT_EQ(0u, live_blocks);
+  }
+  ASSERT_EQ(0u, live_blocks);
+}
+
+TEST(rocrtstUnit, SlabHeap_Double_Free) {
+  Heap heap;
+  void* first = heap.alloc(Heap::kClassGranule);
+  void* second = heap.alloc(Heap::kClassGranule);
+  ASSERT_TRUE(heap.free(first));
+  ASSERT_FALSE(heap.free(first));
+  ASSERT_TRUE(heap.free(second));
+  ASSERT_TRUE(heap.free(nullptr));
+}
+
+TEST(rocrtstUnit, SlabHeap_Discard_Block) {
+  {
+    Heap heap;
+    const size_t object_size = 3 * Heap::kClassGranule;
+    void* kept = heap.alloc(object_size);
+    ASSERT_TRUE(heap.discardBlock(kept));
+
+    // No object of the discarded block is handed out again.
+    const auto discarded = BlockOf(kept);
+    ASSERT_NE(0u, discarded.second);
+    std::vector<void*> objects;
+    for (int i = 0; i < 64; ++i) {
+      void* ptr = heap.alloc(object_size);
+      ASSERT_NE(discarded, BlockOf(ptr));
+      objects.push_back(ptr);
+    }
+
+    ASSERT_TRUE(heap.free(kept));
+    for (void* ptr : objects) ASSERT_TRUE(heap.free(ptr));
+    heap.trim();
+    ASSERT_EQ(0u, live_blocks);
+  }
+  ASSERT_EQ(0u, live_blocks);
+}
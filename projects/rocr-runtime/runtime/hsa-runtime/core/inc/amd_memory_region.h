@@ -50,7 +50,7 @@
 #include "core/inc/agent.h"
 #include "core/inc/runtime.h"
 #include "core/inc/memory_region.h"
-#include "core/util/simple_heap.h"
+#include "core/util/slab_heap.h"
 #include "core/util/locks.h"
 
 #include "inc/hsa_ext_amd.h"
@@ -211,7 +211,7 @@ private:
     size_t block_size() const { return block_size_; }
   };
 
-  mutable SimpleHeap<BlockAllocator> fragment_allocator_;
+  mutable SlabHeap<BlockAllocator> fragment_allocator_;
 };
 
 }  // namespace amd
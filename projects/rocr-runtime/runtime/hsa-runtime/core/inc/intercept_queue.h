@@ -43,6 +43,7 @@
 #ifndef HSA_RUNTIME_CORE_INC_INTERCEPT_QUEUE_H_
 #define HSA_RUNTIME_CORE_INC_INTERCEPT_QUEUE_H_
 
+#include <algorithm>
 #include <vector>
 #include <memory>
 #include <utility>
@@ -196,6 +197,50 @@ class QueueProxy : public QueueWrapper {
   }
 };
 
+// @brief FIFO of rewritten packets waiting for space on the wrapped queue.
+// Storage is a power of two sized ring so that partial submission only moves
+// the head instead of shifting the remaining packets.
+class PacketOverflow {
+ public:
+  bool empty() const { return size_ == 0; }
+  uint64_t size() const { return size_; }
+
+  // First pending packet and the number of pending packets stored contiguously after it.
+  const AqlPacket* front() const { return &ring_[head_ & mask()]; }
+  uint64_t contiguous_size() const {
+    return std::min(size_, uint64_t(ring_.size()) - (head_ & mask()));
+  }
+
+  void push(const AqlPacket* packets, uint64_t count) {
+    if (size_ + count > ring_.size()) grow(size_ + count);
+    for (uint64_t i = 0; i < count; i++) ring_[(head_ + size_ + i) & mask()] = packets[i];
+    size_ += count;
+  }
+
+  void pop(uint64_t count) {
+    assert(count <= size_ && "Packet intercept error: overflow underrun.\n");
+    head_ += count;
+    size_ -= count;
+    if (size_ == 0) head_ = 0;
+  }
+
+ private:
+  uint64_t mask() const { return ring_.size() - 1; }
+
+  void grow(uint64_t min_size) {
+    uint64_t new_size = std::max<uint64_t>(ring_.size(), 64);
+    while (new_size < min_size) new_size *= 2;
+    std::vector<AqlPacket> ring(new_size);
+    for (uint64_t i = 0; i < size_; i++) ring[i] = ring_[(head_ + i) & mask()];
+    ring_.swap(ring);
+    head_ = 0;
+  }
+
+  std::vector<AqlPacket> ring_;
+  uint64_t head_ = 0;
+  uint64_t size_ = 0;
+};
+
 // @brief Provides packet intercept and rewrite capability for a queue.
 // Host-side dispatches are processed during doorbell ring.
 // Device-side dispatches are processed as an asynchronous signal event.
@@ -222,7 +267,7 @@ class InterceptQueue : public QueueProxy, private LocalSignal, public DoorbellSi
   uint64_t next_packet_;
 
   // Post interception packet overflow buffer
-  std::vector<AqlPacket> overflow_;
+  PacketOverflow overflow_;
 
   // Index at which async intercept processing was scheduled.
   uint64_t retry_index_;
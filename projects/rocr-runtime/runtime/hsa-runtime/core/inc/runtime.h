@@ -602,6 +602,54 @@ class Runtime {
     std::vector<void*> arg_;
   };
 
+  struct AsyncEventsInfo;
+
+  // Runs the handlers of satisfied signals for an async events thread. Handlers are keyed by
+  // their argument, or by their signal if they have none, and each key hashes to a slot of
+  // AsyncEventsInfo::worker_slots. While handlers of a slot are queued or running, further
+  // handlers of that slot go to the same worker, so the handlers of a signal, or of an object
+  // watching several signals, run in order and never concurrently. Idle slots go to the least
+  // busy worker. Keys sharing a slot are serialized as if they were one key.
+  struct AsyncEventsWorker {
+    struct Job {
+      hsa_signal_t signal;
+      hsa_signal_condition_t cond;
+      hsa_signal_value_t value;
+      hsa_amd_signal_handler handler;
+      void* arg;
+      hsa_signal_value_t observed;  //!< Signal value which satisfied the condition
+      uint64_t key;
+    };
+
+    // Worker of a slot and its number of queued or running handlers
+    struct Slot {
+      Slot() : worker(0), pending(0) {}
+      uint32_t worker;  //!< Only accessed by the async events thread
+      std::atomic<uint32_t> pending;
+    };
+
+    static const size_t kSlotBits = 8;
+    static const size_t kSlots = size_t(1) << kSlotBits;
+
+    AsyncEventsWorker() : thread_(NULL), info_(nullptr), exit_(false), busy_(0) {}
+
+    bool Start(AsyncEventsInfo* info, int priority);
+    void Submit(const Job& job);
+    void Shutdown();
+
+    static size_t SlotIndex(uint64_t key);
+    static void Dispatch(AsyncEventsInfo* info, const Job& job);
+    static void Loop(void* worker);
+
+    os::Thread thread_;
+    os::Semaphore pending_;
+    HybridMutex lock_;
+    std::vector<Job> jobs_;  //!< Swapped with the worker's batch, both keep their capacity
+    AsyncEventsInfo* info_;
+    bool exit_;
+    std::atomic<uint32_t> busy_;  //!< Handlers queued or running
+  };
+
   struct PrefetchRange;
   typedef std::map<uintptr_t, PrefetchRange> prefetch_map_t;
 
@@ -756,6 +804,8 @@ class Runtime {
     AsyncEvents events;
     AsyncEvents new_events;
     bool monitor_exceptions;
+    std::vector<std::unique_ptr<AsyncEventsWorker>> workers;
+    AsyncEventsWorker::Slot worker_slots[AsyncEventsWorker::kSlots];
   };
 
   struct AsyncEventsInfo asyncSignals_;
@@ -197,14 +197,18 @@ void InterceptQueue::Submit(const void* pkts, uint64_t pkt_count, uint64_t user_
   InterceptQueue* queue = reinterpret_cast<InterceptQueue*>(data);
   const AqlPacket* packets = (const AqlPacket*)pkts;
 
+  // Packets of an earlier rewrite are still waiting, queue behind them to preserve order.
+  if (!queue->overflow_.empty()) {
+    queue->overflow_.push(packets, pkt_count);
+    return;
+  }
+
   // Submit final packet transform to hardware.
   uint64_t submitted_count = queue->Submit(packets, pkt_count);
   if (submitted_count == pkt_count) return;
 
   // Could not submit all the final packets, stash unsubmitted ones for later.
-  assert(queue->overflow_.empty() && "Packet intercept error: overflow buffer not empty.\n");
-  for (uint64_t i = submitted_count; i < pkt_count; i++)
-    queue->overflow_.push_back(packets[i]);
+  queue->overflow_.push(packets + submitted_count, pkt_count - submitted_count);
 }
 
 uint64_t InterceptQueue::Submit(const AqlPacket* packets, uint64_t count) {
@@ -334,18 +338,13 @@ void InterceptQueue::StoreRelaxed(hsa_signal_value_t value) {
   ScopedAcquire<KernelMutex> lock(&lock_);
 
   // Submit overflow packets.
-  if (!overflow_.empty()) {
-    uint64_t submitted_count = Submit(&overflow_[0], overflow_.size());
-
-    if (submitted_count < overflow_.size()) {
-      overflow_.erase(overflow_.begin(), overflow_.begin() + submitted_count);
-      // Since there was no space to submit all the overflow packets, there is
-      // no space for other packets either.
-      return;
-    }
-
-    // All overflow packets have been submitted.
-    overflow_.clear();
+  while (!overflow_.empty()) {
+    uint64_t count = overflow_.contiguous_size();
+    uint64_t submitted_count = Submit(overflow_.front(), count);
+    overflow_.pop(submitted_count);
+    // If there was no space to submit all the overflow packets, there is no
+    // space for other packets either.
+    if (submitted_count < count) return;
   }
 
   Cursor.queue = this;
@@ -364,29 +363,39 @@ void InterceptQueue::StoreRelaxed(hsa_signal_value_t value) {
 
   uint64_t i = next_packet_;
   while (i < end) {
-    // Load the packet header as atomic acquire as it may have been written by
-    // another thread as atomic release. This ensures the rest of the packet
+    // Collect the run of valid packets that are contiguous in the ring buffer
+    // so the interceptor chain is invoked once for the whole run.
+    // Load the packet headers as atomic acquire as they may have been written
+    // by another thread as atomic release. This ensures the rest of the packet
     // fields are visible. Once loaded and proven not to be INVALID, further
     // loads by this thread can be non-atomic.
-    uint16_t header = atomic::Load(&ring[i & mask].packet.header, std::memory_order_acquire);
-    if (!AqlPacket::IsValid(header)) break;
+    uint64_t run_end = std::min(end, (i | mask) + 1);
+    uint64_t run = 0;
+    while (i + run < run_end) {
+      uint16_t header =
+          atomic::Load(&ring[(i + run) & mask].packet.header, std::memory_order_acquire);
+      if (!AqlPacket::IsValid(header)) break;
+      ++run;
+    }
+    if (run == 0) break;
 
     // Process callbacks.
     Cursor.interceptor_index = interceptors.size() - 1;
     Cursor.pkt_index = i;
     auto& handler = interceptors[Cursor.interceptor_index];
-    handler.first(&ring[i & mask], 1, i, handler.second, PacketWriter);
+    handler.first(&ring[i & mask], run, i, handler.second, PacketWriter);
     if (IsDeviceMemRingBuf() && needsPcieOrdering()) {
       // Ensure the packet body is written as header may get reordered when writing over PCIE
       _mm_sfence();
     }
-    // Invalidate consumed packet.
-    atomic::Store(&ring[i & mask].packet.header, kInvalidHeader, std::memory_order_release);
+    // Invalidate consumed packets.
+    for (uint64_t j = i; j < i + run; j++)
+      atomic::Store(&ring[j & mask].packet.header, kInvalidHeader, std::memory_order_release);
 
-    // Packet has now been processed so advance the read index.
-    ++i;
+    // Packets have now been processed so advance the read index.
+    i += run;
 
-    // Only allow the rewrite of one packet to be on the overflow queue. When
+    // Only allow the rewrite of one run to be on the overflow queue. When
     // packets are put on the overflow queue a barrier packet will also be
     // added which has an async handler that will ring the doorbell, That
     // doorbell ring will ensure this function is re-invoked to put the
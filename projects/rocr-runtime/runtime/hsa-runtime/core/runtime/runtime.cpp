@@ -846,6 +846,19 @@ hsa_status_t Runtime::SetAsyncSignalHandler(hsa_signal_t signal,
     asyncInfo->events.PushBack(asyncInfo->control.wake, HSA_SIGNAL_CONDITION_NE,
                           0, NULL, NULL);
 
+    // Start the workers running the signal handlers. Exception handlers stay on the
+    // monitoring thread.
+    if (!asyncInfo->monitor_exceptions) {
+      for (uint32_t i = 0; i < runtime_singleton_->flag().async_events_workers(); i++) {
+        std::unique_ptr<AsyncEventsWorker> worker(new AsyncEventsWorker());
+        if (!worker->Start(asyncInfo, priority)) {
+          assert(false && "Asyncronous events worker creation error.");
+          break;
+        }
+        asyncInfo->workers.push_back(std::move(worker));
+      }
+    }
+
     // Start event monitoring thread
     asyncInfo->control.exit = false;
     asyncInfo->control.async_events_thread_ =
@@ -1555,10 +1568,31 @@ void Runtime::AsyncEventsLoop(void* _eventsInfo) {
   uint32_t unique_evts = 0;
   auto hsa_signals = reinterpret_cast<hsa_signal_handle*>(&async_events_.signal_[0]);
 
+  auto& workers = eventsInfo->workers;
+
   auto processEvent = [&](size_t index, hsa_signal_value_t value, bool wait_any) {
     // No error or timeout occured, process the handlers
     // Call handler for the known satisfied signal.
     assert(async_events_.handler_[index] != nullptr);
+    if (!workers.empty()) {
+      // Hand the handler to its worker. The signal isn't monitored while its handler runs, the
+      // worker registers it again if the handler keeps it.
+      if (!wait_any) {
+        hsa_signals[index]->WaitingDec();
+      }
+      // Handlers of different signals may share their argument, e.g. the inactive and exception
+      // handlers of an AqlQueue, so handlers are keyed by argument and only by signal without one.
+      void* arg = async_events_.arg_[index];
+      uint64_t key = (arg != nullptr) ? reinterpret_cast<uintptr_t>(arg)
+                                      : async_events_.signal_[index].handle;
+      AsyncEventsWorker::Job job = {async_events_.signal_[index], async_events_.cond_[index],
+                                    async_events_.value_[index], async_events_.handler_[index],
+                                    arg, value, key};
+      AsyncEventsWorker::Dispatch(eventsInfo, job);
+      async_events_.CopyIndex(index, async_events_.Size() - 1);
+      async_events_.PopBack();
+      return false;
+    }
     bool keep = async_events_.handler_[index](value, async_events_.arg_[index]);
     if (!keep) {
       if (!wait_any) {
@@ -1727,6 +1761,11 @@ void Runtime::AsyncEventsLoop(void* _eventsInfo) {
     functions.clear();
   }
 
+  // Run the handlers of the signals which are already satisfied. Signals kept by their
+  // handlers are added to the new events and released below.
+  for (auto& worker : workers) worker->Shutdown();
+  workers.clear();
+
   // Release wait count of all pending signals
   for (size_t i = 1; i < async_events_.Size(); i++)
     hsa_signal_handle(async_events_.signal_[i])->Release();
@@ -2492,6 +2531,107 @@ void Runtime::AsyncEventsControl::Shutdown() {
   }
 }
 
+bool Runtime::AsyncEventsWorker::Start(AsyncEventsInfo* info, int priority) {
+  info_ = info;
+  exit_ = false;
+  pending_ = os::CreateSemaphore();
+  thread_ = os::CreateThread(Loop, this, 0, priority);
+  if (thread_ == NULL) {
+    os::DestroySemaphore(pending_);
+    return false;
+  }
+  return true;
+}
+
+void Runtime::AsyncEventsWorker::Submit(const Job& job) {
+  {
+    ScopedAcquire<HybridMutex> lock(&lock_);
+    jobs_.push_back(job);
+  }
+  os::PostSemaphore(pending_);
+}
+
+void Runtime::AsyncEventsWorker::Shutdown() {
+  if (thread_ == NULL) return;
+  {
+    ScopedAcquire<HybridMutex> lock(&lock_);
+    exit_ = true;
+  }
+  os::PostSemaphore(pending_);
+  os::WaitForThread(thread_);
+  os::CloseThread(thread_);
+  thread_ = NULL;
+  os::DestroySemaphore(pending_);
+}
+
+size_t Runtime::AsyncEventsWorker::SlotIndex(uint64_t key) {
+  // Fibonacci hashing, the low bits of arguments and signal handles are mostly alignment
+  return size_t((key * 0x9E3779B97F4A7C15ull) >> (64 - kSlotBits));
+}
+
+void Runtime::AsyncEventsWorker::Dispatch(AsyncEventsInfo* info, const Job& job) {
+  // Only the async events thread dispatches, so it alone assigns the worker of a slot. Once the
+  // pending count of a slot drops to zero no handler of the slot is queued or running, and the
+  // slot may move to another worker.
+  auto& workers = info->workers;
+  Slot& slot = info->worker_slots[SlotIndex(job.key)];
+  if (slot.pending.load(std::memory_order_acquire) == 0) {
+    uint32_t index = 0;
+    for (uint32_t i = 1; i < workers.size(); i++)
+      if (workers[i]->busy_.load(std::memory_order_relaxed) <
+          workers[index]->busy_.load(std::memory_order_relaxed))
+        index = i;
+    slot.worker = index;
+  }
+  slot.pending.fetch_add(1, std::memory_order_relaxed);
+
+  AsyncEventsWorker* worker = workers[slot.worker].get();
+  worker->busy_.fetch_add(1, std::memory_order_relaxed);
+  worker->Submit(job);
+}
+
+void Runtime::AsyncEventsWorker::Loop(void* _worker) {
+  AsyncEventsWorker* worker = reinterpret_cast<AsyncEventsWorker*>(_worker);
+  AsyncEventsInfo* info = worker->info_;
+
+  std::vector<Job> batch;
+  bool exit = false;
+  while (!exit) {
+    // The semaphore doesn't count posts, drain all jobs after every wake up
+    os::WaitSemaphore(worker->pending_);
+    while (true) {
+      {
+        ScopedAcquire<HybridMutex> lock(&worker->lock_);
+        if (worker->jobs_.empty()) {
+          exit = worker->exit_;
+          break;
+        }
+        batch.swap(worker->jobs_);
+      }
+
+      for (const Job& job : batch) {
+        bool keep = job.handler(job.observed, job.arg);
+        if (keep) {
+          // Monitor the signal again, the reference taken at registration is kept
+          ScopedAcquire<HybridMutex> lock(&info->control.lock);
+          info->new_events.PushBack(job.signal, job.cond, job.value, job.handler, job.arg);
+          hsa_signal_handle(info->control.wake)->StoreRelease(1);
+        } else {
+          hsa_signal_handle(job.signal)->Release();
+        }
+
+        // Publishes the completed handler to the dispatcher before the slot can move
+        Slot& slot = info->worker_slots[SlotIndex(job.key)];
+        assert(slot.pending.load(std::memory_order_relaxed) != 0 &&
+               "Async handler slot is not busy.");
+        slot.pending.fetch_sub(1, std::memory_order_release);
+        worker->busy_.fetch_sub(1, std::memory_order_relaxed);
+      }
+      batch.clear();
+    }
+  }
+}
+
 void Runtime::AsyncEvents::PushBack(hsa_signal_t signal,
                                     hsa_signal_condition_t cond,
                                     hsa_signal_value_t value,
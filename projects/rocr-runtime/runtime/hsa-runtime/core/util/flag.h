@@ -282,6 +282,12 @@ class Flag {
         fprintf(stderr, "Failed to parse HSA_ASYNCEVENTS_THREAD_PRIORITY");
     }
 
+    // Number of threads running the handlers of satisfied signals. 0 runs them on the async
+    // events thread, which keeps the order between handlers of unrelated signals.
+    var = os::GetEnvVar("HSA_ASYNCEVENTS_WORKERS");
+    int async_events_workers = var.empty() ? 0 : atoi(var.c_str());
+    async_events_workers_ = (async_events_workers > 0) ? async_events_workers : 0;
+
     var = os::GetEnvVar("HSA_IMAGE_ENABLE_3D_SWIZZLE_DEBUG");
     enable_3d_swizzle_ = (var == "1") ? true : false;
 
@@ -413,6 +419,8 @@ class Flag {
 
   int async_events_thread_priority() const { return async_events_thread_priority_; }
 
+  uint32_t async_events_workers() const { return async_events_workers_; }
+
   bool enable_3d_swizzle() const { return enable_3d_swizzle_; }
 
   bool enable_dtif() const { return enable_dtif_; }
@@ -448,6 +456,7 @@ class Flag {
   bool dev_mem_queue_buf_;
   uint32_t signal_abort_timeout_;
   int  async_events_thread_priority_;
+  uint32_t async_events_workers_;
   bool enable_3d_swizzle_ = false;
   bool enable_dtif_;
 
@@ -286,6 +286,18 @@ template <typename Allocator> class SimpleHeap {
 
   size_t default_block_size() const { return block_allocator_.block_size(); }
 
+  // Find the block containing ptr.  Returns false if ptr is not within a block in use.
+  bool findBlock(const void* ptr, uintptr_t& base, size_t& length) const {
+    uintptr_t addr = reinterpret_cast<uintptr_t>(ptr);
+    auto frag_map_it = block_list_.upper_bound(addr);
+    if (frag_map_it == block_list_.begin()) return false;
+    frag_map_it--;
+    const auto& frag_map = frag_map_it->second;
+    base = frag_map.begin()->first;
+    length = frag_map.rbegin()->first + frag_map.rbegin()->second.size - base;
+    return (base <= addr) && (addr < base + length);
+  }
+
   // Prevent reuse of the block containing ptr.  No further fragments will be allocated from the
   // block and the block will not be added to the block cache when it is free.
   bool discardBlock(void* ptr) {
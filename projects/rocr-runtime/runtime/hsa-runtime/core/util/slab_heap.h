@@ -0,0 +1,292 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// The University of Illinois/NCSA
+// Open Source License (NCSA)
+//
+// Copyright (c) 2026, Advanced Micro Devices, Inc. All rights reserved.
+//
+// Developed by:
+//
+//                 AMD Research and AMD HSA Software Development
+//
+//                 Advanced Micro Devices, Inc.
+//
+//                 www.amd.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+//  - Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimers.
+//  - Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimers in
+//    the documentation and/or other materials provided with the distribution.
+//  - Neither the names of Advanced Micro Devices, Inc,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this Software without specific prior written
+//    permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS WITH THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+// Size class slab front end for SimpleHeap.  Small requests are rounded up to a
+// multiple of kClassGranule and served from slabs of equally sized objects that
+// are sub-allocated from the backing SimpleHeap, so the common alloc/free pair
+// is a bit scan and a binary search instead of several tree updates.  A slab
+// holds as many objects as fit in kSlabSize, at least kMinSlabObjects, which
+// bounds the memory a single live object keeps pinned.  Requests larger than
+// kMaxClassSize go straight to the backing heap.  Like SimpleHeap, all calls
+// must be serialized by the caller.
+
+#ifndef HSA_RUNTME_CORE_UTIL_SLAB_HEAP_H_
+#define HSA_RUNTME_CORE_UTIL_SLAB_HEAP_H_
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "core/util/simple_heap.h"
+#include "core/util/utils.h"
+
+namespace rocr {
+
+template <typename Allocator> class SlabHeap {
+ public:
+  static constexpr size_t kClassGranule = 4096;
+  static constexpr size_t kMaxClassSize = 32 * 1024;
+  static constexpr size_t kNumClasses = kMaxClassSize / kClassGranule;
+  static constexpr size_t kSlabSize = 64 * 1024;
+  static constexpr uint32_t kMinSlabObjects = 2;
+
+  // Number of objects in a slab of the size class.
+  static uint32_t slabObjects(uint32_t class_index) {
+    size_t objects = kSlabSize / ((class_index + 1) * kClassGranule);
+    return uint32_t(std::max<size_t>(objects, kMinSlabObjects));
+  }
+  static_assert(kSlabSize / kClassGranule < 64, "A slab's free mask must fit in 64 bits.");
+
+ private:
+  struct Slab {
+    uintptr_t base_;
+    size_t object_size_;
+    uint32_t class_index_;
+    uint32_t objects_;
+    // Value of free_mask_ when all objects are free.
+    uint64_t all_free_;
+    // Bit set for each free object.
+    uint64_t free_mask_;
+    // Position in the partial list of the size class, or kNotPartial.
+    size_t partial_pos_;
+    // Set when the containing block was discarded.  No further objects are handed out and the
+    // slab is returned to the backing heap once empty.
+    bool discard_;
+
+    static const size_t kNotPartial = SIZE_MAX;
+
+    Slab(uintptr_t base, uint32_t class_index)
+        : base_(base),
+          object_size_((class_index + 1) * kClassGranule),
+          class_index_(class_index),
+          objects_(slabObjects(class_index)),
+          all_free_((1ull << objects_) - 1),
+          free_mask_(all_free_),
+          partial_pos_(kNotPartial),
+          discard_(false) {}
+
+    size_t length() const { return object_size_ * objects_; }
+    bool contains(uintptr_t ptr) const { return (base_ <= ptr) && (ptr < base_ + length()); }
+    bool empty() const { return free_mask_ == all_free_; }
+  };
+
+  struct SizeClass {
+    // Slabs with at least one free object.
+    std::vector<Slab*> partial_;
+    // Number of slabs of this class that are completely free.
+    size_t empty_count_ = 0;
+  };
+
+  SimpleHeap<Allocator> backing_;
+
+  // All slabs sorted by base address.
+  std::vector<std::unique_ptr<Slab>> slabs_;
+  SizeClass classes_[kNumClasses];
+
+  // Total size of completely free slabs.
+  size_t empty_size_;
+
+  static __forceinline bool slabBaseLess(const std::unique_ptr<Slab>& slab, uintptr_t base) {
+    return slab->base_ < base;
+  }
+
+  Slab* findSlab(uintptr_t ptr) const {
+    auto it = std::upper_bound(slabs_.begin(), slabs_.end(), ptr,
+                               [](uintptr_t p, const std::unique_ptr<Slab>& slab) {
+                                 return p < slab->base_;
+                               });
+    if (it == slabs_.begin()) return nullptr;
+    --it;
+    return (*it)->contains(ptr) ? it->get() : nullptr;
+  }
+
+  void addPartial(Slab* slab) {
+    auto& partial = classes_[slab->class_index_].partial_;
+    slab->partial_pos_ = partial.size();
+    partial.push_back(slab);
+  }
+
+  void removePartial(Slab* slab) {
+    auto& partial = classes_[slab->class_index_].partial_;
+    partial[slab->partial_pos_] = partial.back();
+    partial[slab->partial_pos_]->partial_pos_ = slab->partial_pos_;
+    partial.pop_back();
+    slab->partial_pos_ = Slab::kNotPartial;
+  }
+
+  Slab* newSlab(uint32_t class_index) {
+    std::unique_ptr<Slab> slab(new Slab(0, class_index));
+    slab->base_ = reinterpret_cast<uintptr_t>(backing_.alloc(slab->length()));
+    auto it = std::lower_bound(slabs_.begin(), slabs_.end(), slab->base_, slabBaseLess);
+    Slab* ret = slabs_.insert(it, std::move(slab))->get();
+    addPartial(ret);
+    classes_[class_index].empty_count_++;
+    empty_size_ += ret->length();
+    return ret;
+  }
+
+  void releaseSlab(Slab* slab) {
+    if (slab->partial_pos_ != Slab::kNotPartial) removePartial(slab);
+    uintptr_t base = slab->base_;
+    auto it = std::lower_bound(slabs_.begin(), slabs_.end(), base, slabBaseLess);
+    assert(it != slabs_.end() && it->get() == slab && "Inconsistency in SlabHeap.");
+    slabs_.erase(it);
+    bool err = backing_.free(reinterpret_cast<void*>(base));
+    assert(err && "SlabHeap: slab free failed.");
+  }
+
+ public:
+  explicit SlabHeap(const Allocator& BlockAllocator = Allocator())
+      : backing_(BlockAllocator), empty_size_(0) {}
+  ~SlabHeap() { trim(); }
+
+  SlabHeap(const SlabHeap& rhs) = delete;
+  SlabHeap(SlabHeap&& rhs) = delete;
+  SlabHeap& operator=(const SlabHeap& rhs) = delete;
+  SlabHeap& operator=(SlabHeap&& rhs) = delete;
+
+  void* alloc(size_t bytes) {
+    if ((bytes == 0) || (bytes > kMaxClassSize)) return backing_.alloc(bytes);
+
+    uint32_t class_index = uint32_t(AlignUp(bytes, kClassGranule) / kClassGranule) - 1;
+    SizeClass& size_class = classes_[class_index];
+
+    Slab* slab =
+        size_class.partial_.empty() ? newSlab(class_index) : size_class.partial_.back();
+    if (slab->empty()) {
+      size_class.empty_count_--;
+      empty_size_ -= slab->length();
+    }
+
+    uint32_t index = __builtin_ctzll(slab->free_mask_);
+    slab->free_mask_ &= ~(1ull << index);
+    if (slab->free_mask_ == 0) removePartial(slab);
+
+    return reinterpret_cast<void*>(slab->base_ + index * slab->object_size_);
+  }
+
+  bool free(void* ptr) {
+    if (ptr == nullptr) return true;
+
+    uintptr_t addr = reinterpret_cast<uintptr_t>(ptr);
+    Slab* slab = findSlab(addr);
+    if (slab == nullptr) return backing_.free(ptr);
+
+    // Validate object.
+    size_t offset = addr - slab->base_;
+    if ((offset % slab->object_size_) != 0) return false;
+    uint64_t bit = 1ull << (offset / slab->object_size_);
+    if ((slab->free_mask_ & bit) != 0) return false;
+
+    bool was_full = (slab->free_mask_ == 0);
+    slab->free_mask_ |= bit;
+
+    if (slab->discard_) {
+      if (slab->empty()) releaseSlab(slab);
+      return true;
+    }
+
+    if (was_full) addPartial(slab);
+
+    if (slab->empty()) {
+      // Keep one empty slab per class to avoid churning the backing heap.
+      SizeClass& size_class = classes_[slab->class_index_];
+      if (size_class.empty_count_ != 0) {
+        releaseSlab(slab);
+      } else {
+        size_class.empty_count_++;
+        empty_size_ += slab->length();
+      }
+    }
+    return true;
+  }
+
+  void trim() {
+    for (size_t i = slabs_.size(); i > 0; i--) {
+      Slab* slab = slabs_[i - 1].get();
+      if (slab->empty() && !slab->discard_) {
+        classes_[slab->class_index_].empty_count_--;
+        empty_size_ -= slab->length();
+        releaseSlab(slab);
+      }
+    }
+    backing_.trim();
+  }
+
+  size_t cache_size() const { return backing_.cache_size() + empty_size_; }
+
+  size_t default_block_size() const { return backing_.default_block_size(); }
+
+  // Prevent reuse of the block containing ptr.  Slabs carved from the block stop handing out
+  // objects and are released to the backing heap once all their objects are freed.
+  bool discardBlock(void* ptr) {
+    if (ptr == nullptr) return true;
+
+    uintptr_t base;
+    size_t length;
+    if (!backing_.findBlock(ptr, base, length)) return false;
+
+    if (!backing_.discardBlock(ptr)) return false;
+
+    size_t i = std::lower_bound(slabs_.begin(), slabs_.end(), base, slabBaseLess) - slabs_.begin();
+    while ((i < slabs_.size()) && (slabs_[i]->base_ < base + length)) {
+      Slab* slab = slabs_[i].get();
+      if (slab->discard_ || !slab->empty()) {
+        if (!slab->discard_ && (slab->partial_pos_ != Slab::kNotPartial)) removePartial(slab);
+        slab->discard_ = true;
+        i++;
+        continue;
+      }
+      // Empty slabs are returned right away, which removes them from slabs_.
+      slab->discard_ = true;
+      classes_[slab->class_index_].empty_count_--;
+      empty_size_ -= slab->length();
+      releaseSlab(slab);
+    }
+
+    return true;
+  }
+};
+
+}  // namespace rocr
+
+#endif  // HSA_RUNTME_CORE_UTIL_SLAB_HEAP_H_